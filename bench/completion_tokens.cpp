@@ -0,0 +1,410 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Completion token overhead benchmark. Runs identical loops of async operations
+// with each completion token, so differences are due to the async machinery
+// (handler type erasure, allocations, scheduling and coroutine switches) rather than to I/O.
+// Connections use a replay_stream holding canned server responses, so no server is required.
+//
+// Usage: boost_mysql_bench_completion_tokens [filter]
+// Only benchmarks whose name contains filter are run. Build in release mode
+// for meaningful results.
+//
+// Two loops are measured:
+//   execute:        async_execute of a query returning a small resultset
+//   read_some_rows: async_start_execution followed by async_read_some_rows until the
+//                   resultset is complete. The response is delivered in small chunks,
+//                   so most operations complete after a single read.
+// Reported figures are per initiated async operation: wall time, calls to the global
+// operator new (in any thread), and user-space instructions (Linux only, see instruction_counter.hpp).
+// use_future and yield_context figures include the cost of creating a thread or a coroutine
+// per sample, amortized over the sample's operations.
+// use_awaitable and deferred require C++20.
+
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/execution_state.hpp>
+#include <boost/mysql/protocol_trace.hpp>
+#include <boost/mysql/replay_stream.hpp>
+#include <boost/mysql/results.hpp>
+#include <boost/mysql/rows_view.hpp>
+#include <boost/mysql/string_view.hpp>
+#include <boost/mysql/wire_capture.hpp>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/use_future.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench/harness.hpp"
+#include "bench/instruction_counter.hpp"
+#include "bench/server_responses.hpp"
+#include "bench/synthetic_rows.hpp"
+#include "test_common/allocation_counter.hpp"
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/deferred.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#endif
+
+using namespace boost::mysql;
+using namespace boost::mysql::bench;
+namespace asio = boost::asio;
+
+namespace {
+
+constexpr string_view query = "SELECT * FROM bench";
+
+// Benchmarks are set up to never fail. If they did, results would be meaningless
+void check(error_code ec)
+{
+    if (ec)
+    {
+        std::cerr << "Unexpected error: " << ec.message() << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+// Splits the response to a query into records of at most chunk_size bytes
+std::vector<wire_capture_record> make_records(const response_shape& shape, std::size_t chunk_size)
+{
+    server_responses responses(shape);
+    const auto& msg = responses.query();
+    std::vector<wire_capture_record> res;
+    for (std::size_t offset = 0; offset < msg.size(); offset += chunk_size)
+    {
+        std::size_t last = (std::min)(msg.size(), offset + chunk_size);
+        res.push_back(wire_capture_record{
+            trace_direction::read,
+            std::chrono::nanoseconds(0),
+            std::vector<std::uint8_t>(msg.begin() + offset, msg.begin() + last),
+        });
+    }
+    return res;
+}
+
+// A connection replaying the response to a query every time it's rewound
+struct client
+{
+    asio::io_context ctx;
+    connection<replay_stream> conn;
+    results result;
+    execution_state st;
+    std::uint64_t num_ops{};
+
+    explicit client(std::vector<wire_capture_record> records) : conn(ctx.get_executor(), std::move(records))
+    {
+    }
+
+    void rewind() { conn.stream().rewind(); }
+
+    // Runs the io_context until there is no more work, leaving it ready to be run again
+    void run()
+    {
+        ctx.run();
+        ctx.restart();
+    }
+};
+
+//
+// Callbacks. Handlers are small structs that start the next operation on completion
+//
+class execute_callback_op
+{
+    client* c_;
+    std::size_t remaining_;
+
+    void start_execute()
+    {
+        c_->rewind();
+        ++c_->num_ops;
+        c_->conn.async_execute(query, c_->result, std::move(*this));
+    }
+
+public:
+    execute_callback_op(client& c, std::size_t num_iterations) noexcept : c_(&c), remaining_(num_iterations)
+    {
+    }
+
+    void start() { start_execute(); }
+
+    void operator()(error_code ec)
+    {
+        check(ec);
+        do_not_optimize(c_->result.rows().size());
+        if (--remaining_)
+            start_execute();
+    }
+};
+
+class read_some_rows_callback_op
+{
+    client* c_;
+    std::size_t remaining_;
+
+    void start_execution()
+    {
+        c_->rewind();
+        ++c_->num_ops;
+        c_->conn.async_start_execution(query, c_->st, std::move(*this));
+    }
+
+    void read_some_rows()
+    {
+        ++c_->num_ops;
+        c_->conn.async_read_some_rows(c_->st, std::move(*this));
+    }
+
+    void next()
+    {
+        if (!c_->st.complete())
+            read_some_rows();
+        else if (--remaining_)
+            start_execution();
+    }
+
+public:
+    read_some_rows_callback_op(client& c, std::size_t num_iterations) noexcept
+        : c_(&c), remaining_(num_iterations)
+    {
+    }
+
+    void start() { start_execution(); }
+
+    void operator()(error_code ec)
+    {
+        check(ec);
+        next();
+    }
+
+    void operator()(error_code ec, rows_view rows)
+    {
+        check(ec);
+        do_not_optimize(rows.size());
+        next();
+    }
+};
+
+void execute_callback(client& c, std::size_t num_iterations)
+{
+    execute_callback_op(c, num_iterations).start();
+    c.run();
+}
+
+void read_some_rows_callback(client& c, std::size_t num_iterations)
+{
+    read_some_rows_callback_op(c, num_iterations).start();
+    c.run();
+}
+
+//
+// Futures. The io_context is run by a separate thread, while the calling thread waits
+//
+template <class Fn>
+void run_in_thread(client& c, Fn fn)
+{
+    auto guard = asio::make_work_guard(c.ctx);
+    std::thread runner([&c] { c.ctx.run(); });
+    fn();
+    guard.reset();
+    runner.join();
+    c.ctx.restart();
+}
+
+void execute_future(client& c, std::size_t num_iterations)
+{
+    run_in_thread(c, [&c, num_iterations] {
+        for (std::size_t i = 0; i < num_iterations; ++i)
+        {
+            c.rewind();
+            ++c.num_ops;
+            c.conn.async_execute(query, c.result, asio::use_future).get();
+            do_not_optimize(c.result.rows().size());
+        }
+    });
+}
+
+void read_some_rows_future(client& c, std::size_t num_iterations)
+{
+    run_in_thread(c, [&c, num_iterations] {
+        for (std::size_t i = 0; i < num_iterations; ++i)
+        {
+            c.rewind();
+            ++c.num_ops;
+            c.conn.async_start_execution(query, c.st, asio::use_future).get();
+            while (!c.st.complete())
+            {
+                ++c.num_ops;
+                do_not_optimize(c.conn.async_read_some_rows(c.st, asio::use_future).get().size());
+            }
+        }
+    });
+}
+
+//
+// Stackful coroutines
+//
+void execute_yield(client& c, std::size_t num_iterations)
+{
+    asio::spawn(c.ctx.get_executor(), [&c, num_iterations](asio::yield_context yield) {
+        for (std::size_t i = 0; i < num_iterations; ++i)
+        {
+            c.rewind();
+            ++c.num_ops;
+            c.conn.async_execute(query, c.result, yield);
+            do_not_optimize(c.result.rows().size());
+        }
+    });
+    c.run();
+}
+
+void read_some_rows_yield(client& c, std::size_t num_iterations)
+{
+    asio::spawn(c.ctx.get_executor(), [&c, num_iterations](asio::yield_context yield) {
+        for (std::size_t i = 0; i < num_iterations; ++i)
+        {
+            c.rewind();
+            ++c.num_ops;
+            c.conn.async_start_execution(query, c.st, yield);
+            while (!c.st.complete())
+            {
+                ++c.num_ops;
+                do_not_optimize(c.conn.async_read_some_rows(c.st, yield).size());
+            }
+        }
+    });
+    c.run();
+}
+
+//
+// C++20 coroutines. Operations are awaited either with use_awaitable or with deferred
+//
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+void rethrow_on_error(std::exception_ptr ptr)
+{
+    if (ptr)
+        std::rethrow_exception(ptr);
+}
+
+template <class CompletionToken>
+asio::awaitable<void> execute_coro(client& c, std::size_t num_iterations, CompletionToken token)
+{
+    for (std::size_t i = 0; i < num_iterations; ++i)
+    {
+        c.rewind();
+        ++c.num_ops;
+        co_await c.conn.async_execute(query, c.result, token);
+        do_not_optimize(c.result.rows().size());
+    }
+}
+
+template <class CompletionToken>
+asio::awaitable<void> read_some_rows_coro(client& c, std::size_t num_iterations, CompletionToken token)
+{
+    for (std::size_t i = 0; i < num_iterations; ++i)
+    {
+        c.rewind();
+        ++c.num_ops;
+        co_await c.conn.async_start_execution(query, c.st, token);
+        while (!c.st.complete())
+        {
+            ++c.num_ops;
+            rows_view rows = co_await c.conn.async_read_some_rows(c.st, token);
+            do_not_optimize(rows.size());
+        }
+    }
+}
+
+void execute_awaitable(client& c, std::size_t num_iterations)
+{
+    asio::co_spawn(c.ctx, execute_coro(c, num_iterations, asio::use_awaitable), rethrow_on_error);
+    c.run();
+}
+
+void read_some_rows_awaitable(client& c, std::size_t num_iterations)
+{
+    asio::co_spawn(c.ctx, read_some_rows_coro(c, num_iterations, asio::use_awaitable), rethrow_on_error);
+    c.run();
+}
+
+void execute_deferred(client& c, std::size_t num_iterations)
+{
+    asio::co_spawn(c.ctx, execute_coro(c, num_iterations, asio::deferred), rethrow_on_error);
+    c.run();
+}
+
+void read_some_rows_deferred(client& c, std::size_t num_iterations)
+{
+    asio::co_spawn(c.ctx, read_some_rows_coro(c, num_iterations, asio::deferred), rethrow_on_error);
+    c.run();
+}
+#endif
+
+//
+// Measurement
+//
+template <class Fn>
+void bench_token(runner& r, string_view name, client& c, Fn fn)
+{
+    r.run_batch(name, [&c, fn](std::size_t num_iterations) {
+        c.num_ops = 0;
+        fn(c, num_iterations);
+        return static_cast<std::size_t>(c.num_ops);
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    instruction_counter instructions;  // must be created before any thread
+    runner r(argc, argv);
+    r.add_counter("allocs", test::total_allocations);
+    if (instructions.available())
+        r.add_counter("instr", [&instructions] { return instructions.read(); });
+    else
+        std::fprintf(stderr, "Instruction counter not available, instructions won't be reported\n");
+
+    // A small resultset, received in a single read
+    const column_mix mix = all_column_mixes().at(1);  // mixed
+    client execute_client(make_records(response_shape{mix, 10}, 1u << 16));
+
+    // A larger resultset, received in chunks of a few rows
+    client read_client(make_records(response_shape{mix, 1000}, 512));
+
+    bench_token(r, "execute/callback", execute_client, execute_callback);
+    bench_token(r, "execute/use_future", execute_client, execute_future);
+    bench_token(r, "execute/yield_context", execute_client, execute_yield);
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    bench_token(r, "execute/use_awaitable", execute_client, execute_awaitable);
+    bench_token(r, "execute/deferred", execute_client, execute_deferred);
+#endif
+
+    bench_token(r, "read_some_rows/callback", read_client, read_some_rows_callback);
+    bench_token(r, "read_some_rows/use_future", read_client, read_some_rows_future);
+    bench_token(r, "read_some_rows/yield_context", read_client, read_some_rows_yield);
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    bench_token(r, "read_some_rows/use_awaitable", read_client, read_some_rows_awaitable);
+    bench_token(r, "read_some_rows/deferred", read_client, read_some_rows_deferred);
+#endif
+
+    return r.exit_code();
+}
@@ -0,0 +1,546 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// End-to-end throughput benchmark. Runs clients against an in-process scripted server
+// (see scripted_server.hpp), so results include syscalls, Asio scheduling and decoding,
+// but not the cost of a real server. Reports QPS and latency percentiles
+// for each API style and concurrency level.
+//
+// Usage: boost_mysql_bench_e2e [--option=value]...
+//   --transport=tcp|unix                     (default: tcp)
+//   --op=query|statement|ping                (default: query)
+//   --api=all|sync|callback|future|coroutine (default: all)
+//   --concurrency=N[,N]...                   (default: 1,8,32)
+//   --mix=ints|mixed|strings                 (default: mixed)
+//   --rows=N                                 (default: 10)
+//   --duration=SECONDS                       (default: 2)
+//
+// Each client owns a connection. sync and future clients run in a thread each.
+// callback and coroutine clients share a single thread running the io_context.
+// Coroutine clients require C++20.
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/error_with_diagnostics.hpp>
+#include <boost/mysql/handshake_params.hpp>
+#include <boost/mysql/results.hpp>
+#include <boost/mysql/statement.hpp>
+#include <boost/mysql/tcp.hpp>
+#include <boost/mysql/unix.hpp>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/use_future.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench/scripted_server.hpp"
+#include "bench/synthetic_rows.hpp"
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#endif
+
+using namespace boost::mysql;
+using namespace boost::mysql::bench;
+namespace asio = boost::asio;
+using clock_type = std::chrono::steady_clock;
+
+namespace {
+
+enum class transport_kind
+{
+    tcp,
+    unix_socket,
+};
+
+enum class op_kind
+{
+    query,
+    statement,
+    ping,
+};
+
+enum class api_kind
+{
+    sync,
+    callback,
+    future,
+    coroutine,
+};
+
+const char* to_string(api_kind v)
+{
+    switch (v)
+    {
+    case api_kind::sync: return "sync";
+    case api_kind::callback: return "callback";
+    case api_kind::future: return "future";
+    case api_kind::coroutine: return "coroutine";
+    default: return "<unknown>";
+    }
+}
+
+struct config
+{
+    transport_kind transport{transport_kind::tcp};
+    op_kind op{op_kind::query};
+    std::vector<api_kind> apis{api_kind::sync, api_kind::callback, api_kind::future, api_kind::coroutine};
+    std::vector<std::size_t> concurrency{1, 8, 32};
+    std::string mix{"mixed"};
+    std::size_t num_rows{10};
+    double duration_s{2.0};
+};
+
+// The server ignores the SQL, but we send something representative
+constexpr const char* query_sql = "SELECT * FROM bench WHERE id < 10";
+
+// Latencies recorded before this fraction of the run has elapsed are discarded
+constexpr double warmup_fraction = 0.1;
+
+// The time window where operations are measured
+struct run_window
+{
+    clock_type::time_point measure_start;
+    clock_type::time_point deadline;
+
+    explicit run_window(double duration_s)
+    {
+        auto duration = std::chrono::duration_cast<clock_type::duration>(
+            std::chrono::duration<double>(duration_s)
+        );
+        auto now = clock_type::now();
+        measure_start = now + std::chrono::duration_cast<clock_type::duration>(duration * warmup_fraction);
+        deadline = now + duration;
+    }
+};
+
+// A client connection, with the objects required to run operations on it
+template <class Stream>
+struct client
+{
+    connection<Stream> conn;
+    results result;
+    statement stmt;
+    std::vector<std::int64_t> latencies_ns;
+
+    explicit client(asio::io_context& ctx) : conn(ctx) {}
+
+    void record(const run_window& window, clock_type::time_point start)
+    {
+        if (start >= window.measure_start)
+            latencies_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       clock_type::now() - start
+            )
+                                       .count());
+    }
+};
+
+void check(error_code ec)
+{
+    if (ec)
+    {
+        std::cerr << "Operation failed: " << ec.message() << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+void set_nodelay(asio::ip::tcp::socket& sock) { sock.set_option(asio::ip::tcp::no_delay(true)); }
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+void set_nodelay(asio::local::stream_protocol::socket&) noexcept {}
+#endif
+
+template <class Stream>
+void run_op(client<Stream>& c, op_kind op)
+{
+    switch (op)
+    {
+    case op_kind::query: c.conn.execute(query_sql, c.result); break;
+    case op_kind::statement: c.conn.execute(c.stmt.bind(std::int64_t(42)), c.result); break;
+    case op_kind::ping: c.conn.ping(); break;
+    }
+}
+
+// All the operations we measure have a void(error_code) signature
+template <class Stream, class CompletionToken>
+auto async_run_op(client<Stream>& c, op_kind op, CompletionToken&& token)
+    -> decltype(c.conn.async_ping(std::forward<CompletionToken>(token)))
+{
+    switch (op)
+    {
+    case op_kind::query: return c.conn.async_execute(query_sql, c.result, std::forward<CompletionToken>(token));
+    case op_kind::statement:
+        return c.conn.async_execute(
+            c.stmt.bind(std::int64_t(42)),
+            c.result,
+            std::forward<CompletionToken>(token)
+        );
+    default: return c.conn.async_ping(std::forward<CompletionToken>(token));
+    }
+}
+
+// Runs operations on a client until the deadline, re-issuing them from the completion handler
+template <class Stream>
+class callback_loop
+{
+    client<Stream>& client_;
+    op_kind op_;
+    const run_window& window_;
+    clock_type::time_point op_start_;
+
+    void on_done(error_code ec)
+    {
+        check(ec);
+        client_.record(window_, op_start_);
+        start();
+    }
+
+public:
+    callback_loop(client<Stream>& c, op_kind op, const run_window& window) noexcept
+        : client_(c), op_(op), window_(window)
+    {
+    }
+
+    void start()
+    {
+        op_start_ = clock_type::now();
+        if (op_start_ >= window_.deadline)
+            return;
+        async_run_op(client_, op_, [this](error_code ec) { on_done(ec); });
+    }
+};
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+template <class Stream>
+asio::awaitable<void> coroutine_loop(client<Stream>& c, op_kind op, const run_window& window)
+{
+    while (true)
+    {
+        auto start = clock_type::now();
+        if (start >= window.deadline)
+            co_return;
+        co_await async_run_op(c, op, asio::use_awaitable);
+        c.record(window, start);
+    }
+}
+#endif
+
+struct run_result
+{
+    double qps;
+    std::vector<std::int64_t> latencies_ns;  // sorted
+};
+
+// Runs a benchmark with a given API and concurrency, using connections of type Stream
+template <class Stream>
+run_result run_benchmark(
+    const config& cfg,
+    api_kind api,
+    std::size_t concurrency,
+    const typename Stream::endpoint_type& ep
+)
+{
+    asio::io_context ctx;
+
+    // Setup. Connection establishment is not measured
+    std::vector<std::unique_ptr<client<Stream>>> clients;
+    for (std::size_t i = 0; i < concurrency; ++i)
+    {
+        std::unique_ptr<client<Stream>> c(new client<Stream>(ctx));
+        c->conn.connect(ep, handshake_params("bench", "bench"));
+        set_nodelay(c->conn.stream());
+        if (cfg.op == op_kind::statement)
+            c->stmt = c->conn.prepare_statement("SELECT * FROM bench WHERE id = ?");
+        clients.push_back(std::move(c));
+    }
+
+    // Run
+    run_window window(cfg.duration_s);
+    switch (api)
+    {
+    case api_kind::sync:
+    {
+        std::vector<std::thread> threads;
+        for (auto& c : clients)
+        {
+            client<Stream>* pc = c.get();
+            threads.emplace_back([pc, &cfg, &window] {
+                while (true)
+                {
+                    auto start = clock_type::now();
+                    if (start >= window.deadline)
+                        return;
+                    run_op(*pc, cfg.op);
+                    pc->record(window, start);
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+        break;
+    }
+    case api_kind::callback:
+    {
+        std::vector<std::unique_ptr<callback_loop<Stream>>> loops;
+        for (auto& c : clients)
+        {
+            loops.emplace_back(new callback_loop<Stream>(*c, cfg.op, window));
+            loops.back()->start();
+        }
+        ctx.run();
+        break;
+    }
+    case api_kind::future:
+    {
+        auto guard = asio::make_work_guard(ctx);
+        std::thread runner([&ctx] { ctx.run(); });
+        std::vector<std::thread> threads;
+        for (auto& c : clients)
+        {
+            client<Stream>* pc = c.get();
+            threads.emplace_back([pc, &cfg, &window] {
+                while (true)
+                {
+                    auto start = clock_type::now();
+                    if (start >= window.deadline)
+                        return;
+                    async_run_op(*pc, cfg.op, asio::use_future).get();
+                    pc->record(window, start);
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+        guard.reset();
+        runner.join();
+        break;
+    }
+    case api_kind::coroutine:
+    {
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+        for (auto& c : clients)
+            asio::co_spawn(ctx, coroutine_loop(*c, cfg.op, window), asio::detached);
+        ctx.run();
+#endif
+        break;
+    }
+    }
+
+    // Teardown
+    for (auto& c : clients)
+        c->conn.close();
+
+    // Collect results
+    run_result res{};
+    for (const auto& c : clients)
+        res.latencies_ns.insert(res.latencies_ns.end(), c->latencies_ns.begin(), c->latencies_ns.end());
+    std::sort(res.latencies_ns.begin(), res.latencies_ns.end());
+    double measured_s = std::chrono::duration<double>(window.deadline - window.measure_start).count();
+    res.qps = static_cast<double>(res.latencies_ns.size()) / measured_s;
+    return res;
+}
+
+double percentile_us(const std::vector<std::int64_t>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+    auto idx = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+    return static_cast<double>(sorted[idx]) / 1000.0;
+}
+
+void print_header()
+{
+    std::printf(
+        "%-10s %12s %12s %10s %10s %10s %10s %10s\n",
+        "api",
+        "concurrency",
+        "qps",
+        "p50 (us)",
+        "p90 (us)",
+        "p99 (us)",
+        "p99.9 (us)",
+        "max (us)"
+    );
+}
+
+void print_result(api_kind api, std::size_t concurrency, const run_result& r)
+{
+    std::printf(
+        "%-10s %12zu %12.0f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+        to_string(api),
+        concurrency,
+        r.qps,
+        percentile_us(r.latencies_ns, 0.5),
+        percentile_us(r.latencies_ns, 0.9),
+        percentile_us(r.latencies_ns, 0.99),
+        percentile_us(r.latencies_ns, 0.999),
+        percentile_us(r.latencies_ns, 1.0)
+    );
+}
+
+template <class Stream>
+void run_all(const config& cfg, const typename Stream::endpoint_type& ep)
+{
+    print_header();
+    for (auto api : cfg.apis)
+    {
+#ifndef BOOST_ASIO_HAS_CO_AWAIT
+        if (api == api_kind::coroutine)
+        {
+            std::printf("%-10s (requires C++20 coroutines, skipped)\n", to_string(api));
+            continue;
+        }
+#endif
+        for (auto concurrency : cfg.concurrency)
+            print_result(api, concurrency, run_benchmark<Stream>(cfg, api, concurrency, ep));
+    }
+}
+
+// Command line parsing
+[[noreturn]] void usage(const char* prog)
+{
+    std::cerr << "Usage: " << prog
+              << " [--transport=tcp|unix] [--op=query|statement|ping]"
+                 " [--api=all|sync|callback|future|coroutine] [--concurrency=N[,N]...]"
+                 " [--mix=ints|mixed|strings] [--rows=N] [--duration=SECONDS]\n";
+    std::exit(EXIT_FAILURE);
+}
+
+std::vector<std::size_t> parse_list(const std::string& value)
+{
+    std::vector<std::size_t> res;
+    std::size_t pos = 0;
+    while (pos <= value.size())
+    {
+        auto comma = value.find(',', pos);
+        if (comma == std::string::npos)
+            comma = value.size();
+        res.push_back(std::stoul(value.substr(pos, comma - pos)));
+        pos = comma + 1;
+    }
+    return res;
+}
+
+config parse_config(int argc, char** argv)
+{
+    config res;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto eq = arg.find('=');
+        if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos)
+            usage(argv[0]);
+        std::string key = arg.substr(2, eq - 2), value = arg.substr(eq + 1);
+
+        if (key == "transport" && value == "tcp")
+            res.transport = transport_kind::tcp;
+        else if (key == "transport" && value == "unix")
+            res.transport = transport_kind::unix_socket;
+        else if (key == "op" && value == "query")
+            res.op = op_kind::query;
+        else if (key == "op" && value == "statement")
+            res.op = op_kind::statement;
+        else if (key == "op" && value == "ping")
+            res.op = op_kind::ping;
+        else if (key == "api" && value == "sync")
+            res.apis = {api_kind::sync};
+        else if (key == "api" && value == "callback")
+            res.apis = {api_kind::callback};
+        else if (key == "api" && value == "future")
+            res.apis = {api_kind::future};
+        else if (key == "api" && value == "coroutine")
+            res.apis = {api_kind::coroutine};
+        else if (key == "api" && value == "all")
+            res.apis = config().apis;
+        else if (key == "concurrency")
+            res.concurrency = parse_list(value);
+        else if (key == "mix")
+            res.mix = value;
+        else if (key == "rows")
+            res.num_rows = std::stoul(value);
+        else if (key == "duration")
+            res.duration_s = std::stod(value);
+        else
+            usage(argv[0]);
+    }
+    return res;
+}
+
+const column_mix* find_mix(const std::vector<column_mix>& mixes, const std::string& name)
+{
+    for (const auto& mix : mixes)
+    {
+        if (name == mix.name)
+            return &mix;
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        auto cfg = parse_config(argc, argv);
+        auto mixes = all_column_mixes();
+        const column_mix* mix = find_mix(mixes, cfg.mix);
+        if (!mix)
+            usage(argv[0]);
+
+        scripted_server server(response_shape{*mix, cfg.num_rows});
+        std::printf(
+            "op=%s mix=%s rows=%zu transport=%s duration=%.1fs\n",
+            cfg.op == op_kind::query ? "query" : cfg.op == op_kind::statement ? "statement" : "ping",
+            mix->name,
+            cfg.num_rows,
+            cfg.transport == transport_kind::tcp ? "tcp" : "unix",
+            cfg.duration_s
+        );
+
+        if (cfg.transport == transport_kind::tcp)
+        {
+            run_all<asio::ip::tcp::socket>(cfg, server.tcp_endpoint());
+        }
+        else
+        {
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+            run_all<asio::local::stream_protocol::socket>(cfg, server.unix_endpoint());
+#else
+            std::cerr << "UNIX sockets are not supported in this system" << std::endl;
+            return EXIT_FAILURE;
+#endif
+        }
+    }
+    catch (const error_with_diagnostics& err)
+    {
+        std::cerr << "Error: " << err.what() << ", error code: " << err.code() << '\n'
+                  << "Server diagnostics: " << err.get_diagnostics().server_message() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << "Error: " << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
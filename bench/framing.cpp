@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Stress benchmarks for the framing layer (message_reader, message_parser and read_buffer)
+// under unusual inputs: tiny socket reads, messages around the 0xffffff frame size limit,
+// very wide rows and giant cells. Their goal is catching regressions that make
+// framing quadratic in the number of reads or in the message size, which go unnoticed
+// with the typical inputs used by the protocol benchmarks.
+//
+// Usage: boost_mysql_bench_framing [filter]
+// Only benchmarks whose name contains filter are run. Build in release mode
+// for meaningful results. Scenarios with 1-byte reads over multi-frame messages
+// perform tens of millions of reads per call, so they take a few seconds each.
+//
+// Each benchmark reads a network stream with all the scenario's messages through a message_reader,
+// using a stream that returns at most chunk_size bytes per read. Besides timings, the following
+// are reported, measured in the last call:
+//   peak buffer: size of the read buffer, relative to the biggest message in the scenario.
+//   reads:       number of read_some calls on the stream.
+//   allocations: calls to the global operator new. The read buffer is reused between calls,
+//                so this should be zero.
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/any_stream.hpp>
+
+#include <boost/mysql/impl/internal/channel/message_reader.hpp>
+#include <boost/mysql/impl/internal/protocol/constants.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/core/span.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/harness.hpp"
+#include "bench/synthetic_rows.hpp"
+#include "test_common/allocation_counter.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::bench;
+namespace asio = boost::asio;
+
+namespace {
+
+// Benchmarks are set up to never fail. If they did, results would be meaningless
+void check(error_code ec)
+{
+    if (ec)
+    {
+        std::cerr << "Unexpected error: " << ec.message() << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+// Serves a fixed sequence of bytes, returning at most chunk_size bytes per read.
+// This is the read side of test_stream (see the unit tests), which isn't available here.
+// Reads are a bounded memcpy, so the stream doesn't dominate timings even with tiny chunks.
+class chunked_stream final : public detail::any_stream
+{
+    boost::span<const std::uint8_t> bytes_;
+    std::size_t chunk_size_;
+    std::size_t offset_{0};
+
+    static void unsupported(error_code& ec) noexcept { ec = asio::error::operation_not_supported; }
+
+public:
+    chunked_stream(boost::span<const std::uint8_t> bytes, std::size_t chunk_size) noexcept
+        : any_stream(false, false), bytes_(bytes), chunk_size_(chunk_size)
+    {
+    }
+
+    void rewind() noexcept { offset_ = 0; }
+    bool done() const noexcept { return offset_ == bytes_.size(); }
+
+    executor_type get_executor() override { return executor_type(); }
+
+    std::size_t read_some(asio::mutable_buffer buff, error_code& ec) override
+    {
+        std::size_t size = (std::min)({buff.size(), chunk_size_, bytes_.size() - offset_});
+        if (size == 0u)
+        {
+            ec = asio::error::eof;
+            return 0u;
+        }
+        std::memcpy(buff.data(), bytes_.data() + offset_, size);
+        offset_ += size;
+        ec = error_code();
+        return size;
+    }
+
+    // Only sync reads are used by this benchmark
+    void async_read_some(asio::mutable_buffer, asio::any_completion_handler<void(error_code, std::size_t)>)
+        override
+    {
+        std::abort();
+    }
+    std::size_t write_some(asio::const_buffer, error_code& ec) override
+    {
+        unsupported(ec);
+        return 0u;
+    }
+    void async_write_some(asio::const_buffer, asio::any_completion_handler<void(error_code, std::size_t)>)
+        override
+    {
+        std::abort();
+    }
+    void handshake(error_code& ec) override { unsupported(ec); }
+    void async_handshake(asio::any_completion_handler<void(error_code)>) override { std::abort(); }
+    void shutdown(error_code& ec) override { unsupported(ec); }
+    void async_shutdown(asio::any_completion_handler<void(error_code)>) override { std::abort(); }
+    void connect(const void*, error_code& ec) override { unsupported(ec); }
+    void async_connect(const void*, asio::any_completion_handler<void(error_code)>) override { std::abort(); }
+    void close(error_code& ec) override { unsupported(ec); }
+    bool is_open() const noexcept override { return true; }
+    std::string remote_address() const override { return std::string(); }
+};
+
+// A set of messages to be read, as the server would send them
+struct scenario
+{
+    std::string name;
+    std::vector<std::uint8_t> stream;
+    std::size_t num_messages;
+    std::size_t max_message_size;
+};
+
+// Adds frame headers to messages, splitting the ones that don't fit in a single frame.
+// Messages with a size multiple of the maximum frame size are terminated by an empty frame
+scenario make_scenario(std::string name, const std::vector<std::vector<std::uint8_t>>& bodies)
+{
+    scenario res{std::move(name), {}, bodies.size(), 0u};
+    std::uint8_t seqnum = 0;
+    for (const auto& body : bodies)
+    {
+        res.max_message_size = (std::max)(res.max_message_size, body.size());
+        std::size_t offset = 0;
+        while (true)
+        {
+            std::size_t size = (std::min)(body.size() - offset, detail::MAX_PACKET_SIZE);
+            res.stream.push_back(static_cast<std::uint8_t>(size));
+            res.stream.push_back(static_cast<std::uint8_t>(size >> 8));
+            res.stream.push_back(static_cast<std::uint8_t>(size >> 16));
+            res.stream.push_back(seqnum++);
+            res.stream.insert(res.stream.end(), body.begin() + offset, body.begin() + offset + size);
+            offset += size;
+            if (size < detail::MAX_PACKET_SIZE)
+                break;
+        }
+    }
+    return res;
+}
+
+// Rows as returned by typical queries
+scenario rows_scenario(const column_mix& mix)
+{
+    synthetic_rows rows(mix, 256);
+    return make_scenario(std::string("rows_") + mix.name, rows.text_bodies());
+}
+
+// Messages that fill a frame minus one byte, exactly a frame (followed by an empty frame)
+// and a frame plus one byte (two frames)
+scenario frame_boundary_scenario()
+{
+    std::vector<std::vector<std::uint8_t>> bodies{
+        std::vector<std::uint8_t>(detail::MAX_PACKET_SIZE - 1u, 0x61),
+        std::vector<std::uint8_t>(detail::MAX_PACKET_SIZE, 0x62),
+        std::vector<std::uint8_t>(detail::MAX_PACKET_SIZE + 1u, 0x63),
+    };
+    return make_scenario("frame_boundary", bodies);
+}
+
+// Text rows with 4096 short string columns
+scenario wide_rows_scenario()
+{
+    constexpr std::size_t num_columns = 4096;
+    std::vector<std::vector<std::uint8_t>> bodies(16);
+    for (std::size_t i = 0; i < bodies.size(); ++i)
+    {
+        for (std::size_t j = 0; j < num_columns; ++j)
+            detail_bench::put_lenenc_string(bodies[i], std::to_string(i * num_columns + j));
+    }
+    return make_scenario("wide_rows", bodies);
+}
+
+// A single row with a 32MB string cell, which spans several frames
+scenario giant_cell_scenario()
+{
+    std::vector<std::uint8_t> body;
+    detail_bench::put_lenenc_string(body, std::string(32u * 1024u * 1024u, 'a'));
+    return make_scenario("giant_cell", {body});
+}
+
+// Reads all the messages in the stream
+void read_messages(detail::message_reader& reader, chunked_stream& stream, std::size_t num_messages)
+{
+    error_code ec;
+    std::uint8_t seqnum = 0;
+    stream.rewind();
+    for (std::size_t i = 0; i < num_messages; ++i)
+    {
+        reader.read_some(stream, ec);
+        check(ec);
+        auto msg = reader.get_next_message(seqnum, ec);
+        check(ec);
+        do_not_optimize(msg.data());
+    }
+    if (!stream.done() || reader.has_message())
+    {
+        std::cerr << "Unexpected trailing bytes" << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+std::string bench_name(const scenario& s, std::size_t chunk_size)
+{
+    std::string res = "read_messages/";
+    res += chunk_size == static_cast<std::size_t>(-1) ? std::string("unchunked")
+                                                      : "chunk" + std::to_string(chunk_size);
+    res += '/';
+    res += s.name;
+    return res;
+}
+
+void bench_read_messages(runner& r, const scenario& s, std::size_t chunk_size)
+{
+    chunked_stream stream(s.stream, chunk_size);
+    detail::message_reader reader(1024);
+
+    bool ran = r.run(bench_name(s, chunk_size), s.num_messages, s.stream.size(), [&] {
+        read_messages(reader, stream, s.num_messages);
+    });
+    if (!ran)
+        return;
+
+    // Report memory and read counts for a single call
+    std::size_t reads_before = reader.stats().read_calls;
+    std::uint64_t allocs_before = test::total_allocations();
+    read_messages(reader, stream, s.num_messages);
+    std::uint64_t allocs = test::total_allocations() - allocs_before;
+    std::size_t reads = reader.stats().read_calls - reads_before;
+
+    std::printf(
+        "    peak buffer: %zu bytes (%.2fx biggest message), reads: %zu, allocations: %llu\n",
+        reader.buffer().size(),
+        static_cast<double>(reader.buffer().size()) / static_cast<double>(s.max_message_size),
+        reads,
+        static_cast<unsigned long long>(allocs)
+    );
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    runner r(argc, argv);
+    constexpr std::size_t unchunked = static_cast<std::size_t>(-1);
+
+    // Small messages. Tiny reads measure the per-read overhead
+    for (const auto& mix : all_column_mixes())
+    {
+        auto s = rows_scenario(mix);
+        for (std::size_t chunk_size : {std::size_t(1), std::size_t(7), std::size_t(4096), unchunked})
+            bench_read_messages(r, s, chunk_size);
+    }
+
+    // Big messages. Reading them must be linear in their size, regardless of how they're chunked
+    const scenario big_scenarios[] = {wide_rows_scenario(), frame_boundary_scenario(), giant_cell_scenario()};
+    for (const auto& s : big_scenarios)
+    {
+        for (std::size_t chunk_size : {std::size_t(1), std::size_t(4096), std::size_t(65536), unchunked})
+            bench_read_messages(r, s, chunk_size);
+    }
+
+    return r.exit_code();
+}
@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_BENCH_INCLUDE_BENCH_HARNESS_HPP
+#define BOOST_MYSQL_BENCH_INCLUDE_BENCH_HARNESS_HPP
+
+#include <boost/mysql/string_view.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A minimal benchmark harness. Each benchmark is a callable that processes a fixed
+// amount of work (items and bytes). The harness calibrates the number of calls
+// so that a sample takes at least min_sample_ns, then takes num_samples samples
+// and reports the median, which is less sensitive to noise than the mean.
+// Besides timings, benchmarks may report counters (e.g. allocations), also per item.
+
+namespace boost {
+namespace mysql {
+namespace bench {
+
+// Prevents the compiler from optimizing away computations whose result is unused
+template <class T>
+inline void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+    (void)*p;
+#endif
+}
+
+class runner
+{
+    using clock_type = std::chrono::steady_clock;
+
+    static constexpr std::size_t num_samples = 7;
+    static constexpr double min_sample_ns = 50e6;
+
+    struct counter
+    {
+        const char* name;
+        std::function<std::uint64_t()> read;
+    };
+
+    // Figures measured by a sample, before normalizing them by the number of items
+    struct sample
+    {
+        double ns;
+        double items;
+        std::vector<double> counters;
+    };
+
+    std::string filter_;
+    std::vector<counter> counters_;
+    std::size_t num_run_{};
+
+    // Runs batch_fn(num_calls), which returns the number of items it processed
+    template <class BatchFn>
+    sample measure(BatchFn& batch_fn, std::size_t num_calls)
+    {
+        std::vector<std::uint64_t> counters_before;
+        for (const auto& c : counters_)
+            counters_before.push_back(c.read());
+        auto start = clock_type::now();
+
+        std::size_t items = batch_fn(num_calls);
+
+        sample res{std::chrono::duration<double, std::nano>(clock_type::now() - start).count(), 0.0, {}};
+        res.items = static_cast<double>(items);
+        for (std::size_t i = 0; i < counters_.size(); ++i)
+            res.counters.push_back(static_cast<double>(counters_[i].read() - counters_before[i]));
+        return res;
+    }
+
+    static double median(std::vector<double>& values)
+    {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    void print_header() const
+    {
+        std::printf("%-48s %14s %12s", "benchmark", "ns/item", "MB/s");
+        for (const auto& c : counters_)
+            std::printf(" %10s/item", c.name);
+        std::printf("\n");
+    }
+
+    // bytes_per_item is zero if the benchmark doesn't report throughput
+    template <class BatchFn>
+    bool run_impl(string_view name, double bytes_per_item, BatchFn batch_fn)
+    {
+        if (name.find(filter_) == string_view::npos)
+            return false;
+        if (num_run_++ == 0)
+            print_header();
+
+        // Calibrate. This also warms up caches and buffers
+        std::size_t num_calls = 1;
+        while (measure(batch_fn, num_calls).ns < min_sample_ns)
+            num_calls *= 2;
+
+        // Sample
+        std::vector<double> ns;
+        std::vector<std::vector<double>> counter_values(counters_.size());
+        for (std::size_t i = 0; i < num_samples; ++i)
+        {
+            sample s = measure(batch_fn, num_calls);
+            ns.push_back(s.ns / s.items);
+            for (std::size_t j = 0; j < counters_.size(); ++j)
+                counter_values[j].push_back(s.counters[j] / s.items);
+        }
+
+        double ns_per_item = median(ns);
+        std::printf("%-48.*s %14.2f ", static_cast<int>(name.size()), name.data(), ns_per_item);
+        if (bytes_per_item > 0.0)
+            std::printf("%12.1f", bytes_per_item / ns_per_item * 1e3);
+        else
+            std::printf("%12s", "n/a");
+        for (auto& values : counter_values)
+            std::printf(" %15.2f", median(values));
+        std::printf("\n");
+        return true;
+    }
+
+public:
+    // Accepts an optional argument: only benchmarks whose name contains it are run
+    runner(int argc, char** argv)
+    {
+        if (argc >= 2)
+            filter_ = argv[1];
+    }
+
+    // Adds a counter to be reported by all benchmarks, per item. read should return
+    // a monotonically increasing value. Must be called before running any benchmark
+    void add_counter(const char* name, std::function<std::uint64_t()> read)
+    {
+        counters_.push_back(counter{name, std::move(read)});
+    }
+
+    // Runs fn, which processes items_per_call items (e.g. rows)
+    // and bytes_per_call bytes each time it's called.
+    // Returns false if the benchmark was skipped because it didn't match the filter
+    template <class Fn>
+    bool run(string_view name, std::size_t items_per_call, std::size_t bytes_per_call, Fn fn)
+    {
+        return run_impl(
+            name,
+            static_cast<double>(bytes_per_call) / static_cast<double>(items_per_call),
+            [&fn, items_per_call](std::size_t num_calls) {
+                for (std::size_t i = 0; i < num_calls; ++i)
+                    fn();
+                return num_calls * items_per_call;
+            }
+        );
+    }
+
+    // Like run, but for benchmarks where the work done by a call isn't known in advance.
+    // fn(num_calls) runs num_calls iterations and returns the number of items processed
+    // (e.g. async operations). Throughput is not reported
+    template <class Fn>
+    bool run_batch(string_view name, Fn fn)
+    {
+        return run_impl(name, 0.0, fn);
+    }
+
+    // Returns zero if at least one benchmark ran, to be used as the program's exit code
+    int exit_code() const noexcept
+    {
+        if (num_run_ == 0)
+            std::fprintf(stderr, "No benchmark matches the filter '%s'\n", filter_.c_str());
+        return num_run_ ? 0 : 1;
+    }
+};
+
+}  // namespace bench
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_BENCH_INCLUDE_BENCH_INSTRUCTION_COUNTER_HPP
+#define BOOST_MYSQL_BENCH_INCLUDE_BENCH_INSTRUCTION_COUNTER_HPP
+
+#include <cstdint>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Counts the user-space instructions retired by the process, using a hardware
+// performance counter. Instruction counts are much less noisy than timings,
+// which makes them suitable to detect small regressions.
+//
+// Only supported on Linux, and only if perf events are allowed for unprivileged users
+// (/proc/sys/kernel/perf_event_paranoid <= 2) and the CPU exposes the counter
+// (it's often not the case under virtualization). available() reports whether
+// the counter could be opened.
+//
+// The counter is inherited by threads created after the counter, but the instructions
+// executed by a thread are only added to the count when the thread exits.
+
+namespace boost {
+namespace mysql {
+namespace bench {
+
+class instruction_counter
+{
+#ifdef __linux__
+    int fd_{-1};
+#endif
+
+public:
+    instruction_counter() noexcept
+    {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    instruction_counter(const instruction_counter&) = delete;
+    instruction_counter& operator=(const instruction_counter&) = delete;
+
+    ~instruction_counter()
+    {
+#ifdef __linux__
+        if (fd_ != -1)
+            ::close(fd_);
+#endif
+    }
+
+    bool available() const noexcept
+    {
+#ifdef __linux__
+        return fd_ != -1;
+#else
+        return false;
+#endif
+    }
+
+    // Instructions retired since the counter was created. Zero if the counter is not available
+    std::uint64_t read() const noexcept
+    {
+        std::uint64_t res = 0;
+#ifdef __linux__
+        if (fd_ == -1 || ::read(fd_, &res, sizeof(res)) != static_cast<ssize_t>(sizeof(res)))
+            res = 0;
+#endif
+        return res;
+    }
+};
+
+}  // namespace bench
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -0,0 +1,227 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_BENCH_INCLUDE_BENCH_SCRIPTED_SERVER_HPP
+#define BOOST_MYSQL_BENCH_INCLUDE_BENCH_SCRIPTED_SERVER_HPP
+
+#include <boost/mysql/error_code.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench/server_responses.hpp"
+
+// An in-process stand-in for a MySQL server, listening on loopback TCP and a UNIX socket.
+// It answers the handshake, COM_QUERY, COM_STMT_PREPARE, COM_STMT_EXECUTE, COM_STMT_CLOSE,
+// COM_PING, COM_RESET_CONNECTION and COM_QUIT with pre-generated responses,
+// ignoring the contents of the requests.
+//
+// Each accepted connection is served by a thread using blocking I/O, so the server's cost per
+// request is a read and a write syscall. Clients must close their connections
+// before the server is destroyed.
+
+namespace boost {
+namespace mysql {
+namespace bench {
+
+class scripted_server
+{
+    template <class Protocol>
+    class listener
+    {
+        scripted_server& server_;
+        typename Protocol::acceptor acceptor_;
+        std::thread thread_;
+
+    public:
+        listener(scripted_server& server, const typename Protocol::endpoint& ep)
+            : server_(server), acceptor_(server.ctx_, ep)
+        {
+            acceptor_.listen();
+            thread_ = std::thread([this] {
+                while (true)
+                {
+                    typename Protocol::socket sock(server_.ctx_);
+                    error_code ec;
+                    acceptor_.accept(sock, ec);
+                    if (server_.stopped_ || ec)
+                        return;
+                    server_.start_session(std::move(sock));
+                }
+            });
+        }
+
+        typename Protocol::endpoint local_endpoint() const { return acceptor_.local_endpoint(); }
+
+        // Must be called after setting stopped_. Wakes the acceptor by connecting to it
+        void stop()
+        {
+            {
+                typename Protocol::socket sock(server_.ctx_);
+                error_code ec;
+                sock.connect(local_endpoint(), ec);
+            }
+            thread_.join();
+        }
+    };
+
+    enum class command : std::uint8_t
+    {
+        quit = 0x01,
+        query = 0x03,
+        ping = 0x0e,
+        stmt_prepare = 0x16,
+        stmt_execute = 0x17,
+        stmt_close = 0x19,
+        reset_connection = 0x1f,
+    };
+
+    server_responses responses_;
+    asio::io_context ctx_;  // never run, we only use blocking operations
+    std::atomic<bool> stopped_{false};
+    std::atomic<std::uint64_t> num_requests_{0};
+    std::mutex sessions_mtx_;
+    std::vector<std::thread> sessions_;
+    std::unique_ptr<listener<asio::ip::tcp>> tcp_;
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+    std::string unix_path_;
+    std::unique_ptr<listener<asio::local::stream_protocol>> unix_;
+#endif
+
+    // Reads a message. Requests are small, so they always fit in a single frame
+    template <class Socket>
+    static bool read_message(Socket& sock, std::vector<std::uint8_t>& buff)
+    {
+        std::uint8_t header[4];
+        error_code ec;
+        asio::read(sock, asio::buffer(header), ec);
+        if (ec)
+            return false;
+        std::size_t size = header[0] | (header[1] << 8) | (header[2] << 16);
+        buff.resize(size);
+        asio::read(sock, asio::buffer(buff), ec);
+        return !ec && size > 0;
+    }
+
+    template <class Socket>
+    static bool write_message(Socket& sock, const std::vector<std::uint8_t>& msg)
+    {
+        error_code ec;
+        asio::write(sock, asio::buffer(msg), ec);
+        return !ec;
+    }
+
+    template <class Socket>
+    void run_session(Socket& sock)
+    {
+        std::vector<std::uint8_t> msg;
+
+        // Handshake. The login request is not checked
+        if (!write_message(sock, responses_.server_hello()) || !read_message(sock, msg) ||
+            !write_message(sock, responses_.login_ok()))
+            return;
+
+        // Commands
+        while (read_message(sock, msg))
+        {
+            ++num_requests_;
+            const std::vector<std::uint8_t>* response = nullptr;
+            switch (static_cast<command>(msg[0]))
+            {
+            case command::query: response = &responses_.query(); break;
+            case command::stmt_prepare: response = &responses_.prepare(); break;
+            case command::stmt_execute: response = &responses_.execute(); break;
+            case command::ping:
+            case command::reset_connection: response = &responses_.ok(); break;
+            case command::stmt_close: break;  // no response
+            case command::quit: return;
+            default: std::fprintf(stderr, "scripted_server: unsupported command %d\n", msg[0]); return;
+            }
+            if (response && !write_message(sock, *response))
+                return;
+        }
+    }
+
+    static void set_nodelay(asio::ip::tcp::socket& sock) { sock.set_option(asio::ip::tcp::no_delay(true)); }
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+    static void set_nodelay(asio::local::stream_protocol::socket&) noexcept {}
+#endif
+
+    template <class Socket>
+    void start_session(Socket sock)
+    {
+        auto session_sock = std::make_shared<Socket>(std::move(sock));
+        set_nodelay(*session_sock);
+        std::lock_guard<std::mutex> lock(sessions_mtx_);
+        sessions_.emplace_back([this, session_sock] { run_session(*session_sock); });
+    }
+
+public:
+    // Creates the server and starts listening on an ephemeral loopback port and,
+    // if supported, on a UNIX socket in the current directory
+    explicit scripted_server(const response_shape& shape) : responses_(shape)
+    {
+        tcp_.reset(new listener<asio::ip::tcp>(
+            *this,
+            asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0)
+        ));
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+        unix_path_ = "boost_mysql_bench_" + std::to_string(tcp_->local_endpoint().port()) + ".sock";
+        std::remove(unix_path_.c_str());
+        unix_.reset(new listener<asio::local::stream_protocol>(
+            *this,
+            asio::local::stream_protocol::endpoint(unix_path_)
+        ));
+#endif
+    }
+
+    scripted_server(const scripted_server&) = delete;
+    scripted_server& operator=(const scripted_server&) = delete;
+
+    ~scripted_server()
+    {
+        stopped_ = true;
+        tcp_->stop();
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+        unix_->stop();
+        std::remove(unix_path_.c_str());
+#endif
+        std::lock_guard<std::mutex> lock(sessions_mtx_);
+        for (auto& t : sessions_)
+            t.join();
+    }
+
+    asio::ip::tcp::endpoint tcp_endpoint() const { return tcp_->local_endpoint(); }
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+    asio::local::stream_protocol::endpoint unix_endpoint() const { return unix_->local_endpoint(); }
+#endif
+
+    // Number of commands received since construction, excluding handshakes
+    std::uint64_t num_requests() const noexcept { return num_requests_; }
+};
+
+}  // namespace bench
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -0,0 +1,234 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_BENCH_INCLUDE_BENCH_SERVER_RESPONSES_HPP
+#define BOOST_MYSQL_BENCH_INCLUDE_BENCH_SERVER_RESPONSES_HPP
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/coldef_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bench/synthetic_rows.hpp"
+
+// Pre-generated server responses, as complete byte sequences with frame headers.
+// Every command restarts sequence numbers, so responses to a given command
+// are always the same bytes and can be written with a single call.
+
+namespace boost {
+namespace mysql {
+namespace bench {
+
+// The shape of the resultsets returned by the server
+struct response_shape
+{
+    column_mix mix;
+    std::size_t num_rows;
+};
+
+namespace detail_bench {
+
+// Capability flags
+constexpr std::uint32_t server_capabilities = 0x00000200 |  // CLIENT_PROTOCOL_41
+                                              0x00008000 |  // CLIENT_SECURE_CONNECTION
+                                              0x00020000 |  // CLIENT_MULTI_RESULTS
+                                              0x00040000 |  // CLIENT_PS_MULTI_RESULTS
+                                              0x00080000 |  // CLIENT_PLUGIN_AUTH
+                                              0x00200000 |  // CLIENT_PLUGIN_AUTH_LENENC_CLIENT_DATA
+                                              0x01000000;   // CLIENT_DEPRECATE_EOF
+
+constexpr std::uint16_t server_status_autocommit = 0x0002;
+
+inline std::uint8_t to_protocol_type(column_type t)
+{
+    switch (t)
+    {
+    case column_type::int_: return 0x03;
+    case column_type::double_: return 0x05;
+    case column_type::bigint: return 0x08;
+    case column_type::datetime: return 0x0c;
+    case column_type::decimal: return 0xf6;
+    case column_type::text: return 0xfc;
+    default: return 0xfd;  // VARCHAR
+    }
+}
+
+inline std::vector<std::uint8_t> serialize_coldef(const detail::coldef_view& coldef, string_view name)
+{
+    std::vector<std::uint8_t> res;
+    put_lenenc_string(res, "def");    // catalog
+    put_lenenc_string(res, "bench");  // schema
+    put_lenenc_string(res, "t");      // table
+    put_lenenc_string(res, "t");      // org_table
+    put_lenenc_string(res, name);
+    put_lenenc_string(res, name);  // org_name
+    res.push_back(0x0c);           // length of the fixed fields
+    put_int<std::uint16_t>(res, coldef.collation_id);
+    put_int<std::uint32_t>(res, coldef.column_length);
+    res.push_back(to_protocol_type(coldef.type));
+    put_int<std::uint16_t>(res, coldef.flags);
+    res.push_back(coldef.decimals);
+    put_int<std::uint16_t>(res, 0);  // filler
+    return res;
+}
+
+// An OK packet. With CLIENT_DEPRECATE_EOF, resultsets end with an OK packet with a 0xfe header
+inline std::vector<std::uint8_t> serialize_ok(std::uint8_t header)
+{
+    std::vector<std::uint8_t> res{header};
+    put_lenenc_int(res, 0);  // affected rows
+    put_lenenc_int(res, 0);  // last insert ID
+    put_int<std::uint16_t>(res, server_status_autocommit);
+    put_int<std::uint16_t>(res, 0);  // warnings
+    return res;
+}
+
+// Accumulates messages, assigning consecutive sequence numbers
+class response_builder
+{
+    std::vector<std::uint8_t> buff_;
+    std::uint8_t seqnum_;
+
+public:
+    explicit response_builder(std::uint8_t first_seqnum) noexcept : seqnum_(first_seqnum) {}
+
+    response_builder& add(const std::vector<std::uint8_t>& body)
+    {
+        auto size = static_cast<std::uint32_t>(body.size());
+        buff_.push_back(static_cast<std::uint8_t>(size));
+        buff_.push_back(static_cast<std::uint8_t>(size >> 8));
+        buff_.push_back(static_cast<std::uint8_t>(size >> 16));
+        buff_.push_back(seqnum_++);
+        buff_.insert(buff_.end(), body.begin(), body.end());
+        return *this;
+    }
+
+    response_builder& add_all(const std::vector<std::vector<std::uint8_t>>& bodies)
+    {
+        for (const auto& body : bodies)
+            add(body);
+        return *this;
+    }
+
+    std::vector<std::uint8_t> build() { return std::move(buff_); }
+};
+
+}  // namespace detail_bench
+
+class server_responses
+{
+    std::vector<std::uint8_t> server_hello_;
+    std::vector<std::uint8_t> login_ok_;
+    std::vector<std::uint8_t> ok_;
+    std::vector<std::uint8_t> query_;
+    std::vector<std::uint8_t> prepare_;
+    std::vector<std::uint8_t> execute_;
+
+    static std::vector<std::uint8_t> make_server_hello()
+    {
+        using namespace detail_bench;
+        const char scramble[] = "abcdefghijklmnopqrst";  // 20 bytes, plus the NULL terminator
+        string_view version = "8.0.33-bench";
+        string_view plugin = "mysql_native_password";
+
+        std::vector<std::uint8_t> res{10};  // protocol version
+        res.insert(res.end(), version.begin(), version.end());
+        res.push_back(0);
+        put_int<std::uint32_t>(res, 1);                 // connection ID
+        res.insert(res.end(), scramble, scramble + 8);  // auth plugin data, part 1
+        res.push_back(0);                               // filler
+        put_int<std::uint16_t>(res, static_cast<std::uint16_t>(server_capabilities));
+        res.push_back(45);  // utf8mb4_general_ci
+        put_int<std::uint16_t>(res, server_status_autocommit);
+        put_int<std::uint16_t>(res, static_cast<std::uint16_t>(server_capabilities >> 16));
+        res.push_back(21);                                   // auth plugin data length
+        res.insert(res.end(), 10, 0);                        // reserved
+        res.insert(res.end(), scramble + 8, scramble + 21);  // auth plugin data, part 2
+        res.insert(res.end(), plugin.begin(), plugin.end());
+        res.push_back(0);
+        return response_builder(0).add(res).build();
+    }
+
+public:
+    // Statements prepared against this server have this number of parameters
+    static constexpr std::size_t num_params = 1;
+
+    explicit server_responses(const response_shape& shape)
+    {
+        using namespace detail_bench;
+        synthetic_rows rows(shape.mix, shape.num_rows);
+
+        std::vector<std::vector<std::uint8_t>> coldefs;
+        for (std::size_t i = 0; i < rows.num_columns(); ++i)
+            coldefs.push_back(serialize_coldef(rows.coldefs()[i], "c" + std::to_string(i)));
+        std::vector<std::uint8_t> num_columns;
+        put_lenenc_int(num_columns, rows.num_columns());
+
+        server_hello_ = make_server_hello();
+        login_ok_ = response_builder(2).add(serialize_ok(0x00)).build();
+        ok_ = response_builder(1).add(serialize_ok(0x00)).build();
+
+        query_ = response_builder(1)
+                     .add(num_columns)
+                     .add_all(coldefs)
+                     .add_all(rows.text_bodies())
+                     .add(serialize_ok(0xfe))
+                     .build();
+
+        // Prepare OK: status, statement ID, number of columns and params, reserved, warnings
+        std::vector<std::uint8_t> prepare_ok{0x00};
+        put_int<std::uint32_t>(prepare_ok, 1);
+        put_int<std::uint16_t>(prepare_ok, static_cast<std::uint16_t>(rows.num_columns()));
+        put_int<std::uint16_t>(prepare_ok, static_cast<std::uint16_t>(num_params));
+        prepare_ok.push_back(0);
+        put_int<std::uint16_t>(prepare_ok, 0);
+        detail::coldef_view param_coldef{};
+        param_coldef.type = column_type::varchar;
+        param_coldef.collation_id = 63;
+        response_builder prepare_builder(1);
+        prepare_builder.add(prepare_ok);
+        for (std::size_t i = 0; i < num_params; ++i)
+            prepare_builder.add(serialize_coldef(param_coldef, "?"));
+        prepare_ = prepare_builder.add_all(coldefs).build();
+
+        execute_ = response_builder(1)
+                       .add(num_columns)
+                       .add_all(coldefs)
+                       .add_all(rows.binary_bodies())
+                       .add(serialize_ok(0xfe))
+                       .build();
+    }
+
+    // Sent as soon as a connection is accepted
+    const std::vector<std::uint8_t>& server_hello() const noexcept { return server_hello_; }
+
+    // Sent in response to the login request. mysql_native_password is used, and passwords aren't checked
+    const std::vector<std::uint8_t>& login_ok() const noexcept { return login_ok_; }
+
+    // Sent in response to COM_PING and COM_RESET_CONNECTION
+    const std::vector<std::uint8_t>& ok() const noexcept { return ok_; }
+
+    // Sent in response to COM_QUERY: a text resultset with the configured shape
+    const std::vector<std::uint8_t>& query() const noexcept { return query_; }
+
+    // Sent in response to COM_STMT_PREPARE
+    const std::vector<std::uint8_t>& prepare() const noexcept { return prepare_; }
+
+    // Sent in response to COM_STMT_EXECUTE: a binary resultset with the configured shape
+    const std::vector<std::uint8_t>& execute() const noexcept { return execute_; }
+};
+
+}  // namespace bench
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -0,0 +1,392 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_BENCH_INCLUDE_BENCH_SYNTHETIC_ROWS_HPP
+#define BOOST_MYSQL_BENCH_INCLUDE_BENCH_SYNTHETIC_ROWS_HPP
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/datetime.hpp>
+#include <boost/mysql/field.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/metadata.hpp>
+#include <boost/mysql/metadata_collection_view.hpp>
+
+#include <boost/mysql/detail/access.hpp>
+#include <boost/mysql/detail/coldef_view.hpp>
+#include <boost/mysql/detail/flags.hpp>
+
+#include <boost/core/span.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Generates rows with a fixed column mix, together with their wire representations,
+// without a server. Values come from std::minstd_rand with a fixed seed. Its output
+// (unlike the standard distributions') is fully specified, so inputs are identical
+// across platforms and runs.
+
+namespace boost {
+namespace mysql {
+namespace bench {
+
+// A column in a mix
+struct column_spec
+{
+    column_type type;
+    bool nullable;  // if true, the column is NULL for every other row
+};
+
+// The column mixes used by benchmarks
+struct column_mix
+{
+    const char* name;
+    std::vector<column_spec> columns;
+};
+
+inline std::vector<column_mix> all_column_mixes()
+{
+    // Numeric keys and counters
+    column_mix ints{
+        "ints",
+        {
+            {column_type::bigint, false},
+            {column_type::bigint, false},
+            {column_type::bigint, false},
+            {column_type::int_, false},
+            {column_type::int_, false},
+            {column_type::int_, false},
+        }
+    };
+
+    // A typical entity table
+    column_mix mixed{
+        "mixed",
+        {
+            {column_type::bigint, false},
+            {column_type::int_, false},
+            {column_type::varchar, false},
+            {column_type::varchar, false},
+            {column_type::double_, false},
+            {column_type::datetime, false},
+            {column_type::decimal, false},
+            {column_type::int_, true},
+        }
+    };
+
+    // Text-heavy rows
+    column_mix strings{
+        "strings",
+        {
+            {column_type::varchar, false},
+            {column_type::varchar, false},
+            {column_type::varchar, false},
+            {column_type::text, false},
+        }
+    };
+
+    return {ints, mixed, strings};
+}
+
+class row_generator
+{
+    std::minstd_rand gen_{42};
+
+    std::uint32_t next(std::uint32_t upper) { return static_cast<std::uint32_t>(gen_() % upper); }
+
+    std::string next_string(std::size_t min_size, std::size_t max_size)
+    {
+        std::string res(min_size + next(static_cast<std::uint32_t>(max_size - min_size)), 'a');
+        for (char& c : res)
+            c = static_cast<char>('a' + next(26));
+        return res;
+    }
+
+public:
+    field next_value(column_type type)
+    {
+        switch (type)
+        {
+        case column_type::bigint: return field(static_cast<std::int64_t>(gen_()) * 1000 + next(1000));
+        case column_type::int_: return field(static_cast<std::int64_t>(next(1000000)));
+        case column_type::double_: return field(static_cast<double>(next(10000000)) / 100.0);
+        case column_type::datetime:
+            return field(datetime(
+                static_cast<std::uint16_t>(2000 + next(30)),
+                static_cast<std::uint8_t>(1 + next(12)),
+                static_cast<std::uint8_t>(1 + next(28)),
+                static_cast<std::uint8_t>(next(24)),
+                static_cast<std::uint8_t>(next(60)),
+                static_cast<std::uint8_t>(next(60))
+            ));
+        case column_type::decimal:
+            return field(std::to_string(next(100000)) + '.' + std::to_string(10 + next(90)));
+        case column_type::text: return field(next_string(64, 256));
+        default: return field(next_string(8, 48));
+        }
+    }
+};
+
+namespace detail_bench {
+
+inline void put_lenenc_int(std::vector<std::uint8_t>& to, std::uint64_t value)
+{
+    std::size_t num_bytes = 0;
+    if (value < 251)
+    {
+        to.push_back(static_cast<std::uint8_t>(value));
+        return;
+    }
+    else if (value < 0x10000)
+    {
+        to.push_back(0xfc);
+        num_bytes = 2;
+    }
+    else if (value < 0x1000000)
+    {
+        to.push_back(0xfd);
+        num_bytes = 3;
+    }
+    else
+    {
+        to.push_back(0xfe);
+        num_bytes = 8;
+    }
+    for (std::size_t i = 0; i < num_bytes; ++i)
+        to.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+}
+
+inline void put_lenenc_string(std::vector<std::uint8_t>& to, string_view value)
+{
+    put_lenenc_int(to, value.size());
+    to.insert(to.end(), value.begin(), value.end());
+}
+
+template <class T>
+void put_int(std::vector<std::uint8_t>& to, T value)
+{
+    std::uint8_t buff[sizeof(T)];
+    boost::endian::endian_store<T, sizeof(T), boost::endian::order::little>(buff, value);
+    to.insert(to.end(), buff, buff + sizeof(T));
+}
+
+inline std::string to_text(field_view f)
+{
+    char buff[64]{};
+    switch (f.kind())
+    {
+    case field_kind::int64: return std::to_string(f.get_int64());
+    case field_kind::double_: std::snprintf(buff, sizeof(buff), "%.2f", f.get_double()); return buff;
+    case field_kind::datetime:
+    {
+        auto dt = f.get_datetime();
+        std::snprintf(
+            buff,
+            sizeof(buff),
+            "%04d-%02d-%02d %02d:%02d:%02d",
+            dt.year(),
+            dt.month(),
+            dt.day(),
+            dt.hour(),
+            dt.minute(),
+            dt.second()
+        );
+        return buff;
+    }
+    default: return std::string(f.get_string());
+    }
+}
+
+inline void put_binary(std::vector<std::uint8_t>& to, field_view f, column_type type)
+{
+    switch (type)
+    {
+    case column_type::bigint: put_int<std::int64_t>(to, f.get_int64()); break;
+    case column_type::int_: put_int<std::int32_t>(to, static_cast<std::int32_t>(f.get_int64())); break;
+    case column_type::double_:
+    {
+        double value = f.get_double();
+        std::uint64_t repr{};
+        std::memcpy(&repr, &value, sizeof(repr));
+        put_int<std::uint64_t>(to, repr);
+        break;
+    }
+    case column_type::datetime:
+    {
+        auto dt = f.get_datetime();
+        to.push_back(7);
+        put_int<std::uint16_t>(to, dt.year());
+        to.push_back(dt.month());
+        to.push_back(dt.day());
+        to.push_back(dt.hour());
+        to.push_back(dt.minute());
+        to.push_back(dt.second());
+        break;
+    }
+    default: put_lenenc_string(to, f.get_string()); break;
+    }
+}
+
+}  // namespace detail_bench
+
+// A set of rows with a given column mix, in all the representations used by the benchmarks
+class synthetic_rows
+{
+    std::size_t num_columns_;
+    std::vector<detail::coldef_view> coldefs_;
+    std::vector<metadata> meta_;
+    std::vector<field> values_;
+    std::vector<field_view> views_;
+    std::vector<std::vector<std::uint8_t>> text_bodies_;
+    std::vector<std::vector<std::uint8_t>> binary_bodies_;
+
+    static detail::coldef_view make_coldef(const column_spec& col)
+    {
+        namespace flags = detail::column_flags;
+        detail::coldef_view res{};
+        res.type = col.type;
+        res.flags = col.nullable ? 0 : flags::not_null;
+        switch (col.type)
+        {
+        case column_type::varchar:
+        case column_type::text:
+            res.collation_id = 45;  // utf8mb4_general_ci
+            res.decimals = 0;
+            break;
+        case column_type::double_:
+            res.collation_id = 63;  // binary
+            res.decimals = 31;
+            break;
+        case column_type::decimal:
+            res.collation_id = 63;
+            res.decimals = 2;
+            break;
+        default:
+            res.collation_id = 63;
+            res.decimals = 0;
+            break;
+        }
+        return res;
+    }
+
+    static std::vector<std::uint8_t> serialize_text_row(span<const field_view> fields)
+    {
+        std::vector<std::uint8_t> res;
+        for (auto f : fields)
+        {
+            if (f.is_null())
+                res.push_back(0xfb);
+            else
+                detail_bench::put_lenenc_string(res, detail_bench::to_text(f));
+        }
+        return res;
+    }
+
+    std::vector<std::uint8_t> serialize_binary_row(span<const field_view> fields) const
+    {
+        // Header, then the null bitmap, which has an offset of 2 bits
+        std::vector<std::uint8_t> res{0x00};
+        std::size_t bitmap_first = res.size();
+        res.resize(res.size() + (num_columns_ + 7 + 2) / 8, 0);
+        for (std::size_t i = 0; i < num_columns_; ++i)
+        {
+            if (fields[i].is_null())
+            {
+                std::size_t bit = i + 2;
+                res[bitmap_first + bit / 8] |= static_cast<std::uint8_t>(1 << (bit % 8));
+            }
+            else
+            {
+                detail_bench::put_binary(res, fields[i], coldefs_[i].type);
+            }
+        }
+        return res;
+    }
+
+public:
+    synthetic_rows(const column_mix& mix, std::size_t num_rows) : num_columns_(mix.columns.size())
+    {
+        for (const auto& col : mix.columns)
+        {
+            coldefs_.push_back(make_coldef(col));
+            meta_.push_back(detail::access::construct<metadata>(coldefs_.back(), false));
+        }
+
+        // Values. Views are created once all values are in place, so strings don't move
+        row_generator gen;
+        values_.reserve(num_rows * num_columns_);
+        for (std::size_t row = 0; row < num_rows; ++row)
+        {
+            for (const auto& col : mix.columns)
+            {
+                if (col.nullable && row % 2 == 0)
+                    values_.emplace_back();
+                else
+                    values_.push_back(gen.next_value(col.type));
+            }
+        }
+        views_.assign(values_.begin(), values_.end());
+
+        for (std::size_t row = 0; row < num_rows; ++row)
+        {
+            text_bodies_.push_back(serialize_text_row(this->row(row)));
+            binary_bodies_.push_back(serialize_binary_row(this->row(row)));
+        }
+    }
+
+    std::size_t num_rows() const noexcept { return text_bodies_.size(); }
+    std::size_t num_columns() const noexcept { return num_columns_; }
+
+    const std::vector<detail::coldef_view>& coldefs() const noexcept { return coldefs_; }
+    metadata_collection_view meta() const noexcept { return meta_; }
+
+    span<const field_view> row(std::size_t i) const noexcept
+    {
+        return {views_.data() + i * num_columns_, num_columns_};
+    }
+
+    // Row messages, as sent by the server, excluding frame headers
+    const std::vector<std::vector<std::uint8_t>>& text_bodies() const noexcept { return text_bodies_; }
+    const std::vector<std::vector<std::uint8_t>>& binary_bodies() const noexcept { return binary_bodies_; }
+
+    // Total size of the row messages, excluding frame headers
+    static std::size_t total_size(const std::vector<std::vector<std::uint8_t>>& bodies) noexcept
+    {
+        std::size_t res = 0;
+        for (const auto& b : bodies)
+            res += b.size();
+        return res;
+    }
+
+    // The given messages, with frame headers, as they would appear in the network stream
+    static std::vector<std::uint8_t> frame(const std::vector<std::vector<std::uint8_t>>& bodies)
+    {
+        std::vector<std::uint8_t> res;
+        std::uint8_t seqnum = 0;
+        for (const auto& body : bodies)
+        {
+            auto size = static_cast<std::uint32_t>(body.size());
+            res.push_back(static_cast<std::uint8_t>(size));
+            res.push_back(static_cast<std::uint8_t>(size >> 8));
+            res.push_back(static_cast<std::uint8_t>(size >> 16));
+            res.push_back(seqnum++);
+            res.insert(res.end(), body.begin(), body.end());
+        }
+        return res;
+    }
+};
+
+}  // namespace bench
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -0,0 +1,804 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Sysbench-style load generator, to be run against a real server. Drives a workload
+// with a configurable number of threads and coroutines per thread, and reports
+// throughput, latency percentiles, network bytes and client CPU usage.
+//
+// Usage: boost_mysql_loadgen prepare|run|cleanup [--option=value]...
+//   --host=HOST                                  (default: localhost)
+//   --port=PORT                                  (default: 3306)
+//   --user=USER                                  (default: root)
+//   --password=PASSWORD                          (default: empty)
+//   --database=DB                                (default: boost_mysql_loadgen)
+//   --ssl=disable|enable|require                 (default: disable)
+//   --table-size=N                               (default: 10000)
+//   --workload=point_select|range_scan|insert|oltp (default: oltp)
+//   --protocol=text|prepared                     (default: prepared)
+//   --threads=N                                  (default: 1)
+//   --coroutines=N                               (default: 8, per thread)
+//   --connections=N                              (default: threads * coroutines)
+//   --range-size=N                               (default: 100)
+//   --duration=SECONDS                           (default: 10)
+//   --warmup=SECONDS                             (default: 2)
+//
+// prepare creates the database and a table with table-size rows, cleanup drops the table,
+// and run executes the workload against it. Workloads:
+//   point_select: SELECT by primary key
+//   range_scan:   SELECT range-size consecutive rows by primary key
+//   insert:       INSERT a row with random contents
+//   oltp:         a read-write transaction with 10 point selects, a range scan and an UPDATE
+//
+// The structure follows the recommended way of getting high throughput with this library:
+// each thread runs its own io_context and owns a share of the connections, which are
+// only used by that thread's coroutines. Connections don't share any state across threads and
+// no locking is required. By default, each coroutine gets its own connection. If there are
+// fewer connections than coroutines, coroutines wait for a free connection in their thread
+// before running each event, which models a connection pool under pressure. Each connection
+// reuses a results object, so steady state operation doesn't allocate.
+//
+// Latencies are measured per event: a query for all workloads except oltp, where
+// an event is a full transaction. They include the time spent waiting for a connection.
+// Connections are established during the warmup, and events completing before it ends
+// are not measured. Client CPU is process CPU time,
+// as reported by std::clock (wall time on Windows). Requires C++20 coroutines.
+
+#include <boost/mysql/connection_stats.hpp>
+#include <boost/mysql/error_with_diagnostics.hpp>
+#include <boost/mysql/handshake_params.hpp>
+#include <boost/mysql/histogram.hpp>
+#include <boost/mysql/results.hpp>
+#include <boost/mysql/ssl_mode.hpp>
+#include <boost/mysql/statement.hpp>
+#include <boost/mysql/string_view.hpp>
+#include <boost/mysql/tcp_ssl.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#endif
+
+using namespace boost::mysql;
+namespace asio = boost::asio;
+using clock_type = std::chrono::steady_clock;
+
+namespace {
+
+enum class command_kind
+{
+    prepare,
+    run,
+    cleanup,
+};
+
+enum class workload_kind
+{
+    point_select,
+    range_scan,
+    insert,
+    oltp,
+};
+
+struct config
+{
+    command_kind command{command_kind::run};
+    std::string host{"localhost"};
+    std::string port{"3306"};
+    std::string user{"root"};
+    std::string password;
+    std::string database{"boost_mysql_loadgen"};
+    ssl_mode ssl{ssl_mode::disable};
+    std::size_t table_size{10000};
+    workload_kind workload{workload_kind::oltp};
+    bool prepared{true};
+    std::size_t num_threads{1};
+    std::size_t num_coroutines{8};
+    std::size_t num_connections{0};  // 0 means one per coroutine
+    std::size_t range_size{100};
+    double duration_s{10.0};
+    double warmup_s{2.0};
+
+    handshake_params params(bool use_database = true) const
+    {
+        return handshake_params(
+            user,
+            password,
+            use_database ? string_view(database) : string_view(),
+            handshake_params::default_collation,
+            ssl
+        );
+    }
+};
+
+// Number of point selects in an oltp transaction
+constexpr std::size_t oltp_point_selects = 10;
+
+// Size of the c and pad columns
+constexpr std::size_t c_size = 120;
+constexpr std::size_t pad_size = 60;
+
+// Rows inserted per INSERT statement by prepare
+constexpr std::size_t prepare_batch_size = 1000;
+
+// Generates random row contents. Strings only contain [a-z0-9-],
+// so they can be safely embedded in text queries
+class row_generator
+{
+    std::minstd_rand gen_;
+
+public:
+    explicit row_generator(std::uint32_t seed) : gen_(seed) {}
+
+    std::int64_t id(std::size_t table_size)
+    {
+        return 1 + static_cast<std::int64_t>(gen_() % table_size);
+    }
+
+    std::int64_t k(std::size_t table_size) { return id(table_size); }
+
+    std::string str(std::size_t size)
+    {
+        static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789-";
+        std::string res(size, 'a');
+        for (char& c : res)
+            c = alphabet[gen_() % (sizeof(alphabet) - 1)];
+        return res;
+    }
+};
+
+//
+// prepare and cleanup. These don't need to be fast, so they use sync functions
+//
+void prepare(const config& cfg, asio::io_context& ctx, asio::ssl::context& ssl_ctx)
+{
+    asio::ip::tcp::resolver resolver(ctx);
+    auto endpoints = resolver.resolve(cfg.host, cfg.port);
+    tcp_ssl_connection conn(ctx, ssl_ctx);
+    results result;
+
+    conn.connect(*endpoints.begin(), cfg.params(false));
+    conn.execute("CREATE DATABASE IF NOT EXISTS " + cfg.database, result);
+    conn.execute("USE " + cfg.database, result);
+    conn.execute("DROP TABLE IF EXISTS sbtest", result);
+    conn.execute(
+        "CREATE TABLE sbtest("
+        "id INT NOT NULL AUTO_INCREMENT PRIMARY KEY,"
+        "k INT NOT NULL DEFAULT 0,"
+        "c CHAR(120) NOT NULL DEFAULT '',"
+        "pad CHAR(60) NOT NULL DEFAULT '',"
+        "KEY k_idx(k)"
+        ")",
+        result
+    );
+
+    row_generator gen(42);
+    for (std::size_t first = 0; first < cfg.table_size; first += prepare_batch_size)
+    {
+        std::string query = "INSERT INTO sbtest (k, c, pad) VALUES ";
+        std::size_t last = (std::min)(first + prepare_batch_size, cfg.table_size);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            if (i != first)
+                query += ',';
+            query += '(' + std::to_string(gen.k(cfg.table_size)) + ",'" + gen.str(c_size) + "','" +
+                     gen.str(pad_size) + "')";
+        }
+        conn.execute(query, result);
+    }
+
+    conn.close();
+    std::printf("Created table %s.sbtest with %zu rows\n", cfg.database.c_str(), cfg.table_size);
+}
+
+void cleanup(const config& cfg, asio::io_context& ctx, asio::ssl::context& ssl_ctx)
+{
+    asio::ip::tcp::resolver resolver(ctx);
+    auto endpoints = resolver.resolve(cfg.host, cfg.port);
+    tcp_ssl_connection conn(ctx, ssl_ctx);
+    results result;
+
+    conn.connect(*endpoints.begin(), cfg.params());
+    conn.execute("DROP TABLE IF EXISTS sbtest", result);
+    conn.close();
+    std::printf("Dropped table %s.sbtest\n", cfg.database.c_str());
+}
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+
+//
+// run
+//
+
+const char* to_string(workload_kind v)
+{
+    switch (v)
+    {
+    case workload_kind::point_select: return "point_select";
+    case workload_kind::range_scan: return "range_scan";
+    case workload_kind::insert: return "insert";
+    case workload_kind::oltp: return "oltp";
+    default: return "<unknown>";
+    }
+}
+
+// The time window where events are measured
+struct run_window
+{
+    clock_type::time_point measure_start;
+    clock_type::time_point deadline;
+
+    explicit run_window(const config& cfg)
+    {
+        auto now = clock_type::now();
+        measure_start = now + std::chrono::duration_cast<clock_type::duration>(
+                                  std::chrono::duration<double>(cfg.warmup_s)
+                              );
+        deadline = measure_start + std::chrono::duration_cast<clock_type::duration>(
+                                       std::chrono::duration<double>(cfg.duration_s)
+                                   );
+    }
+};
+
+// Measurements for the coroutines in a thread. Only accessed from that thread
+// until the run finishes, so no synchronization is required
+struct thread_stats
+{
+    histogram latencies_ns;
+    std::uint64_t events{};
+    std::uint64_t queries{};
+    std::uint64_t bytes_read{};
+    std::uint64_t bytes_written{};
+    std::uint64_t rows_read{};
+    std::exception_ptr error;
+
+    void record_error(std::exception_ptr err)
+    {
+        if (err && !error)
+            error = err;
+    }
+};
+
+// A connection, together with the statements and results object that events use with it
+class session
+{
+    const config& cfg_;
+    bool measuring_{false};
+    connection_stats initial_stats_;
+
+public:
+    tcp_ssl_connection conn;
+    results result;
+    statement point_select_stmt;
+    statement range_scan_stmt;
+    statement insert_stmt;
+    statement update_stmt;
+    bool connected{false};
+
+    session(const config& cfg, asio::io_context& ctx, asio::ssl::context& ssl_ctx)
+        : cfg_(cfg), conn(ctx, ssl_ctx)
+    {
+    }
+
+    asio::awaitable<void> setup()
+    {
+        auto ex = co_await asio::this_coro::executor;
+        asio::ip::tcp::resolver resolver(ex);
+        auto endpoints = co_await resolver.async_resolve(cfg_.host, cfg_.port, asio::use_awaitable);
+        co_await conn.async_connect(*endpoints.begin(), cfg_.params(), asio::use_awaitable);
+        connected = true;
+        if (cfg_.prepared)
+        {
+            point_select_stmt = co_await conn.async_prepare_statement(
+                "SELECT c FROM sbtest WHERE id = ?",
+                asio::use_awaitable
+            );
+            range_scan_stmt = co_await conn.async_prepare_statement(
+                "SELECT c FROM sbtest WHERE id BETWEEN ? AND ?",
+                asio::use_awaitable
+            );
+            insert_stmt = co_await conn.async_prepare_statement(
+                "INSERT INTO sbtest (k, c, pad) VALUES (?, ?, ?)",
+                asio::use_awaitable
+            );
+            update_stmt = co_await conn.async_prepare_statement(
+                "UPDATE sbtest SET k = k + 1 WHERE id = ?",
+                asio::use_awaitable
+            );
+        }
+    }
+
+    // Called before running an event in the measured window
+    void start_measuring()
+    {
+        if (!measuring_)
+        {
+            measuring_ = true;
+            initial_stats_ = conn.stats();
+        }
+    }
+
+    void add_network_stats(thread_stats& stats) const
+    {
+        if (measuring_)
+        {
+            auto final_stats = conn.stats();
+            stats.bytes_read += final_stats.bytes_read - initial_stats_.bytes_read;
+            stats.bytes_written += final_stats.bytes_written - initial_stats_.bytes_written;
+            stats.rows_read += final_stats.rows_read - initial_stats_.rows_read;
+        }
+    }
+};
+
+// The sessions owned by a thread, shared by its coroutines. Sessions are
+// handed out once they've been set up, and an event keeps its session until it completes
+class session_pool
+{
+    std::vector<session*> idle_;
+
+    // Never reset, so waits complete when a session is released (cancel_one) or the window ends
+    asio::steady_timer signal_;
+
+public:
+    session_pool(asio::io_context& ctx, const run_window& window) : signal_(ctx, window.deadline) {}
+
+    // Returns nullptr if the window ended before a session was available
+    asio::awaitable<session*> acquire()
+    {
+        while (idle_.empty())
+        {
+            if (clock_type::now() >= signal_.expiry())
+                co_return nullptr;
+            boost::system::error_code ec;
+            co_await signal_.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        }
+        session* res = idle_.back();
+        idle_.pop_back();
+        co_return res;
+    }
+
+    void release(session* s)
+    {
+        idle_.push_back(s);
+        signal_.cancel_one();
+    }
+};
+
+// A coroutine running events, each one on a session taken from the thread's pool
+class worker
+{
+    const config& cfg_;
+    const run_window& window_;
+    thread_stats& stats_;
+    session_pool& pool_;
+    row_generator gen_;
+
+    asio::awaitable<void> execute(session& s, const std::string& query)
+    {
+        co_await s.conn.async_execute(query, s.result, asio::use_awaitable);
+    }
+
+    asio::awaitable<void> point_select(session& s)
+    {
+        auto id = gen_.id(cfg_.table_size);
+        if (cfg_.prepared)
+            co_await s.conn.async_execute(s.point_select_stmt.bind(id), s.result, asio::use_awaitable);
+        else
+            co_await execute(s, "SELECT c FROM sbtest WHERE id = " + std::to_string(id));
+    }
+
+    asio::awaitable<void> range_scan(session& s)
+    {
+        auto first = gen_.id(cfg_.table_size);
+        auto last = first + static_cast<std::int64_t>(cfg_.range_size) - 1;
+        if (cfg_.prepared)
+        {
+            co_await s.conn
+                .async_execute(s.range_scan_stmt.bind(first, last), s.result, asio::use_awaitable);
+        }
+        else
+        {
+            co_await execute(
+                s,
+                "SELECT c FROM sbtest WHERE id BETWEEN " + std::to_string(first) + " AND " +
+                    std::to_string(last)
+            );
+        }
+    }
+
+    asio::awaitable<void> insert(session& s)
+    {
+        auto k = gen_.k(cfg_.table_size);
+        auto c = gen_.str(c_size);
+        auto pad = gen_.str(pad_size);
+        if (cfg_.prepared)
+        {
+            co_await s.conn.async_execute(s.insert_stmt.bind(k, c, pad), s.result, asio::use_awaitable);
+        }
+        else
+        {
+            co_await execute(
+                s,
+                "INSERT INTO sbtest (k, c, pad) VALUES (" + std::to_string(k) + ",'" + c + "','" + pad + "')"
+            );
+        }
+    }
+
+    asio::awaitable<void> update(session& s)
+    {
+        auto id = gen_.id(cfg_.table_size);
+        if (cfg_.prepared)
+            co_await s.conn.async_execute(s.update_stmt.bind(id), s.result, asio::use_awaitable);
+        else
+            co_await execute(s, "UPDATE sbtest SET k = k + 1 WHERE id = " + std::to_string(id));
+    }
+
+    // Runs an event, returning the number of queries it issued
+    asio::awaitable<std::size_t> run_event(session& s)
+    {
+        switch (cfg_.workload)
+        {
+        case workload_kind::point_select: co_await point_select(s); co_return 1u;
+        case workload_kind::range_scan: co_await range_scan(s); co_return 1u;
+        case workload_kind::insert: co_await insert(s); co_return 1u;
+        case workload_kind::oltp:
+        default:
+            co_await execute(s, "START TRANSACTION");
+            for (std::size_t i = 0; i < oltp_point_selects; ++i)
+                co_await point_select(s);
+            co_await range_scan(s);
+            co_await update(s);
+            co_await execute(s, "COMMIT");
+            co_return oltp_point_selects + 4u;
+        }
+    }
+
+public:
+    worker(
+        const config& cfg,
+        const run_window& window,
+        thread_stats& stats,
+        session_pool& pool,
+        std::uint32_t seed
+    )
+        : cfg_(cfg), window_(window), stats_(stats), pool_(pool), gen_(seed)
+    {
+    }
+
+    asio::awaitable<void> run()
+    {
+        while (true)
+        {
+            // Latency includes the time spent waiting for a session
+            auto start = clock_type::now();
+            if (start >= window_.deadline)
+                break;
+            session* s = co_await pool_.acquire();
+            if (!s)
+                break;
+            bool measuring = start >= window_.measure_start;
+            if (measuring)
+                s->start_measuring();
+
+            // On error, the session is not returned to the pool
+            std::size_t num_queries = co_await run_event(*s);
+            pool_.release(s);
+
+            if (measuring)
+            {
+                auto elapsed = clock_type::now() - start;
+                stats_.latencies_ns.record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+                ));
+                ++stats_.events;
+                stats_.queries += num_queries;
+            }
+        }
+    }
+};
+
+// Number of connections owned by each thread. Connections are evenly distributed
+std::size_t thread_connections(const config& cfg, std::size_t thread_idx)
+{
+    std::size_t res = cfg.num_connections / cfg.num_threads;
+    if (thread_idx < cfg.num_connections % cfg.num_threads)
+        ++res;
+    return res;
+}
+
+// Runs the coroutines assigned to a thread until the window ends
+void run_thread(
+    const config& cfg,
+    const run_window& window,
+    thread_stats& stats,
+    asio::ssl::context& ssl_ctx,
+    std::size_t thread_idx
+)
+{
+    // Single-threaded contexts can skip internal locking
+    asio::io_context ctx(1);
+    auto on_error = [&stats](std::exception_ptr err) { stats.record_error(err); };
+
+    // Connections are established concurrently, and become available as soon as they're set up
+    session_pool pool(ctx, window);
+    std::vector<std::unique_ptr<session>> sessions;
+    for (std::size_t i = 0; i < thread_connections(cfg, thread_idx); ++i)
+    {
+        sessions.emplace_back(new session(cfg, ctx, ssl_ctx));
+        session* s = sessions.back().get();
+        asio::co_spawn(
+            ctx,
+            [s, &pool]() -> asio::awaitable<void> {
+                co_await s->setup();
+                pool.release(s);
+            },
+            on_error
+        );
+    }
+
+    std::vector<std::unique_ptr<worker>> workers;
+    for (std::size_t i = 0; i < cfg.num_coroutines; ++i)
+    {
+        auto seed = static_cast<std::uint32_t>(thread_idx * cfg.num_coroutines + i + 1);
+        workers.emplace_back(new worker(cfg, window, stats, pool, seed));
+        asio::co_spawn(ctx, workers.back()->run(), on_error);
+    }
+    ctx.run();
+
+    // Gather network stats and close connections
+    for (const auto& s : sessions)
+    {
+        s->add_network_stats(stats);
+        if (s->connected)
+            asio::co_spawn(ctx, s->conn.async_close(asio::use_awaitable), on_error);
+    }
+    ctx.restart();
+    ctx.run();
+}
+
+void print_latency(const char* name, const histogram_snapshot& snap, double q)
+{
+    std::printf("    %-6s %12.1f\n", name, static_cast<double>(snap.value_at_quantile(q)) / 1000.0);
+}
+
+void run(const config& cfg, asio::ssl::context& ssl_ctx)
+{
+    std::printf(
+        "workload=%s protocol=%s threads=%zu coroutines=%zu connections=%zu duration=%.1fs warmup=%.1fs\n",
+        to_string(cfg.workload),
+        cfg.prepared ? "prepared" : "text",
+        cfg.num_threads,
+        cfg.num_coroutines,
+        cfg.num_connections,
+        cfg.duration_s,
+        cfg.warmup_s
+    );
+
+    // Run
+    run_window window(cfg);
+    std::vector<std::unique_ptr<thread_stats>> stats;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < cfg.num_threads; ++i)
+    {
+        stats.emplace_back(new thread_stats);
+        thread_stats* s = stats.back().get();
+        threads.emplace_back([&cfg, &window, &ssl_ctx, s, i] { run_thread(cfg, window, *s, ssl_ctx, i); });
+    }
+
+    // Client CPU time, sampled at the boundaries of the measured window
+    std::this_thread::sleep_until(window.measure_start);
+    std::clock_t cpu_start = std::clock();
+    std::this_thread::sleep_until(window.deadline);
+    std::clock_t cpu_end = std::clock();
+
+    for (auto& t : threads)
+        t.join();
+
+    // Aggregate
+    histogram_snapshot latencies;
+    thread_stats total;
+    for (const auto& s : stats)
+    {
+        if (s->error)
+            std::rethrow_exception(s->error);
+        latencies.merge(s->latencies_ns.snapshot());
+        total.events += s->events;
+        total.queries += s->queries;
+        total.bytes_read += s->bytes_read;
+        total.bytes_written += s->bytes_written;
+        total.rows_read += s->rows_read;
+    }
+
+    // Report
+    double measured_s = std::chrono::duration<double>(window.deadline - window.measure_start).count();
+    double cpu_s = static_cast<double>(cpu_end - cpu_start) / CLOCKS_PER_SEC;
+    auto per_second = [measured_s](std::uint64_t v) { return static_cast<double>(v) / measured_s; };
+    std::printf(
+        "events:       %12llu (%.1f/s)\n",
+        static_cast<unsigned long long>(total.events),
+        per_second(total.events)
+    );
+    std::printf(
+        "queries:      %12llu (%.1f/s)\n",
+        static_cast<unsigned long long>(total.queries),
+        per_second(total.queries)
+    );
+    std::printf(
+        "rows read:    %12llu (%.1f/s)\n",
+        static_cast<unsigned long long>(total.rows_read),
+        per_second(total.rows_read)
+    );
+    std::printf(
+        "network:      %.2f MB/s read, %.2f MB/s written\n",
+        per_second(total.bytes_read) / 1e6,
+        per_second(total.bytes_written) / 1e6
+    );
+    std::printf(
+        "client CPU:   %.2fs (%.1f%% of a core), %.2f us/query\n",
+        cpu_s,
+        100.0 * cpu_s / measured_s,
+        total.queries ? cpu_s * 1e6 / static_cast<double>(total.queries) : 0.0
+    );
+    std::printf("event latency (us):\n");
+    print_latency("p50", latencies, 0.5);
+    print_latency("p90", latencies, 0.9);
+    print_latency("p99", latencies, 0.99);
+    print_latency("p99.9", latencies, 0.999);
+    print_latency("max", latencies, 1.0);
+}
+
+#else
+
+void run(const config&, asio::ssl::context&)
+{
+    std::cerr << "Sorry, run requires C++20 coroutines" << std::endl;
+    std::exit(EXIT_FAILURE);
+}
+
+#endif
+
+// Command line parsing
+[[noreturn]] void usage(const char* prog)
+{
+    std::cerr << "Usage: " << prog
+              << " prepare|run|cleanup [--host=HOST] [--port=PORT] [--user=USER] [--password=PASSWORD]"
+                 " [--database=DB] [--ssl=disable|enable|require] [--table-size=N]"
+                 " [--workload=point_select|range_scan|insert|oltp] [--protocol=text|prepared]"
+                 " [--threads=N] [--coroutines=N] [--connections=N] [--range-size=N] [--duration=SECONDS]"
+                 " [--warmup=SECONDS]\n";
+    std::exit(EXIT_FAILURE);
+}
+
+config parse_config(int argc, char** argv)
+{
+    config res;
+    if (argc < 2)
+        usage(argv[0]);
+    std::string command = argv[1];
+    if (command == "prepare")
+        res.command = command_kind::prepare;
+    else if (command == "run")
+        res.command = command_kind::run;
+    else if (command == "cleanup")
+        res.command = command_kind::cleanup;
+    else
+        usage(argv[0]);
+
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto eq = arg.find('=');
+        if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos)
+            usage(argv[0]);
+        std::string key = arg.substr(2, eq - 2), value = arg.substr(eq + 1);
+
+        if (key == "host")
+            res.host = value;
+        else if (key == "port")
+            res.port = value;
+        else if (key == "user")
+            res.user = value;
+        else if (key == "password")
+            res.password = value;
+        else if (key == "database")
+            res.database = value;
+        else if (key == "ssl" && value == "disable")
+            res.ssl = ssl_mode::disable;
+        else if (key == "ssl" && value == "enable")
+            res.ssl = ssl_mode::enable;
+        else if (key == "ssl" && value == "require")
+            res.ssl = ssl_mode::require;
+        else if (key == "table-size")
+            res.table_size = std::stoul(value);
+        else if (key == "workload" && value == "point_select")
+            res.workload = workload_kind::point_select;
+        else if (key == "workload" && value == "range_scan")
+            res.workload = workload_kind::range_scan;
+        else if (key == "workload" && value == "insert")
+            res.workload = workload_kind::insert;
+        else if (key == "workload" && value == "oltp")
+            res.workload = workload_kind::oltp;
+        else if (key == "protocol" && value == "text")
+            res.prepared = false;
+        else if (key == "protocol" && value == "prepared")
+            res.prepared = true;
+        else if (key == "threads")
+            res.num_threads = std::stoul(value);
+        else if (key == "coroutines")
+            res.num_coroutines = std::stoul(value);
+        else if (key == "connections")
+            res.num_connections = std::stoul(value);
+        else if (key == "range-size")
+            res.range_size = std::stoul(value);
+        else if (key == "duration")
+            res.duration_s = std::stod(value);
+        else if (key == "warmup")
+            res.warmup_s = std::stod(value);
+        else
+            usage(argv[0]);
+    }
+
+    if (res.table_size == 0 || res.num_threads == 0 || res.num_coroutines == 0 || res.range_size == 0)
+        usage(argv[0]);
+    if (res.num_connections == 0)
+        res.num_connections = res.num_threads * res.num_coroutines;
+    else if (res.num_connections < res.num_threads)
+        usage(argv[0]);
+    return res;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        auto cfg = parse_config(argc, argv);
+        asio::io_context ctx;
+        asio::ssl::context ssl_ctx(asio::ssl::context::tls_client);
+
+        switch (cfg.command)
+        {
+        case command_kind::prepare: prepare(cfg, ctx, ssl_ctx); break;
+        case command_kind::cleanup: cleanup(cfg, ctx, ssl_ctx); break;
+        case command_kind::run: run(cfg, ssl_ctx); break;
+        }
+    }
+    catch (const error_with_diagnostics& err)
+    {
+        std::cerr << "Error: " << err.what() << ", error code: " << err.code() << '\n'
+                  << "Server diagnostics: " << err.get_diagnostics().server_message() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << "Error: " << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,324 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Microbenchmarks for the protocol hot paths: framing, row deserialization, string copying,
+// row accumulation and statement parameter serialization. Inputs are synthetic rows
+// (see synthetic_rows.hpp), so no server is required.
+//
+// Usage: boost_mysql_bench_protocol [filter]
+// Only benchmarks whose name contains filter are run. Build in release mode
+// for meaningful results.
+
+#include <boost/mysql/diagnostics.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/metadata_mode.hpp>
+#include <boost/mysql/results.hpp>
+
+#include <boost/mysql/detail/access.hpp>
+#include <boost/mysql/detail/config.hpp>
+#include <boost/mysql/detail/execution_processor/execution_processor.hpp>
+#include <boost/mysql/detail/resultset_encoding.hpp>
+#include <boost/mysql/detail/row_impl.hpp>
+
+#include <boost/mysql/impl/internal/channel/message_parser.hpp>
+#include <boost/mysql/impl/internal/channel/read_buffer.hpp>
+#include <boost/mysql/impl/internal/protocol/db_flavor.hpp>
+#include <boost/mysql/impl/internal/protocol/protocol.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench/harness.hpp"
+#include "bench/synthetic_rows.hpp"
+
+#ifdef BOOST_MYSQL_CXX14
+#include <boost/mysql/datetime.hpp>
+#include <boost/mysql/static_results.hpp>
+
+#include <boost/optional/optional.hpp>
+
+#include <tuple>
+#endif
+
+using namespace boost::mysql;
+using namespace boost::mysql::bench;
+using boost::mysql::detail::resultset_encoding;
+
+namespace {
+
+// Number of distinct rows per input. Enough to not fit in L1, not enough to spill L2
+constexpr std::size_t num_rows = 256;
+
+// Benchmarks are set up to never fail. If they did, results would be meaningless
+void check(error_code ec)
+{
+    if (ec)
+    {
+        std::cerr << "Unexpected error: " << ec.message() << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+const std::vector<std::vector<std::uint8_t>>& bodies(const synthetic_rows& rows, resultset_encoding enc)
+{
+    return enc == resultset_encoding::text ? rows.text_bodies() : rows.binary_bodies();
+}
+
+const char* to_string(resultset_encoding enc)
+{
+    return enc == resultset_encoding::text ? "text" : "binary";
+}
+
+std::string bench_name(const char* op, const char* mix, const char* variant = nullptr)
+{
+    std::string res = op;
+    if (variant)
+    {
+        res += '/';
+        res += variant;
+    }
+    res += '/';
+    res += mix;
+    return res;
+}
+
+// Splits a network stream with all the rows in a batch into messages
+void bench_parse_message(runner& r, const column_mix& mix, const synthetic_rows& rows)
+{
+    auto stream = synthetic_rows::frame(rows.text_bodies());
+    detail::read_buffer buff(stream.size());
+    detail::message_parser parser;
+    detail::message_parser::result res;
+
+    r.run(bench_name("parse_message", mix.name), rows.num_rows(), stream.size(), [&] {
+        // Emulate a read that places the entire batch into the buffer.
+        // Messages are left in the reserved area as they're parsed
+        buff.remove_reserved();
+        std::memcpy(buff.free_first(), stream.data(), stream.size());
+        buff.move_to_pending(stream.size());
+        for (std::size_t i = 0; i < rows.num_rows(); ++i)
+        {
+            parser.parse_message(buff, res);
+            do_not_optimize(res.message);
+        }
+        parser.parse_message(buff, res);  // no more messages; resets the parser to reading a header
+    });
+}
+
+// Classifies a message as a row, OK packet or error
+void bench_deserialize_row_message(runner& r, const column_mix& mix, const synthetic_rows& rows)
+{
+    diagnostics diag;
+    const auto& msgs = rows.text_bodies();
+
+    r.run(
+        bench_name("deserialize_row_message", mix.name),
+        rows.num_rows(),
+        synthetic_rows::total_size(msgs),
+        [&] {
+            for (const auto& msg : msgs)
+            {
+                auto res = detail::deserialize_row_message(msg, detail::db_flavor::mysql, diag);
+                do_not_optimize(res);
+            }
+        }
+    );
+}
+
+// Parses a row message into fields
+void bench_deserialize_row(
+    runner& r,
+    const column_mix& mix,
+    const synthetic_rows& rows,
+    resultset_encoding enc
+)
+{
+    std::vector<field_view> fields(rows.num_columns());
+    const auto& msgs = bodies(rows, enc);
+
+    r.run(
+        bench_name("deserialize_row", mix.name, to_string(enc)),
+        rows.num_rows(),
+        synthetic_rows::total_size(msgs),
+        [&] {
+            for (const auto& msg : msgs)
+            {
+                check(detail::deserialize_row(enc, msg, rows.meta(), fields));
+                do_not_optimize(fields.data());
+            }
+        }
+    );
+}
+
+// Copies fields into an owning row, as done by row and rows
+void bench_copy_strings(runner& r, const column_mix& mix, const synthetic_rows& rows)
+{
+    detail::row_impl impl;
+    std::size_t num_bytes = rows.num_rows() * rows.num_columns() * sizeof(field_view);
+    for (std::size_t i = 0; i < rows.num_rows(); ++i)
+    {
+        for (auto f : rows.row(i))
+            num_bytes += f.is_string() ? f.get_string().size() : 0u;
+    }
+
+    r.run(bench_name("row_impl_copy_strings", mix.name), rows.num_rows(), num_bytes, [&] {
+        for (std::size_t i = 0; i < rows.num_rows(); ++i)
+        {
+            auto row = rows.row(i);
+            impl.assign(row.data(), row.size());
+            do_not_optimize(impl.fields().data());
+        }
+    });
+}
+
+// Feeds metadata and a batch of rows to an execution processor, as read_some_rows and execute do
+void run_batch(
+    detail::execution_processor& proc,
+    const synthetic_rows& rows,
+    resultset_encoding enc,
+    std::vector<field_view>& storage,
+    const detail::output_ref& ref = detail::output_ref()
+)
+{
+    diagnostics diag;
+    proc.reset(enc, metadata_mode::minimal);
+    proc.on_num_meta(rows.num_columns());
+    for (const auto& coldef : rows.coldefs())
+        check(proc.on_meta(coldef, diag));
+    proc.on_row_batch_start();
+    for (const auto& msg : bodies(rows, enc))
+        check(proc.on_row(msg, ref, storage));
+    proc.on_row_batch_finish();
+    check(proc.on_row_ok_packet(detail::ok_view{}));
+}
+
+void bench_results(runner& r, const column_mix& mix, const synthetic_rows& rows, resultset_encoding enc)
+{
+    results result;
+    std::vector<field_view> storage;
+    auto& proc = detail::access::get_impl(result).get_interface();
+
+    r.run(
+        bench_name("results_on_row", mix.name, to_string(enc)),
+        rows.num_rows(),
+        synthetic_rows::total_size(bodies(rows, enc)),
+        [&] {
+            run_batch(proc, rows, enc, storage);
+            do_not_optimize(result.rows().size());
+        }
+    );
+}
+
+// Serializes a COM_STMT_EXECUTE with every row as the statement parameters
+void bench_execute_stmt_serialization(runner& r, const column_mix& mix, const synthetic_rows& rows)
+{
+    std::vector<std::uint8_t> buff;
+    std::size_t num_bytes = 0;
+    for (std::size_t i = 0; i < rows.num_rows(); ++i)
+    {
+        std::size_t size = detail::execute_stmt_command{1, rows.row(i)}.get_size();
+        if (size > buff.size())
+            buff.resize(size);
+        num_bytes += size;
+    }
+
+    r.run(bench_name("execute_stmt_serialization", mix.name), rows.num_rows(), num_bytes, [&] {
+        for (std::size_t i = 0; i < rows.num_rows(); ++i)
+        {
+            detail::execute_stmt_command cmd{1, rows.row(i)};
+            std::size_t size = cmd.get_size();
+            cmd.serialize(boost::span<std::uint8_t>(buff.data(), size));
+            do_not_optimize(buff.data());
+        }
+    });
+}
+
+#ifdef BOOST_MYSQL_CXX14
+
+// The row types matching each column mix, for the static interface
+using ints_row = std::tuple<std::int64_t, std::int64_t, std::int64_t, std::int32_t, std::int32_t, std::int32_t>;
+using mixed_row = std::tuple<
+    std::int64_t,
+    std::int32_t,
+    std::string,
+    std::string,
+    double,
+    datetime,
+    std::string,
+    boost::optional<std::int32_t>>;
+using strings_row = std::tuple<std::string, std::string, std::string, std::string>;
+
+// Parses rows into user-defined types, using parse_functor
+template <class StaticRow>
+void bench_static_results(
+    runner& r,
+    const column_mix& mix,
+    const synthetic_rows& rows,
+    resultset_encoding enc
+)
+{
+    static_results<StaticRow> result;
+    std::vector<field_view> storage;
+    auto& proc = detail::access::get_impl(result).get_interface();
+
+    r.run(
+        bench_name("static_results_on_row", mix.name, to_string(enc)),
+        rows.num_rows(),
+        synthetic_rows::total_size(bodies(rows, enc)),
+        [&] {
+            run_batch(proc, rows, enc, storage);
+            do_not_optimize(result.rows().size());
+        }
+    );
+}
+
+void bench_static_results(runner& r, const column_mix& mix, const synthetic_rows& rows, resultset_encoding enc)
+{
+    std::string name = mix.name;
+    if (name == "ints")
+        bench_static_results<ints_row>(r, mix, rows, enc);
+    else if (name == "mixed")
+        bench_static_results<mixed_row>(r, mix, rows, enc);
+    else if (name == "strings")
+        bench_static_results<strings_row>(r, mix, rows, enc);
+}
+
+#endif
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    runner r(argc, argv);
+    const resultset_encoding encodings[] = {resultset_encoding::text, resultset_encoding::binary};
+
+    for (const auto& mix : all_column_mixes())
+    {
+        synthetic_rows rows(mix, num_rows);
+
+        bench_parse_message(r, mix, rows);
+        bench_deserialize_row_message(r, mix, rows);
+        for (auto enc : encodings)
+            bench_deserialize_row(r, mix, rows, enc);
+        bench_copy_strings(r, mix, rows);
+        for (auto enc : encodings)
+            bench_results(r, mix, rows, enc);
+#ifdef BOOST_MYSQL_CXX14
+        for (auto enc : encodings)
+            bench_static_results(r, mix, rows, enc);
+#endif
+        bench_execute_stmt_serialization(r, mix, rows);
+    }
+
+    return r.exit_code();
+}
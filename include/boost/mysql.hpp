@@ -8,6 +8,7 @@
 #ifndef BOOST_MYSQL_HPP
 #define BOOST_MYSQL_HPP
 
+#include <boost/mysql/auth_plugin_cache.hpp>
 #include <boost/mysql/bad_field_access.hpp>
 #include <boost/mysql/blob.hpp>
 #include <boost/mysql/blob_view.hpp>
@@ -16,6 +17,8 @@
 #include <boost/mysql/column_type.hpp>
 #include <boost/mysql/common_server_errc.hpp>
 #include <boost/mysql/connection.hpp>
+#include <boost/mysql/connection_handoff.hpp>
+#include <boost/mysql/connection_stats.hpp>
 #include <boost/mysql/date.hpp>
 #include <boost/mysql/datetime.hpp>
 #include <boost/mysql/days.hpp>
@@ -28,20 +31,35 @@
 #include <boost/mysql/field_kind.hpp>
 #include <boost/mysql/field_view.hpp>
 #include <boost/mysql/handshake_params.hpp>
+#include <boost/mysql/hash_index.hpp>
+#include <boost/mysql/histogram.hpp>
 #include <boost/mysql/mariadb_collations.hpp>
 #include <boost/mysql/mariadb_server_errc.hpp>
+#include <boost/mysql/memory_usage.hpp>
 #include <boost/mysql/metadata.hpp>
 #include <boost/mysql/metadata_collection_view.hpp>
 #include <boost/mysql/metadata_mode.hpp>
+#include <boost/mysql/metrics.hpp>
 #include <boost/mysql/mysql_collations.hpp>
 #include <boost/mysql/mysql_server_errc.hpp>
+#include <boost/mysql/operation_observer.hpp>
+#include <boost/mysql/protocol_trace.hpp>
+#include <boost/mysql/query_digest.hpp>
+#include <boost/mysql/replay_stream.hpp>
+#include <boost/mysql/request_scheduler.hpp>
 #include <boost/mysql/results.hpp>
 #include <boost/mysql/resultset.hpp>
+#include <boost/mysql/resultset_diff.hpp>
 #include <boost/mysql/resultset_view.hpp>
 #include <boost/mysql/row.hpp>
+#include <boost/mysql/row_filter.hpp>
 #include <boost/mysql/row_view.hpp>
 #include <boost/mysql/rows.hpp>
 #include <boost/mysql/rows_view.hpp>
+#include <boost/mysql/server_command.hpp>
+#include <boost/mysql/server_connection.hpp>
+#include <boost/mysql/server_messages.hpp>
+#include <boost/mysql/sort_rows.hpp>
 #include <boost/mysql/ssl_mode.hpp>
 #include <boost/mysql/statement.hpp>
 #include <boost/mysql/static_execution_state.hpp>
@@ -53,5 +71,6 @@
 #include <boost/mysql/time.hpp>
 #include <boost/mysql/unix.hpp>
 #include <boost/mysql/unix_ssl.hpp>
+#include <boost/mysql/wire_capture.hpp>
 
 #endif
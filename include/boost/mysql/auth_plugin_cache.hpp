@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_AUTH_PLUGIN_CACHE_HPP
+#define BOOST_MYSQL_AUTH_PLUGIN_CACHE_HPP
+
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/access.hpp>
+#include <boost/mysql/detail/config.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace boost {
+namespace mysql {
+
+namespace detail {
+
+class auth_plugin_cache_impl
+{
+    mutable std::mutex mtx_;
+
+    // Keys are built from the server address and the username. Values point to
+    // the names of the plugins the library implements, which have static storage duration
+    std::unordered_map<std::string, string_view> entries_;
+
+public:
+    BOOST_MYSQL_DECL
+    string_view find(string_view server_address, string_view username) const;
+
+    BOOST_MYSQL_DECL
+    void store(string_view server_address, string_view username, string_view plugin_name);
+
+    BOOST_MYSQL_DECL
+    std::size_t size() const;
+
+    BOOST_MYSQL_DECL
+    void clear();
+};
+
+}  // namespace detail
+
+/**
+ * \brief Remembers the authentication plugin used by each user and server.
+ * \details
+ * When a user account employs an authentication plugin different from the server's default one,
+ * the server asks the client to switch plugins during the handshake. This costs an extra
+ * round trip every time a connection is established. A cache attached to a connection using
+ * \ref connection::set_auth_cache records the plugin that authentication finally
+ * used, and later handshakes to the same server with the same username send the right
+ * plugin response straight away.
+ * \n
+ * Entries are keyed by the server's address (as reported by the socket's remote endpoint)
+ * and the username. Connections using streams that are not a \ref SocketStream share
+ * a single address. If an account's plugin changes, the server requests a switch again
+ * and the entry is updated, so stale entries only cost the round trip they were meant to save.
+ * \n
+ * A single cache is meant to be shared by many connections (e.g. all the connections in
+ * a pool), and outlive all of them.
+ *
+ * \par Thread safety
+ * Distinct objects: safe. \n
+ * Shared objects: safe. Connections running in different threads may use the same cache.
+ */
+class auth_plugin_cache
+{
+public:
+    /// Default constructor. Constructs an empty cache.
+    auth_plugin_cache() = default;
+
+#ifndef BOOST_MYSQL_DOXYGEN
+    auth_plugin_cache(const auth_plugin_cache&) = delete;
+    auth_plugin_cache& operator=(const auth_plugin_cache&) = delete;
+#endif
+
+    /**
+     * \brief Returns the number of (server, user) pairs with a recorded plugin.
+     * \details
+     * Only accounts requiring a plugin switch are recorded.
+     */
+    std::size_t size() const { return impl_.size(); }
+
+    /// Removes all entries.
+    void clear() { impl_.clear(); }
+
+private:
+    detail::auth_plugin_cache_impl impl_;
+
+#ifndef BOOST_MYSQL_DOXYGEN
+    friend struct detail::access;
+#endif
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/auth_plugin_cache.ipp>
+#endif
+
+#endif
@@ -67,6 +67,10 @@ enum class client_errc : int
 
     /// The static interface encountered an error when parsing a field into a C++ data structure.
     static_row_parsing_error,
+
+    /// An asynchronous operation didn't complete within the timeout set by
+    /// `connection::set_operation_timeout`. The connection's socket was closed.
+    timeout,
 };
 
 BOOST_MYSQL_DECL
@@ -8,12 +8,17 @@
 #ifndef BOOST_MYSQL_CONNECTION_HPP
 #define BOOST_MYSQL_CONNECTION_HPP
 
+#include <boost/mysql/auth_plugin_cache.hpp>
 #include <boost/mysql/buffer_params.hpp>
+#include <boost/mysql/connection_stats.hpp>
 #include <boost/mysql/diagnostics.hpp>
 #include <boost/mysql/error_code.hpp>
 #include <boost/mysql/execution_state.hpp>
 #include <boost/mysql/handshake_params.hpp>
+#include <boost/mysql/memory_usage.hpp>
 #include <boost/mysql/metadata_mode.hpp>
+#include <boost/mysql/operation_observer.hpp>
+#include <boost/mysql/protocol_trace.hpp>
 #include <boost/mysql/results.hpp>
 #include <boost/mysql/rows_view.hpp>
 #include <boost/mysql/statement.hpp>
@@ -29,8 +34,11 @@
 #include <boost/mysql/detail/throw_on_error_loc.hpp>
 #include <boost/mysql/detail/writable_field_traits.hpp>
 
+#include <boost/asio/any_io_executor.hpp>
 #include <boost/assert.hpp>
 
+#include <chrono>
+#include <iosfwd>
 #include <type_traits>
 #include <utility>
 
@@ -199,6 +207,249 @@ public:
      */
     void set_meta_mode(metadata_mode v) noexcept { channel_.set_meta_mode(v); }
 
+    /**
+     * \brief Returns the I/O and protocol counters collected by this connection.
+     * \details
+     * Counters are cumulative since the connection object was constructed and
+     * are not reset by \ref handshake or \ref close. See \ref connection_stats
+     * for the meaning of each member.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Preconditions
+     * No asynchronous operation should be outstanding when this function is called.
+     * Otherwise, the returned values may be partially updated.
+     */
+    connection_stats stats() const noexcept { return channel_.stats(); }
+
+    /**
+     * \brief Returns the dynamic memory owned by this connection, in bytes.
+     * \details
+     * Buffers grow to fit the largest message exchanged and are never shrunk,
+     * so values reflect the connection's peak requirements. See \ref connection_memory_usage
+     * for the meaning of each member.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Preconditions
+     * No asynchronous operation should be outstanding when this function is called.
+     */
+    connection_memory_usage memory_usage() const noexcept { return channel_.memory_usage(); }
+
+    /**
+     * \brief Returns the operation observer installed in this connection, or `nullptr`.
+     * \details
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    operation_observer* observer() const noexcept { return channel_.observer(); }
+
+    /**
+     * \brief Installs an observer that gets notified of every network operation.
+     * \details
+     * The observer is invoked when any network operation (like \ref execute or \ref ping)
+     * starts and finishes, and receives timing information about each internal phase.
+     * Passing `nullptr` removes the observer. See \ref operation_observer for more info.
+     * \n
+     * The connection doesn't take ownership of the observer. It must be kept alive
+     * until it's removed or the connection is destroyed.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Preconditions
+     * No asynchronous operation should be outstanding when this function is called.
+     */
+    void set_observer(operation_observer* obs) noexcept { channel_.set_observer(obs); }
+
+    /**
+     * \brief Returns the authentication plugin cache used by this connection, or `nullptr`.
+     * \details
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    auth_plugin_cache* auth_cache() const noexcept { return channel_.auth_cache(); }
+
+    /**
+     * \brief Sets the cache used to remember the authentication plugin of each user and server.
+     * \details
+     * Handshakes performed by \ref connect, \ref handshake and their async counterparts will
+     * consult and update `cache`, saving the auth switch round trip that happens when an
+     * account's authentication plugin is not the server's default. The same cache may be shared
+     * between many connections. See \ref auth_plugin_cache for more info.
+     * \n
+     * `cache` is not owned by the connection, and must be kept alive while the connection uses it.
+     * Passing `nullptr` disables caching, which is the default.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Preconditions
+     * No handshake should be in progress when this function is called.
+     */
+    void set_auth_cache(auth_plugin_cache* cache) noexcept { channel_.set_auth_cache(cache); }
+
+    /**
+     * \brief Returns the timeout applied to async operations, or zero if operations are not timed.
+     * \details
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    std::chrono::steady_clock::duration operation_timeout() const noexcept
+    {
+        return channel_.operation_timeout();
+    }
+
+    /**
+     * \brief Sets a timeout for every async operation initiated by this connection.
+     * \details
+     * Async operations (like \ref async_execute or \ref async_ping) that don't complete within
+     * `timeout` fail with \ref client_errc::timeout. When the timeout expires, the underlying socket
+     * is closed, interrupting the operation. The connection can't be used until it's re-established,
+     * by calling \ref async_connect (or \ref connect).
+     * \n
+     * A single timer is allocated the first time it's required, and is reused by every operation.
+     * This is cheaper than creating a timer and using cancellation for every operation. Timed operations
+     * don't perform any extra allocation when compared to operations without a timeout.
+     * \n
+     * A zero or negative `timeout` disables timeouts, which is the default. Timeouts only apply
+     * to async operations on connections whose `Stream` is a \ref SocketStream. Sync operations
+     * are never timed.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Preconditions
+     * No asynchronous operation should be outstanding when this function is called.
+     */
+    void set_operation_timeout(std::chrono::steady_clock::duration timeout) noexcept
+    {
+        channel_.set_operation_timeout(timeout);
+    }
+
+    /**
+     * \brief Returns the executor where TLS handshakes run, or an empty executor if they're not offloaded.
+     * \details
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    asio::any_io_executor tls_handshake_executor() const { return channel_.tls_handshake_executor(); }
+
+    /**
+     * \brief Sets an executor where the TLS handshake of async operations is run.
+     * \details
+     * The TLS handshake performed by \ref async_connect and \ref async_handshake involves
+     * asymmetric cryptography, which is expensive. By default, it runs in the connection's
+     * executor. If many connections are established at once (e.g. when a server restarts),
+     * this can stall other connections sharing the executor's threads.
+     * \n
+     * If `ex` is not empty, the TLS handshake is run in `ex` instead. Every step of the handshake,
+     * including the cryptographic computations, is run by `ex`. Once the TLS handshake completes,
+     * the operation continues in the connection's executor, and its completion handler is invoked
+     * as usual. A typical choice for `ex` is the executor of a `boost::asio::thread_pool` dedicated
+     * to cryptographic work. Passing an empty executor disables offloading, which is the default.
+     * \n
+     * This setting only affects connections whose `Stream` supports TLS, when TLS is negotiated.
+     * Sync operations always run the TLS handshake in the calling thread.
+     * \n
+     * The operation timeout (see \ref set_operation_timeout) is not enforced while an offloaded
+     * handshake runs, since closing the socket would race with it. If the timeout expires meanwhile,
+     * the operation fails with \ref client_errc::timeout once the handshake finishes.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Preconditions
+     * No asynchronous operation should be outstanding when this function is called.
+     */
+    void set_tls_handshake_executor(asio::any_io_executor ex) noexcept
+    {
+        channel_.set_tls_handshake_executor(std::move(ex));
+    }
+
+    /**
+     * \brief Starts recording the last protocol messages exchanged with the server.
+     * \details
+     * Allocates a \ref protocol_trace holding the last `capacity` messages, replacing
+     * any previous one. Once enabled, every message read or written by this connection
+     * is recorded with its header, size, timestamp and payload prefix. This is cheap
+     * enough to be left enabled in production, and helps debugging misbehaving connections.
+     * Use \ref get_protocol_trace to access the records.
+     * \n
+     * Note that payload prefixes may contain sensitive data, like query text.
+     *
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     *
+     * \par Preconditions
+     * No asynchronous operation should be outstanding when this function is called.
+     */
+    void enable_protocol_trace(std::size_t capacity = 64) { channel_.enable_protocol_trace(capacity); }
+
+    /**
+     * \brief Stops recording protocol messages and frees the trace.
+     * \details
+     * Pointers obtained from \ref get_protocol_trace are invalidated.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Preconditions
+     * No asynchronous operation should be outstanding when this function is called.
+     */
+    void disable_protocol_trace() noexcept { channel_.disable_protocol_trace(); }
+
+    /**
+     * \brief Returns the protocol trace, or `nullptr` if it's not enabled.
+     * \details
+     * The returned object is owned by the connection. Its contents should be
+     * inspected while no operation is outstanding, e.g. after an operation fails.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    const protocol_trace* get_protocol_trace() const noexcept { return channel_.get_protocol_trace(); }
+
+    /**
+     * \brief Starts recording all the bytes exchanged with the server.
+     * \details
+     * Writes a capture header to `output`, followed by a record for every subsequent
+     * read or write performed by this connection, with the bytes transferred and a timestamp
+     * relative to this call. Records are written as soon as each read or write completes.
+     * Any previous capture is stopped. Use \ref read_wire_capture to load the records, and
+     * \ref replay_stream to replay the server side deterministically.
+     * \n
+     * Only the bytes exchanged with the MySQL protocol layer are captured. If the connection
+     * uses TLS, the captured bytes are the decrypted ones, and the TLS handshake isn't recorded.
+     * Captures contain everything sent to the server, including query text and authentication data.
+     * \n
+     * The connection doesn't take ownership of `output`. It must be kept alive until
+     * the capture is stopped or the connection is destroyed. Output errors are not reported
+     * by the connection: they set the stream's state bits, as usual.
+     *
+     * \par Exception safety
+     * Basic guarantee. Memory allocations and writes to `output` may throw.
+     *
+     * \par Preconditions
+     * No asynchronous operation should be outstanding when this function is called.
+     */
+    void start_wire_capture(std::ostream& output) { channel_.start_wire_capture(output); }
+
+    /**
+     * \brief Stops recording the bytes exchanged with the server.
+     * \details
+     * Does nothing if no capture is active. The output stream is not flushed.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Preconditions
+     * No asynchronous operation should be outstanding when this function is called.
+     */
+    void stop_wire_capture() noexcept { channel_.stop_wire_capture(); }
+
     /**
      * \brief Establishes a connection to a MySQL server.
      * \details
@@ -1124,6 +1375,123 @@ public:
         );
     }
 
+    /**
+     * \brief Prepares, executes and closes a statement.
+     * \details
+     * Prepares `sql` as a statement, executes it with `params` and reads the response into `result`.
+     * The statement is closed afterwards, even if the execution fails. This gives ad-hoc queries
+     * the safety of the binary protocol, without having to manage the lifetime of a \ref statement.
+     * `result` may be either a \ref results or \ref static_results object.
+     * \n
+     * If the server is MariaDB, the three requests are sent together, and the operation completes in a
+     * single round trip. MariaDB interprets the statement ID `0xffffffff` as "the statement that was
+     * just prepared". Otherwise, the three operations are performed sequentially, in three round trips.
+     * \n
+     * The statement actual parameters (`params`) are passed as a `std::tuple` of elements.
+     * See the `WritableFieldTuple` concept defition for more info. You should pass exactly as many
+     * parameters as placeholders has `sql`, or the operation will fail with
+     * \ref client_errc::wrong_num_params.
+     * `sql` and any string parameters should be encoded using the connection's character set.
+     * \n
+     * After this operation completes successfully, `result.has_value() == true`.
+     * \n
+     * Metadata in `result` will be populated according to `this->meta_mode()`.
+     * \n
+     * Operation observers see this operation as an \ref operation_type::execute.
+     */
+    template <
+        BOOST_MYSQL_WRITABLE_FIELD_TUPLE WritableFieldTuple,
+        BOOST_MYSQL_RESULTS_TYPE ResultsType,
+        class EnableIf =
+            typename std::enable_if<detail::is_writable_field_tuple<WritableFieldTuple>::value>::type>
+    void execute_prepared_once(
+        string_view sql,
+        const WritableFieldTuple& params,
+        ResultsType& result,
+        error_code& err,
+        diagnostics& diag
+    )
+    {
+        detail::execute_prepared_once_interface(channel_.get(), sql, params, result, err, diag);
+    }
+
+    /// \copydoc execute_prepared_once
+    template <
+        BOOST_MYSQL_WRITABLE_FIELD_TUPLE WritableFieldTuple,
+        BOOST_MYSQL_RESULTS_TYPE ResultsType,
+        class EnableIf =
+            typename std::enable_if<detail::is_writable_field_tuple<WritableFieldTuple>::value>::type>
+    void execute_prepared_once(string_view sql, const WritableFieldTuple& params, ResultsType& result)
+    {
+        error_code err;
+        diagnostics diag;
+        execute_prepared_once(sql, params, result, err, diag);
+        detail::throw_on_error_loc(err, diag, BOOST_CURRENT_LOCATION);
+    }
+
+    /**
+     * \copydoc execute_prepared_once
+     * \par Object lifetimes
+     * If `CompletionToken` is deferred (like `use_awaitable`), the string pointed to by `sql` must be
+     * kept alive until the operation is initiated. If `params` contains any reference
+     * type (like `string_view`), the caller must keep the values pointed by these references alive
+     * until the operation is initiated. Value types will be copied/moved as required, so don't need
+     * to be kept alive.
+     *
+     * \par Handler signature
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <
+        BOOST_MYSQL_WRITABLE_FIELD_TUPLE WritableFieldTuple,
+        BOOST_MYSQL_RESULTS_TYPE ResultsType,
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(::boost::mysql::error_code))
+            CompletionToken BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type),
+        class EnableIf =
+            typename std::enable_if<detail::is_writable_field_tuple<WritableFieldTuple>::value>::type>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_execute_prepared_once(
+        string_view sql,
+        WritableFieldTuple&& params,
+        ResultsType& result,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return async_execute_prepared_once(
+            sql,
+            std::forward<WritableFieldTuple>(params),
+            result,
+            shared_diag(),
+            std::forward<CompletionToken>(token)
+        );
+    }
+
+    /// \copydoc async_execute_prepared_once
+    template <
+        BOOST_MYSQL_WRITABLE_FIELD_TUPLE WritableFieldTuple,
+        BOOST_MYSQL_RESULTS_TYPE ResultsType,
+        BOOST_ASIO_COMPLETION_TOKEN_FOR(void(::boost::mysql::error_code))
+            CompletionToken BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type),
+        class EnableIf =
+            typename std::enable_if<detail::is_writable_field_tuple<WritableFieldTuple>::value>::type>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_execute_prepared_once(
+        string_view sql,
+        WritableFieldTuple&& params,
+        ResultsType& result,
+        diagnostics& diag,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return detail::async_execute_prepared_once_interface(
+            channel_.get(),
+            sql,
+            std::forward<WritableFieldTuple>(params),
+            result,
+            diag,
+            std::forward<CompletionToken>(token)
+        );
+    }
+
     /**
      * \brief Reads a batch of rows.
      * \details
@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_CONNECTION_HANDOFF_HPP
+#define BOOST_MYSQL_CONNECTION_HANDOFF_HPP
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/throw_on_error.hpp>
+
+#include <boost/mysql/detail/access.hpp>
+#include <boost/mysql/detail/config.hpp>
+#include <boost/mysql/detail/socket_stream.hpp>
+
+#include <boost/asio/local/stream_protocol.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_MYSQL_DOXYGEN)
+
+namespace boost {
+namespace mysql {
+
+namespace detail {
+
+class channel;
+
+BOOST_MYSQL_DECL
+error_code send_connection_state(channel& chan, int connection_fd, int handoff_fd);
+
+// On success, sockaddr_buffer contains the received socket's local address, sockaddr_size
+// its size and family its address family
+BOOST_MYSQL_DECL
+error_code receive_connection_state(
+    channel& chan,
+    int handoff_fd,
+    int& connection_fd,
+    void* sockaddr_buffer,
+    std::size_t& sockaddr_size,
+    int& family
+);
+
+BOOST_MYSQL_DECL
+void close_fd(int fd) noexcept;
+
+}  // namespace detail
+
+/**
+ * \brief Sends an established connection to another process, over a UNIX domain socket.
+ * \details
+ * The connection's socket is sent as a file descriptor, using `SCM_RIGHTS`, together with
+ * the state negotiated during the handshake (capabilities and server flavor). Another process
+ * can then use it by calling \ref import_connection on the other end of `handoff_sock`,
+ * without reconnecting. This allows a supervisor process to establish connections
+ * and hand them to worker processes.
+ * \n
+ * On success, `conn`'s socket is closed in this process, without notifying the server:
+ * the connection stays alive in the receiving process. `conn` may be reconnected afterwards.
+ * \n
+ * Connections using TLS can't be handed off, since the TLS session state can't be transferred.
+ * Attempting it fails with `asio::error::operation_not_supported`. Connections with
+ * a `Stream` supporting TLS (like \ref tcp_ssl_connection) can be handed off if TLS was
+ * not negotiated.
+ * \n
+ * This function is blocking and there is no async counterpart.
+ *
+ * \par Preconditions
+ * `conn` is connected and idle: no operation is outstanding, and there is no
+ * multi-function operation (see \ref connection::start_execution) in progress.
+ *
+ * \par Exception safety
+ * No-throw guarantee.
+ */
+template <class Stream>
+void export_connection(
+    connection<Stream>& conn,
+    asio::local::stream_protocol::socket& handoff_sock,
+    error_code& err
+)
+{
+    static_assert(detail::is_socket_stream<Stream>::value, "Stream should be a SocketStream");
+    auto& sock = conn.stream().lowest_layer();
+    err = detail::send_connection_state(
+        detail::access::get_channel(conn).get(),
+        static_cast<int>(sock.native_handle()),
+        static_cast<int>(handoff_sock.native_handle())
+    );
+    if (err)
+        return;
+
+    // Don't shutdown the socket, since it's still in use by the receiver
+    error_code ignored;
+    sock.close(ignored);
+}
+
+/// \copydoc export_connection
+template <class Stream>
+void export_connection(connection<Stream>& conn, asio::local::stream_protocol::socket& handoff_sock)
+{
+    error_code err;
+    export_connection(conn, handoff_sock, err);
+    throw_on_error(err);
+}
+
+/**
+ * \brief Receives a connection sent by \ref export_connection, over a UNIX domain socket.
+ * \details
+ * Receives a socket and its connection state from `handoff_sock`, and makes `conn`
+ * use them. On success, `conn` is ready to run operations, as if \ref connection::connect
+ * had been called on it. Only the connection's network state is transferred: settings
+ * like \ref connection::meta_mode are not modified.
+ * \n
+ * The transferred socket must be compatible with `Stream` (e.g. a TCP socket
+ * can only be imported by a \ref tcp_connection or \ref tcp_ssl_connection).
+ * If the received data is not a valid connection, the operation fails with
+ * \ref client_errc::protocol_value_error.
+ * \n
+ * This function is blocking and there is no async counterpart.
+ *
+ * \par Preconditions
+ * No operation is outstanding on `conn`. If `conn`'s socket is open, it is closed first,
+ * without notifying the server.
+ *
+ * \par Exception safety
+ * No-throw guarantee.
+ */
+template <class Stream>
+void import_connection(
+    asio::local::stream_protocol::socket& handoff_sock,
+    connection<Stream>& conn,
+    error_code& err
+)
+{
+    static_assert(detail::is_socket_stream<Stream>::value, "Stream should be a SocketStream");
+    auto& sock = conn.stream().lowest_layer();
+    using socket_type = typename std::decay<decltype(sock)>::type;
+
+    error_code ignored;
+    if (sock.is_open())
+        sock.close(ignored);
+
+    int fd = -1;
+    int family = 0;
+    typename socket_type::endpoint_type local_ep;
+    std::size_t local_ep_size = local_ep.capacity();
+    err = detail::receive_connection_state(
+        detail::access::get_channel(conn).get(),
+        static_cast<int>(handoff_sock.native_handle()),
+        fd,
+        local_ep.data(),
+        local_ep_size,
+        family
+    );
+    if (err)
+        return;
+
+    // The endpoint deduces the protocol from the address, so this detects mismatches
+    local_ep.resize(local_ep_size);
+    if (local_ep.protocol().family() != family)
+        err = client_errc::protocol_value_error;
+    else
+        sock.assign(local_ep.protocol(), fd, err);
+    if (err)
+        detail::close_fd(fd);
+}
+
+/// \copydoc import_connection
+template <class Stream>
+void import_connection(asio::local::stream_protocol::socket& handoff_sock, connection<Stream>& conn)
+{
+    error_code err;
+    import_connection(handoff_sock, conn, err);
+    throw_on_error(err);
+}
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/connection_handoff.ipp>
+#endif
+
+#endif
+
+#endif
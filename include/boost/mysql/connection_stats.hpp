@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_CONNECTION_STATS_HPP
+#define BOOST_MYSQL_CONNECTION_STATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Network and protocol counters for a connection.
+ * \details
+ * Contains cumulative counters about the I/O and decoding work that a \ref connection
+ * has performed since it was constructed. They are always collected and are cheap
+ * to maintain. They can be used to tune \ref buffer_params and to spot
+ * connections that spend too much time waiting for the network or decoding rows.
+ * \n
+ * Obtain them by calling \ref connection::stats.
+ */
+struct connection_stats
+{
+    /// Number of bytes read from the underlying stream.
+    std::uint64_t bytes_read{};
+
+    /// Number of bytes written to the underlying stream, including frame headers.
+    std::uint64_t bytes_written{};
+
+    /// Number of read operations (`read_some` or `async_read_some`) issued to the underlying stream.
+    std::uint64_t read_calls{};
+
+    /// Number of write operations (`write_some` or `async_write_some`) issued to the underlying stream.
+    std::uint64_t write_calls{};
+
+    /// Number of protocol messages received from the server.
+    std::uint64_t messages_read{};
+
+    /// Number of protocol messages sent to the server.
+    std::uint64_t messages_written{};
+
+    /// Number of protocol frames received from the server. A message is made of one or more frames.
+    std::uint64_t frames_read{};
+
+    /// Number of received messages that spanned more than one frame.
+    std::uint64_t multiframe_messages_read{};
+
+    /// Number of times the read buffer had to be enlarged to fit an incoming message.
+    std::uint64_t read_buffer_growths{};
+
+    /// The current size of the read buffer, in bytes.
+    std::size_t read_buffer_size{};
+
+    /// Number of rows decoded.
+    std::uint64_t rows_read{};
+
+    /**
+     * \brief Time spent in stream read and write operations.
+     * \details
+     * For sync operations, this is the time spent blocked in the stream calls.
+     * For async operations, this is the time elapsed between initiating the stream
+     * operation and the completion handler being invoked.
+     */
+    std::chrono::nanoseconds io_time{};
+
+    /// Time spent deserializing rows and storing them in results or execution states.
+    std::chrono::nanoseconds decode_time{};
+
+    /**
+     * \brief Adds the counters in `rhs` to `*this`.
+     * \details
+     * Useful to aggregate statistics for several connections. \ref read_buffer_size
+     * is also added, yielding the total memory used by read buffers.
+     */
+    connection_stats& operator+=(const connection_stats& rhs) noexcept
+    {
+        bytes_read += rhs.bytes_read;
+        bytes_written += rhs.bytes_written;
+        read_calls += rhs.read_calls;
+        write_calls += rhs.write_calls;
+        messages_read += rhs.messages_read;
+        messages_written += rhs.messages_written;
+        frames_read += rhs.frames_read;
+        multiframe_messages_read += rhs.multiframe_messages_read;
+        read_buffer_growths += rhs.read_buffer_growths;
+        read_buffer_size += rhs.read_buffer_size;
+        rows_read += rhs.rows_read;
+        io_time += rhs.io_time;
+        decode_time += rhs.decode_time;
+        return *this;
+    }
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -30,6 +30,12 @@ struct access
         return obj.impl_;
     }
 
+    template <class T>
+    static decltype(std::declval<T>().channel_)& get_channel(T& obj) noexcept
+    {
+        return obj.channel_;
+    }
+
     template <class T, class... Args>
     static T construct(Args&&... args)
     {
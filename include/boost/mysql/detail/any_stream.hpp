@@ -15,6 +15,7 @@
 #include <boost/asio/buffer.hpp>
 
 #include <cstddef>
+#include <string>
 
 namespace boost {
 namespace mysql {
@@ -23,8 +24,8 @@ namespace detail {
 class any_stream
 {
 public:
-    any_stream(bool supports_ssl) noexcept
-        : ssl_state_(supports_ssl ? ssl_state::inactive : ssl_state::unsupported)
+    any_stream(bool supports_ssl, bool supports_close) noexcept
+        : ssl_state_(supports_ssl ? ssl_state::inactive : ssl_state::unsupported), supports_close_(supports_close)
     {
     }
     bool ssl_active() const noexcept { return ssl_state_ == ssl_state::active; }
@@ -40,6 +41,9 @@ public:
     }
     bool supports_ssl() const noexcept { return ssl_state_ != ssl_state::unsupported; }
 
+    // Whether connect and close are available (i.e. the stream is a SocketStream)
+    bool supports_close() const noexcept { return supports_close_; }
+
     using executor_type = asio::any_io_executor;
 
     virtual ~any_stream() {}
@@ -66,6 +70,9 @@ public:
     virtual void close(error_code& ec) = 0;
     virtual bool is_open() const noexcept = 0;
 
+    // The address of the peer, as raw bytes. Empty if unknown or not a SocketStream
+    virtual std::string remote_address() const = 0;
+
 private:
     enum class ssl_state
     {
@@ -73,6 +80,7 @@ private:
         active,
         unsupported
     } ssl_state_;
+    bool supports_close_;
 };
 
 }  // namespace detail
@@ -18,6 +18,7 @@
 #include <boost/asio/ssl/stream.hpp>
 #include <boost/config.hpp>
 
+#include <string>
 #include <type_traits>
 
 namespace boost {
@@ -118,6 +119,28 @@ bool do_is_open(const Stream& stream) noexcept
     return do_is_open_impl(stream, is_socket_stream<Stream>{});
 }
 
+template <class Stream>
+std::string do_remote_address_impl(const Stream&, std::false_type)
+{
+    return std::string();
+}
+
+template <class Stream>
+std::string do_remote_address_impl(const Stream& stream, std::true_type)
+{
+    error_code ec;
+    auto ep = stream.lowest_layer().remote_endpoint(ec);
+    if (ec)
+        return std::string();
+    return std::string(reinterpret_cast<const char*>(ep.data()), ep.size());
+}
+
+template <class Stream>
+std::string do_remote_address(const Stream& stream)
+{
+    return do_remote_address_impl(stream, is_socket_stream<Stream>{});
+}
+
 template <class Stream>
 class any_stream_impl final : public any_stream
 {
@@ -125,7 +148,8 @@ class any_stream_impl final : public any_stream
 
 public:
     template <class... Args>
-    any_stream_impl(Args&&... args) : any_stream(false), stream_(std::forward<Args>(args)...)
+    any_stream_impl(Args&&... args)
+        : any_stream(false, is_socket_stream<Stream>::value), stream_(std::forward<Args>(args)...)
     {
     }
 
@@ -181,6 +205,7 @@ public:
     }
     void close(error_code& ec) override final { do_close(stream_, ec); }
     bool is_open() const noexcept override { return do_is_open(stream_); }
+    std::string remote_address() const override { return do_remote_address(stream_); }
 };
 
 template <class Stream>
@@ -190,7 +215,8 @@ class any_stream_impl<asio::ssl::stream<Stream>> final : public any_stream
 
 public:
     template <class... Args>
-    any_stream_impl(Args&&... args) : any_stream(true), stream_(std::forward<Args>(args)...)
+    any_stream_impl(Args&&... args)
+        : any_stream(true, is_socket_stream<Stream>::value), stream_(std::forward<Args>(args)...)
     {
     }
 
@@ -279,6 +305,7 @@ public:
     }
     void close(error_code& ec) override final { do_close(stream_, ec); }
     bool is_open() const noexcept override { return do_is_open(stream_); }
+    std::string remote_address() const override { return do_remote_address(stream_); }
 };
 
 template <class Stream>
@@ -8,15 +8,23 @@
 #ifndef BOOST_MYSQL_DETAIL_CHANNEL_PTR_HPP
 #define BOOST_MYSQL_DETAIL_CHANNEL_PTR_HPP
 
+#include <boost/mysql/auth_plugin_cache.hpp>
+#include <boost/mysql/connection_stats.hpp>
 #include <boost/mysql/diagnostics.hpp>
 #include <boost/mysql/field_view.hpp>
+#include <boost/mysql/memory_usage.hpp>
 #include <boost/mysql/metadata_mode.hpp>
+#include <boost/mysql/operation_observer.hpp>
+#include <boost/mysql/protocol_trace.hpp>
 
 #include <boost/mysql/detail/any_stream.hpp>
 #include <boost/mysql/detail/config.hpp>
 
+#include <boost/asio/any_io_executor.hpp>
 #include <boost/assert.hpp>
 
+#include <chrono>
+#include <iosfwd>
 #include <memory>
 
 namespace boost {
@@ -56,6 +64,21 @@ public:
     BOOST_MYSQL_DECL metadata_mode meta_mode() const noexcept;
     BOOST_MYSQL_DECL void set_meta_mode(metadata_mode v) noexcept;
     BOOST_MYSQL_DECL diagnostics& shared_diag() noexcept;
+    BOOST_MYSQL_DECL connection_stats stats() const noexcept;
+    BOOST_MYSQL_DECL connection_memory_usage memory_usage() const noexcept;
+    BOOST_MYSQL_DECL operation_observer* observer() const noexcept;
+    BOOST_MYSQL_DECL void set_observer(operation_observer* v) noexcept;
+    BOOST_MYSQL_DECL auth_plugin_cache* auth_cache() const noexcept;
+    BOOST_MYSQL_DECL void set_auth_cache(auth_plugin_cache* v) noexcept;
+    BOOST_MYSQL_DECL std::chrono::steady_clock::duration operation_timeout() const noexcept;
+    BOOST_MYSQL_DECL void set_operation_timeout(std::chrono::steady_clock::duration v) noexcept;
+    BOOST_MYSQL_DECL asio::any_io_executor tls_handshake_executor() const;
+    BOOST_MYSQL_DECL void set_tls_handshake_executor(asio::any_io_executor v) noexcept;
+    BOOST_MYSQL_DECL const protocol_trace* get_protocol_trace() const noexcept;
+    BOOST_MYSQL_DECL void enable_protocol_trace(std::size_t capacity);
+    BOOST_MYSQL_DECL void disable_protocol_trace() noexcept;
+    BOOST_MYSQL_DECL void start_wire_capture(std::ostream& output);
+    BOOST_MYSQL_DECL void stop_wire_capture() noexcept;
 };
 
 BOOST_MYSQL_DECL std::vector<field_view>& get_shared_fields(channel&) noexcept;
@@ -27,6 +27,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <vector>
 
 namespace boost {
 namespace mysql {
@@ -69,6 +70,15 @@ public:
     }
 };
 
+// Dynamic memory owned by a metadata vector, used by the processors' memory_usage()
+inline std::size_t metadata_memory_usage(const std::vector<metadata>& meta) noexcept
+{
+    std::size_t res = vector_memory_usage(meta);
+    for (const auto& m : meta)
+        res += m.memory_usage();
+    return res;
+}
+
 class execution_processor
 {
 public:
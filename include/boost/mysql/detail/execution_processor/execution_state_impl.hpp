@@ -13,13 +13,16 @@
 #include <boost/mysql/field_view.hpp>
 #include <boost/mysql/metadata.hpp>
 #include <boost/mysql/metadata_collection_view.hpp>
+#include <boost/mysql/row_filter.hpp>
 #include <boost/mysql/string_view.hpp>
 
 #include <boost/mysql/detail/config.hpp>
 #include <boost/mysql/detail/execution_processor/execution_processor.hpp>
+#include <boost/mysql/detail/row_impl.hpp>
 
 #include <boost/assert.hpp>
 
+#include <utility>
 #include <vector>
 
 namespace boost {
@@ -40,12 +43,22 @@ class execution_state_impl final : public execution_processor
     std::vector<metadata> meta_;
     ok_data eof_data_;
     std::vector<char> info_;
+    row_filter filter_;
+    std::size_t num_resultsets_{0};
+    bool has_rows_{false};  // Has the current resultset had any rows?
+
+    // The first row discarded by the filter, and the connection's field vector
+    // where it should be restored if it turns out to be OUT params
+    row_impl filtered_first_row_;
+    std::vector<field_view>* filtered_first_row_output_{nullptr};
 
     void on_new_resultset() noexcept
     {
         meta_.clear();
         eof_data_ = ok_data{};
         info_.clear();
+        ++num_resultsets_;
+        has_rows_ = false;
     }
 
     BOOST_MYSQL_DECL
@@ -109,7 +122,14 @@ public:
         return eof_data_.is_out_params;
     }
 
+    std::size_t memory_usage() const noexcept
+    {
+        return metadata_memory_usage(meta_) + vector_memory_usage(info_) + filtered_first_row_.memory_usage();
+    }
+
     execution_state_impl& get_interface() noexcept { return *this; }
+
+    void set_row_filter(row_filter filter) noexcept { filter_ = std::move(filter); }
 };
 
 }  // namespace detail
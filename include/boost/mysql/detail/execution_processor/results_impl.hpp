@@ -13,6 +13,7 @@
 #include <boost/mysql/field_view.hpp>
 #include <boost/mysql/metadata.hpp>
 #include <boost/mysql/metadata_collection_view.hpp>
+#include <boost/mysql/row_filter.hpp>
 #include <boost/mysql/rows_view.hpp>
 #include <boost/mysql/string_view.hpp>
 
@@ -22,6 +23,8 @@
 
 #include <boost/assert.hpp>
 
+#include <utility>
+
 namespace boost {
 namespace mysql {
 namespace detail {
@@ -76,6 +79,7 @@ public:
         return rest_.empty() ? first_ : rest_.back();
     }
     BOOST_MYSQL_DECL per_resultset_data& emplace_back();
+    std::size_t memory_usage() const noexcept { return vector_memory_usage(rest_); }
 };
 
 // Rows for all resultsets are stored in a single rows_impl object.
@@ -134,8 +138,16 @@ public:
 
     bool get_is_out_params(std::size_t index) const noexcept { return get_resultset(index).is_out_params; }
 
+    std::size_t memory_usage() const noexcept
+    {
+        return metadata_memory_usage(meta_) + per_result_.memory_usage() + vector_memory_usage(info_) +
+               rows_.memory_usage() + filtered_first_row_.memory_usage();
+    }
+
     results_impl& get_interface() noexcept { return *this; }
 
+    void set_row_filter(row_filter filter) noexcept { filter_ = std::move(filter); }
+
 private:
     // Virtual impls
     BOOST_MYSQL_DECL
@@ -169,6 +181,10 @@ private:
     std::vector<char> info_;
     row_impl rows_;
     std::size_t num_fields_at_batch_start_{no_batch};
+    row_filter filter_;
+    row_impl filtered_first_row_;
+    bool has_filtered_first_row_{false};
+    bool has_rows_{false};
 
     // Auxiliar
     static constexpr std::size_t no_batch = std::size_t(-1);
@@ -151,6 +151,11 @@ public:
 
     bool get_is_out_params(std::size_t index) const noexcept { return ext_.per_result(index).is_out_params; }
 
+    std::size_t memory_usage() const noexcept
+    {
+        return metadata_memory_usage(meta_) + vector_memory_usage(info_);
+    }
+
 private:
     // Virtual implementations
     BOOST_MYSQL_DECL
@@ -228,6 +233,25 @@ struct results_fns
         boost::mp11::mp_for_each<boost::mp11::mp_iota_c<sizeof...(StaticRow)>>(reset_fn{rows});
     }
 
+    struct memory_usage_fn
+    {
+        const rows_t& obj;
+        std::size_t& res;
+
+        template <std::size_t I>
+        void operator()(boost::mp11::mp_size_t<I>) const noexcept
+        {
+            res += vector_memory_usage(std::get<I>(obj));
+        }
+    };
+
+    static std::size_t memory_usage(const rows_t& rows) noexcept
+    {
+        std::size_t res = 0;
+        boost::mp11::mp_for_each<boost::mp11::mp_iota_c<sizeof...(StaticRow)>>(memory_usage_fn{rows, res});
+        return res;
+    }
+
     template <std::size_t I>
     static error_code do_parse(span<const std::size_t> pos_map, span<const field_view> from, void* to)
     {
@@ -332,6 +356,11 @@ public:
         return std::get<I>(data_.rows);
     }
 
+    std::size_t memory_usage() const noexcept
+    {
+        return results_fns<StaticRow...>::memory_usage(data_.rows) + impl_.memory_usage();
+    }
+
     const static_results_erased_impl& get_interface() const noexcept { return impl_; }
     static_results_erased_impl& get_interface() noexcept { return impl_; }
 };
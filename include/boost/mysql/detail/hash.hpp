@@ -0,0 +1,39 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_HASH_HPP
+#define BOOST_MYSQL_DETAIL_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// The 64-bit finalizer from MurmurHash3. Every input bit affects every output bit
+inline std::uint64_t hash_mix(std::uint64_t x) noexcept
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdu;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53u;
+    x ^= x >> 33;
+    return x;
+}
+
+// Order-dependent combination, used to hash sequences of fields
+inline std::size_t hash_combine(std::size_t seed, std::size_t value) noexcept
+{
+    return static_cast<std::size_t>(hash_mix(seed + 0x9e3779b97f4a7c15u + value));
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
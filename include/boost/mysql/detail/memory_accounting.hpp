@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_MEMORY_ACCOUNTING_HPP
+#define BOOST_MYSQL_DETAIL_MEMORY_ACCOUNTING_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef BOOST_MYSQL_ENABLE_MEMORY_ACCOUNTING
+#include <atomic>
+#endif
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+template <class T>
+std::size_t vector_memory_usage(const std::vector<T>& v) noexcept
+{
+    return v.capacity() * sizeof(T);
+}
+
+// Strings using the small buffer optimization don't own any heap memory
+inline std::size_t string_memory_usage(const std::string& s) noexcept
+{
+    const void* data = s.data();
+    const void* obj_first = &s;
+    const void* obj_last = &s + 1;
+    std::less<const void*> lt;
+    bool is_inline = !lt(data, obj_first) && lt(data, obj_last);
+    return is_inline ? 0u : s.capacity() + 1u;
+}
+
+#ifdef BOOST_MYSQL_ENABLE_MEMORY_ACCOUNTING
+
+inline std::atomic<std::size_t>& accounted_memory_counter() noexcept
+{
+    static std::atomic<std::size_t> res{0};
+    return res;
+}
+
+// Contributes a number of bytes to the global counter, for as long as it's alive.
+// Copies start at zero: the owner is expected to call update() after copying its storage.
+// Moves transfer the amount, as moved-from vectors are left empty.
+class memory_account
+{
+    std::size_t size_{};
+
+    static void add(std::size_t n) noexcept
+    {
+        accounted_memory_counter().fetch_add(n, std::memory_order_relaxed);
+    }
+
+    static void sub(std::size_t n) noexcept
+    {
+        accounted_memory_counter().fetch_sub(n, std::memory_order_relaxed);
+    }
+
+public:
+    memory_account() = default;
+    memory_account(const memory_account&) noexcept {}
+    memory_account(memory_account&& rhs) noexcept : size_(rhs.size_) { rhs.size_ = 0; }
+    memory_account& operator=(const memory_account&) noexcept { return *this; }
+    memory_account& operator=(memory_account&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            sub(size_);
+            size_ = rhs.size_;
+            rhs.size_ = 0;
+        }
+        return *this;
+    }
+    ~memory_account() { sub(size_); }
+
+    void update(std::size_t new_size) noexcept
+    {
+        if (new_size > size_)
+            add(new_size - size_);
+        else if (new_size < size_)
+            sub(size_ - new_size);
+        size_ = new_size;
+    }
+};
+
+#else
+
+class memory_account
+{
+public:
+    void update(std::size_t) noexcept {}
+};
+
+#endif
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -25,10 +25,13 @@
 #include <boost/mysql/detail/typing/get_type_index.hpp>
 
 #include <boost/asio/any_completion_handler.hpp>
+#include <boost/asio/associator.hpp>
 #include <boost/mp11/integer_sequence.hpp>
 
 #include <array>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace boost {
 namespace mysql {
@@ -45,6 +48,43 @@ using any_handler = asio::any_completion_handler<void(error_code, T)>;
 
 using any_void_handler = asio::any_completion_handler<void(error_code)>;
 
+// Called by async operations before invoking the final handler. Stops the connection's deadline,
+// if any, and notifies the observer, if any. Returns the error code to pass to the handler, which is
+// client_errc::timeout if the deadline expired and caused the operation to fail
+BOOST_MYSQL_DECL
+error_code finish_async_operation(channel& chan, error_code err) noexcept;
+
+// Wraps the final handler of async operations. Applied before the handler is type-erased,
+// so operations with a timeout or an observer don't allocate more than the ones without them.
+// Associated characteristics are those of the wrapped handler
+template <class Handler>
+class async_op_handler
+{
+    channel* chan_;
+    Handler handler_;
+
+public:
+    template <class DeducedHandler>
+    async_op_handler(channel& chan, DeducedHandler&& handler)
+        : chan_(&chan), handler_(std::forward<DeducedHandler>(handler))
+    {
+    }
+
+    const Handler& get() const noexcept { return handler_; }
+
+    template <class... Args>
+    void operator()(error_code err, Args&&... args)
+    {
+        std::move(handler_)(finish_async_operation(*chan_, err), std::forward<Args>(args)...);
+    }
+};
+
+template <class Handler>
+async_op_handler<typename std::decay<Handler>::type> make_async_op_handler(channel& chan, Handler&& handler)
+{
+    return async_op_handler<typename std::decay<Handler>::type>(chan, std::forward<Handler>(handler));
+}
+
 // execution helpers
 template <class... T, std::size_t... I>
 std::array<field_view, sizeof...(T)> tuple_to_array_impl(const std::tuple<T...>& t, mp11::index_sequence<I...>) noexcept
@@ -150,7 +190,13 @@ struct connect_initiation
         diagnostics* diag
     )
     {
-        async_connect_erased(*chan, &endpoint, params, *diag, std::forward<Handler>(handler));
+        async_connect_erased(
+            *chan,
+            &endpoint,
+            params,
+            *diag,
+            make_async_op_handler(*chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -203,7 +249,12 @@ struct handshake_initiation
     template <class Handler>
     void operator()(Handler&& handler, channel* chan, handshake_params params, diagnostics* diag)
     {
-        async_handshake_erased(*chan, params, *diag, std::forward<Handler>(handler));
+        async_handshake_erased(
+            *chan,
+            params,
+            *diag,
+            make_async_op_handler(*chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -257,7 +308,13 @@ struct initiate_execute
     )
     {
         auto getter = make_request_getter(req, chan);
-        async_execute_erased(chan, getter.get(), proc, diag, std::forward<Handler>(handler));
+        async_execute_erased(
+            chan,
+            getter.get(),
+            proc,
+            diag,
+            make_async_op_handler(chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -327,7 +384,13 @@ struct initiate_start_execution
     )
     {
         auto getter = make_request_getter(req, chan);
-        async_start_execution_erased(chan, getter.get(), proc, diag, std::forward<Handler>(handler));
+        async_start_execution_erased(
+            chan,
+            getter.get(),
+            proc,
+            diag,
+            make_async_op_handler(chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -382,7 +445,12 @@ struct prepare_statement_initiation
     template <class Handler>
     void operator()(Handler&& handler, channel* chan, string_view stmt_sql, diagnostics* diag)
     {
-        async_prepare_statement_erased(*chan, stmt_sql, *diag, std::forward<Handler>(handler));
+        async_prepare_statement_erased(
+            *chan,
+            stmt_sql,
+            *diag,
+            make_async_op_handler(*chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -428,7 +496,12 @@ struct close_statement_initiation
     template <class Handler>
     void operator()(Handler&& handler, channel* chan, statement stmt, diagnostics* diag)
     {
-        async_close_statement_erased(*chan, stmt, *diag, std::forward<Handler>(handler));
+        async_close_statement_erased(
+            *chan,
+            stmt,
+            *diag,
+            make_async_op_handler(*chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -460,6 +533,89 @@ async_close_statement_interface(
     );
 }
 
+//
+// execute_prepared_once
+//
+BOOST_MYSQL_DECL
+void execute_prepared_once_erased(
+    channel& chan,
+    string_view sql,
+    span<const field_view> params,
+    execution_processor& proc,
+    error_code& err,
+    diagnostics& diag
+);
+
+BOOST_MYSQL_DECL
+void async_execute_prepared_once_erased(
+    channel& chan,
+    string_view sql,
+    span<const field_view> params,
+    execution_processor& proc,
+    diagnostics& diag,
+    any_void_handler handler
+);
+
+struct initiate_execute_prepared_once
+{
+    template <class Handler, class WritableFieldTuple>
+    void operator()(
+        Handler&& handler,
+        channel& chan,
+        string_view sql,
+        const WritableFieldTuple& params,
+        execution_processor& proc,
+        diagnostics& diag
+    )
+    {
+        auto params_arr = tuple_to_array(params);
+        async_execute_prepared_once_erased(
+            chan,
+            sql,
+            params_arr,
+            proc,
+            diag,
+            make_async_op_handler(chan, std::forward<Handler>(handler))
+        );
+    }
+};
+
+template <class WritableFieldTuple, class ResultsType>
+void execute_prepared_once_interface(
+    channel& chan,
+    string_view sql,
+    const WritableFieldTuple& params,
+    ResultsType& result,
+    error_code& err,
+    diagnostics& diag
+)
+{
+    auto params_arr = tuple_to_array(params);
+    execute_prepared_once_erased(chan, sql, params_arr, access::get_impl(result).get_interface(), err, diag);
+}
+
+template <class WritableFieldTuple, class ResultsType, class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+async_execute_prepared_once_interface(
+    channel& chan,
+    string_view sql,
+    WritableFieldTuple&& params,
+    ResultsType& result,
+    diagnostics& diag,
+    CompletionToken&& token
+)
+{
+    return asio::async_initiate<CompletionToken, void(error_code)>(
+        initiate_execute_prepared_once(),
+        token,
+        std::ref(chan),
+        sql,
+        std::forward<WritableFieldTuple>(params),
+        std::ref(access::get_impl(result).get_interface()),
+        std::ref(diag)
+    );
+}
+
 //
 // read_some_rows (dynamic)
 //
@@ -483,7 +639,12 @@ struct read_some_rows_dynamic_initiation
     template <class Handler>
     void operator()(Handler&& handler, channel* chan, execution_state_impl* st, diagnostics* diag)
     {
-        async_read_some_rows_dynamic_erased(*chan, *st, *diag, std::forward<Handler>(handler));
+        async_read_some_rows_dynamic_erased(
+            *chan,
+            *st,
+            *diag,
+            make_async_op_handler(*chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -568,7 +729,13 @@ struct read_some_rows_static_initiation
         diagnostics* diag
     )
     {
-        async_read_some_rows_erased(*chan, *proc, output, *diag, std::forward<Handler>(handler));
+        async_read_some_rows_erased(
+            *chan,
+            *proc,
+            output,
+            *diag,
+            make_async_op_handler(*chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -633,7 +800,12 @@ struct read_resultset_head_initiation
     template <class Handler>
     void operator()(Handler&& handler, channel* chan, execution_processor* proc, diagnostics* diag)
     {
-        async_read_resultset_head_erased(*chan, *proc, *diag, std::forward<Handler>(handler));
+        async_read_resultset_head_erased(
+            *chan,
+            *proc,
+            *diag,
+            make_async_op_handler(*chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -669,7 +841,7 @@ struct ping_initiation
     template <class Handler>
     void operator()(Handler&& handler, channel* chan, diagnostics* diag)
     {
-        async_ping_erased(*chan, *diag, std::forward<Handler>(handler));
+        async_ping_erased(*chan, *diag, make_async_op_handler(*chan, std::forward<Handler>(handler)));
     }
 };
 
@@ -699,7 +871,11 @@ struct close_connection_initiation
     template <class Handler>
     void operator()(Handler&& handler, channel* chan, diagnostics* diag)
     {
-        async_close_connection_erased(*chan, *diag, std::forward<Handler>(handler));
+        async_close_connection_erased(
+            *chan,
+            *diag,
+            make_async_op_handler(*chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -734,7 +910,11 @@ struct quit_connection_initiation
     template <class Handler>
     void operator()(Handler&& handler, channel* chan, diagnostics* diag)
     {
-        async_quit_connection_erased(*chan, *diag, std::forward<Handler>(handler));
+        async_quit_connection_erased(
+            *chan,
+            *diag,
+            make_async_op_handler(*chan, std::forward<Handler>(handler))
+        );
     }
 };
 
@@ -757,6 +937,30 @@ async_quit_connection_interface(channel& chan, diagnostics& diag, CompletionToke
 
 }  // namespace detail
 }  // namespace mysql
+
+namespace asio {
+
+template <template <class, class> class Associator, class Handler, class DefaultCandidate>
+struct associator<Associator, mysql::detail::async_op_handler<Handler>, DefaultCandidate>
+    : Associator<Handler, DefaultCandidate>
+{
+    static typename Associator<Handler, DefaultCandidate>::type get(
+        const mysql::detail::async_op_handler<Handler>& h
+    ) noexcept
+    {
+        return Associator<Handler, DefaultCandidate>::get(h.get());
+    }
+
+    static typename Associator<Handler, DefaultCandidate>::type get(
+        const mysql::detail::async_op_handler<Handler>& h,
+        const DefaultCandidate& c
+    ) noexcept
+    {
+        return Associator<Handler, DefaultCandidate>::get(h.get(), c);
+    }
+};
+
+}  // namespace asio
 }  // namespace boost
 
 #ifdef BOOST_MYSQL_HEADER_ONLY
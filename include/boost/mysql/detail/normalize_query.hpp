@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_NORMALIZE_QUERY_HPP
+#define BOOST_MYSQL_DETAIL_NORMALIZE_QUERY_HPP
+
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Transforms SQL text into a canonical form, so that queries differing only
+// in literal values get the same text. Tokens are separated by a single space,
+// comments are removed, literals (strings, numbers, hex and bit values) are replaced
+// by ? and comma-separated lists of literals are replaced by a single "...".
+// Identifiers and keywords are left as-is. output is cleared before writing.
+BOOST_MYSQL_DECL
+void normalize_query(string_view query, std::string& output);
+
+// 64-bit FNV-1a hash. seed allows chaining several calls
+inline std::uint64_t fnv1a_hash(string_view data, std::uint64_t seed = 0xcbf29ce484222325u) noexcept
+{
+    for (char c : data)
+    {
+        seed ^= static_cast<unsigned char>(c);
+        seed *= 0x100000001b3u;
+    }
+    return seed;
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/normalize_query.ipp>
+#endif
+
+#endif
@@ -11,6 +11,7 @@
 #include <boost/mysql/field_view.hpp>
 
 #include <boost/mysql/detail/config.hpp>
+#include <boost/mysql/detail/memory_accounting.hpp>
 
 #include <boost/core/span.hpp>
 
@@ -60,7 +61,16 @@ public:
     // Adds new default constructed fields to provide storage to deserialization
     span<field_view> add_fields(std::size_t num_fields)
     {
-        return ::boost::mysql::detail::add_fields(fields_, num_fields);
+        auto res = ::boost::mysql::detail::add_fields(fields_, num_fields);
+        update_accounted_memory();
+        return res;
+    }
+
+    // Removes the last num_fields fields, used by execute to discard filtered rows
+    void remove_last_fields(std::size_t num_fields) noexcept
+    {
+        BOOST_ASSERT(num_fields <= fields_.size());
+        fields_.resize(fields_.size() - num_fields);
     }
 
     // Saves strings in the [first, first+num_fields) range into the string buffer, used by execute
@@ -79,9 +89,22 @@ public:
         string_buffer_.clear();
     }
 
+    // Dynamic memory owned by this object, in bytes
+    std::size_t memory_usage() const noexcept
+    {
+        return vector_memory_usage(fields_) + vector_memory_usage(string_buffer_);
+    }
+
 private:
     std::vector<field_view> fields_;
     std::vector<unsigned char> string_buffer_;
+#ifdef BOOST_MYSQL_ENABLE_MEMORY_ACCOUNTING
+    memory_account accounted_;
+
+    void update_accounted_memory() noexcept { accounted_.update(memory_usage()); }
+#else
+    void update_accounted_memory() noexcept {}
+#endif
 };
 
 }  // namespace detail
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_SERVER_NETWORK_ALGORITHMS_HPP
+#define BOOST_MYSQL_DETAIL_SERVER_NETWORK_ALGORITHMS_HPP
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/server_command.hpp>
+#include <boost/mysql/server_messages.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+#include <boost/mysql/detail/network_algorithms.hpp>
+
+#include <boost/asio/async_result.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+class server_session;
+
+//
+// handshake
+//
+BOOST_MYSQL_DECL
+void server_handshake_erased(server_session& sess, const server_handshake_params& params, error_code& err);
+
+BOOST_MYSQL_DECL
+void async_server_handshake_erased(
+    server_session& sess,
+    const server_handshake_params& params,
+    any_void_handler handler
+);
+
+struct server_handshake_initiation
+{
+    template <class Handler>
+    void operator()(Handler&& handler, server_session* sess, server_handshake_params params)
+    {
+        async_server_handshake_erased(*sess, params, std::forward<Handler>(handler));
+    }
+};
+
+inline void server_handshake_interface(
+    server_session& sess,
+    const server_handshake_params& params,
+    error_code& err
+)
+{
+    server_handshake_erased(sess, params, err);
+}
+
+template <class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+async_server_handshake_interface(
+    server_session& sess,
+    const server_handshake_params& params,
+    CompletionToken&& token
+)
+{
+    return asio::async_initiate<CompletionToken, void(error_code)>(
+        server_handshake_initiation(),
+        token,
+        &sess,
+        params
+    );
+}
+
+//
+// read command
+//
+BOOST_MYSQL_DECL
+server_command server_read_command_erased(server_session& sess, error_code& err);
+
+BOOST_MYSQL_DECL
+void async_server_read_command_erased(server_session& sess, any_handler<server_command> handler);
+
+struct server_read_command_initiation
+{
+    template <class Handler>
+    void operator()(Handler&& handler, server_session* sess)
+    {
+        async_server_read_command_erased(*sess, std::forward<Handler>(handler));
+    }
+};
+
+inline server_command server_read_command_interface(server_session& sess, error_code& err)
+{
+    return server_read_command_erased(sess, err);
+}
+
+template <class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, server_command))
+async_server_read_command_interface(server_session& sess, CompletionToken&& token)
+{
+    return asio::async_initiate<CompletionToken, void(error_code, server_command)>(
+        server_read_command_initiation(),
+        token,
+        &sess
+    );
+}
+
+//
+// flush
+//
+BOOST_MYSQL_DECL
+void server_flush_erased(server_session& sess, error_code& err);
+
+BOOST_MYSQL_DECL
+void async_server_flush_erased(server_session& sess, any_void_handler handler);
+
+struct server_flush_initiation
+{
+    template <class Handler>
+    void operator()(Handler&& handler, server_session* sess)
+    {
+        async_server_flush_erased(*sess, std::forward<Handler>(handler));
+    }
+};
+
+inline void server_flush_interface(server_session& sess, error_code& err) { server_flush_erased(sess, err); }
+
+template <class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+async_server_flush_interface(server_session& sess, CompletionToken&& token)
+{
+    return asio::async_initiate<CompletionToken, void(error_code)>(server_flush_initiation(), token, &sess);
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/server_network_algorithms.ipp>
+#endif
+
+#endif
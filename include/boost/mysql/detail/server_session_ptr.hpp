@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_SERVER_SESSION_PTR_HPP
+#define BOOST_MYSQL_DETAIL_SERVER_SESSION_PTR_HPP
+
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/rows_view.hpp>
+#include <boost/mysql/server_messages.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/any_stream.hpp>
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/core/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+class server_session;
+
+class server_session_ptr
+{
+    std::unique_ptr<server_session> sess_;
+
+    BOOST_MYSQL_DECL any_stream& get_stream() const;
+
+public:
+    BOOST_MYSQL_DECL server_session_ptr(std::size_t read_buff_size, std::unique_ptr<any_stream>);
+    server_session_ptr(const server_session_ptr&) = delete;
+    BOOST_MYSQL_DECL server_session_ptr(server_session_ptr&&) noexcept;
+    server_session_ptr& operator=(const server_session_ptr&) = delete;
+    BOOST_MYSQL_DECL server_session_ptr& operator=(server_session_ptr&&) noexcept;
+    BOOST_MYSQL_DECL ~server_session_ptr();
+
+    any_stream& stream() noexcept { return get_stream(); }
+    const any_stream& stream() const noexcept { return get_stream(); }
+
+    server_session& get() noexcept
+    {
+        BOOST_ASSERT(sess_);
+        return *sess_;
+    }
+    const server_session& get() const noexcept
+    {
+        BOOST_ASSERT(sess_);
+        return *sess_;
+    }
+
+    BOOST_MYSQL_DECL const server_login& login() const noexcept;
+    BOOST_MYSQL_DECL bool check_password(string_view password) const;
+    BOOST_MYSQL_DECL void add_ok(const server_ok& ok);
+    BOOST_MYSQL_DECL void add_error(std::uint16_t code, string_view message);
+    BOOST_MYSQL_DECL void add_prepare_ok(
+        std::uint32_t statement_id,
+        span<const server_column> params,
+        span<const server_column> columns
+    );
+    BOOST_MYSQL_DECL void add_resultset_head(span<const server_column> columns);
+    BOOST_MYSQL_DECL void add_row(span<const field_view> fields);
+    BOOST_MYSQL_DECL void add_rows(rows_view rows);
+    BOOST_MYSQL_DECL void add_resultset_end(const server_ok& ok);
+    BOOST_MYSQL_DECL std::size_t pending_bytes() const noexcept;
+};
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/server_session_ptr.ipp>
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_DETAIL_WORK_STEALING_DEQUE_HPP
+#define BOOST_MYSQL_DETAIL_WORK_STEALING_DEQUE_HPP
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// A bounded Chase-Lev deque of pointers. Only the owner thread may push, while any thread
+// (including the owner) may steal. As both the owner and thieves take elements from the top,
+// elements are consumed in the order they were pushed. The buffer doesn't grow:
+// push() fails if the deque is full.
+template <class T>
+class work_stealing_deque
+{
+    std::unique_ptr<std::atomic<T*>[]> buffer_;
+    std::int64_t mask_;
+    std::atomic<std::int64_t> top_{0};
+    std::atomic<std::int64_t> bottom_{0};
+
+    static std::size_t round_capacity(std::size_t v) noexcept
+    {
+        std::size_t res = 1;
+        while (res < v)
+            res <<= 1;
+        return res;
+    }
+
+public:
+    // capacity is rounded up to a power of two
+    explicit work_stealing_deque(std::size_t capacity)
+        : buffer_(new std::atomic<T*>[round_capacity(capacity)]),
+          mask_(static_cast<std::int64_t>(round_capacity(capacity)) - 1)
+    {
+        for (std::int64_t i = 0; i <= mask_; ++i)
+            buffer_[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const noexcept { return static_cast<std::size_t>(mask_ + 1); }
+
+    // Approximate when called concurrently with other operations
+    std::size_t size() const noexcept
+    {
+        auto b = bottom_.load(std::memory_order_relaxed);
+        auto t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0u;
+    }
+
+    // Owner only
+    bool push(T* value) noexcept
+    {
+        BOOST_ASSERT(value != nullptr);
+        auto b = bottom_.load(std::memory_order_relaxed);
+        auto t = top_.load(std::memory_order_acquire);
+        if (b - t > mask_)
+            return false;
+        buffer_[b & mask_].store(value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Any thread. Returns nullptr if the deque is empty or another thread took the element first
+    T* steal() noexcept
+    {
+        auto t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto b = bottom_.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+        T* res = buffer_[t & mask_].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return res;
+    }
+};
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -9,6 +9,7 @@
 #define BOOST_MYSQL_EXECUTION_STATE_HPP
 
 #include <boost/mysql/metadata_collection_view.hpp>
+#include <boost/mysql/row_filter.hpp>
 #include <boost/mysql/string_view.hpp>
 
 #include <boost/mysql/detail/access.hpp>
@@ -16,6 +17,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 namespace boost {
 namespace mysql {
@@ -207,6 +209,37 @@ public:
      */
     bool is_out_params() const noexcept { return impl_.get_is_out_params(); }
 
+    /**
+     * \brief Sets the filter that rows must match to be returned by \ref connection::read_some_rows.
+     * \details
+     * Rows read by subsequent \ref connection::read_some_rows operations using this object
+     * are checked against `filter` as soon as they are deserialized. Rows not matching it
+     * are discarded. Note that \ref connection::read_some_rows may then return an empty
+     * collection even if `this->complete() == false`. The filter only applies to the first resultset,
+     * and never to OUT parameters, which are always returned. Pass an empty \ref row_filter to
+     * return all rows again.
+     * \n
+     * The filter is kept when `*this` is reused for other operations.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    void set_row_filter(row_filter filter) noexcept { impl_.set_row_filter(std::move(filter)); }
+
+    /**
+     * \brief Returns the dynamic memory owned by this object, in bytes.
+     * \details
+     * Includes the storage for metadata and info strings, measured as allocated capacity.
+     * Rows are not stored by this class, so they are not included. Doesn't include `sizeof(*this)`.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Complexity
+     * Linear on the number of columns.
+     */
+    std::size_t memory_usage() const noexcept { return impl_.memory_usage(); }
+
 private:
     detail::execution_state_impl impl_;
 
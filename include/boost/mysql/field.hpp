@@ -949,9 +949,33 @@ inline bool operator!=(const field& lhs, const field_view& rhs) noexcept { retur
 BOOST_MYSQL_DECL
 std::ostream& operator<<(std::ostream& os, const field& v);
 
+/**
+ * \relates field
+ * \brief Computes a hash value for a `field`.
+ * \details The same considerations as \ref hash_value(const field_view&) apply.
+ *
+ * \par Exception safety
+ * No-throw guarantee.
+ */
+inline std::size_t hash_value(const field& v) noexcept { return hash_value(field_view(v)); }
+
 }  // namespace mysql
 }  // namespace boost
 
+namespace std {
+
+/// Allows using \ref boost::mysql::field as a key in unordered containers.
+template <>
+struct hash<::boost::mysql::field>
+{
+    std::size_t operator()(const ::boost::mysql::field& v) const noexcept
+    {
+        return ::boost::mysql::hash_value(v);
+    }
+};
+
+}  // namespace std
+
 #ifdef BOOST_MYSQL_HEADER_ONLY
 #include <boost/mysql/impl/field.ipp>
 #endif
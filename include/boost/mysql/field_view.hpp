@@ -24,6 +24,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 
 namespace boost {
@@ -601,9 +602,41 @@ private:
 BOOST_MYSQL_DECL
 std::ostream& operator<<(std::ostream& os, const field_view& v);
 
+/**
+ * \relates field_view
+ * \brief Computes a hash value for a `field_view`.
+ * \details
+ * The hash is consistent with \ref field_view::operator==: fields comparing equal
+ * have the same hash. In particular, `INT64` and `UINT64` fields holding the same
+ * value hash equally, and so do positive and negative floating point zeros.
+ * Hash values are not stable across library versions.
+ *
+ * \par Exception safety
+ * No-throw guarantee.
+ *
+ * \par Complexity
+ * Linear in the size of the field, for strings and blobs. Constant otherwise.
+ */
+BOOST_MYSQL_DECL
+std::size_t hash_value(const field_view& v) noexcept;
+
 }  // namespace mysql
 }  // namespace boost
 
+namespace std {
+
+/// Allows using \ref boost::mysql::field_view as a key in unordered containers.
+template <>
+struct hash<::boost::mysql::field_view>
+{
+    std::size_t operator()(const ::boost::mysql::field_view& v) const noexcept
+    {
+        return ::boost::mysql::hash_value(v);
+    }
+};
+
+}  // namespace std
+
 #include <boost/mysql/impl/field_view.hpp>
 #ifdef BOOST_MYSQL_HEADER_ONLY
 #include <boost/mysql/impl/field_view.ipp>
@@ -0,0 +1,308 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_HASH_INDEX_HPP
+#define BOOST_MYSQL_HASH_INDEX_HPP
+
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/row_view.hpp>
+#include <boost/mysql/rows_view.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+#include <boost/mysql/detail/hash.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/core/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief A hash index over a collection of rows, by one or more key columns.
+ * \details
+ * Allows looking up the rows whose key columns match a given key in constant expected time,
+ * and joining two resultsets without copying their keys. A typical hash join builds
+ * an index over the smaller resultset and probes it with every row in the bigger one:
+ * \n
+ * \code
+ * hash_index idx(customers.rows(), {0}); // customers.id
+ * for (row_view order : orders.rows())
+ * {
+ *     for (row_view customer : idx.find(order, {1})) // orders.customer_id
+ *     {
+ *         // ...
+ *     }
+ * }
+ * \endcode
+ * \n
+ * Keys are compared using \ref field_view::operator==. In particular, `NULL` values
+ * match other `NULL` values, unlike in SQL, and `INT64` and `UINT64` values match if they
+ * hold the same number.
+ * \n
+ * The index is built using open addressing with linear probing. Each slot holds part of the key's
+ * hash and the position of the first matching row, and rows with duplicate keys are chained
+ * using a separate array. Building the index performs a constant number of allocations, and
+ * lookups don't allocate.
+ * \n
+ * The index references the rows it's built from, which must be kept alive and unmodified
+ * while it's in use. Iterators and ranges returned by \ref find are invalidated when
+ * the index is destroyed or assigned to.
+ */
+class hash_index
+{
+    struct slot
+    {
+        std::uint32_t tag;   // upper bits of the key's hash
+        std::uint32_t head;  // index of the first row with this key, plus one. Zero means empty
+    };
+
+    static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+    rows_view rows_;
+    std::vector<std::size_t> key_columns_;
+    std::vector<slot> slots_;         // size is zero or a power of two
+    std::vector<std::uint32_t> next_;  // next row with the same key, or npos
+    std::size_t num_keys_{};
+
+    BOOST_MYSQL_DECL
+    void build();
+
+    template <class KeyGetter>
+    std::uint32_t find_impl(std::size_t hash, KeyGetter key) const noexcept;
+
+public:
+#ifndef BOOST_MYSQL_DOXYGEN
+    class match_range;
+#endif
+
+    /**
+     * \brief A forward iterator over the rows matching a key.
+     * \details Dereferencing it yields a \ref row_view. Rows are visited in the order they
+     * appear in \ref rows.
+     */
+    class iterator
+    {
+        const hash_index* idx_{};
+        std::uint32_t row_{npos};
+
+        iterator(const hash_index* idx, std::uint32_t row) noexcept : idx_(idx), row_(row) {}
+        friend class hash_index;
+        friend class match_range;
+
+    public:
+        using value_type = row_view;
+        using reference = row_view;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        /// Default constructor.
+        iterator() = default;
+
+        /// Returns the matching row.
+        row_view operator*() const noexcept { return idx_->rows_[row_]; }
+
+        /// Returns the position of the matching row in \ref hash_index::rows.
+        std::size_t index() const noexcept { return row_; }
+
+        /// Advances to the next matching row.
+        iterator& operator++() noexcept
+        {
+            row_ = idx_->next_[row_];
+            return *this;
+        }
+
+        /// Advances to the next matching row.
+        iterator operator++(int) noexcept
+        {
+            auto res = *this;
+            ++(*this);
+            return res;
+        }
+
+        /// Equality comparison.
+        bool operator==(const iterator& rhs) const noexcept { return row_ == rhs.row_; }
+
+        /// Inequality comparison.
+        bool operator!=(const iterator& rhs) const noexcept { return row_ != rhs.row_; }
+    };
+
+    /**
+     * \brief The rows matching a key, as returned by \ref find.
+     */
+    class match_range
+    {
+        iterator first_;
+
+        match_range(iterator first) noexcept : first_(first) {}
+        friend class hash_index;
+
+    public:
+        /// Default constructor. Constructs an empty range.
+        match_range() = default;
+
+        /// Returns an iterator to the first matching row.
+        iterator begin() const noexcept { return first_; }
+
+        /// Returns an iterator one-past the last matching row.
+        iterator end() const noexcept { return iterator(first_.idx_, npos); }
+
+        /// Returns `true` if no rows matched.
+        bool empty() const noexcept { return first_.row_ == npos; }
+
+        /**
+         * \brief Returns the first matching row.
+         * \par Preconditions
+         * `!this->empty()`
+         */
+        row_view front() const noexcept
+        {
+            BOOST_ASSERT(!empty());
+            return *first_;
+        }
+
+        /**
+         * \brief Returns the number of matching rows.
+         * \par Complexity
+         * Linear in the number of matching rows.
+         */
+        std::size_t size() const noexcept
+        {
+            std::size_t res = 0;
+            for (auto it = begin(); it != end(); ++it)
+                ++res;
+            return res;
+        }
+    };
+
+    /**
+     * \brief Default constructor.
+     * \details Constructs an empty index with no key columns. Lookups on it never match.
+     */
+    hash_index() = default;
+
+    /**
+     * \brief Builds an index over `rows`, using `key_columns` as key.
+     * \details
+     * `key_columns` contains zero-based column positions, as they appear in `rows`.
+     * `rows` is not copied, and must outlive the index.
+     *
+     * \par Preconditions
+     * `!key_columns.empty()`, and every element in `key_columns` is less than `rows.num_columns()`
+     * (unless `rows` is empty).
+     *
+     * \par Exception safety
+     * Strong guarantee. Throws `std::length_error` if `rows` contains `2^32 - 1` rows or more.
+     *
+     * \par Complexity
+     * Linear in `rows.size()`.
+     */
+    hash_index(rows_view rows, span<const std::size_t> key_columns)
+        : rows_(rows), key_columns_(key_columns.begin(), key_columns.end())
+    {
+        build();
+    }
+
+    /// \copydoc hash_index(rows_view,span<const std::size_t>)
+    hash_index(rows_view rows, std::initializer_list<std::size_t> key_columns)
+        : rows_(rows), key_columns_(key_columns)
+    {
+        build();
+    }
+
+    /// Returns the rows this index was built from.
+    rows_view rows() const noexcept { return rows_; }
+
+    /// Returns the key columns this index was built with.
+    span<const std::size_t> key_columns() const noexcept { return key_columns_; }
+
+    /// Returns the number of indexed rows.
+    std::size_t size() const noexcept { return next_.size(); }
+
+    /// Returns the number of distinct keys in the index.
+    std::size_t num_keys() const noexcept { return num_keys_; }
+
+    /**
+     * \brief Looks up the rows matching a key.
+     * \details
+     * `key[i]` is compared to the column `key_columns()[i]` of every row.
+     *
+     * \par Preconditions
+     * `key.size() == this->key_columns().size()`
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Complexity
+     * Constant expected time.
+     */
+    BOOST_MYSQL_DECL
+    match_range find(span<const field_view> key) const noexcept;
+
+    /// \copydoc find(span<const field_view>) const
+    match_range find(std::initializer_list<field_view> key) const noexcept
+    {
+        return find(span<const field_view>(key.begin(), key.size()));
+    }
+
+    /**
+     * \brief Looks up the rows matching the key projected from another row.
+     * \details
+     * Equivalent to building a key with the fields of `probe` at positions `probe_columns`
+     * and calling \ref find. This is the operation performed by hash joins.
+     *
+     * \par Preconditions
+     * `probe_columns.size() == this->key_columns().size()`, and every element
+     * in `probe_columns` is less than `probe.size()`.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Complexity
+     * Constant expected time.
+     */
+    BOOST_MYSQL_DECL
+    match_range find(row_view probe, span<const std::size_t> probe_columns) const noexcept;
+
+    /// \copydoc find(row_view,span<const std::size_t>) const
+    match_range find(row_view probe, std::initializer_list<std::size_t> probe_columns) const noexcept
+    {
+        return find(probe, span<const std::size_t>(probe_columns.begin(), probe_columns.size()));
+    }
+
+    /**
+     * \brief Computes the hash of a key.
+     * \details
+     * The result is the same as \ref hash_value(const row_view&) for a row
+     * containing the fields in `key`.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    static std::size_t hash_key(span<const field_view> key) noexcept
+    {
+        std::size_t res = key.size();
+        for (const field_view& f : key)
+            res = detail::hash_combine(res, hash_value(f));
+        return res;
+    }
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/hash_index.ipp>
+#endif
+
+#endif
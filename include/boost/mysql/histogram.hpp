@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_HISTOGRAM_HPP
+#define BOOST_MYSQL_HISTOGRAM_HPP
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/core/bit.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/// Number of linear sub-buckets per power of two in a \ref histogram, as a power of two.
+constexpr unsigned histogram_precision_bits = 3;
+
+/// Number of buckets in a \ref histogram.
+constexpr std::size_t histogram_num_buckets = (1u << histogram_precision_bits) *
+                                              (64 - histogram_precision_bits + 1);
+
+/**
+ * \brief A point-in-time copy of a \ref histogram.
+ * \details
+ * Contains the count for each bucket, as defined by \ref histogram, together
+ * with the number, sum and maximum of the recorded values.
+ * Snapshots can be merged to aggregate several histograms.
+ */
+class histogram_snapshot
+{
+    std::vector<std::uint64_t> buckets_;
+    std::uint64_t count_{};
+    std::uint64_t sum_{};
+    std::uint64_t max_{};
+
+    friend class histogram;
+
+public:
+    /**
+     * \brief Constructs an empty snapshot.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    histogram_snapshot() = default;
+
+    /// Returns the number of recorded values.
+    std::uint64_t count() const noexcept { return count_; }
+
+    /// Returns the sum of the recorded values. Wraps around on overflow.
+    std::uint64_t sum() const noexcept { return sum_; }
+
+    /// Returns the maximum recorded value, or zero if the snapshot is empty.
+    std::uint64_t max() const noexcept { return max_; }
+
+    /**
+     * \brief Returns the number of values recorded in each bucket.
+     * \details
+     * The returned vector is either empty (if no values were recorded) or has
+     * \ref histogram_num_buckets elements.
+     */
+    const std::vector<std::uint64_t>& bucket_counts() const noexcept { return buckets_; }
+
+    /**
+     * \brief Estimates the value at a given quantile.
+     * \details
+     * Returns the upper bound of the bucket where the value at quantile `q` lies,
+     * capped to \ref max. `q` is clamped to the `[0, 1]` range. Returns zero for empty snapshots.
+     * The relative error is bounded by the bucket width (see \ref histogram).
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    BOOST_MYSQL_DECL
+    std::uint64_t value_at_quantile(double q) const noexcept;
+
+    /**
+     * \brief Adds the values recorded in another snapshot to `*this`.
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    BOOST_MYSQL_DECL
+    void merge(const histogram_snapshot& other);
+};
+
+/**
+ * \brief A thread-safe, fixed-size histogram with logarithmic buckets.
+ * \details
+ * Values are unsigned 64-bit integers. Buckets follow a log-linear layout, like
+ * HDR histograms: values below 8 get a bucket each, and every power of two
+ * above that is split into 8 equal-width buckets. This keeps the relative error
+ * of any reported value below 12.5% across the full 64-bit range, using
+ * a fixed amount of memory and no allocations.
+ * \n
+ * \ref record is lock-free and wait-free on platforms with native 64-bit atomics,
+ * so a single histogram can be shared between threads. \ref snapshot reads the counters
+ * without synchronizing with writers, so a snapshot taken while values are being
+ * recorded may include some of them partially (e.g. in the count but not the sum).
+ * \n
+ * The maximum value is exact if values are recorded by a single thread at a time. Threads recording
+ * concurrently may overwrite each other's maximum. In this case, \ref snapshot reports the lower
+ * bound of the highest non-empty bucket, so the error is bounded by the bucket width.
+ * \n
+ * Histograms are neither copyable nor movable. Use \ref snapshot to get a copy.
+ */
+class histogram
+{
+public:
+    /**
+     * \brief Constructs an empty histogram.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    histogram() noexcept { reset(); }
+
+    histogram(const histogram&) = delete;
+    histogram& operator=(const histogram&) = delete;
+
+    /**
+     * \brief Records a value.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    void record(std::uint64_t value) noexcept
+    {
+        buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        // A compare-exchange loop would make this lock-free but not wait-free.
+        // Updates lost due to concurrent writers are compensated for by snapshot()
+        if (value > max_.load(std::memory_order_relaxed))
+            max_.store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Sets all counters to zero.
+     * \details
+     * Not atomic with respect to concurrent calls to \ref record.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    void reset() noexcept
+    {
+        for (auto& b : buckets_)
+            b.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Returns a copy of the current counters.
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    BOOST_MYSQL_DECL
+    histogram_snapshot snapshot() const;
+
+    /// Returns the index of the bucket where `value` would be recorded.
+    static std::size_t bucket_index(std::uint64_t value) noexcept
+    {
+        constexpr std::uint64_t linear_limit = 1u << histogram_precision_bits;
+        if (value < linear_limit)
+            return static_cast<std::size_t>(value);
+        unsigned exponent = 63u - static_cast<unsigned>(core::countl_zero(value));
+        unsigned shift = exponent - histogram_precision_bits;
+        auto sub = static_cast<std::size_t>((value >> shift) & (linear_limit - 1));
+        return linear_limit + shift * linear_limit + sub;
+    }
+
+    /// Returns the smallest value that would be recorded in the bucket with index `idx`.
+    static std::uint64_t bucket_lower_bound(std::size_t idx) noexcept
+    {
+        BOOST_ASSERT(idx < histogram_num_buckets);
+        constexpr std::size_t linear_limit = 1u << histogram_precision_bits;
+        if (idx < linear_limit)
+            return idx;
+        std::size_t shift = (idx - linear_limit) / linear_limit;
+        std::size_t sub = (idx - linear_limit) % linear_limit;
+        return static_cast<std::uint64_t>(linear_limit + sub) << shift;
+    }
+
+    /// Returns the largest value that would be recorded in the bucket with index `idx`.
+    static std::uint64_t bucket_upper_bound(std::size_t idx) noexcept
+    {
+        BOOST_ASSERT(idx < histogram_num_buckets);
+        constexpr std::size_t linear_limit = 1u << histogram_precision_bits;
+        if (idx < linear_limit)
+            return idx;
+        std::size_t shift = (idx - linear_limit) / linear_limit;
+        return bucket_lower_bound(idx) + ((std::uint64_t(1) << shift) - 1u);
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, histogram_num_buckets> buckets_;
+    std::atomic<std::uint64_t> sum_;
+    std::atomic<std::uint64_t> max_;
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/histogram.ipp>
+#endif
+
+#endif
@@ -0,0 +1,71 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_AUTH_PLUGIN_CACHE_IPP
+#define BOOST_MYSQL_IMPL_AUTH_PLUGIN_CACHE_IPP
+
+#pragma once
+
+#include <boost/mysql/auth_plugin_cache.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Addresses are prefixed by their size, so different (address, username) pairs
+// never produce the same key
+BOOST_MYSQL_STATIC_OR_INLINE
+std::string auth_plugin_cache_key(string_view server_address, string_view username)
+{
+    std::string res;
+    res.reserve(sizeof(std::size_t) + server_address.size() + username.size());
+    std::size_t address_size = server_address.size();
+    res.append(reinterpret_cast<const char*>(&address_size), sizeof(address_size));
+    res.append(server_address.data(), server_address.size());
+    res.append(username.data(), username.size());
+    return res;
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+boost::mysql::string_view boost::mysql::detail::auth_plugin_cache_impl::find(
+    string_view server_address,
+    string_view username
+) const
+{
+    auto key = auth_plugin_cache_key(server_address, username);
+    std::lock_guard<std::mutex> guard(mtx_);
+    auto it = entries_.find(key);
+    return it == entries_.end() ? string_view() : it->second;
+}
+
+void boost::mysql::detail::auth_plugin_cache_impl::store(
+    string_view server_address,
+    string_view username,
+    string_view plugin_name
+)
+{
+    auto key = auth_plugin_cache_key(server_address, username);
+    std::lock_guard<std::mutex> guard(mtx_);
+    entries_[std::move(key)] = plugin_name;
+}
+
+std::size_t boost::mysql::detail::auth_plugin_cache_impl::size() const
+{
+    std::lock_guard<std::mutex> guard(mtx_);
+    return entries_.size();
+}
+
+void boost::mysql::detail::auth_plugin_cache_impl::clear()
+{
+    std::lock_guard<std::mutex> guard(mtx_);
+    entries_.clear();
+}
+
+#endif
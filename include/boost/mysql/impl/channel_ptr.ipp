@@ -46,6 +46,75 @@ boost::mysql::diagnostics& boost::mysql::detail::channel_ptr::shared_diag() noex
     return chan_->shared_diag();
 }
 
+boost::mysql::connection_stats boost::mysql::detail::channel_ptr::stats() const noexcept
+{
+    return chan_->stats();
+}
+
+boost::mysql::connection_memory_usage boost::mysql::detail::channel_ptr::memory_usage() const noexcept
+{
+    return chan_->memory_usage();
+}
+
+boost::mysql::operation_observer* boost::mysql::detail::channel_ptr::observer() const noexcept
+{
+    return chan_->observer();
+}
+
+void boost::mysql::detail::channel_ptr::set_observer(operation_observer* v) noexcept
+{
+    chan_->set_observer(v);
+}
+
+boost::mysql::auth_plugin_cache* boost::mysql::detail::channel_ptr::auth_cache() const noexcept
+{
+    return chan_->auth_cache();
+}
+
+void boost::mysql::detail::channel_ptr::set_auth_cache(auth_plugin_cache* v) noexcept
+{
+    chan_->set_auth_cache(v);
+}
+
+std::chrono::steady_clock::duration boost::mysql::detail::channel_ptr::operation_timeout() const noexcept
+{
+    return chan_->operation_timeout();
+}
+
+void boost::mysql::detail::channel_ptr::set_operation_timeout(std::chrono::steady_clock::duration v) noexcept
+{
+    chan_->set_operation_timeout(v);
+}
+
+boost::asio::any_io_executor boost::mysql::detail::channel_ptr::tls_handshake_executor() const
+{
+    return chan_->tls_handshake_executor();
+}
+
+void boost::mysql::detail::channel_ptr::set_tls_handshake_executor(asio::any_io_executor v) noexcept
+{
+    chan_->set_tls_handshake_executor(std::move(v));
+}
+
+const boost::mysql::protocol_trace* boost::mysql::detail::channel_ptr::get_protocol_trace() const noexcept
+{
+    return chan_->get_protocol_trace();
+}
+
+void boost::mysql::detail::channel_ptr::enable_protocol_trace(std::size_t capacity)
+{
+    chan_->enable_protocol_trace(capacity);
+}
+
+void boost::mysql::detail::channel_ptr::disable_protocol_trace() noexcept { chan_->disable_protocol_trace(); }
+
+void boost::mysql::detail::channel_ptr::start_wire_capture(std::ostream& output)
+{
+    chan_->start_wire_capture(output);
+}
+
+void boost::mysql::detail::channel_ptr::stop_wire_capture() noexcept { chan_->stop_wire_capture(); }
+
 std::vector<boost::mysql::field_view>& boost::mysql::detail::get_shared_fields(channel& chan) noexcept
 {
     return chan.shared_fields();
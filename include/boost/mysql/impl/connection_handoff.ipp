@@ -0,0 +1,261 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_CONNECTION_HANDOFF_IPP
+#define BOOST_MYSQL_IMPL_CONNECTION_HANDOFF_IPP
+
+#pragma once
+
+#include <boost/mysql/connection_handoff.hpp>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <boost/mysql/client_errc.hpp>
+
+#include <boost/mysql/impl/internal/channel/channel.hpp>
+#include <boost/mysql/impl/internal/protocol/capabilities.hpp>
+#include <boost/mysql/impl/internal/protocol/db_flavor.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// The message sent along with the socket: a magic number, a format version,
+// the server flavor and the negotiated capabilities
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::size_t handoff_message_size = 8;
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::uint8_t handoff_magic[] = {0x4d, 0x59};  // "MY"
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::uint8_t handoff_version = 1;
+
+using handoff_message = std::array<std::uint8_t, handoff_message_size>;
+
+BOOST_MYSQL_STATIC_OR_INLINE
+error_code last_socket_error() noexcept { return error_code(errno, asio::error::get_system_category()); }
+
+// The handoff socket may be in non-blocking mode
+BOOST_MYSQL_STATIC_OR_INLINE
+bool wait_for_socket(int fd, short events) noexcept
+{
+    if (errno != EAGAIN && errno != EWOULDBLOCK)
+        return false;
+    pollfd pfd{fd, events, 0};
+    return ::poll(&pfd, 1, -1) >= 0 || errno == EINTR;
+}
+
+// The capabilities a connection can have negotiated during handshake. TLS connections can't be handed off
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr capabilities handoff_allowed_capabilities =
+    mandatory_capabilities | optional_capabilities |
+    capabilities(CLIENT_CONNECT_WITH_DB | CLIENT_MULTI_STATEMENTS);
+
+BOOST_MYSQL_STATIC_OR_INLINE
+bool is_valid_handoff_message(const handoff_message& msg) noexcept
+{
+    capabilities caps(endian::load_little_u32(msg.data() + 4));
+    return msg[0] == handoff_magic[0] && msg[1] == handoff_magic[1] && msg[2] == handoff_version &&
+           msg[3] <= static_cast<std::uint8_t>(db_flavor::mariadb) && caps.has_all(mandatory_capabilities) &&
+           (caps | handoff_allowed_capabilities) == handoff_allowed_capabilities;
+}
+
+// Takes ownership of the descriptors received with a message. The first one is stored
+// in connection_fd, and any other is closed, so they don't leak into this process.
+// Returns false if there was more than one
+BOOST_MYSQL_STATIC_OR_INLINE
+bool take_received_descriptors(msghdr& hdr, int& connection_fd) noexcept
+{
+    bool res = true;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+            continue;
+        std::size_t num_fds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        const unsigned char* data = CMSG_DATA(cmsg);
+        for (std::size_t i = 0; i < num_fds; ++i)
+        {
+            int fd = -1;
+            std::memcpy(&fd, data + i * sizeof(int), sizeof(int));
+            if (connection_fd == -1)
+                connection_fd = fd;
+            else
+            {
+                ::close(fd);
+                res = false;
+            }
+        }
+    }
+    return res;
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+boost::mysql::error_code boost::mysql::detail::send_connection_state(
+    channel& chan,
+    int connection_fd,
+    int handoff_fd
+)
+{
+    if (chan.stream().ssl_active())
+        return asio::error::operation_not_supported;
+
+    // Message
+    handoff_message msg{};
+    msg[0] = handoff_magic[0];
+    msg[1] = handoff_magic[1];
+    msg[2] = handoff_version;
+    msg[3] = static_cast<std::uint8_t>(chan.flavor());
+    endian::store_little_u32(msg.data() + 4, chan.current_capabilities().get());
+    iovec iov{msg.data(), msg.size()};
+
+    // File descriptor
+    union
+    {
+        char buf[CMSG_SPACE(sizeof(int))];
+        cmsghdr align;
+    } control{};
+    msghdr hdr{};
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control.buf;
+    hdr.msg_controllen = sizeof(control.buf);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &connection_fd, sizeof(int));
+
+    // The descriptor is sent with the first byte. The rest of the message may need several writes
+    std::size_t bytes_sent = 0;
+    while (bytes_sent < msg.size())
+    {
+#ifdef MSG_NOSIGNAL
+        constexpr int flags = MSG_NOSIGNAL;
+#else
+        constexpr int flags = 0;
+#endif
+        ssize_t res = bytes_sent == 0u
+                          ? ::sendmsg(handoff_fd, &hdr, flags)
+                          : ::send(handoff_fd, msg.data() + bytes_sent, msg.size() - bytes_sent, flags);
+        if (res < 0)
+        {
+            if (errno == EINTR || wait_for_socket(handoff_fd, POLLOUT))
+                continue;
+            return last_socket_error();
+        }
+        bytes_sent += static_cast<std::size_t>(res);
+    }
+    return error_code();
+}
+
+boost::mysql::error_code boost::mysql::detail::receive_connection_state(
+    channel& chan,
+    int handoff_fd,
+    int& connection_fd,
+    void* sockaddr_buffer,
+    std::size_t& sockaddr_size,
+    int& family
+)
+{
+    connection_fd = -1;
+    handoff_message msg{};
+    std::size_t bytes_read = 0;
+    error_code err;
+
+    while (bytes_read < msg.size())
+    {
+        iovec iov{msg.data() + bytes_read, msg.size() - bytes_read};
+        union
+        {
+            char buf[CMSG_SPACE(sizeof(int))];
+            cmsghdr align;
+        } control{};
+        msghdr hdr{};
+        hdr.msg_iov = &iov;
+        hdr.msg_iovlen = 1;
+        hdr.msg_control = control.buf;
+        hdr.msg_controllen = sizeof(control.buf);
+#ifdef MSG_CMSG_CLOEXEC
+        constexpr int flags = MSG_CMSG_CLOEXEC;
+#else
+        constexpr int flags = 0;
+#endif
+        ssize_t res = ::recvmsg(handoff_fd, &hdr, flags);
+        if (res < 0)
+        {
+            if (errno == EINTR || wait_for_socket(handoff_fd, POLLIN))
+                continue;
+            err = last_socket_error();
+            break;
+        }
+        else if (res == 0)
+        {
+            err = asio::error::eof;
+            break;
+        }
+        bytes_read += static_cast<std::size_t>(res);
+
+        // Retrieve the descriptor, if this chunk carried it. A truncated control message
+        // means that the sender sent more descriptors than expected, which the kernel discarded
+        bool fds_ok = take_received_descriptors(hdr, connection_fd);
+        if (!fds_ok || (hdr.msg_flags & MSG_CTRUNC))
+        {
+            err = client_errc::protocol_value_error;
+            break;
+        }
+    }
+
+    // Validate the message
+    if (!err && (connection_fd == -1 || !is_valid_handoff_message(msg)))
+        err = client_errc::protocol_value_error;
+
+    // Get the socket's address, which determines the protocol to use
+    if (!err)
+    {
+        sockaddr_storage addr{};
+        socklen_t addr_size = sizeof(addr);
+        if (::getsockname(connection_fd, reinterpret_cast<sockaddr*>(&addr), &addr_size) != 0)
+            err = last_socket_error();
+        else if (addr_size > sockaddr_size)
+            err = client_errc::protocol_value_error;
+        else
+        {
+            std::memcpy(sockaddr_buffer, &addr, addr_size);
+            sockaddr_size = addr_size;
+            family = addr.ss_family;
+        }
+    }
+
+    if (err)
+    {
+        if (connection_fd != -1)
+            close_fd(connection_fd);
+        connection_fd = -1;
+        return err;
+    }
+
+    // Set up the channel as if a handshake had just completed
+    chan.reset();
+    chan.set_flavor(static_cast<db_flavor>(msg[3]));
+    chan.set_current_capabilities(capabilities(endian::load_little_u32(msg.data() + 4)));
+    return error_code();
+}
+
+void boost::mysql::detail::close_fd(int fd) noexcept { ::close(fd); }
+
+#endif
+
+#endif
@@ -57,6 +57,8 @@ const char* error_to_string(client_errc error) noexcept
     case boost::mysql::client_errc::row_type_mismatch:
         return "The StaticRow type passed to read_some_rows does not correspond to the resultset type being "
                "read";
+    case boost::mysql::client_errc::timeout:
+        return "The operation didn't complete within the configured timeout, and the connection was closed";
 
     default: return "<unknown MySQL client error>";
     }
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <boost/mysql/detail/access.hpp>
 #include <boost/mysql/detail/execution_processor/execution_state_impl.hpp>
 #include <boost/mysql/detail/row_impl.hpp>
 
@@ -30,6 +31,9 @@ void boost::mysql::detail::execution_state_impl::reset_impl() noexcept
     meta_.clear();
     eof_data_ = ok_data();
     info_.clear();
+    num_resultsets_ = 0;
+    has_rows_ = false;
+    filtered_first_row_output_ = nullptr;
 }
 
 boost::mysql::error_code boost::mysql::detail::execution_state_impl::
@@ -64,12 +68,39 @@ boost::mysql::error_code boost::mysql::detail::execution_state_impl::on_row_impl
     span<field_view> storage = add_fields(fields, meta_.size());
 
     // deserialize the row
-    return deserialize_row(encoding(), msg, meta_, storage);
+    auto err = deserialize_row(encoding(), msg, meta_, storage);
+    if (err)
+        return err;
+
+    // discard the row if it doesn't match the filter. Filters only apply to the first resultset.
+    // A binary resultset may contain OUT params, which are never filtered, but this is only known
+    // once it finishes. They are sent as a single row, so a discarded first row is kept aside until then
+    if (num_resultsets_ == 1u && !filter_.empty() &&
+        !filter_.matches(access::construct<row_view>(storage.data(), storage.size())))
+    {
+        if (encoding() == resultset_encoding::binary && !has_rows_)
+        {
+            filtered_first_row_.assign(storage.data(), storage.size());
+            filtered_first_row_output_ = &fields;
+        }
+        fields.resize(fields.size() - storage.size());
+    }
+    has_rows_ = true;
+
+    return error_code();
 }
 
 boost::mysql::error_code boost::mysql::detail::execution_state_impl::on_row_ok_packet_impl(const ok_view& pack
 )
 {
+    // Restore OUT params discarded by the filter. They're returned with the rows read by this operation
+    if (filtered_first_row_output_ && pack.is_out_params())
+    {
+        const auto& row = filtered_first_row_.fields();
+        filtered_first_row_output_->insert(filtered_first_row_output_->end(), row.begin(), row.end());
+    }
+    filtered_first_row_output_ = nullptr;
+
     on_ok_packet_impl(pack);
     return error_code();
 }
@@ -13,7 +13,9 @@
 #include <boost/mysql/field_view.hpp>
 
 #include <boost/mysql/detail/config.hpp>
+#include <boost/mysql/detail/hash.hpp>
 
+#include <cstring>
 #include <ostream>
 
 namespace boost {
@@ -69,6 +71,43 @@ std::ostream& print_time(std::ostream& os, const boost::mysql::time& value)
     return os;
 }
 
+// Distinct seeds keep fields of different kinds from colliding systematically
+enum class hash_tag : std::uint64_t
+{
+    null = 0x6e756c6c,
+    integer,
+    string,
+    blob,
+    float_,
+    double_,
+    date,
+    datetime,
+    time,
+};
+
+BOOST_MYSQL_STATIC_OR_INLINE
+std::uint64_t hash_word(hash_tag tag, std::uint64_t value) noexcept
+{
+    return hash_mix(static_cast<std::uint64_t>(tag) * 0x9e3779b97f4a7c15u ^ value);
+}
+
+// Processes 8 bytes at a time, so long keys are cheap to hash
+BOOST_MYSQL_STATIC_OR_INLINE
+std::uint64_t hash_bytes(hash_tag tag, const unsigned char* data, std::size_t size) noexcept
+{
+    std::uint64_t res = hash_word(tag, size);
+    for (; size >= 8u; data += 8, size -= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data, 8);
+        res = hash_mix(res ^ word) * 0x9e3779b97f4a7c15u;
+    }
+    std::uint64_t last = 0;
+    for (std::size_t i = 0; i < size; ++i)
+        last |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+    return hash_mix(res ^ last);
+}
+
 }  // namespace detail
 }  // namespace mysql
 }  // namespace boost
@@ -97,4 +136,80 @@ std::ostream& boost::mysql::operator<<(std::ostream& os, const field_view& value
     }
 }
 
+std::size_t boost::mysql::hash_value(const field_view& v) noexcept
+{
+    using detail::hash_tag;
+    using detail::hash_word;
+
+    std::uint64_t res = 0;
+    switch (v.kind())
+    {
+    case field_kind::null: res = hash_word(hash_tag::null, 0); break;
+    // Non-negative int64 values compare equal to uint64 values, so they must hash equally
+    case field_kind::int64:
+        res = hash_word(hash_tag::integer, static_cast<std::uint64_t>(v.get_int64()));
+        break;
+    case field_kind::uint64: res = hash_word(hash_tag::integer, v.get_uint64()); break;
+    case field_kind::string:
+    {
+        auto s = v.get_string();
+        res = detail::hash_bytes(hash_tag::string, reinterpret_cast<const unsigned char*>(s.data()), s.size());
+        break;
+    }
+    case field_kind::blob:
+    {
+        auto b = v.get_blob();
+        res = detail::hash_bytes(hash_tag::blob, b.data(), b.size());
+        break;
+    }
+    case field_kind::float_:
+    {
+        // +0.0 == -0.0, so they must hash equally
+        float f = v.get_float();
+        if (f == 0.0f)
+            f = 0.0f;
+        std::uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        res = hash_word(hash_tag::float_, bits);
+        break;
+    }
+    case field_kind::double_:
+    {
+        double d = v.get_double();
+        if (d == 0.0)
+            d = 0.0;
+        std::uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        res = hash_word(hash_tag::double_, bits);
+        break;
+    }
+    case field_kind::date:
+    {
+        auto d = v.get_date();
+        res = hash_word(
+            hash_tag::date,
+            static_cast<std::uint64_t>(d.year()) << 16 | static_cast<std::uint64_t>(d.month()) << 8 | d.day()
+        );
+        break;
+    }
+    case field_kind::datetime:
+    {
+        auto d = v.get_datetime();
+        std::uint64_t packed = static_cast<std::uint64_t>(d.year()) << 48 |
+                               static_cast<std::uint64_t>(d.month()) << 40 |
+                               static_cast<std::uint64_t>(d.day()) << 32 |
+                               static_cast<std::uint64_t>(d.hour()) << 24 |
+                               static_cast<std::uint64_t>(d.minute()) << 16 |
+                               static_cast<std::uint64_t>(d.second());
+        res = hash_word(hash_tag::datetime, detail::hash_mix(packed) ^ d.microsecond());
+        break;
+    }
+    case field_kind::time:
+        res = hash_word(hash_tag::time, static_cast<std::uint64_t>(v.get_time().count()));
+        break;
+    default: BOOST_ASSERT(false); break;
+    }
+    return static_cast<std::size_t>(res);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_HASH_INDEX_IPP
+#define BOOST_MYSQL_IMPL_HASH_INDEX_IPP
+
+#pragma once
+
+#include <boost/mysql/hash_index.hpp>
+
+#include <boost/throw_exception.hpp>
+
+#include <stdexcept>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// The slot where probing for a hash starts, and the bits stored in the slot to
+// filter out most non-matching keys without touching the rows
+BOOST_MYSQL_STATIC_OR_INLINE
+std::uint32_t hash_index_tag(std::size_t hash) noexcept
+{
+    return static_cast<std::uint32_t>(hash >> (sizeof(std::size_t) * 4));
+}
+
+// Keeps the load factor between 0.25 and 0.5
+BOOST_MYSQL_STATIC_OR_INLINE
+std::size_t hash_index_capacity(std::size_t num_rows) noexcept
+{
+    std::size_t res = 8;
+    while (res < num_rows * 2)
+        res *= 2;
+    return res;
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+template <class KeyGetter>
+std::uint32_t boost::mysql::hash_index::find_impl(std::size_t hash, KeyGetter key) const noexcept
+{
+    if (slots_.empty())
+        return npos;
+
+    std::size_t mask = slots_.size() - 1;
+    std::uint32_t tag = detail::hash_index_tag(hash);
+    for (std::size_t pos = hash & mask;; pos = (pos + 1) & mask)
+    {
+        const slot& s = slots_[pos];
+        if (s.head == 0)
+            return npos;
+        if (s.tag == tag)
+        {
+            std::uint32_t row_idx = s.head - 1;
+            row_view r = rows_[row_idx];
+            bool matches = true;
+            for (std::size_t i = 0; i < key_columns_.size() && matches; ++i)
+                matches = r[key_columns_[i]] == key(i);
+            if (matches)
+                return row_idx;
+        }
+    }
+}
+
+void boost::mysql::hash_index::build()
+{
+    BOOST_ASSERT(!key_columns_.empty());
+
+    std::size_t num_rows = rows_.size();
+    if (num_rows >= npos)
+        BOOST_THROW_EXCEPTION(std::length_error("hash_index: too many rows"));
+    if (num_rows == 0)
+        return;
+
+    slots_.assign(detail::hash_index_capacity(num_rows), slot{0, 0});
+    next_.assign(num_rows, npos);
+
+    // Rows are inserted in reverse order and prepended to their chain,
+    // so chains are traversed in ascending order
+    std::size_t mask = slots_.size() - 1;
+    std::vector<field_view> key(key_columns_.size());
+    for (std::size_t i = num_rows; i-- > 0;)
+    {
+        row_view r = rows_[i];
+        for (std::size_t j = 0; j < key_columns_.size(); ++j)
+        {
+            BOOST_ASSERT(key_columns_[j] < r.size());
+            key[j] = r[key_columns_[j]];
+        }
+        std::size_t hash = hash_key(key);
+        std::uint32_t tag = detail::hash_index_tag(hash);
+        auto row_idx = static_cast<std::uint32_t>(i);
+
+        for (std::size_t pos = hash & mask;; pos = (pos + 1) & mask)
+        {
+            slot& s = slots_[pos];
+            if (s.head == 0)
+            {
+                s = slot{tag, row_idx + 1};
+                ++num_keys_;
+                break;
+            }
+            if (s.tag == tag)
+            {
+                row_view other = rows_[s.head - 1];
+                bool matches = true;
+                for (std::size_t j = 0; j < key.size() && matches; ++j)
+                    matches = other[key_columns_[j]] == key[j];
+                if (matches)
+                {
+                    next_[row_idx] = s.head - 1;
+                    s.head = row_idx + 1;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+boost::mysql::hash_index::match_range boost::mysql::hash_index::find(span<const field_view> key
+) const noexcept
+{
+    BOOST_ASSERT(key.size() == key_columns_.size());
+    auto first = find_impl(hash_key(key), [key](std::size_t i) { return key[i]; });
+    return match_range(iterator(this, first));
+}
+
+boost::mysql::hash_index::match_range boost::mysql::hash_index::find(
+    row_view probe,
+    span<const std::size_t> probe_columns
+) const noexcept
+{
+    BOOST_ASSERT(probe_columns.size() == key_columns_.size());
+
+    // Same as hash_key, without materializing the key
+    std::size_t hash = probe_columns.size();
+    for (std::size_t col : probe_columns)
+    {
+        BOOST_ASSERT(col < probe.size());
+        hash = detail::hash_combine(hash, hash_value(probe[col]));
+    }
+    auto first = find_impl(hash, [probe, probe_columns](std::size_t i) { return probe[probe_columns[i]]; });
+    return match_range(iterator(this, first));
+}
+
+#endif
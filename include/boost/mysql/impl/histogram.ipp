@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_HISTOGRAM_IPP
+#define BOOST_MYSQL_IMPL_HISTOGRAM_IPP
+
+#pragma once
+
+#include <boost/mysql/histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+std::uint64_t boost::mysql::histogram_snapshot::value_at_quantile(double q) const noexcept
+{
+    if (count_ == 0u)
+        return 0u;
+
+    // Rank of the value we're looking for, in [1, count]
+    q = (std::min)((std::max)(q, 0.0), 1.0);
+    auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count_)));
+    rank = (std::max)(rank, std::uint64_t(1));
+
+    std::uint64_t acc = 0;
+    for (std::size_t i = 0; i < buckets_.size(); ++i)
+    {
+        acc += buckets_[i];
+        if (acc >= rank)
+            return (std::min)(histogram::bucket_upper_bound(i), max_);
+    }
+
+    // Only reachable if the snapshot was taken while recording values
+    return max_;
+}
+
+void boost::mysql::histogram_snapshot::merge(const histogram_snapshot& other)
+{
+    if (other.buckets_.empty())
+        return;
+    if (buckets_.empty())
+        buckets_.resize(histogram_num_buckets);
+    for (std::size_t i = 0; i < histogram_num_buckets; ++i)
+        buckets_[i] += other.buckets_[i];
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = (std::max)(max_, other.max_);
+}
+
+boost::mysql::histogram_snapshot boost::mysql::histogram::snapshot() const
+{
+    histogram_snapshot res;
+    res.buckets_.resize(histogram_num_buckets);
+    std::size_t last_bucket = 0;
+    for (std::size_t i = 0; i < histogram_num_buckets; ++i)
+    {
+        auto v = buckets_[i].load(std::memory_order_relaxed);
+        res.buckets_[i] = v;
+        res.count_ += v;
+        if (v)
+            last_bucket = i;
+    }
+    if (res.count_ == 0u)
+        res.buckets_.clear();
+    res.sum_ = sum_.load(std::memory_order_relaxed);
+
+    // Concurrent writers may have overwritten a bigger maximum
+    res.max_ = (std::max)(max_.load(std::memory_order_relaxed), bucket_lower_bound(last_bucket));
+    return res;
+}
+
+#endif
@@ -15,6 +15,7 @@
 
 #include <boost/core/span.hpp>
 
+#include <cstdint>
 #include <vector>
 
 namespace boost {
@@ -37,6 +38,18 @@ error_code compute_auth_response(
     auth_response& output
 );
 
+// Server side of mysql_native_password. Fills output with random bytes to be used
+// as the authentication challenge (scramble). Bytes are never zero, since scrambles
+// are sent as NULL-terminated strings
+BOOST_MYSQL_DECL
+void generate_auth_scramble(span<std::uint8_t> output);
+
+// Compares the response computed by the server with the one sent by the client.
+// Runs in constant time, so it doesn't reveal how many bytes match
+BOOST_ATTRIBUTE_NODISCARD
+BOOST_MYSQL_DECL
+bool auth_responses_equal(span<const std::uint8_t> expected, span<const std::uint8_t> actual) noexcept;
+
 }  // namespace detail
 }  // namespace mysql
 }  // namespace boost
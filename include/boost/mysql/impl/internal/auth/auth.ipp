@@ -19,7 +19,10 @@
 
 #include <algorithm>
 #include <cstring>
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
 #include <openssl/sha.h>
+#include <random>
 
 namespace boost {
 namespace mysql {
@@ -232,4 +235,26 @@ boost::mysql::error_code boost::mysql::detail::compute_auth_response(
     }
 }
 
+void boost::mysql::detail::generate_auth_scramble(span<std::uint8_t> output)
+{
+    if (RAND_bytes(output.data(), static_cast<int>(output.size())) != 1)
+    {
+        std::random_device dev;
+        for (auto& b : output)
+            b = static_cast<std::uint8_t>(dev());
+    }
+    for (auto& b : output)
+        b = static_cast<std::uint8_t>(1u + b % 127u);
+}
+
+bool boost::mysql::detail::auth_responses_equal(
+    span<const std::uint8_t> expected,
+    span<const std::uint8_t> actual
+) noexcept
+{
+    // Response sizes are fixed by the plugin, so they don't need to be hidden
+    return expected.size() == actual.size() &&
+           CRYPTO_memcmp(expected.data(), actual.data(), expected.size()) == 0;
+}
+
 #endif
@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_CAPTURE_STREAM_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_CAPTURE_STREAM_HPP
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/protocol_trace.hpp>
+
+#include <boost/mysql/detail/any_stream.hpp>
+
+#include <boost/asio/any_completion_handler.hpp>
+#include <boost/asio/associator.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+
+// Wire capture file format. All integers are little-endian.
+//   header: magic (8 bytes), version (4 bytes)
+//   record: direction (1 byte, a trace_direction), timestamp in nanoseconds
+//           since the capture started (8 bytes), size (4 bytes), data (size bytes)
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+constexpr char wire_capture_magic[] = "BMYSQLWC";
+constexpr std::size_t wire_capture_magic_size = 8;
+constexpr std::uint32_t wire_capture_version = 1;
+constexpr std::size_t wire_capture_header_size = wire_capture_magic_size + 4;
+constexpr std::size_t wire_capture_record_header_size = 1 + 8 + 4;
+
+inline void write_wire_capture_header(std::ostream& output)
+{
+    std::uint8_t buff[wire_capture_header_size];
+    for (std::size_t i = 0; i < wire_capture_magic_size; ++i)
+        buff[i] = static_cast<std::uint8_t>(wire_capture_magic[i]);
+    endian::store_little_u32(buff + wire_capture_magic_size, wire_capture_version);
+    output.write(reinterpret_cast<const char*>(buff), sizeof(buff));
+}
+
+inline void write_wire_capture_record(
+    std::ostream& output,
+    trace_direction dir,
+    std::chrono::nanoseconds timestamp,
+    const void* data,
+    std::size_t size
+)
+{
+    std::uint8_t header[wire_capture_record_header_size];
+    header[0] = static_cast<std::uint8_t>(dir);
+    endian::store_little_u64(header + 1, static_cast<std::uint64_t>(timestamp.count()));
+    endian::store_little_u32(header + 9, static_cast<std::uint32_t>(size));
+    output.write(reinterpret_cast<const char*>(header), sizeof(header));
+    output.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+// Decorates a stream, recording the bytes transferred by every successful read and write.
+// Only the I/O functions are decorated: SSL state and the SocketStream functions
+// are forwarded to the underlying stream
+class capture_stream final : public any_stream
+{
+    any_stream& inner_;
+    std::ostream& output_;
+    std::chrono::steady_clock::time_point start_{std::chrono::steady_clock::now()};
+
+    void record(trace_direction dir, const void* data, std::size_t size)
+    {
+        if (size)
+        {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            write_wire_capture_record(
+                output_,
+                dir,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed),
+                data,
+                size
+            );
+        }
+    }
+
+public:
+    // Records the bytes transferred by an async operation before invoking the original handler
+    class capturing_handler
+    {
+        capture_stream* self_;
+        trace_direction dir_;
+        const void* data_;
+        asio::any_completion_handler<void(error_code, std::size_t)> handler_;
+
+    public:
+        capturing_handler(
+            capture_stream& self,
+            trace_direction dir,
+            const void* data,
+            asio::any_completion_handler<void(error_code, std::size_t)> handler
+        ) noexcept
+            : self_(&self), dir_(dir), data_(data), handler_(std::move(handler))
+        {
+        }
+
+        const asio::any_completion_handler<void(error_code, std::size_t)>& get() const noexcept
+        {
+            return handler_;
+        }
+
+        void operator()(error_code ec, std::size_t bytes_transferred)
+        {
+            self_->record(dir_, data_, bytes_transferred);
+            std::move(handler_)(ec, bytes_transferred);
+        }
+    };
+
+    // Writes the file header to output
+    capture_stream(any_stream& inner, std::ostream& output)
+        : any_stream(inner.supports_ssl(), inner.supports_close()), inner_(inner), output_(output)
+    {
+        write_wire_capture_header(output_);
+    }
+
+    executor_type get_executor() override { return inner_.get_executor(); }
+
+    // SSL
+    void handshake(error_code& ec) override { inner_.handshake(ec); }
+    void async_handshake(asio::any_completion_handler<void(error_code)> handler) override
+    {
+        inner_.async_handshake(std::move(handler));
+    }
+    void shutdown(error_code& ec) override { inner_.shutdown(ec); }
+    void async_shutdown(asio::any_completion_handler<void(error_code)> handler) override
+    {
+        inner_.async_shutdown(std::move(handler));
+    }
+
+    // Reading
+    std::size_t read_some(asio::mutable_buffer buff, error_code& ec) override
+    {
+        std::size_t res = inner_.read_some(buff, ec);
+        record(trace_direction::read, buff.data(), res);
+        return res;
+    }
+    void async_read_some(
+        asio::mutable_buffer buff,
+        asio::any_completion_handler<void(error_code, std::size_t)> handler
+    ) override
+    {
+        inner_.async_read_some(
+            buff,
+            capturing_handler(*this, trace_direction::read, buff.data(), std::move(handler))
+        );
+    }
+
+    // Writing
+    std::size_t write_some(asio::const_buffer buff, error_code& ec) override
+    {
+        std::size_t res = inner_.write_some(buff, ec);
+        record(trace_direction::write, buff.data(), res);
+        return res;
+    }
+    void async_write_some(
+        asio::const_buffer buff,
+        asio::any_completion_handler<void(error_code, std::size_t)> handler
+    ) override
+    {
+        inner_.async_write_some(
+            buff,
+            capturing_handler(*this, trace_direction::write, buff.data(), std::move(handler))
+        );
+    }
+
+    // Connect and close
+    void connect(const void* endpoint, error_code& ec) override { inner_.connect(endpoint, ec); }
+    void async_connect(const void* endpoint, asio::any_completion_handler<void(error_code)> handler) override
+    {
+        inner_.async_connect(endpoint, std::move(handler));
+    }
+    void close(error_code& ec) override { inner_.close(ec); }
+    bool is_open() const noexcept override { return inner_.is_open(); }
+    std::string remote_address() const override { return inner_.remote_address(); }
+};
+
+}  // namespace detail
+}  // namespace mysql
+
+namespace asio {
+
+template <template <class, class> class Associator, class DefaultCandidate>
+struct associator<Associator, mysql::detail::capture_stream::capturing_handler, DefaultCandidate>
+    : Associator<any_completion_handler<void(mysql::error_code, std::size_t)>, DefaultCandidate>
+{
+    using inner_associator = Associator<
+        any_completion_handler<void(mysql::error_code, std::size_t)>,
+        DefaultCandidate>;
+
+    static typename inner_associator::type get(const mysql::detail::capture_stream::capturing_handler& h
+    ) noexcept
+    {
+        return inner_associator::get(h.get());
+    }
+
+    static typename inner_associator::type get(
+        const mysql::detail::capture_stream::capturing_handler& h,
+        const DefaultCandidate& c
+    ) noexcept
+    {
+        return inner_associator::get(h.get(), c);
+    }
+};
+
+}  // namespace asio
+}  // namespace boost
+
+#endif
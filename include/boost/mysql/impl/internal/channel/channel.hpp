@@ -8,24 +8,37 @@
 #ifndef BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_CHANNEL_HPP
 #define BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_CHANNEL_HPP
 
+#include <boost/mysql/auth_plugin_cache.hpp>
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/connection_stats.hpp>
 #include <boost/mysql/diagnostics.hpp>
 #include <boost/mysql/error_code.hpp>
 #include <boost/mysql/field_view.hpp>
+#include <boost/mysql/memory_usage.hpp>
 #include <boost/mysql/metadata_mode.hpp>
+#include <boost/mysql/operation_observer.hpp>
+#include <boost/mysql/protocol_trace.hpp>
+#include <boost/mysql/string_view.hpp>
 
 #include <boost/mysql/detail/any_stream.hpp>
 
+#include <boost/mysql/impl/internal/channel/capture_stream.hpp>
 #include <boost/mysql/impl/internal/channel/message_reader.hpp>
 #include <boost/mysql/impl/internal/channel/message_writer.hpp>
+#include <boost/mysql/impl/internal/channel/operation_deadline.hpp>
+#include <boost/mysql/impl/internal/channel/phase_tracer.hpp>
 #include <boost/mysql/impl/internal/channel/write_message.hpp>
 #include <boost/mysql/impl/internal/protocol/capabilities.hpp>
 #include <boost/mysql/impl/internal/protocol/db_flavor.hpp>
+#include <boost/mysql/impl/internal/usdt.hpp>
 
 #include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/async_result.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
+#include <ostream>
 #include <utility>
 #include <vector>
 
@@ -45,6 +58,34 @@ class channel
     message_reader reader_;
     message_writer writer_;
     std::unique_ptr<any_stream> stream_;
+    std::uint64_t rows_read_{};
+    std::chrono::nanoseconds decode_time_{};
+    operation_observer* observer_{};
+    auth_plugin_cache* auth_cache_{};
+    operation_info current_op_;
+    phase_tracer tracer_;
+    std::unique_ptr<protocol_trace> trace_;
+    std::unique_ptr<capture_stream> capture_;
+    std::chrono::steady_clock::duration op_timeout_{};
+    std::unique_ptr<operation_deadline> deadline_;  // created on first use
+    asio::any_io_executor tls_handshake_ex_;        // empty if TLS handshakes are not offloaded
+    bool async_op_observed_{};                      // set by start_async_operation
+    bool async_op_timed_{};                         // set by start_async_operation
+
+    // The stream used for reads and writes. Other operations always use stream_
+    any_stream& io_stream() noexcept { return capture_ ? *capture_ : *stream_; }
+
+    void set_tracers_active(bool v) noexcept
+    {
+        phase_tracer* tracers[] = {&tracer_, &reader_.tracer(), &writer_.tracer()};
+        for (auto* t : tracers)
+        {
+            if (v)
+                t->activate(current_op_);
+            else
+                t->deactivate();
+        }
+    }
 
 public:
     channel(std::size_t read_buffer_size, std::unique_ptr<any_stream> stream)
@@ -64,25 +105,25 @@ public:
         return reader_.get_next_message(seqnum, err);
     }
 
-    void read_some(error_code& code) { read_some_messages(*stream_, reader_, code); }
+    void read_some(error_code& code) { read_some_messages(io_stream(), reader_, code); }
 
     template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code)) CompletionToken>
     BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
     async_read_some(CompletionToken&& token)
     {
-        return async_read_some_messages(*stream_, reader_, std::forward<CompletionToken>(token));
+        return async_read_some_messages(io_stream(), reader_, std::forward<CompletionToken>(token));
     }
 
     span<const std::uint8_t> read_one(std::uint8_t& seqnum, error_code& ec)
     {
-        return read_one_message(*stream_, reader_, seqnum, ec);
+        return read_one_message(io_stream(), reader_, seqnum, ec);
     }
 
     template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, span<const std::uint8_t>)) CompletionToken>
     BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, span<const std::uint8_t>))
     async_read_one(std::uint8_t& seqnum, CompletionToken&& token)
     {
-        return async_read_one_message(*stream_, reader_, seqnum, std::forward<CompletionToken>(token));
+        return async_read_one_message(io_stream(), reader_, seqnum, std::forward<CompletionToken>(token));
     }
 
     // Exposed for the sake of testing
@@ -95,16 +136,30 @@ public:
         std::size_t size = message.get_size();
         auto buff = writer_.prepare_buffer(size, sequence_number);
         message.serialize(buff);
+        writer_.on_message_serialized();
     }
 
-    // Writes what has been set up by serialize()
-    void write(error_code& code) { write_message(*stream_, writer_, code); }
+    // Pipelining. Messages serialized by serialize_pipelined() after begin_pipeline()
+    // are sent together by the next write()
+    void begin_pipeline() noexcept { writer_.begin_pipeline(); }
+
+    template <class Serializable>
+    void serialize_pipelined(const Serializable& message, std::uint8_t& sequence_number)
+    {
+        std::size_t size = message.get_size();
+        auto buff = writer_.prepare_pipelined_buffer(size, sequence_number);
+        message.serialize(buff);
+        writer_.on_message_serialized();
+    }
+
+    // Writes what has been set up by serialize() or serialize_pipelined()
+    void write(error_code& code) { write_message(io_stream(), writer_, code); }
 
     template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code)) CompletionToken>
     BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
     async_write(CompletionToken&& token)
     {
-        return async_write_message(*stream_, writer_, std::forward<CompletionToken>(token));
+        return async_write_message(io_stream(), writer_, std::forward<CompletionToken>(token));
     }
 
     // Capabilities
@@ -138,6 +193,173 @@ public:
     // SSL
     bool ssl_active() const noexcept { return stream_->ssl_active(); }
 
+    // Statistics
+    void on_rows_decoded(std::size_t num_rows, std::chrono::nanoseconds elapsed) noexcept
+    {
+        rows_read_ += num_rows;
+        decode_time_ += elapsed;
+    }
+
+    connection_stats stats() const noexcept
+    {
+        const auto& rd = reader_.stats();
+        const auto& wr = writer_.stats();
+        connection_stats res;
+        res.bytes_read = rd.bytes_read;
+        res.bytes_written = wr.bytes_written;
+        res.read_calls = rd.read_calls;
+        res.write_calls = wr.write_calls;
+        res.messages_read = rd.messages_read;
+        res.messages_written = wr.messages_written;
+        res.frames_read = rd.frames_read;
+        res.multiframe_messages_read = rd.multiframe_messages_read;
+        res.read_buffer_growths = rd.read_buffer_growths;
+        res.read_buffer_size = reader_.buffer().size();
+        res.rows_read = rows_read_;
+        res.io_time = rd.io_time + wr.io_time;
+        res.decode_time = decode_time_;
+        return res;
+    }
+
+    connection_memory_usage memory_usage() const noexcept
+    {
+        connection_memory_usage res;
+        res.read_buffer = reader_.buffer().memory_usage();
+        res.write_buffer = writer_.memory_usage();
+        res.shared_fields = vector_memory_usage(shared_fields_);
+        res.shared_diagnostics = string_memory_usage(access::get_impl(shared_diag_).msg);
+        res.protocol_trace = trace_ ? trace_->capacity() * sizeof(protocol_trace_record) : 0u;
+        return res;
+    }
+
+    // Operation observer
+#ifdef BOOST_MYSQL_NO_OPERATION_OBSERVER
+    operation_observer* observer() const noexcept { return nullptr; }
+#else
+    operation_observer* observer() const noexcept { return observer_; }
+#endif
+    void set_observer(operation_observer* v) noexcept { observer_ = v; }
+
+    // Authentication plugin cache
+    auth_plugin_cache* auth_cache() const noexcept { return auth_cache_; }
+    void set_auth_cache(auth_plugin_cache* v) noexcept { auth_cache_ = v; }
+    phase_tracer& tracer() noexcept { return tracer_; }
+
+    // Notifies the observer that an operation is starting.
+    // Returns false if there is no observer, in which case finish_operation shouldn't be called.
+    // Operations are also tracked if a tracer is attached to the operation USDT probes
+    bool start_operation(operation_type type, string_view query = {}, std::uint32_t statement_id = 0) noexcept
+    {
+        auto* obs = observer();
+        if (!obs && !BOOST_MYSQL_USDT_ENABLED(operation_start) && !BOOST_MYSQL_USDT_ENABLED(operation_finish))
+            return false;
+        current_op_ = operation_info();
+        current_op_.type = type;
+        current_op_.query = query;
+        current_op_.statement_id = statement_id;
+        current_op_.started = std::chrono::steady_clock::now();
+        current_op_.rows_read = rows_read_;  // stored to compute deltas
+        current_op_.decode_time = decode_time_;
+        current_op_.bytes_read = reader_.stats().bytes_read;
+        current_op_.bytes_written = writer_.stats().bytes_written;
+        set_tracers_active(true);
+        BOOST_MYSQL_USDT4(operation_start, static_cast<int>(type), query.data(), query.size(), statement_id);
+        if (obs)
+            obs->on_operation_start(current_op_);
+        return true;
+    }
+
+    void finish_operation(error_code err) noexcept
+    {
+        set_tracers_active(false);
+        current_op_.finished = std::chrono::steady_clock::now();
+        current_op_.error = err;
+        current_op_.rows_read = rows_read_ - current_op_.rows_read;
+        current_op_.decode_time = decode_time_ - current_op_.decode_time;
+        current_op_.bytes_read = reader_.stats().bytes_read - current_op_.bytes_read;
+        current_op_.bytes_written = writer_.stats().bytes_written - current_op_.bytes_written;
+        BOOST_MYSQL_USDT6(
+            operation_finish,
+            static_cast<int>(current_op_.type),
+            err.value(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(current_op_.finished - current_op_.started)
+                .count(),
+            current_op_.rows_read,
+            current_op_.bytes_read,
+            current_op_.bytes_written
+        );
+        if (auto* obs = observer())
+            obs->on_operation_finish(current_op_);
+    }
+
+    // Protocol trace. The reader and writer point to the heap-allocated trace,
+    // so they remain valid if the channel is moved
+    const protocol_trace* get_protocol_trace() const noexcept { return trace_.get(); }
+    void enable_protocol_trace(std::size_t capacity)
+    {
+        trace_.reset(new protocol_trace(capacity));
+        reader_.set_protocol_trace(trace_.get());
+        writer_.set_protocol_trace(trace_.get());
+    }
+    void disable_protocol_trace() noexcept
+    {
+        reader_.set_protocol_trace(nullptr);
+        writer_.set_protocol_trace(nullptr);
+        trace_.reset();
+    }
+
+    // Wire capture. Reads and writes go through the capture decorator while it's active
+    void start_wire_capture(std::ostream& output) { capture_.reset(new capture_stream(*stream_, output)); }
+    void stop_wire_capture() noexcept { capture_.reset(); }
+
+    // Operation timeouts. Only async operations over streams that can be closed are timed
+    std::chrono::steady_clock::duration operation_timeout() const noexcept { return op_timeout_; }
+    void set_operation_timeout(std::chrono::steady_clock::duration v) noexcept { op_timeout_ = v; }
+
+    // Executor where async TLS handshakes run, or an empty executor to run them in the stream's
+    const asio::any_io_executor& tls_handshake_executor() const noexcept { return tls_handshake_ex_; }
+    void set_tls_handshake_executor(asio::any_io_executor v) noexcept { tls_handshake_ex_ = std::move(v); }
+
+    // Async operations. start_async_operation should be called after start_operation,
+    // passing its return value, and starts the deadline, if the operation is timed.
+    // finish_async_operation undoes both before invoking the final handler, and returns
+    // the error code to pass to it, which is client_errc::timeout if the deadline expired
+    // and caused the operation to fail
+    void start_async_operation(bool observed)
+    {
+        async_op_observed_ = observed;
+        async_op_timed_ = false;
+        if (op_timeout_ <= std::chrono::steady_clock::duration::zero() || !stream_->supports_close())
+            return;
+        if (!deadline_)
+            deadline_.reset(new operation_deadline(get_executor(), *stream_));
+        deadline_->arm(op_timeout_);
+        async_op_timed_ = true;
+    }
+
+    error_code finish_async_operation(error_code err) noexcept
+    {
+        // Operations that succeeded finished before the stream was closed
+        if (async_op_timed_ && deadline_->disarm() && err)
+            err = client_errc::timeout;
+        if (async_op_observed_)
+            finish_operation(err);
+        return err;
+    }
+
+    // Used around offloaded TLS handshakes. No-ops if the current operation has no deadline
+    void pause_deadline() noexcept
+    {
+        if (deadline_)
+            deadline_->pause();
+    }
+
+    void resume_deadline()
+    {
+        if (deadline_)
+            deadline_->resume();
+    }
+
     // Getting the underlying stream
     any_stream& stream() noexcept { return *stream_; }
     const any_stream& stream() const noexcept { return *stream_; }
@@ -9,14 +9,18 @@
 #define BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_MESSAGE_READER_HPP
 
 #include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/connection_stats.hpp>
 #include <boost/mysql/error_code.hpp>
+#include <boost/mysql/protocol_trace.hpp>
 
 #include <boost/mysql/detail/any_stream.hpp>
 
 #include <boost/mysql/impl/internal/channel/message_parser.hpp>
+#include <boost/mysql/impl/internal/channel/phase_tracer.hpp>
 #include <boost/mysql/impl/internal/channel/read_buffer.hpp>
 #include <boost/mysql/impl/internal/channel/valgrind.hpp>
 #include <boost/mysql/impl/internal/protocol/constants.hpp>
+#include <boost/mysql/impl/internal/usdt.hpp>
 
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/buffer.hpp>
@@ -25,6 +29,7 @@
 #include <boost/asio/post.hpp>
 #include <boost/assert.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 
@@ -86,7 +91,9 @@ public:
             maybe_resize_buffer();
 
             // Actually read bytes
+            auto start = std::chrono::steady_clock::now();
             std::size_t bytes_read = stream.read_some(free_area(), ec);
+            on_read_complete(start);
             if (ec)
                 break;
             valgrind_make_mem_defined(buffer_.free_first(), bytes_read);
@@ -104,25 +111,82 @@ public:
     read_buffer& buffer() noexcept { return buffer_; }
     const read_buffer& buffer() const noexcept { return buffer_; }
 
+    // Only the read-related members are populated
+    const connection_stats& stats() const noexcept { return stats_; }
+
+    phase_tracer& tracer() noexcept { return tracer_; }
+
+    void set_protocol_trace(protocol_trace* v) noexcept { trace_ = v; }
+
 private:
     struct read_some_op;
 
     read_buffer buffer_;
     message_parser parser_;
     message_parser::result result_;
+    connection_stats stats_;
+    phase_tracer tracer_;
+    protocol_trace* trace_{};
 
-    void parse_message() { parser_.parse_message(buffer_, result_); }
+    void parse_message()
+    {
+        parser_.parse_message(buffer_, result_);
+        if (result_.has_message)
+        {
+            // Sequence numbers increase by one
+            // (modulo 256) with each frame
+            std::uint64_t num_frames = static_cast<std::uint8_t>(
+                                           result_.message.seqnum_last - result_.message.seqnum_first
+                                       ) +
+                                       1u;
+            ++stats_.messages_read;
+            stats_.frames_read += num_frames;
+            if (num_frames > 1)
+                ++stats_.multiframe_messages_read;
+            BOOST_MYSQL_USDT3(
+                message_read,
+                result_.message.size,
+                result_.message.seqnum_first,
+                result_.message.seqnum_last
+            );
+            if (trace_)
+            {
+                trace_->append(
+                    trace_direction::read,
+                    result_.message.seqnum_first,
+                    result_.message.seqnum_last,
+                    buffer_.current_message_first() - result_.message.size,
+                    result_.message.size
+                );
+            }
+        }
+    }
 
     void maybe_resize_buffer()
     {
         if (!result_.has_message)
         {
+            std::size_t old_size = buffer_.size();
             buffer_.grow_to_fit(result_.required_size);
+            if (buffer_.size() != old_size)
+            {
+                ++stats_.read_buffer_growths;
+                BOOST_MYSQL_USDT2(read_buffer_resize, old_size, buffer_.size());
+            }
         }
     }
 
+    void on_read_complete(std::chrono::steady_clock::time_point start) noexcept
+    {
+        ++stats_.read_calls;
+        stats_.io_time += std::chrono::steady_clock::now() - start;
+    }
+
     void on_read_bytes(size_t num_bytes)
     {
+        stats_.bytes_read += num_bytes;
+        if (num_bytes)
+            tracer_.on_bytes_received();
         buffer_.move_to_pending(num_bytes);
         parse_message();
     }
@@ -138,12 +202,20 @@ struct boost::mysql::detail::message_reader::read_some_op : boost::asio::corouti
 {
     message_reader& reader_;
     any_stream& stream_;
+    std::chrono::steady_clock::time_point read_start_{};
 
     read_some_op(message_reader& reader, any_stream& stream) noexcept : reader_(reader), stream_(stream) {}
 
     template <class Self>
     void operator()(Self& self, error_code ec = {}, std::size_t bytes_read = 0)
     {
+        // Track the read we just completed, if any
+        if (read_start_ != std::chrono::steady_clock::time_point())
+        {
+            reader_.on_read_complete(read_start_);
+            read_start_ = std::chrono::steady_clock::time_point();
+        }
+
         // Error handling
         if (ec)
         {
@@ -172,6 +244,7 @@ struct boost::mysql::detail::message_reader::read_some_op : boost::asio::corouti
                 reader_.maybe_resize_buffer();
 
                 // Actually read bytes
+                read_start_ = std::chrono::steady_clock::now();
                 BOOST_ASIO_CORO_YIELD stream_.async_read_some(reader_.free_area(), std::move(self));
                 valgrind_make_mem_defined(reader_.buffer_.free_first(), bytes_read);
 
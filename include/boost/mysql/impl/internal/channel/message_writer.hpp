@@ -8,10 +8,18 @@
 #ifndef BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_MESSAGE_WRITER_HPP
 #define BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_MESSAGE_WRITER_HPP
 
+#include <boost/mysql/connection_stats.hpp>
+#include <boost/mysql/protocol_trace.hpp>
+
+#include <boost/mysql/detail/memory_accounting.hpp>
+
+#include <boost/mysql/impl/internal/channel/phase_tracer.hpp>
 #include <boost/mysql/impl/internal/protocol/constants.hpp>
-#include <boost/mysql/impl/internal/protocol/protocol.hpp>
+#include <boost/mysql/impl/internal/protocol/framing.hpp>
+#include <boost/mysql/impl/internal/usdt.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 
@@ -53,27 +61,33 @@ class message_writer
     std::vector<std::uint8_t> buffer_;
     std::size_t max_frame_size_;
     std::uint8_t* seqnum_{nullptr};
+    std::uint8_t seqnum_first_{};
+    std::size_t payload_offset_{HEADER_SIZE};
+    bool pipelined_{};
 
     chunk_processor chunk_;
     std::size_t total_bytes_{};
     std::size_t total_bytes_written_{};
     bool should_send_empty_frame_{};
-
-    void process_header_write(std::uint32_t size_to_write, std::uint8_t seqnum, std::size_t buff_offset)
-    {
-        serialize_frame_header(
-            frame_header{size_to_write, seqnum},
-            span<std::uint8_t, frame_header_size>(buffer_.data() + buff_offset, frame_header_size)
-        );
-    }
+    connection_stats stats_;
+    phase_tracer tracer_;
+    protocol_trace* trace_{};
+    memory_account accounted_;
 
     std::uint8_t next_seqnum() noexcept { return (*seqnum_)++; }
 
+    std::size_t message_frames() const noexcept { return num_frames(total_bytes_, max_frame_size_); }
+
     void prepare_next_chunk()
     {
-        if (should_send_empty_frame_)
+        if (pipelined_)
+        {
+            // Pipelined messages are framed on serialization and written as a single chunk
+            chunk_.reset();
+        }
+        else if (should_send_empty_frame_)
         {
-            process_header_write(0, next_seqnum(), 0);
+            write_frame_header(buffer_.data(), 0, next_seqnum());
             chunk_.reset(0, HEADER_SIZE);
             should_send_empty_frame_ = false;
         }
@@ -82,7 +96,7 @@ class message_writer
             std::size_t offset = total_bytes_written_;
             std::size_t remaining = total_bytes_ - total_bytes_written_;
             std::size_t size = (std::min)(max_frame_size_, remaining);
-            process_header_write(static_cast<std::uint32_t>(size), next_seqnum(), offset);
+            write_frame_header(buffer_.data() + offset, size, next_seqnum());
             chunk_.reset(offset, offset + size + HEADER_SIZE);
             if (remaining == max_frame_size_)
             {
@@ -102,15 +116,68 @@ public:
 
     span<std::uint8_t> prepare_buffer(std::size_t msg_size, std::uint8_t& seqnum)
     {
+        pipelined_ = false;
+        payload_offset_ = HEADER_SIZE;
         buffer_.resize(msg_size + HEADER_SIZE);
+        accounted_.update(memory_usage());
         total_bytes_ = msg_size;
         total_bytes_written_ = 0;
         should_send_empty_frame_ = msg_size == 0;
         seqnum_ = &seqnum;
+        seqnum_first_ = seqnum;
+        ++stats_.messages_written;
         prepare_next_chunk();
         return {buffer_.data() + HEADER_SIZE, msg_size};
     }
 
+    // Pipelining: messages set up by prepare_pipelined_buffer() after a call to begin_pipeline()
+    // are written together, by a single write operation. As every message has its own sequence number,
+    // frame headers are written on serialization, rather than when writing
+    void begin_pipeline() noexcept
+    {
+        buffer_.clear();
+        pipelined_ = true;
+        seqnum_ = nullptr;
+        chunk_.reset();
+    }
+
+    span<std::uint8_t> prepare_pipelined_buffer(std::size_t msg_size, std::uint8_t& seqnum)
+    {
+        BOOST_ASSERT(pipelined_);
+
+        // The payload is serialized after the space reserved for its frame headers,
+        // and moved to its place by on_message_serialized()
+        payload_offset_ = reserve_framed_message(buffer_, msg_size, max_frame_size_);
+        accounted_.update(memory_usage());
+        total_bytes_ = msg_size;
+        seqnum_first_ = seqnum;
+        seqnum = static_cast<std::uint8_t>(seqnum + message_frames());
+        ++stats_.messages_written;
+        chunk_.reset(0, buffer_.size());
+        return {buffer_.data() + payload_offset_, msg_size};
+    }
+
+    // Should be called once the message set up by prepare_buffer() or prepare_pipelined_buffer()
+    // has been serialized
+    void on_message_serialized() noexcept
+    {
+        if (trace_)
+        {
+            trace_->append(
+                trace_direction::write,
+                seqnum_first_,
+                static_cast<std::uint8_t>(seqnum_first_ + message_frames() - 1u),
+                buffer_.data() + payload_offset_,
+                total_bytes_
+            );
+        }
+        if (pipelined_)
+        {
+            std::uint8_t* first = buffer_.data() + payload_offset_ - message_frames() * HEADER_SIZE;
+            frame_message(first, total_bytes_, seqnum_first_, max_frame_size_);
+        }
+    }
+
     bool done() const noexcept { return chunk_.done(); }
 
     // This function returns an empty buffer to signal that we're done
@@ -120,9 +187,27 @@ public:
         return chunk_.get_chunk(buffer_);
     }
 
+    // Only the write-related members are populated
+    const connection_stats& stats() const noexcept { return stats_; }
+    std::size_t memory_usage() const noexcept { return vector_memory_usage(buffer_); }
+
+    phase_tracer& tracer() noexcept { return tracer_; }
+
+    void set_protocol_trace(protocol_trace* v) noexcept { trace_ = v; }
+
+    // Should be called after every stream write, even if it failed
+    void on_write_complete(std::chrono::steady_clock::time_point start) noexcept
+    {
+        auto now = std::chrono::steady_clock::now();
+        ++stats_.write_calls;
+        stats_.io_time += now - start;
+        tracer_.record(operation_phase::request_write, start, now);
+    }
+
     void on_bytes_written(std::size_t n)
     {
         BOOST_ASSERT(!done());
+        stats_.bytes_written += n;
 
         // Acknowledge the written bytes
         chunk_.on_bytes_written(n);
@@ -131,6 +216,15 @@ public:
         if (chunk_.done())
         {
             prepare_next_chunk();
+            if (done() && seqnum_)
+            {
+                BOOST_MYSQL_USDT3(
+                    message_written,
+                    total_bytes_,
+                    seqnum_first_,
+                    static_cast<std::uint8_t>(*seqnum_ - 1u)
+                );
+            }
         }
     }
 };
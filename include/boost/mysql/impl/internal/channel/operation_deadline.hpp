@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_OPERATION_DEADLINE_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_OPERATION_DEADLINE_HPP
+
+#include <boost/mysql/error_code.hpp>
+
+#include <boost/mysql/detail/any_stream.hpp>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Memory for the timer's wait operations, so that arming the deadline doesn't allocate.
+// A cancelled wait may still be queued when the deadline is re-armed, so two blocks are kept.
+// Requests that don't fit are served by operator new
+class deadline_wait_memory
+{
+    static constexpr std::size_t block_size = 256;
+
+    struct block
+    {
+        alignas(std::max_align_t) unsigned char data[block_size];
+        bool in_use;
+    };
+    block blocks_[2]{};
+
+public:
+    void* allocate(std::size_t size)
+    {
+        for (auto& b : blocks_)
+        {
+            if (!b.in_use && size <= block_size)
+            {
+                b.in_use = true;
+                return b.data;
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void deallocate(void* p) noexcept
+    {
+        for (auto& b : blocks_)
+        {
+            if (p == b.data)
+            {
+                b.in_use = false;
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+};
+
+template <class T>
+class deadline_wait_allocator
+{
+    template <class U>
+    friend class deadline_wait_allocator;
+
+    deadline_wait_memory* mem_;
+
+public:
+    using value_type = T;
+
+    explicit deadline_wait_allocator(deadline_wait_memory& mem) noexcept : mem_(&mem) {}
+
+    template <class U>
+    deadline_wait_allocator(const deadline_wait_allocator<U>& other) noexcept : mem_(other.mem_)
+    {
+    }
+
+    T* allocate(std::size_t n) { return static_cast<T*>(mem_->allocate(n * sizeof(T))); }
+    void deallocate(T* p, std::size_t) noexcept { mem_->deallocate(p); }
+
+    template <class U>
+    bool operator==(const deadline_wait_allocator<U>& rhs) const noexcept
+    {
+        return mem_ == rhs.mem_;
+    }
+
+    template <class U>
+    bool operator!=(const deadline_wait_allocator<U>& rhs) const noexcept
+    {
+        return mem_ != rhs.mem_;
+    }
+};
+
+// A timer shared by all the async operations in a connection. When it expires,
+// the stream is closed, which causes the running operation to fail.
+// The timer is re-armed for every operation, so no timer is created per operation.
+// Timer is an asio::basic_waitable_timer. Tests use one with a manually advanced clock.
+template <class Timer>
+class basic_operation_deadline
+{
+    // Shared with the pending wait, so it can detect that the deadline has been
+    // disarmed or destroyed before the wait handler runs
+    struct state
+    {
+        any_stream* stream;
+        std::uint64_t op_id{0};
+        bool expired{false};
+        deadline_wait_memory wait_memory;
+
+        state(any_stream& stream) noexcept : stream(&stream) {}
+    };
+
+    struct close_handler
+    {
+        std::shared_ptr<state> st;
+        std::uint64_t op_id;
+
+        void operator()()
+        {
+            if (!st->stream || st->op_id != op_id)
+                return;
+            st->expired = true;
+            error_code ignored;
+            st->stream->close(ignored);
+        }
+    };
+
+    // The timer may expire after the operation's last I/O has completed, but before its
+    // handler has disarmed the deadline. The I/O completion is queued by then, so closing
+    // is posted to run after it. If the operation finishes in between, it's not interrupted
+    struct wait_handler
+    {
+        std::shared_ptr<state> st;
+        std::uint64_t op_id;
+        typename Timer::executor_type ex;
+
+        using allocator_type = deadline_wait_allocator<void>;
+        allocator_type get_allocator() const noexcept { return allocator_type(st->wait_memory); }
+
+        void operator()(error_code ec)
+        {
+            if (ec || !st->stream || st->op_id != op_id)
+                return;
+            asio::post(ex, close_handler{std::move(st), op_id});
+        }
+    };
+
+    Timer timer_;
+    std::shared_ptr<state> state_;
+    bool armed_{false};
+
+    void wait() { timer_.async_wait(wait_handler{state_, state_->op_id, timer_.get_executor()}); }
+
+public:
+    basic_operation_deadline(typename Timer::executor_type ex, any_stream& stream)
+        : timer_(std::move(ex)), state_(std::make_shared<state>(stream))
+    {
+    }
+    basic_operation_deadline(const basic_operation_deadline&) = delete;
+    basic_operation_deadline& operator=(const basic_operation_deadline&) = delete;
+    ~basic_operation_deadline() { state_->stream = nullptr; }
+
+    // Starts counting for a new operation
+    void arm(typename Timer::duration timeout)
+    {
+        ++state_->op_id;
+        state_->expired = false;
+        armed_ = true;
+        timer_.expires_after(timeout);
+        wait();
+    }
+
+    // While paused, the stream is not closed, even if the deadline expires. Used while the stream
+    // is being used from other threads. Resuming keeps the original expiry time
+    void pause() noexcept
+    {
+        if (!armed_)
+            return;
+        ++state_->op_id;
+        timer_.cancel();
+    }
+
+    void resume()
+    {
+        if (armed_)
+            wait();
+    }
+
+    // Stops counting. Returns true if the deadline expired and closed the stream
+    // before the operation finished
+    bool disarm() noexcept
+    {
+        bool res = state_->expired;
+        ++state_->op_id;
+        state_->expired = false;
+        armed_ = false;
+        timer_.cancel();
+        return res;
+    }
+};
+
+using operation_deadline = basic_operation_deadline<asio::steady_timer>;
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_PHASE_TRACER_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_PHASE_TRACER_HPP
+
+#include <boost/mysql/operation_observer.hpp>
+
+#include <chrono>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Records phase timestamps into the operation_info of the operation
+// in progress. Does nothing if no operation is being observed.
+// If BOOST_MYSQL_NO_OPERATION_OBSERVER is defined, active() is a constant
+// and all functions are optimized away.
+class phase_tracer
+{
+    using clock = std::chrono::steady_clock;
+
+    operation_info* info_{};
+
+public:
+    phase_tracer() = default;
+
+#ifdef BOOST_MYSQL_NO_OPERATION_OBSERVER
+    bool active() const noexcept { return false; }
+#else
+    bool active() const noexcept { return info_ != nullptr; }
+#endif
+
+    void activate(operation_info& info) noexcept { info_ = &info; }
+    void deactivate() noexcept { info_ = nullptr; }
+
+    // Marks the beginning of a phase. If the phase happens several times
+    // during an operation, the first beginning is kept
+    void begin(operation_phase p) noexcept
+    {
+        if (active())
+            begin(p, clock::now());
+    }
+
+    void begin(operation_phase p, clock::time_point tp) noexcept
+    {
+        if (active())
+        {
+            auto& t = info_->phase(p);
+            if (t.begin == clock::time_point())
+                t.begin = tp;
+        }
+    }
+
+    // Marks the end of a phase. The last end is kept
+    void end(operation_phase p) noexcept
+    {
+        if (active())
+            info_->phase(p).end = clock::now();
+    }
+
+    // Records a complete interval for a phase, as a begin() plus end() would
+    void record(operation_phase p, clock::time_point from, clock::time_point to) noexcept
+    {
+        if (active())
+        {
+            begin(p, from);
+            info_->phase(p).end = to;
+        }
+    }
+
+    // Called by the reader when bytes are received. Records the time to first byte
+    void on_bytes_received() noexcept
+    {
+        if (active())
+        {
+            auto& t = info_->phase(operation_phase::first_byte);
+            if (t.end == clock::time_point())
+            {
+                const auto& write = info_->phase(operation_phase::request_write);
+                const auto& connect = info_->phase(operation_phase::tcp_connect);
+                if (write.end != clock::time_point())
+                    t.begin = write.end;
+                else if (connect.end != clock::time_point())
+                    t.begin = connect.end;
+                else
+                    t.begin = info_->started;
+                t.end = clock::now();
+            }
+        }
+    }
+};
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
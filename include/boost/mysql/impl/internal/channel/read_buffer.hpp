@@ -8,6 +8,8 @@
 #ifndef BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_READ_BUFFER_HPP
 #define BOOST_MYSQL_IMPL_INTERNAL_CHANNEL_READ_BUFFER_HPP
 
+#include <boost/mysql/detail/memory_accounting.hpp>
+
 #include <boost/assert.hpp>
 #include <boost/core/span.hpp>
 
@@ -33,13 +35,19 @@ class read_buffer
     std::size_t current_message_offset_{0};
     std::size_t pending_offset_{0};
     std::size_t free_offset_{0};
+    memory_account accounted_;
 
 public:
-    read_buffer(std::size_t size) : buffer_(size, std::uint8_t(0)) { buffer_.resize(buffer_.capacity()); }
+    read_buffer(std::size_t size) : buffer_(size, std::uint8_t(0))
+    {
+        buffer_.resize(buffer_.capacity());
+        accounted_.update(memory_usage());
+    }
 
     // Whole buffer accessors
     const std::uint8_t* first() const noexcept { return buffer_.data(); }
     std::size_t size() const noexcept { return buffer_.size(); }
+    std::size_t memory_usage() const noexcept { return vector_memory_usage(buffer_); }
 
     // Area accessors
     std::uint8_t* reserved_first() noexcept { return buffer_.data(); }
@@ -122,6 +130,7 @@ public:
         {
             buffer_.resize(buffer_.size() + n - free_size());
             buffer_.resize(buffer_.capacity());
+            accounted_.update(memory_usage());
         }
     }
 };
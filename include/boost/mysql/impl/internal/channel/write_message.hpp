@@ -20,6 +20,7 @@
 #include <boost/asio/compose.hpp>
 #include <boost/asio/coroutine.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 
@@ -33,7 +34,9 @@ inline void write_message(any_stream& stream, message_writer& processor, error_c
 {
     while (!processor.done())
     {
+        auto start = std::chrono::steady_clock::now();
         std::size_t bytes_written = stream.write_some(asio::buffer(processor.next_chunk()), ec);
+        processor.on_write_complete(start);
         if (ec)
             break;
         processor.on_bytes_written(bytes_written);
@@ -44,6 +47,7 @@ struct write_message_op : boost::asio::coroutine
 {
     any_stream& stream_;
     message_writer& processor_;
+    std::chrono::steady_clock::time_point write_start_{};
 
     write_message_op(any_stream& stream, message_writer& processor) noexcept
         : stream_(stream), processor_(processor)
@@ -53,6 +57,13 @@ struct write_message_op : boost::asio::coroutine
     template <class Self>
     void operator()(Self& self, error_code ec = {}, std::size_t bytes_written = 0)
     {
+        // Track the write we just completed, if any
+        if (write_start_ != std::chrono::steady_clock::time_point())
+        {
+            processor_.on_write_complete(write_start_);
+            write_start_ = std::chrono::steady_clock::time_point();
+        }
+
         // Error handling
         if (ec)
         {
@@ -67,6 +78,7 @@ struct write_message_op : boost::asio::coroutine
             BOOST_ASSERT(!processor_.done());
             while (!processor_.done())
             {
+                write_start_ = std::chrono::steady_clock::now();
                 BOOST_ASIO_CORO_YIELD stream_.async_write_some(
                     asio::buffer(processor_.next_chunk()),
                     std::move(self)
@@ -44,7 +44,9 @@ struct connect_op : boost::asio::coroutine
             diag_.clear();
 
             // Physical connect
+            chan_.tracer().begin(operation_phase::tcp_connect);
             BOOST_ASIO_CORO_YIELD chan_.stream().async_connect(ep_, std::move(self));
+            chan_.tracer().end(operation_phase::tcp_connect);
             if (code)
             {
                 chan_.stream().close(ignored);
@@ -76,7 +78,9 @@ inline void connect_impl(
     diag.clear();
 
     error_code ignored;
+    chan.tracer().begin(operation_phase::tcp_connect);
     chan.stream().connect(endpoint, err);
+    chan.tracer().end(operation_phase::tcp_connect);
     if (err)
     {
         chan.stream().close(ignored);
@@ -0,0 +1,377 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_NETWORK_ALGORITHMS_EXECUTE_PREPARED_ONCE_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_NETWORK_ALGORITHMS_EXECUTE_PREPARED_ONCE_HPP
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/diagnostics.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/field.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/statement.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/any_execution_request.hpp>
+#include <boost/mysql/detail/execution_processor/execution_processor.hpp>
+#include <boost/mysql/detail/resultset_encoding.hpp>
+
+#include <boost/mysql/impl/internal/channel/channel.hpp>
+#include <boost/mysql/impl/internal/network_algorithms/close_statement.hpp>
+#include <boost/mysql/impl/internal/network_algorithms/execute.hpp>
+#include <boost/mysql/impl/internal/network_algorithms/prepare_statement.hpp>
+#include <boost/mysql/impl/internal/network_algorithms/read_resultset_head.hpp>
+#include <boost/mysql/impl/internal/network_algorithms/read_some_rows.hpp>
+#include <boost/mysql/impl/internal/protocol/db_flavor.hpp>
+#include <boost/mysql/impl/internal/protocol/protocol.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/coroutine.hpp>
+#include <boost/core/span.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// MariaDB interprets this statement ID as "the last statement prepared in this session"
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::uint32_t mariadb_last_statement_id = 0xffffffff;
+
+inline bool can_pipeline_prepared_once(const channel& chan) noexcept
+{
+    return chan.flavor() == db_flavor::mariadb;
+}
+
+// Serializes prepare, execute and close requests, to be written together
+inline void compose_prepared_once_pipeline(
+    channel& chan,
+    string_view sql,
+    span<const field_view> params,
+    execution_processor& proc
+)
+{
+    proc.reset(resultset_encoding::binary, chan.meta_mode());
+    std::uint8_t close_seqnum = 0;  // close requests have no response
+    chan.begin_pipeline();
+    chan.serialize_pipelined(prepare_stmt_command{sql}, chan.reset_sequence_number());
+    chan.serialize_pipelined(execute_stmt_command{mariadb_last_statement_id, params}, proc.sequence_number());
+    chan.serialize_pipelined(close_stmt_command{mariadb_last_statement_id}, close_seqnum);
+}
+
+// Server errors leave the connection usable. Any other error means that we can't rely on
+// the server having sent the rest of the responses
+inline bool is_server_error(error_code err) noexcept
+{
+    return err && err.category() != get_client_category();
+}
+
+// The number of params is only checked after preparing the statement
+inline error_code check_prepared_once_params(const prepare_stmt_response& response, std::size_t num_params)
+{
+    return response.num_params == num_params ? error_code() : client_errc::wrong_num_params;
+}
+
+// Reads the response to an execution request, including any rows
+inline void read_execution_response(
+    channel& chan,
+    execution_processor& proc,
+    error_code& err,
+    diagnostics& diag
+)
+{
+    while (!proc.is_complete())
+    {
+        if (proc.is_reading_head())
+        {
+            read_resultset_head_impl(chan, proc, err, diag);
+            if (err)
+                return;
+        }
+        else if (proc.is_reading_rows())
+        {
+            read_some_rows_impl(chan, proc, output_ref(), err, diag);
+            if (err)
+                return;
+        }
+    }
+}
+
+struct execute_prepared_once_op : boost::asio::coroutine
+{
+    channel& chan_;
+    string_view sql_;
+    span<const field_view> params_;
+    execution_processor& proc_;
+    diagnostics& diag_;
+    error_code pending_err_;
+    statement stmt_;
+    prepare_stmt_response response_{};
+    unsigned remaining_meta_{};
+    diagnostics aux_diag_;
+    std::vector<field> owned_params_;  // only used by the fallback
+
+    execute_prepared_once_op(
+        channel& chan,
+        string_view sql,
+        span<const field_view> params,
+        execution_processor& proc,
+        diagnostics& diag
+    ) noexcept
+        : chan_(chan), sql_(sql), params_(params), proc_(proc), diag_(diag)
+    {
+        // The fallback serializes the execution request after initiation. Params may not be alive by then
+        if (!can_pipeline_prepared_once(chan))
+            owned_params_.assign(params.begin(), params.end());
+    }
+
+    template <class Self>
+    void operator()(Self& self, error_code err, statement stmt)
+    {
+        stmt_ = stmt;
+        (*this)(self, err);
+    }
+
+    // Rows are read into the processor
+    template <class Self>
+    void operator()(Self& self, error_code err, std::size_t)
+    {
+        (*this)(self, err);
+    }
+
+    template <class Self>
+    void operator()(Self& self, error_code err = {}, span<const std::uint8_t> read_message = {})
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            diag_.clear();
+
+            if (!can_pipeline_prepared_once(chan_))
+            {
+                // Fallback: one round trip per operation
+                BOOST_ASIO_CORO_YIELD async_prepare_statement_impl(chan_, sql_, diag_, std::move(self));
+                if (err)
+                {
+                    self.complete(err);
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+
+                chan_.shared_fields().assign(owned_params_.begin(), owned_params_.end());
+                params_ = chan_.shared_fields();
+                BOOST_ASIO_CORO_YIELD async_execute_impl(
+                    chan_,
+                    any_execution_request(stmt_, params_),
+                    proc_,
+                    diag_,
+                    std::move(self)
+                );
+
+                // Close the statement even if the execution failed. Errors in the execution take precedence
+                pending_err_ = err;
+                BOOST_ASIO_CORO_YIELD async_close_statement_impl(chan_, stmt_, aux_diag_, std::move(self));
+                self.complete(pending_err_ ? pending_err_ : err);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+
+            // Send the three requests at once
+            compose_prepared_once_pipeline(chan_, sql_, params_, proc_);
+            BOOST_ASIO_CORO_YIELD chan_.async_write(std::move(self));
+            if (err)
+            {
+                self.complete(err);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+
+            // Read the prepare response
+            BOOST_ASIO_CORO_YIELD chan_.async_read_one(chan_.shared_sequence_number(), std::move(self));
+            if (err)
+            {
+                self.complete(err);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+            err = deserialize_prepare_stmt_response(read_message, chan_.flavor(), response_, diag_);
+            if (err)
+            {
+                // The execution request fails, too. Read its response to keep the connection usable
+                pending_err_ = err;
+                if (is_server_error(err))
+                {
+                    err = error_code();
+                    while (!err && !proc_.is_complete())
+                    {
+                        if (proc_.is_reading_head())
+                        {
+                            BOOST_ASIO_CORO_YIELD
+                            async_read_resultset_head_impl(chan_, proc_, aux_diag_, std::move(self));
+                        }
+                        else
+                        {
+                            BOOST_ASIO_CORO_YIELD
+                            async_read_some_rows_impl(chan_, proc_, output_ref(), aux_diag_, std::move(self));
+                        }
+                    }
+                }
+                self.complete(pending_err_);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+            pending_err_ = check_prepared_once_params(response_, params_.size());
+
+            // Skip statement metadata
+            remaining_meta_ = response_.num_columns + response_.num_params;
+            while (remaining_meta_)
+            {
+                if (!chan_.has_read_messages())
+                {
+                    BOOST_ASIO_CORO_YIELD chan_.async_read_some(std::move(self));
+                    if (err)
+                    {
+                        self.complete(err);
+                        BOOST_ASIO_CORO_YIELD break;
+                    }
+                }
+                chan_.next_read_message(chan_.shared_sequence_number(), err);
+                if (err)
+                {
+                    self.complete(err);
+                    BOOST_ASIO_CORO_YIELD break;
+                }
+                --remaining_meta_;
+            }
+
+            // Read the execution response
+            while (!proc_.is_complete())
+            {
+                if (proc_.is_reading_head())
+                {
+                    BOOST_ASIO_CORO_YIELD
+                    async_read_resultset_head_impl(chan_, proc_, diag_, std::move(self));
+                }
+                else
+                {
+                    BOOST_ASIO_CORO_YIELD
+                    async_read_some_rows_impl(chan_, proc_, output_ref(), diag_, std::move(self));
+                }
+                if (err)
+                    break;
+            }
+
+            // A mismatch in the number of params takes precedence
+            if (pending_err_)
+            {
+                diag_.clear();
+                err = pending_err_;
+            }
+            self.complete(err);
+        }
+    }
+};
+
+// External interface
+inline void execute_prepared_once_impl(
+    channel& chan,
+    string_view sql,
+    span<const field_view> params,
+    execution_processor& proc,
+    error_code& err,
+    diagnostics& diag
+)
+{
+    err.clear();
+    diag.clear();
+
+    if (!can_pipeline_prepared_once(chan))
+    {
+        // Fallback: one round trip per operation
+        statement stmt = prepare_statement_impl(chan, sql, err, diag);
+        if (err)
+            return;
+        execute_impl(chan, any_execution_request(stmt, params), proc, err, diag);
+
+        // Close the statement even if the execution failed. Errors in the execution take precedence
+        error_code close_err;
+        diagnostics close_diag;
+        close_statement_impl(chan, stmt, close_err, close_diag);
+        if (!err)
+            err = close_err;
+        return;
+    }
+
+    // Send the three requests at once
+    compose_prepared_once_pipeline(chan, sql, params, proc);
+    chan.write(err);
+    if (err)
+        return;
+
+    // Read the prepare response
+    auto msg = chan.read_one(chan.shared_sequence_number(), err);
+    if (err)
+        return;
+    prepare_stmt_response response{};
+    err = deserialize_prepare_stmt_response(msg, chan.flavor(), response, diag);
+    if (err)
+    {
+        // The execution request fails, too. Read its response to keep the connection usable
+        if (is_server_error(err))
+        {
+            error_code exec_err;
+            diagnostics exec_diag;
+            read_execution_response(chan, proc, exec_err, exec_diag);
+        }
+        return;
+    }
+    error_code params_err = check_prepared_once_params(response, params.size());
+
+    // Skip statement metadata
+    unsigned remaining_meta = response.num_columns + response.num_params;
+    for (; remaining_meta != 0u; --remaining_meta)
+    {
+        if (!chan.has_read_messages())
+        {
+            chan.read_some(err);
+            if (err)
+                return;
+        }
+        chan.next_read_message(chan.shared_sequence_number(), err);
+        if (err)
+            return;
+    }
+
+    // Read the execution response
+    read_execution_response(chan, proc, err, diag);
+
+    // A mismatch in the number of params takes precedence
+    if (params_err)
+    {
+        diag.clear();
+        err = params_err;
+    }
+}
+
+template <class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+async_execute_prepared_once_impl(
+    channel& chan,
+    string_view sql,
+    span<const field_view> params,
+    execution_processor& proc,
+    diagnostics& diag,
+    CompletionToken&& token
+)
+{
+    return asio::async_compose<CompletionToken, void(error_code)>(
+        execute_prepared_once_op(chan, sql, params, proc, diag),
+        token,
+        chan
+    );
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
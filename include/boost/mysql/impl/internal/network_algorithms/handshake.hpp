@@ -8,17 +8,29 @@
 #ifndef BOOST_MYSQL_IMPL_INTERNAL_NETWORK_ALGORITHMS_HANDSHAKE_HPP
 #define BOOST_MYSQL_IMPL_INTERNAL_NETWORK_ALGORITHMS_HANDSHAKE_HPP
 
+#include <boost/mysql/auth_plugin_cache.hpp>
 #include <boost/mysql/client_errc.hpp>
 #include <boost/mysql/diagnostics.hpp>
 #include <boost/mysql/error_code.hpp>
 #include <boost/mysql/handshake_params.hpp>
 
+#include <boost/mysql/detail/access.hpp>
 #include <boost/mysql/detail/config.hpp>
 
 #include <boost/mysql/impl/internal/auth/auth.hpp>
 #include <boost/mysql/impl/internal/channel/channel.hpp>
 #include <boost/mysql/impl/internal/protocol/capabilities.hpp>
 #include <boost/mysql/impl/internal/protocol/protocol.hpp>
+#include <boost/mysql/impl/internal/usdt.hpp>
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/associator.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/dispatch.hpp>
+
+#include <string>
+#include <type_traits>
+#include <utility>
 
 namespace boost {
 namespace mysql {
@@ -86,6 +98,23 @@ class handshake_processor
     channel& channel_;
     auth_response auth_resp_;
     auth_state auth_state_{auth_state::invalid};
+    string_view login_plugin_;    // the plugin used by the login request
+    std::string server_address_;  // only retrieved if there is an auth plugin cache
+
+    auth_plugin_cache_impl* auth_cache() noexcept
+    {
+        auto* cache = channel_.auth_cache();
+        return cache ? &access::get_impl(*cache) : nullptr;
+    }
+
+    // If authentication required switching plugins, remember the final one, so
+    // the next handshake can use it from the start
+    void update_auth_cache()
+    {
+        auto* cache = auth_cache();
+        if (cache && auth_resp_.plugin_name != login_plugin_)
+            cache->store(server_address_, params_.username(), auth_resp_.plugin_name);
+    }
 
 public:
     handshake_processor(const handshake_params& params, diagnostics& diag, channel& channel)
@@ -115,6 +144,34 @@ public:
         // Set capabilities & db flavor
         channel_.set_current_capabilities(negotiated_caps);
         channel_.set_flavor(hello.server);
+        BOOST_MYSQL_USDT3(
+            handshake_hello,
+            hello.auth_plugin_name.data(),
+            hello.auth_plugin_name.size(),
+            use_ssl()
+        );
+
+        // If the account's plugin is known, compute its response using the hello's scramble.
+        // If the server agrees on the plugin, this saves the auth switch round trip.
+        // Otherwise, the server will request a switch, as it would have done anyway
+        auto* cache = auth_cache();
+        if (cache)
+        {
+            server_address_ = channel_.stream().remote_address();
+            auto cached_plugin = cache->find(server_address_, params_.username());
+            if (!cached_plugin.empty() && cached_plugin != hello.auth_plugin_name)
+            {
+                err = compute_auth_response(
+                    cached_plugin,
+                    params_.password(),
+                    hello.auth_plugin_data.to_span(),
+                    use_ssl(),
+                    auth_resp_
+                );
+                if (!err)
+                    return err;
+            }
+        }
 
         // Compute auth response
         return compute_auth_response(
@@ -139,6 +196,8 @@ public:
 
     void compose_login_request()
     {
+        login_plugin_ = auth_resp_.plugin_name;
+
         // Compose login request
         login_request response{
             channel_.current_capabilities(),
@@ -166,9 +225,19 @@ public:
         case handhake_server_response::type_t::ok:
             // Auth success
             auth_state_ = auth_state::complete;
+            BOOST_MYSQL_USDT1(handshake_auth_finish, 0);
+            update_auth_cache();
             return error_code();
-        case handhake_server_response::type_t::error: return response.data.err;
+        case handhake_server_response::type_t::error:
+            BOOST_MYSQL_USDT1(handshake_auth_finish, response.data.err.value());
+            return response.data.err;
         case handhake_server_response::type_t::auth_switch:
+            BOOST_MYSQL_USDT2(
+                handshake_auth_switch,
+                response.data.auth_sw.plugin_name.data(),
+                response.data.auth_sw.plugin_name.size()
+            );
+
             // Compute response
             err = compute_auth_response(
                 response.data.auth_sw.plugin_name,
@@ -189,6 +258,8 @@ public:
             auth_state_ = auth_state::wait_for_ok;
             return error_code();
         case handhake_server_response::type_t::auth_more_data:
+            BOOST_MYSQL_USDT1(handshake_auth_more_data, response.data.more_data.size());
+
             // Compute response
             err = compute_auth_response(
                 auth_resp_.plugin_name,
@@ -214,9 +285,66 @@ public:
     bool auth_complete() const noexcept { return auth_state_ == auth_state::complete; }
 };
 
+// Resumes an operation in its own executor, once an offloaded TLS handshake finishes
+template <class Handler>
+class tls_handshake_resume_handler
+{
+    Handler handler_;
+    error_code err_;
+
+public:
+    tls_handshake_resume_handler(Handler&& handler, error_code err)
+        : handler_(std::move(handler)), err_(err)
+    {
+    }
+
+    const Handler& get() const noexcept { return handler_; }
+
+    void operator()() { std::move(handler_)(err_); }
+};
+
+// Completion handler for TLS handshakes run in a separate executor. Intermediate handlers
+// of the TLS handshake (where the crypto work happens) run in the handler's associated
+// executor, which is set to the offload executor using bind_executor. Once the handshake finishes,
+// the operation is resumed in its own executor. Other associated properties (like the allocator
+// and cancellation slot) are the ones of the operation
+template <class Handler>
+class offloaded_tls_handshake_handler
+{
+    Handler handler_;
+
+public:
+    explicit offloaded_tls_handshake_handler(Handler&& handler) : handler_(std::move(handler)) {}
+
+    const Handler& get() const noexcept { return handler_; }
+
+    void operator()(error_code err)
+    {
+        auto ex = asio::get_associated_executor(handler_);
+        asio::dispatch(ex, tls_handshake_resume_handler<Handler>(std::move(handler_), err));
+    }
+};
+
+template <class Handler>
+using offloaded_tls_handshake_handler_t = asio::executor_binder<
+    offloaded_tls_handshake_handler<typename std::decay<Handler>::type>,
+    asio::any_io_executor>;
+
+template <class Handler>
+offloaded_tls_handshake_handler_t<Handler> make_offloaded_tls_handshake_handler(
+    const asio::any_io_executor& ex,
+    Handler&& handler
+)
+{
+    using handler_type = offloaded_tls_handshake_handler<typename std::decay<Handler>::type>;
+    return asio::bind_executor(ex, handler_type(std::forward<Handler>(handler)));
+}
+
 struct handshake_op : boost::asio::coroutine
 {
     handshake_processor processor_;
+    bool tls_handshake_running_{false};
+    bool tls_handshake_offloaded_{false};
 
     handshake_op(const handshake_params& params, diagnostics& diag, channel& channel)
         : processor_(params, diag, channel)
@@ -228,6 +356,20 @@ struct handshake_op : boost::asio::coroutine
     template <class Self>
     void operator()(Self& self, error_code err = {}, span<const std::uint8_t> read_msg = {})
     {
+        // The TLS handshake finished, either successfully or not. If it was offloaded,
+        // we're back in the connection's executor, where the deadline can close the stream
+        if (tls_handshake_running_)
+        {
+            tls_handshake_running_ = false;
+            if (tls_handshake_offloaded_)
+            {
+                tls_handshake_offloaded_ = false;
+                get_channel().resume_deadline();
+            }
+            BOOST_MYSQL_USDT1(handshake_tls_finish, err.value());
+            get_channel().tracer().end(operation_phase::tls_handshake);
+        }
+
         // Error checking
         if (err)
         {
@@ -265,10 +407,30 @@ struct handshake_op : boost::asio::coroutine
                 BOOST_ASIO_CORO_YIELD get_channel().async_write(std::move(self));
 
                 // SSL handshake
-                BOOST_ASIO_CORO_YIELD get_channel().stream().async_handshake(std::move(self));
+                get_channel().tracer().begin(operation_phase::tls_handshake);
+                BOOST_MYSQL_USDT0(handshake_tls_start);
+                tls_handshake_running_ = true;
+                if (get_channel().tls_handshake_executor())
+                {
+                    // The handshake uses the stream from the offload executor's threads.
+                    // Closing it meanwhile would be a data race, so the deadline is paused
+                    tls_handshake_offloaded_ = true;
+                    get_channel().pause_deadline();
+                    BOOST_ASIO_CORO_YIELD get_channel().stream().async_handshake(
+                        make_offloaded_tls_handshake_handler(
+                            get_channel().tls_handshake_executor(),
+                            std::move(self)
+                        )
+                    );
+                }
+                else
+                {
+                    BOOST_ASIO_CORO_YIELD get_channel().stream().async_handshake(std::move(self));
+                }
             }
 
             // Compose and send handshake response
+            get_channel().tracer().begin(operation_phase::authentication);
             processor_.compose_login_request();
             BOOST_ASIO_CORO_YIELD get_channel().async_write(std::move(self));
 
@@ -295,6 +457,7 @@ struct handshake_op : boost::asio::coroutine
                 }
             }
 
+            get_channel().tracer().end(operation_phase::authentication);
             self.complete(error_code());
         }
     }
@@ -335,12 +498,17 @@ inline void handshake_impl(
             return;
 
         // SSL handshake
+        channel.tracer().begin(operation_phase::tls_handshake);
+        BOOST_MYSQL_USDT0(handshake_tls_start);
         channel.stream().handshake(err);
+        BOOST_MYSQL_USDT1(handshake_tls_finish, err.value());
+        channel.tracer().end(operation_phase::tls_handshake);
         if (err)
             return;
     }
 
     // Handshake response
+    channel.tracer().begin(operation_phase::authentication);
     processor.compose_login_request();
     channel.write(err);
     if (err)
@@ -366,6 +534,7 @@ inline void handshake_impl(
                 return;
         }
     };
+    channel.tracer().end(operation_phase::authentication);
 }
 
 template <class CompletionToken>
@@ -386,6 +555,54 @@ async_handshake_impl(
 
 }  // namespace detail
 }  // namespace mysql
+
+namespace asio {
+
+template <template <class, class> class Associator, class Handler, class DefaultCandidate>
+struct associator<Associator, mysql::detail::offloaded_tls_handshake_handler<Handler>, DefaultCandidate>
+    : Associator<Handler, DefaultCandidate>
+{
+    using inner_associator = Associator<Handler, DefaultCandidate>;
+
+    static typename inner_associator::type get(
+        const mysql::detail::offloaded_tls_handshake_handler<Handler>& h
+    ) noexcept
+    {
+        return inner_associator::get(h.get());
+    }
+
+    static typename inner_associator::type get(
+        const mysql::detail::offloaded_tls_handshake_handler<Handler>& h,
+        const DefaultCandidate& c
+    ) noexcept
+    {
+        return inner_associator::get(h.get(), c);
+    }
+};
+
+template <template <class, class> class Associator, class Handler, class DefaultCandidate>
+struct associator<Associator, mysql::detail::tls_handshake_resume_handler<Handler>, DefaultCandidate>
+    : Associator<Handler, DefaultCandidate>
+{
+    using inner_associator = Associator<Handler, DefaultCandidate>;
+
+    static typename inner_associator::type get(
+        const mysql::detail::tls_handshake_resume_handler<Handler>& h
+    ) noexcept
+    {
+        return inner_associator::get(h.get());
+    }
+
+    static typename inner_associator::type get(
+        const mysql::detail::tls_handshake_resume_handler<Handler>& h,
+        const DefaultCandidate& c
+    ) noexcept
+    {
+        return inner_associator::get(h.get(), c);
+    }
+};
+
+}  // namespace asio
 }  // namespace boost
 
 #endif
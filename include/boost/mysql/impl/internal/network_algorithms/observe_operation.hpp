@@ -0,0 +1,54 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_NETWORK_ALGORITHMS_OBSERVE_OPERATION_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_NETWORK_ALGORITHMS_OBSERVE_OPERATION_HPP
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/operation_observer.hpp>
+
+#include <boost/mysql/detail/any_execution_request.hpp>
+
+#include <boost/mysql/impl/internal/channel/channel.hpp>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Notifies the observer, if any, that an operation running an execution request is starting
+inline bool start_operation(channel& chan, operation_type type, const any_execution_request& req) noexcept
+{
+    return req.is_query ? chan.start_operation(type, req.data.query)
+                        : chan.start_operation(type, string_view(), req.data.stmt.stmt.id());
+}
+
+// Used by sync operations. Notifies the observer when the operation finishes
+class operation_guard
+{
+    channel& chan_;
+    bool observed_;
+    const error_code& err_;
+
+public:
+    operation_guard(channel& chan, bool observed, const error_code& err) noexcept
+        : chan_(chan), observed_(observed), err_(err)
+    {
+    }
+    operation_guard(const operation_guard&) = delete;
+    operation_guard& operator=(const operation_guard&) = delete;
+    ~operation_guard()
+    {
+        if (observed_)
+            chan_.finish_operation(err_);
+    }
+};
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
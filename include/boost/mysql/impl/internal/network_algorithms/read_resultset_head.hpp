@@ -102,6 +102,7 @@ struct read_resultset_head_op : boost::asio::coroutine
 
             // Read the response
             BOOST_ASIO_CORO_YIELD chan_.async_read_one(proc_.sequence_number(), std::move(self));
+            chan_.tracer().begin(operation_phase::metadata_read);
 
             // Response may be: ok_packet, err_packet, local infile request
             // (not implemented), or response with fields
@@ -131,6 +132,7 @@ struct read_resultset_head_op : boost::asio::coroutine
             }
 
             // No EOF packet is expected here, as we require deprecate EOF capabilities
+            chan_.tracer().end(operation_phase::metadata_read);
             self.complete(err);
         }
     }
@@ -156,6 +158,7 @@ inline void read_resultset_head_impl(
     auto msg = chan.read_one(proc.sequence_number(), err);
     if (err)
         return;
+    chan.tracer().begin(operation_phase::metadata_read);
 
     // Response may be: ok_packet, err_packet, local infile request
     // (not implemented), or response with fields
@@ -179,6 +182,7 @@ inline void read_resultset_head_impl(
         if (err)
             return;
     }
+    chan.tracer().end(operation_phase::metadata_read);
 }
 
 template <class CompletionToken>
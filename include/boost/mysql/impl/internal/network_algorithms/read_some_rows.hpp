@@ -15,28 +15,32 @@
 #include <boost/mysql/detail/execution_processor/execution_processor.hpp>
 
 #include <boost/mysql/impl/internal/channel/channel.hpp>
+#include <boost/mysql/impl/internal/usdt.hpp>
 
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/coroutine.hpp>
 #include <boost/asio/post.hpp>
 
+#include <chrono>
 #include <cstddef>
 
 namespace boost {
 namespace mysql {
 namespace detail {
 
-BOOST_ATTRIBUTE_NODISCARD inline error_code process_some_rows(
+BOOST_ATTRIBUTE_NODISCARD inline error_code process_some_rows_untimed(
     channel& chan,
     execution_processor& proc,
     output_ref output,
     std::size_t& read_rows,
+    std::size_t& read_bytes,
     diagnostics& diag
 )
 {
     // Process all read messages until they run out, an error happens
     // or an EOF is received
     read_rows = 0;
+    read_bytes = 0;
     error_code err;
     proc.on_row_batch_start();
     while (chan.has_read_messages() && proc.is_reading_rows() && read_rows < output.max_size())
@@ -45,6 +49,7 @@ BOOST_ATTRIBUTE_NODISCARD inline error_code process_some_rows(
         auto buff = chan.next_read_message(proc.sequence_number(), err);
         if (err)
             return err;
+        read_bytes += buff.size();
 
         // Deserialize it
         auto res = deserialize_row_message(buff, chan.flavor(), diag);
@@ -71,6 +76,24 @@ BOOST_ATTRIBUTE_NODISCARD inline error_code process_some_rows(
     return error_code();
 }
 
+BOOST_ATTRIBUTE_NODISCARD inline error_code process_some_rows(
+    channel& chan,
+    execution_processor& proc,
+    output_ref output,
+    std::size_t& read_rows,
+    diagnostics& diag
+)
+{
+    std::size_t read_bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto err = process_some_rows_untimed(chan, proc, output, read_rows, read_bytes, diag);
+    auto finish = std::chrono::steady_clock::now();
+    BOOST_MYSQL_USDT2(rows_decoded, read_rows, read_bytes);
+    chan.on_rows_decoded(read_rows, finish - start);
+    chan.tracer().record(operation_phase::rows_read, start, finish);
+    return err;
+}
+
 struct read_some_rows_impl_op : boost::asio::coroutine
 {
     channel& chan_;
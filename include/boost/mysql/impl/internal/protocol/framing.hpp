@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_PROTOCOL_FRAMING_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_PROTOCOL_FRAMING_HPP
+
+#include <boost/mysql/impl/internal/protocol/constants.hpp>
+#include <boost/mysql/impl/internal/protocol/protocol.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/core/span.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Splitting messages into frames. Every frame has a header with its size and sequence number.
+// Messages bigger than the maximum frame size are split into several frames with consecutive
+// sequence numbers, and messages with a size multiple of it are terminated by an empty frame.
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Number of frames a message with msg_size bytes is split into
+constexpr std::size_t num_frames(std::size_t msg_size, std::size_t max_frame_size = MAX_PACKET_SIZE) noexcept
+{
+    return msg_size / max_frame_size + 1u;
+}
+
+// Writes the header of a frame with frame_size bytes to the HEADER_SIZE bytes pointed by to
+inline void write_frame_header(std::uint8_t* to, std::size_t frame_size, std::uint8_t seqnum) noexcept
+{
+    BOOST_ASSERT(frame_size <= MAX_PACKET_SIZE);
+    serialize_frame_header(
+        frame_header{static_cast<std::uint32_t>(frame_size), seqnum},
+        span<std::uint8_t, frame_header_size>(to, frame_header_size)
+    );
+}
+
+// Framing a message in a buffer, when all its frames are to be written at once.
+// reserve_framed_message grows buff to hold the framed message at its end, and returns the offset
+// where the payload should be serialized: after the space reserved for its frame headers.
+// Once serialized, frame_message interleaves frame headers with the payload.
+inline std::size_t reserve_framed_message(
+    std::vector<std::uint8_t>& buff,
+    std::size_t msg_size,
+    std::size_t max_frame_size = MAX_PACKET_SIZE
+)
+{
+    std::size_t payload_offset = buff.size() + num_frames(msg_size, max_frame_size) * HEADER_SIZE;
+    buff.resize(payload_offset + msg_size);
+    return payload_offset;
+}
+
+// first points to the beginning of the framed message (the offset buff had before calling
+// reserve_framed_message). Frames are moved towards the beginning of the buffer, so no data
+// is overwritten before being moved. The last frame is already in place, so single-frame
+// messages are not moved. Returns the sequence number following the message's last frame
+inline std::uint8_t frame_message(
+    std::uint8_t* first,
+    std::size_t msg_size,
+    std::uint8_t seqnum,
+    std::size_t max_frame_size = MAX_PACKET_SIZE
+) noexcept
+{
+    std::size_t frames = num_frames(msg_size, max_frame_size);
+    const std::uint8_t* src = first + frames * HEADER_SIZE;
+    std::uint8_t* dst = first;
+    std::size_t remaining = msg_size;
+    for (std::size_t i = 0; i < frames; ++i)
+    {
+        std::size_t size = (std::min)(max_frame_size, remaining);
+        write_frame_header(dst, size, seqnum++);
+        dst += HEADER_SIZE;
+        if (size && dst != src)
+            std::memmove(dst, src, size);
+        dst += size;
+        src += size;
+        remaining -= size;
+    }
+    return seqnum;
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
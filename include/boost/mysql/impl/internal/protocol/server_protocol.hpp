@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_PROTOCOL_SERVER_PROTOCOL_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_PROTOCOL_SERVER_PROTOCOL_HPP
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/server_command.hpp>
+#include <boost/mysql/server_messages.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/mysql/impl/internal/protocol/capabilities.hpp>
+#include <boost/mysql/impl/internal/protocol/protocol.hpp>
+
+#include <boost/core/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// The server side of the protocol: the counterparts of the messages in protocol.hpp.
+// Messages sent by the server have get_size() and serialize(), like client requests.
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Capabilities announced by server_connection. Clients must support the mandatory ones
+constexpr capabilities server_connection_capabilities = mandatory_capabilities | optional_capabilities |
+                                                        capabilities(CLIENT_CONNECT_WITH_DB);
+
+// Size of the authentication challenge (scramble). Only mysql_native_password is supported
+constexpr std::size_t server_scramble_size = 20;
+
+// Status flags sent in OK packets. Transactions aren't tracked, so autocommit is always reported
+constexpr std::uint16_t server_status_autocommit = 2;
+
+// Server hello
+struct server_hello_message
+{
+    string_view server_version;
+    std::uint32_t connection_id;
+    span<const std::uint8_t> scramble;  // server_scramble_size bytes
+    std::uint16_t collation_id;
+    string_view auth_plugin_name;
+
+    BOOST_MYSQL_DECL std::size_t get_size() const noexcept;
+    BOOST_MYSQL_DECL void serialize(span<std::uint8_t> buffer) const noexcept;
+};
+
+// Auth switch request
+struct auth_switch_message
+{
+    string_view plugin_name;
+    span<const std::uint8_t> auth_data;
+
+    BOOST_MYSQL_DECL std::size_t get_size() const noexcept;
+    BOOST_MYSQL_DECL void serialize(span<std::uint8_t> buffer) const noexcept;
+};
+
+// OK packets. Resultsets end with an OK packet with a 0xfe header
+struct ok_message
+{
+    std::uint8_t header;
+    server_ok content;
+    std::uint16_t status_flags;
+
+    BOOST_MYSQL_DECL std::size_t get_size() const noexcept;
+    BOOST_MYSQL_DECL void serialize(span<std::uint8_t> buffer) const noexcept;
+};
+
+// Error packets
+struct error_message
+{
+    std::uint16_t code;
+    string_view message;
+
+    BOOST_MYSQL_DECL std::size_t get_size() const noexcept;
+    BOOST_MYSQL_DECL void serialize(span<std::uint8_t> buffer) const noexcept;
+};
+
+// Resultset heads
+struct column_count_message
+{
+    std::size_t num_columns;
+
+    BOOST_MYSQL_DECL std::size_t get_size() const noexcept;
+    BOOST_MYSQL_DECL void serialize(span<std::uint8_t> buffer) const noexcept;
+};
+
+struct column_definition_message
+{
+    const server_column& column;
+
+    BOOST_MYSQL_DECL std::size_t get_size() const noexcept;
+    BOOST_MYSQL_DECL void serialize(span<std::uint8_t> buffer) const noexcept;
+};
+
+// Prepare statement response. Followed by parameter and column definitions
+struct prepare_ok_message
+{
+    std::uint32_t statement_id;
+    std::uint16_t num_columns;
+    std::uint16_t num_params;
+
+    BOOST_MYSQL_DECL std::size_t get_size() const noexcept;
+    BOOST_MYSQL_DECL void serialize(span<std::uint8_t> buffer) const noexcept;
+};
+
+// Rows. Fields are encoded according to the column they belong to
+struct row_column
+{
+    column_type type;
+    std::uint8_t decimals;
+};
+
+struct text_row_message
+{
+    span<const field_view> fields;
+    span<const row_column> columns;  // same size as fields
+
+    BOOST_MYSQL_DECL std::size_t get_size() const noexcept;
+    BOOST_MYSQL_DECL void serialize(span<std::uint8_t> buffer) const noexcept;
+};
+
+struct binary_row_message
+{
+    span<const field_view> fields;
+    span<const row_column> columns;  // same size as fields
+
+    BOOST_MYSQL_DECL std::size_t get_size() const noexcept;
+    BOOST_MYSQL_DECL void serialize(span<std::uint8_t> buffer) const noexcept;
+};
+
+// Login request. This is the message serialized by login_request. String and spans point into msg
+BOOST_ATTRIBUTE_NODISCARD BOOST_MYSQL_DECL error_code
+deserialize_login_request(span<const std::uint8_t> msg, login_request& output) noexcept;
+
+// Commands. The output points into msg
+BOOST_ATTRIBUTE_NODISCARD BOOST_MYSQL_DECL error_code
+deserialize_server_command(span<const std::uint8_t> msg, server_command& output) noexcept;
+
+// Execute statement parameters. msg is the entire command. Fields point into msg
+BOOST_ATTRIBUTE_NODISCARD BOOST_MYSQL_DECL error_code
+deserialize_statement_params(span<const std::uint8_t> msg, span<field_view> output) noexcept;
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/internal/protocol/server_protocol.ipp>
+#endif
+
+#endif
@@ -0,0 +1,815 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_PROTOCOL_SERVER_PROTOCOL_IPP
+#define BOOST_MYSQL_IMPL_INTERNAL_PROTOCOL_SERVER_PROTOCOL_IPP
+
+#pragma once
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/field_kind.hpp>
+#include <boost/mysql/metadata.hpp>
+#include <boost/mysql/mysql_collations.hpp>
+
+#include <boost/mysql/detail/access.hpp>
+#include <boost/mysql/detail/coldef_view.hpp>
+#include <boost/mysql/detail/flags.hpp>
+
+#include <boost/mysql/impl/internal/protocol/binary_serialization.hpp>
+#include <boost/mysql/impl/internal/protocol/constants.hpp>
+#include <boost/mysql/impl/internal/protocol/deserialize_binary_field.hpp>
+#include <boost/mysql/impl/internal/protocol/null_bitmap_traits.hpp>
+#include <boost/mysql/impl/internal/protocol/protocol_field_type.hpp>
+#include <boost/mysql/impl/internal/protocol/serialization.hpp>
+#include <boost/mysql/impl/internal/protocol/server_protocol.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Constants
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::uint8_t server_protocol_version = 10;
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::uint8_t server_error_header = 0xff;
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::uint8_t server_auth_switch_header = 0xfe;
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::uint8_t server_null_text_field = 0xfb;
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::size_t server_scramble_part1_size = 8;
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr unsigned server_max_decimals = 6;
+
+// Text representation of fields. Strings and blobs are sent as they are.
+// Any other value fits in this many bytes.
+BOOST_MYSQL_STATIC_IF_COMPILED constexpr std::size_t max_text_field_size = 32;
+
+BOOST_MYSQL_STATIC_OR_INLINE
+std::size_t count_digits(std::uint64_t v) noexcept
+{
+    std::size_t res = 1;
+    while (v >= 10u)
+    {
+        v /= 10u;
+        ++res;
+    }
+    return res;
+}
+
+// Writes exactly num_digits digits, padding with zeros
+BOOST_MYSQL_STATIC_OR_INLINE
+char* write_digits(std::uint64_t v, std::size_t num_digits, char* output) noexcept
+{
+    for (std::size_t i = num_digits; i > 0; --i)
+    {
+        output[i - 1] = static_cast<char>('0' + v % 10u);
+        v /= 10u;
+    }
+    return output + num_digits;
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+char* format_uint(std::uint64_t v, char* output) noexcept { return write_digits(v, count_digits(v), output); }
+
+BOOST_MYSQL_STATIC_OR_INLINE
+char* format_int(std::int64_t v, char* output) noexcept
+{
+    if (v < 0)
+    {
+        *output++ = '-';
+        return format_uint(0u - static_cast<std::uint64_t>(v), output);
+    }
+    return format_uint(static_cast<std::uint64_t>(v), output);
+}
+
+// Uses the shortest of the two usual precisions that round-trips
+template <class T>
+char* format_float(T v, char* output) noexcept
+{
+    BOOST_ASSERT(!std::isnan(v) && !std::isinf(v));
+    int size = std::snprintf(
+        output,
+        max_text_field_size,
+        "%.*g",
+        std::numeric_limits<T>::digits10,
+        static_cast<double>(v)
+    );
+    if (static_cast<T>(std::strtod(output, nullptr)) != v)
+    {
+        size = std::snprintf(
+            output,
+            max_text_field_size,
+            "%.*g",
+            std::numeric_limits<T>::max_digits10,
+            static_cast<double>(v)
+        );
+    }
+    return output + size;
+}
+
+// The client expects exactly as many fractional digits as the column decimals
+BOOST_MYSQL_STATIC_OR_INLINE
+char* format_micros(std::uint64_t micros, unsigned decimals, char* output) noexcept
+{
+    if (decimals)
+    {
+        *output++ = '.';
+        std::uint64_t divisor = 1u;
+        for (unsigned i = decimals; i < server_max_decimals; ++i)
+            divisor *= 10u;
+        output = write_digits(micros / divisor, decimals, output);
+    }
+    return output;
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+char* format_date(const date& d, char* output) noexcept
+{
+    output = write_digits(d.year(), 4, output);
+    *output++ = '-';
+    output = write_digits(d.month(), 2, output);
+    *output++ = '-';
+    return write_digits(d.day(), 2, output);
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+char* format_hms(std::uint64_t hours, std::uint64_t minutes, std::uint64_t seconds, char* output) noexcept
+{
+    output = write_digits(hours, (std::max)(count_digits(hours), std::size_t(2)), output);
+    *output++ = ':';
+    output = write_digits(minutes, 2, output);
+    *output++ = ':';
+    return write_digits(seconds, 2, output);
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+char* format_datetime(const datetime& dt, unsigned decimals, char* output) noexcept
+{
+    output = format_date(date(dt.year(), dt.month(), dt.day()), output);
+    *output++ = ' ';
+    output = format_hms(dt.hour(), dt.minute(), dt.second(), output);
+    return format_micros(dt.microsecond(), decimals, output);
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+char* format_time(const boost::mysql::time& t, unsigned decimals, char* output) noexcept
+{
+    constexpr std::uint64_t micros_per_second = 1000000u;
+    auto count = t.count();
+    if (count < 0)
+        *output++ = '-';
+    auto total = count < 0 ? 0u - static_cast<std::uint64_t>(count) : static_cast<std::uint64_t>(count);
+    auto total_secs = total / micros_per_second;
+    output = format_hms(total_secs / 3600u, (total_secs / 60u) % 60u, total_secs % 60u, output);
+    return format_micros(total % micros_per_second, decimals, output);
+}
+
+// Returns the text representation of f. Uses buffer, which must be max_text_field_size long, if required
+BOOST_MYSQL_STATIC_OR_INLINE
+string_view to_text(field_view f, row_column col, char* buffer) noexcept
+{
+    unsigned decimals = (std::min)(static_cast<unsigned>(col.decimals), server_max_decimals);
+    char* end = buffer;
+    switch (f.kind())
+    {
+    case field_kind::string: return f.get_string();
+    case field_kind::blob: return to_string(f.get_blob());
+    case field_kind::int64: end = format_int(f.get_int64(), buffer); break;
+    case field_kind::uint64:
+        if (col.type == column_type::bit)
+        {
+            // BIT values are sent as big-endian binary strings
+            endian::store_big_u64(reinterpret_cast<unsigned char*>(buffer), f.get_uint64());
+            end = buffer + 8;
+        }
+        else
+        {
+            end = format_uint(f.get_uint64(), buffer);
+        }
+        break;
+    case field_kind::float_: end = format_float(f.get_float(), buffer); break;
+    case field_kind::double_: end = format_float(f.get_double(), buffer); break;
+    case field_kind::date: end = format_date(f.get_date(), buffer); break;
+    case field_kind::datetime: end = format_datetime(f.get_datetime(), decimals, buffer); break;
+    case field_kind::time: end = format_time(f.get_time(), decimals, buffer); break;
+    default: BOOST_ASSERT(false); break;
+    }
+    BOOST_ASSERT(static_cast<std::size_t>(end - buffer) <= max_text_field_size);
+    return string_view(buffer, static_cast<std::size_t>(end - buffer));
+}
+
+// Numeric conversions for the binary protocol. Clients interpret values according
+// to the column type, so numbers are converted to the column type width.
+BOOST_MYSQL_STATIC_OR_INLINE
+std::uint64_t to_uint64_bits(field_view f) noexcept
+{
+    switch (f.kind())
+    {
+    case field_kind::int64: return static_cast<std::uint64_t>(f.get_int64());
+    case field_kind::uint64: return f.get_uint64();
+    case field_kind::float_: return static_cast<std::uint64_t>(static_cast<std::int64_t>(f.get_float()));
+    case field_kind::double_: return static_cast<std::uint64_t>(static_cast<std::int64_t>(f.get_double()));
+    default: BOOST_ASSERT(false); return 0;
+    }
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+double to_double(field_view f) noexcept
+{
+    switch (f.kind())
+    {
+    case field_kind::int64: return static_cast<double>(f.get_int64());
+    case field_kind::uint64: return static_cast<double>(f.get_uint64());
+    case field_kind::float_: return f.get_float();
+    case field_kind::double_: return f.get_double();
+    default: BOOST_ASSERT(false); return 0.0;
+    }
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+field_view to_binary_date(field_view f) noexcept
+{
+    if (f.is_datetime())
+    {
+        const auto& dt = f.get_datetime();
+        return field_view(date(dt.year(), dt.month(), dt.day()));
+    }
+    BOOST_ASSERT(f.is_date());
+    return f;
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+field_view to_binary_datetime(field_view f) noexcept
+{
+    if (f.is_date())
+    {
+        const auto& d = f.get_date();
+        return field_view(datetime(d.year(), d.month(), d.day()));
+    }
+    BOOST_ASSERT(f.is_datetime());
+    return f;
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+std::size_t get_binary_field_size(field_view f, row_column col, char* buffer) noexcept
+{
+    switch (col.type)
+    {
+    case column_type::tinyint: return 1;
+    case column_type::smallint:
+    case column_type::year: return 2;
+    case column_type::mediumint:
+    case column_type::int_: return 4;
+    case column_type::bigint: return 8;
+    case column_type::float_: return 4;
+    case column_type::double_: return 8;
+    case column_type::date: return binc::length_sz + binc::date_sz;
+    case column_type::datetime:
+    case column_type::timestamp: return binc::length_sz + binc::datetime_dhmsu_sz;
+    case column_type::time: return binc::length_sz + binc::time_dhmsu_sz;
+    default: return get_size(string_lenenc{to_text(f, col, buffer)});
+    }
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+void serialize_binary_field(serialization_context& ctx, field_view f, row_column col, char* buffer) noexcept
+{
+    switch (col.type)
+    {
+    case column_type::tinyint: serialize(ctx, static_cast<std::uint8_t>(to_uint64_bits(f))); break;
+    case column_type::smallint:
+    case column_type::year: serialize(ctx, static_cast<std::uint16_t>(to_uint64_bits(f))); break;
+    case column_type::mediumint:
+    case column_type::int_: serialize(ctx, static_cast<std::uint32_t>(to_uint64_bits(f))); break;
+    case column_type::bigint: serialize(ctx, to_uint64_bits(f)); break;
+    case column_type::float_: serialize(ctx, field_view(static_cast<float>(to_double(f)))); break;
+    case column_type::double_: serialize(ctx, field_view(to_double(f))); break;
+    case column_type::date: serialize(ctx, to_binary_date(f)); break;
+    case column_type::datetime:
+    case column_type::timestamp: serialize(ctx, to_binary_datetime(f)); break;
+    case column_type::time:
+        BOOST_ASSERT(f.is_time());
+        serialize(ctx, f);
+        break;
+    default: serialize(ctx, string_lenenc{to_text(f, col, buffer)}); break;
+    }
+}
+
+// Column definitions
+struct protocol_column
+{
+    protocol_field_type type;
+    std::uint16_t flags;
+    std::uint16_t collation;
+};
+
+BOOST_MYSQL_STATIC_OR_INLINE
+protocol_column to_protocol_column(const server_column& col) noexcept
+{
+    std::uint16_t unsigned_flag = col.is_unsigned ? column_flags::unsigned_ : std::uint16_t(0);
+    std::uint16_t binary_flags = column_flags::binary;
+    switch (col.type)
+    {
+    case column_type::tinyint: return {protocol_field_type::tiny, unsigned_flag, binary_collation};
+    case column_type::smallint: return {protocol_field_type::short_, unsigned_flag, binary_collation};
+    case column_type::mediumint: return {protocol_field_type::int24, unsigned_flag, binary_collation};
+    case column_type::int_: return {protocol_field_type::long_, unsigned_flag, binary_collation};
+    case column_type::bigint: return {protocol_field_type::longlong, unsigned_flag, binary_collation};
+    case column_type::float_: return {protocol_field_type::float_, unsigned_flag, binary_collation};
+    case column_type::double_: return {protocol_field_type::double_, unsigned_flag, binary_collation};
+    case column_type::decimal: return {protocol_field_type::newdecimal, unsigned_flag, binary_collation};
+    case column_type::bit: return {protocol_field_type::bit, column_flags::unsigned_, binary_collation};
+    case column_type::year: return {protocol_field_type::year, column_flags::unsigned_, binary_collation};
+    case column_type::time: return {protocol_field_type::time, binary_flags, binary_collation};
+    case column_type::date: return {protocol_field_type::date, binary_flags, binary_collation};
+    case column_type::datetime: return {protocol_field_type::datetime, binary_flags, binary_collation};
+    case column_type::timestamp: return {protocol_field_type::timestamp, binary_flags, binary_collation};
+    case column_type::char_: return {protocol_field_type::string, 0, col.collation};
+    case column_type::varchar: return {protocol_field_type::var_string, 0, col.collation};
+    case column_type::binary: return {protocol_field_type::string, binary_flags, binary_collation};
+    case column_type::varbinary: return {protocol_field_type::var_string, binary_flags, binary_collation};
+    case column_type::text: return {protocol_field_type::blob, column_flags::blob, col.collation};
+    case column_type::blob:
+        return {protocol_field_type::blob, std::uint16_t(column_flags::blob | binary_flags), binary_collation};
+    case column_type::enum_: return {protocol_field_type::string, column_flags::enum_, col.collation};
+    case column_type::set: return {protocol_field_type::string, column_flags::set, col.collation};
+    case column_type::json: return {protocol_field_type::json, column_flags::blob, col.collation};
+    case column_type::geometry:
+        return {protocol_field_type::geometry, std::uint16_t(column_flags::blob | binary_flags), binary_collation};
+    default: return {protocol_field_type::var_string, 0, col.collation};
+    }
+}
+
+// Collation sent in the execute statement parameters. The type is only a hint:
+// string vs blob is signaled by the protocol type
+BOOST_MYSQL_STATIC_OR_INLINE
+std::uint16_t param_collation(protocol_field_type type) noexcept
+{
+    switch (type)
+    {
+    case protocol_field_type::tiny_blob:
+    case protocol_field_type::medium_blob:
+    case protocol_field_type::long_blob:
+    case protocol_field_type::blob: return binary_collation;
+    default: return mysql_collations::utf8mb4_general_ci;
+    }
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+// Server hello
+std::size_t boost::mysql::detail::server_hello_message::get_size() const noexcept
+{
+    return 1 +                                          // protocol version
+           ::boost::mysql::detail::get_size(string_null{server_version}) + 4 +  // connection ID
+           server_scramble_part1_size + 1 +             // filler
+           2 + 1 + 2 + 2 +                              // caps low, collation, status, caps high
+           1 + 10 +                                     // auth plugin data length, reserved
+           (server_scramble_size - server_scramble_part1_size) + 1 +  // includes a NULL byte
+           ::boost::mysql::detail::get_size(string_null{auth_plugin_name});
+}
+
+void boost::mysql::detail::server_hello_message::serialize(span<std::uint8_t> buff) const noexcept
+{
+    BOOST_ASSERT(buff.size() >= get_size());
+    BOOST_ASSERT(scramble.size() == server_scramble_size);
+    serialization_context ctx(buff.data());
+
+    auto caps = server_connection_capabilities.get();
+    ::boost::mysql::detail::serialize(
+        ctx,
+        server_protocol_version,
+        string_null{server_version},
+        connection_id
+    );
+    ctx.write(scramble.data(), server_scramble_part1_size);
+    ::boost::mysql::detail::serialize(
+        ctx,
+        std::uint8_t(0),  // filler
+        static_cast<std::uint16_t>(caps & 0xffff),
+        static_cast<std::uint8_t>(collation_id & 0xff),  // only the lower 8 bits
+        server_status_autocommit,
+        static_cast<std::uint16_t>(caps >> 16),
+        static_cast<std::uint8_t>(server_scramble_size + 1),  // includes the NULL byte
+        string_fixed<10>{}
+    );
+    ctx.write(scramble.data() + server_scramble_part1_size, server_scramble_size - server_scramble_part1_size);
+    ::boost::mysql::detail::serialize(ctx, std::uint8_t(0), string_null{auth_plugin_name});
+}
+
+// Auth switch
+std::size_t boost::mysql::detail::auth_switch_message::get_size() const noexcept
+{
+    return 1 + ::boost::mysql::detail::get_size(string_null{plugin_name}) + auth_data.size() + 1;
+}
+
+void boost::mysql::detail::auth_switch_message::serialize(span<std::uint8_t> buff) const noexcept
+{
+    BOOST_ASSERT(buff.size() >= get_size());
+    serialization_context ctx(buff.data());
+    ::boost::mysql::detail::serialize(ctx, server_auth_switch_header, string_null{plugin_name});
+    ctx.write(auth_data.data(), auth_data.size());
+    ctx.write(std::uint8_t(0));
+}
+
+// OK packets. We always send the info string, which clients accept
+std::size_t boost::mysql::detail::ok_message::get_size() const noexcept
+{
+    return 1 + ::boost::mysql::detail::get_size(
+                   int_lenenc{content.affected_rows},
+                   int_lenenc{content.last_insert_id},
+                   status_flags,
+                   content.warnings,
+                   string_lenenc{content.info}
+               );
+}
+
+void boost::mysql::detail::ok_message::serialize(span<std::uint8_t> buff) const noexcept
+{
+    BOOST_ASSERT(buff.size() >= get_size());
+    serialization_context ctx(buff.data());
+    ::boost::mysql::detail::serialize(
+        ctx,
+        header,
+        int_lenenc{content.affected_rows},
+        int_lenenc{content.last_insert_id},
+        status_flags,
+        content.warnings,
+        string_lenenc{content.info}
+    );
+}
+
+// Error packets. We don't track SQL states, so we always send the generic one
+std::size_t boost::mysql::detail::error_message::get_size() const noexcept
+{
+    return 1 + 2 + 1 + 5 + message.size();
+}
+
+void boost::mysql::detail::error_message::serialize(span<std::uint8_t> buff) const noexcept
+{
+    BOOST_ASSERT(buff.size() >= get_size());
+    serialization_context ctx(buff.data());
+    ::boost::mysql::detail::serialize(
+        ctx,
+        server_error_header,
+        code,
+        string_fixed<1>{{'#'}},
+        string_fixed<5>{{'H', 'Y', '0', '0', '0'}},
+        string_eof{message}
+    );
+}
+
+// Column count
+std::size_t boost::mysql::detail::column_count_message::get_size() const noexcept
+{
+    return ::boost::mysql::detail::get_size(int_lenenc{num_columns});
+}
+
+void boost::mysql::detail::column_count_message::serialize(span<std::uint8_t> buff) const noexcept
+{
+    BOOST_ASSERT(buff.size() >= get_size());
+    serialization_context ctx(buff.data());
+    ::boost::mysql::detail::serialize(ctx, int_lenenc{num_columns});
+}
+
+// Column definition. The layout matches what deserialize_column_definition expects
+std::size_t boost::mysql::detail::column_definition_message::get_size() const noexcept
+{
+    constexpr std::size_t fixed_fields_size = 2 + 4 + 1 + 2 + 1 + 2;  // includes 2 filler bytes
+    return ::boost::mysql::detail::get_size(
+               string_lenenc{"def"},
+               string_lenenc{column.database},
+               string_lenenc{column.table},
+               string_lenenc{column.table},
+               string_lenenc{column.name},
+               string_lenenc{column.name}
+           ) +
+           1 + fixed_fields_size;
+}
+
+void boost::mysql::detail::column_definition_message::serialize(span<std::uint8_t> buff) const noexcept
+{
+    BOOST_ASSERT(buff.size() >= get_size());
+    serialization_context ctx(buff.data());
+    auto proto = to_protocol_column(column);
+    ::boost::mysql::detail::serialize(
+        ctx,
+        string_lenenc{"def"},
+        string_lenenc{column.database},
+        string_lenenc{column.table},
+        string_lenenc{column.table},  // org_table
+        string_lenenc{column.name},
+        string_lenenc{column.name},  // org_name
+        std::uint8_t(12),            // length of the fixed fields
+        proto.collation,
+        column.column_length,
+        proto.type,
+        proto.flags,
+        column.decimals,
+        std::uint16_t(0)  // filler
+    );
+}
+
+// Prepare statement response
+std::size_t boost::mysql::detail::prepare_ok_message::get_size() const noexcept
+{
+    return 1 + 4 + 2 + 2 + 1 + 2;
+}
+
+void boost::mysql::detail::prepare_ok_message::serialize(span<std::uint8_t> buff) const noexcept
+{
+    BOOST_ASSERT(buff.size() >= get_size());
+    serialization_context ctx(buff.data());
+    ::boost::mysql::detail::serialize(
+        ctx,
+        std::uint8_t(0),  // status
+        statement_id,
+        num_columns,
+        num_params,
+        std::uint8_t(0),  // reserved
+        std::uint16_t(0)  // warning count
+    );
+}
+
+// Text rows: every field is sent as a string_lenenc, and NULLs as a single 0xfb byte
+std::size_t boost::mysql::detail::text_row_message::get_size() const noexcept
+{
+    BOOST_ASSERT(fields.size() == columns.size());
+    char buffer[max_text_field_size];
+    std::size_t res = 0;
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        if (fields[i].is_null())
+            res += 1;
+        else
+            res += ::boost::mysql::detail::get_size(string_lenenc{to_text(fields[i], columns[i], buffer)});
+    }
+    return res;
+}
+
+void boost::mysql::detail::text_row_message::serialize(span<std::uint8_t> buff) const noexcept
+{
+    BOOST_ASSERT(buff.size() >= get_size());
+    serialization_context ctx(buff.data());
+    char buffer[max_text_field_size];
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        if (fields[i].is_null())
+            ctx.write(server_null_text_field);
+        else
+            ::boost::mysql::detail::serialize(ctx, string_lenenc{to_text(fields[i], columns[i], buffer)});
+    }
+}
+
+// Binary rows: header, NULL bitmap and non-NULL values encoded according to the column type
+std::size_t boost::mysql::detail::binary_row_message::get_size() const noexcept
+{
+    BOOST_ASSERT(fields.size() == columns.size());
+    char buffer[max_text_field_size];
+    std::size_t res = 1 + null_bitmap_traits(binary_row_null_bitmap_offset, fields.size()).byte_count();
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        if (!fields[i].is_null())
+            res += get_binary_field_size(fields[i], columns[i], buffer);
+    }
+    return res;
+}
+
+void boost::mysql::detail::binary_row_message::serialize(span<std::uint8_t> buff) const noexcept
+{
+    BOOST_ASSERT(buff.size() >= get_size());
+    serialization_context ctx(buff.data());
+
+    // Header
+    ctx.write(std::uint8_t(0));
+
+    // NULL bitmap
+    null_bitmap_traits traits(binary_row_null_bitmap_offset, fields.size());
+    std::uint8_t* null_bitmap = ctx.first();
+    std::memset(null_bitmap, 0, traits.byte_count());
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        if (fields[i].is_null())
+            traits.set_null(null_bitmap, i);
+    }
+    ctx.advance(traits.byte_count());
+
+    // Values
+    char buffer[max_text_field_size];
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        if (!fields[i].is_null())
+            serialize_binary_field(ctx, fields[i], columns[i], buffer);
+    }
+}
+
+// Login request. This is the reverse of login_request::serialize
+boost::mysql::error_code boost::mysql::detail::deserialize_login_request(
+    span<const std::uint8_t> msg,
+    login_request& output
+) noexcept
+{
+    struct login_request_packet
+    {
+        std::uint32_t client_flag;
+        std::uint32_t max_packet_size;
+        std::uint8_t character_set;
+        string_fixed<23> filler;
+        string_null username;
+    } pack{};
+
+    deserialization_context ctx(msg);
+    auto err = deserialize(
+        ctx,
+        pack.client_flag,
+        pack.max_packet_size,
+        pack.character_set,
+        pack.filler,
+        pack.username
+    );
+    if (err != deserialize_errc::ok)
+        return to_error_code(err);
+    capabilities caps(pack.client_flag);
+
+    // Auth response. Old clients use a single-byte length
+    string_view auth_response;
+    if (caps.has(CLIENT_PLUGIN_AUTH_LENENC_CLIENT_DATA))
+    {
+        string_lenenc value;
+        err = deserialize(ctx, value);
+        auth_response = value.value;
+    }
+    else
+    {
+        std::uint8_t length = 0;
+        err = deserialize(ctx, length);
+        if (err == deserialize_errc::ok)
+        {
+            if (!ctx.enough_size(length))
+                return client_errc::incomplete_message;
+            auth_response = string_view(reinterpret_cast<const char*>(ctx.first()), length);
+            ctx.advance(length);
+        }
+    }
+    if (err != deserialize_errc::ok)
+        return to_error_code(err);
+
+    // Database
+    string_null database;
+    if (caps.has(CLIENT_CONNECT_WITH_DB))
+    {
+        err = deserialize(ctx, database);
+        if (err != deserialize_errc::ok)
+            return to_error_code(err);
+    }
+
+    // Plugin name. Connection attributes may follow, and are ignored
+    string_null plugin_name;
+    if (caps.has(CLIENT_PLUGIN_AUTH))
+    {
+        err = deserialize(ctx, plugin_name);
+        if (err != deserialize_errc::ok)
+            return to_error_code(err);
+    }
+
+    output = login_request{
+        caps,
+        pack.max_packet_size,
+        pack.character_set,
+        pack.username.value,
+        to_span(auth_response),
+        database.value,
+        plugin_name.value,
+    };
+    return error_code();
+}
+
+// Commands
+boost::mysql::error_code boost::mysql::detail::deserialize_server_command(
+    span<const std::uint8_t> msg,
+    server_command& output
+) noexcept
+{
+    deserialization_context ctx(msg);
+    std::uint8_t command_id = 0;
+    auto err = deserialize(ctx, command_id);
+    if (err != deserialize_errc::ok)
+        return to_error_code(err);
+
+    output = server_command();
+    output.payload = msg;
+
+    switch (command_id)
+    {
+    case 0x01: output.type = server_command_type::quit; break;
+    case 0x02: output.type = server_command_type::init_db; break;
+    case 0x03: output.type = server_command_type::query; break;
+    case 0x0e: output.type = server_command_type::ping; break;
+    case 0x16: output.type = server_command_type::stmt_prepare; break;
+    case 0x17: output.type = server_command_type::stmt_execute; break;
+    case 0x19: output.type = server_command_type::stmt_close; break;
+    case 0x1f: output.type = server_command_type::reset_connection; break;
+    default: return error_code();  // server_command_type::other
+    }
+
+    switch (output.type)
+    {
+    case server_command_type::init_db:
+    case server_command_type::query:
+    case server_command_type::stmt_prepare:
+    {
+        string_eof text;
+        err = deserialize(ctx, text);
+        output.text = text.value;
+        break;
+    }
+    case server_command_type::stmt_execute:
+        // Parameters are parsed by deserialize_statement_params
+        return to_error_code(deserialize(ctx, output.statement_id));
+    case server_command_type::stmt_close: err = deserialize(ctx, output.statement_id); break;
+    default: break;
+    }
+    if (err != deserialize_errc::ok)
+        return to_error_code(err);
+    return ctx.check_extra_bytes();
+}
+
+// Statement parameters. This is the reverse of execute_stmt_command::serialize
+boost::mysql::error_code boost::mysql::detail::deserialize_statement_params(
+    span<const std::uint8_t> msg,
+    span<field_view> output
+) noexcept
+{
+    struct execute_stmt_packet
+    {
+        std::uint8_t command_id;
+        std::uint32_t statement_id;
+        std::uint8_t flags;
+        std::uint32_t iteration_count;
+    } pack{};
+
+    deserialization_context ctx(msg);
+    auto err = deserialize(ctx, pack.command_id, pack.statement_id, pack.flags, pack.iteration_count);
+    if (err != deserialize_errc::ok)
+        return to_error_code(err);
+    if (output.empty())
+        return ctx.check_extra_bytes();
+
+    // NULL bitmap
+    null_bitmap_traits traits(stmt_execute_null_bitmap_offset, output.size());
+    const std::uint8_t* null_bitmap = ctx.first();
+    if (!ctx.enough_size(traits.byte_count()))
+        return client_errc::incomplete_message;
+    ctx.advance(traits.byte_count());
+
+    // We can only parse values if types are present
+    std::uint8_t new_params_bind_flag = 0;
+    err = deserialize(ctx, new_params_bind_flag);
+    if (err != deserialize_errc::ok)
+        return to_error_code(err);
+    if (new_params_bind_flag != 1)
+        return client_errc::protocol_value_error;
+
+    // Types
+    constexpr std::size_t param_meta_packet_size = 2;  // type + unsigned flag
+    const std::uint8_t* types = ctx.first();
+    if (!ctx.enough_size(param_meta_packet_size * output.size()))
+        return client_errc::incomplete_message;
+    ctx.advance(param_meta_packet_size * output.size());
+
+    // Values
+    for (std::size_t i = 0; i < output.size(); ++i)
+    {
+        if (traits.is_null(null_bitmap, i))
+        {
+            output[i] = field_view();
+            continue;
+        }
+        auto type = static_cast<protocol_field_type>(types[i * param_meta_packet_size]);
+        bool is_unsigned = types[i * param_meta_packet_size + 1] & 0x80;
+        std::uint16_t flags = is_unsigned ? column_flags::unsigned_ : std::uint16_t(0);
+        coldef_view coldef{};
+        coldef.type = compute_column_type(type, flags, param_collation(type));
+        coldef.flags = flags;
+        coldef.collation_id = param_collation(type);
+        err = deserialize_binary_field(ctx, access::construct<metadata>(coldef, false), output[i]);
+        if (err != deserialize_errc::ok)
+            return to_error_code(err);
+    }
+
+    return ctx.check_extra_bytes();
+}
+
+#endif
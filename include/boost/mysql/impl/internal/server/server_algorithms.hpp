@@ -0,0 +1,253 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_SERVER_SERVER_ALGORITHMS_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_SERVER_SERVER_ALGORITHMS_HPP
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/server_command.hpp>
+#include <boost/mysql/server_messages.hpp>
+
+#include <boost/mysql/impl/internal/channel/message_reader.hpp>
+#include <boost/mysql/impl/internal/server/server_session.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/post.hpp>
+
+#include <cstddef>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+//
+// flush: writes all the responses accumulated by the session
+//
+inline void server_flush_impl(server_session& sess, error_code& err)
+{
+    err.clear();
+    auto buff = sess.pending();
+    std::size_t offset = 0;
+    while (offset < buff.size())
+    {
+        offset += sess.stream().write_some(asio::buffer(buff.data() + offset, buff.size() - offset), err);
+        if (err)
+            return;
+    }
+    sess.clear_pending();
+}
+
+struct server_flush_op : boost::asio::coroutine
+{
+    server_session& sess_;
+    std::size_t offset_{};
+
+    server_flush_op(server_session& sess) noexcept : sess_(sess) {}
+
+    template <class Self>
+    void operator()(Self& self, error_code err = {}, std::size_t bytes_written = 0)
+    {
+        // Error checking
+        if (err)
+        {
+            self.complete(err);
+            return;
+        }
+
+        // Regular coroutine body; if there has been an error, we don't get here
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            // Nothing to write, complete immediately
+            if (sess_.pending().empty())
+            {
+                BOOST_ASIO_CORO_YIELD boost::asio::post(sess_.get_executor(), std::move(self));
+            }
+
+            while (offset_ < sess_.pending().size())
+            {
+                BOOST_ASIO_CORO_YIELD sess_.stream().async_write_some(
+                    asio::buffer(sess_.pending().data() + offset_, sess_.pending().size() - offset_),
+                    std::move(self)
+                );
+                offset_ += bytes_written;
+            }
+
+            sess_.clear_pending();
+            self.complete(error_code());
+        }
+    }
+};
+
+template <class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+async_server_flush_impl(server_session& sess, CompletionToken&& token)
+{
+    return asio::async_compose<CompletionToken, void(error_code)>(server_flush_op(sess), token, sess);
+}
+
+//
+// handshake: sends the server hello and reads the client's login request,
+// asking the client to switch to mysql_native_password if required.
+// The final OK or error packet is sent by the user, once credentials are verified.
+//
+inline void server_handshake_impl(server_session& sess, const server_handshake_params& params, error_code& err)
+{
+    // Server hello
+    sess.add_hello(params);
+    server_flush_impl(sess, err);
+    if (err)
+        return;
+
+    // Login request
+    auto msg = read_one_message(sess.stream(), sess.reader(), sess.sequence_number(), err);
+    if (err)
+        return;
+    bool needs_auth_switch = false;
+    err = sess.process_login(msg, needs_auth_switch);
+    if (err || !needs_auth_switch)
+        return;
+
+    // Auth switch
+    sess.add_auth_switch();
+    server_flush_impl(sess, err);
+    if (err)
+        return;
+    msg = read_one_message(sess.stream(), sess.reader(), sess.sequence_number(), err);
+    if (err)
+        return;
+    sess.process_auth_switch_response(msg);
+}
+
+struct server_handshake_op : boost::asio::coroutine
+{
+    server_session& sess_;
+    server_handshake_params params_;
+    bool needs_auth_switch_{};
+
+    server_handshake_op(server_session& sess, const server_handshake_params& params) noexcept
+        : sess_(sess), params_(params)
+    {
+    }
+
+    template <class Self>
+    void operator()(Self& self, error_code err = {}, span<const std::uint8_t> msg = {})
+    {
+        // Error checking
+        if (err)
+        {
+            self.complete(err);
+            return;
+        }
+
+        // Regular coroutine body; if there has been an error, we don't get here
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            // Server hello
+            sess_.add_hello(params_);
+            BOOST_ASIO_CORO_YIELD async_server_flush_impl(sess_, std::move(self));
+
+            // Login request
+            BOOST_ASIO_CORO_YIELD
+            async_read_one_message(sess_.stream(), sess_.reader(), sess_.sequence_number(), std::move(self));
+            err = sess_.process_login(msg, needs_auth_switch_);
+            if (err || !needs_auth_switch_)
+            {
+                self.complete(err);
+                BOOST_ASIO_CORO_YIELD break;
+            }
+
+            // Auth switch
+            sess_.add_auth_switch();
+            BOOST_ASIO_CORO_YIELD async_server_flush_impl(sess_, std::move(self));
+            BOOST_ASIO_CORO_YIELD
+            async_read_one_message(sess_.stream(), sess_.reader(), sess_.sequence_number(), std::move(self));
+            sess_.process_auth_switch_response(msg);
+            self.complete(error_code());
+        }
+    }
+};
+
+template <class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+async_server_handshake_impl(server_session& sess, const server_handshake_params& params, CompletionToken&& token)
+{
+    return asio::async_compose<CompletionToken, void(error_code)>(
+        server_handshake_op(sess, params),
+        token,
+        sess
+    );
+}
+
+//
+// read command: flushes any pending response and reads the next command.
+// Clients reset the sequence number with every command.
+//
+inline server_command server_read_command_impl(server_session& sess, error_code& err)
+{
+    server_flush_impl(sess, err);
+    if (err)
+        return {};
+    sess.sequence_number() = 0;
+    auto msg = read_one_message(sess.stream(), sess.reader(), sess.sequence_number(), err);
+    if (err)
+        return {};
+    server_command res;
+    err = sess.process_command(msg, res);
+    return res;
+}
+
+struct server_read_command_op : boost::asio::coroutine
+{
+    server_session& sess_;
+
+    server_read_command_op(server_session& sess) noexcept : sess_(sess) {}
+
+    template <class Self>
+    void operator()(Self& self, error_code err = {}, span<const std::uint8_t> msg = {})
+    {
+        // Error checking
+        if (err)
+        {
+            self.complete(err, server_command());
+            return;
+        }
+
+        // Regular coroutine body; if there has been an error, we don't get here
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            BOOST_ASIO_CORO_YIELD async_server_flush_impl(sess_, std::move(self));
+            sess_.sequence_number() = 0;
+            BOOST_ASIO_CORO_YIELD
+            async_read_one_message(sess_.stream(), sess_.reader(), sess_.sequence_number(), std::move(self));
+            {
+                server_command res;
+                err = sess_.process_command(msg, res);
+                self.complete(err, res);
+            }
+        }
+    }
+};
+
+template <class CompletionToken>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, server_command))
+async_server_read_command_impl(server_session& sess, CompletionToken&& token)
+{
+    return asio::async_compose<CompletionToken, void(error_code, server_command)>(
+        server_read_command_op(sess),
+        token,
+        sess
+    );
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_SERVER_SERVER_SESSION_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_SERVER_SERVER_SESSION_HPP
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/rows_view.hpp>
+#include <boost/mysql/server_command.hpp>
+#include <boost/mysql/server_messages.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/any_stream.hpp>
+
+#include <boost/mysql/impl/internal/auth/auth.hpp>
+#include <boost/mysql/impl/internal/channel/message_reader.hpp>
+#include <boost/mysql/impl/internal/make_string_view.hpp>
+#include <boost/mysql/impl/internal/protocol/framing.hpp>
+#include <boost/mysql/impl/internal/protocol/protocol.hpp>
+#include <boost/mysql/impl/internal/protocol/server_protocol.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/core/span.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// The only plugin server_connection can verify
+constexpr string_view server_auth_plugin = make_string_view("mysql_native_password");
+
+// The state of a server_connection. Responses are serialized into a single buffer,
+// so many of them can be written in a single operation. Nothing is written until
+// the connection is flushed.
+class server_session
+{
+    std::unique_ptr<any_stream> stream_;
+    message_reader reader_;
+    std::vector<std::uint8_t> write_buffer_;
+    std::uint8_t seqnum_{};
+    std::array<std::uint8_t, server_scramble_size> scramble_{};
+    server_login login_;
+    server_command_type last_command_{server_command_type::other};
+    std::vector<row_column> columns_;  // of the resultset being sent
+    bool binary_rows_{false};
+
+public:
+    server_session(std::size_t read_buffer_size, std::unique_ptr<any_stream> stream)
+        : stream_(std::move(stream)), reader_(read_buffer_size)
+    {
+    }
+
+    // Executor
+    using executor_type = asio::any_io_executor;
+    executor_type get_executor() { return stream_->get_executor(); }
+
+    any_stream& stream() noexcept { return *stream_; }
+    message_reader& reader() noexcept { return reader_; }
+    std::uint8_t& sequence_number() noexcept { return seqnum_; }
+
+    // Serializes a message into the write buffer, splitting it into frames if required
+    template <class Serializable>
+    void add_message(const Serializable& message)
+    {
+        std::size_t size = message.get_size();
+        std::size_t offset = write_buffer_.size();
+        std::size_t payload_offset = reserve_framed_message(write_buffer_, size);
+        message.serialize(span<std::uint8_t>(write_buffer_.data() + payload_offset, size));
+        seqnum_ = frame_message(write_buffer_.data() + offset, size, seqnum_);
+    }
+
+    span<const std::uint8_t> pending() const noexcept { return write_buffer_; }
+    void clear_pending() noexcept { write_buffer_.clear(); }
+
+    // Handshake
+    void add_hello(const server_handshake_params& params)
+    {
+        generate_auth_scramble(scramble_);
+        seqnum_ = 0;
+        add_message(server_hello_message{
+            params.server_version,
+            params.connection_id,
+            scramble_,
+            params.collation,
+            server_auth_plugin,
+        });
+    }
+
+    // Returns whether an auth switch is required
+    error_code process_login(span<const std::uint8_t> msg, bool& needs_auth_switch)
+    {
+        login_request req;
+        auto err = deserialize_login_request(msg, req);
+        if (err)
+            return err;
+        if (!req.negotiated_capabilities.has_all(mandatory_capabilities))
+            return client_errc::server_unsupported;
+        login_.username.assign(req.username.data(), req.username.size());
+        login_.database.assign(req.database.data(), req.database.size());
+        login_.auth_plugin_name.assign(req.auth_plugin_name.data(), req.auth_plugin_name.size());
+        login_.auth_response.assign(req.auth_response.begin(), req.auth_response.end());
+        login_.collation = static_cast<std::uint16_t>(req.collation_id);
+        needs_auth_switch = req.auth_plugin_name != server_auth_plugin;
+        return error_code();
+    }
+
+    void add_auth_switch() { add_message(auth_switch_message{server_auth_plugin, scramble_}); }
+
+    void process_auth_switch_response(span<const std::uint8_t> msg)
+    {
+        login_.auth_plugin_name.assign(server_auth_plugin.data(), server_auth_plugin.size());
+        login_.auth_response.assign(msg.begin(), msg.end());
+    }
+
+    const server_login& login() const noexcept { return login_; }
+
+    bool check_password(string_view password) const
+    {
+        // Clients send an empty response for empty passwords
+        if (password.empty() && login_.auth_response.empty())
+            return true;
+        auth_response expected;
+        auto err = compute_auth_response(server_auth_plugin, password, scramble_, false, expected);
+        return !err && auth_responses_equal(expected.data, login_.auth_response);
+    }
+
+    // Commands. Clients reset sequence numbers with every command
+    error_code process_command(span<const std::uint8_t> msg, server_command& output)
+    {
+        auto err = deserialize_server_command(msg, output);
+        last_command_ = err ? server_command_type::other : output.type;
+        return err;
+    }
+
+    // Responses
+    void add_ok(const server_ok& ok) { add_message(ok_message{0x00, ok, server_status_autocommit}); }
+
+    void add_error(std::uint16_t code, string_view message) { add_message(error_message{code, message}); }
+
+    void add_prepare_ok(
+        std::uint32_t statement_id,
+        span<const server_column> params,
+        span<const server_column> columns
+    )
+    {
+        BOOST_ASSERT(params.size() <= 0xffffu && columns.size() <= 0xffffu);
+        add_message(prepare_ok_message{
+            statement_id,
+            static_cast<std::uint16_t>(columns.size()),
+            static_cast<std::uint16_t>(params.size()),
+        });
+        for (const auto& param : params)
+            add_message(column_definition_message{param});
+        for (const auto& col : columns)
+            add_message(column_definition_message{col});
+    }
+
+    void add_resultset_head(span<const server_column> columns)
+    {
+        BOOST_ASSERT(!columns.empty());
+        binary_rows_ = last_command_ == server_command_type::stmt_execute;
+        columns_.clear();
+        add_message(column_count_message{columns.size()});
+        for (const auto& col : columns)
+        {
+            add_message(column_definition_message{col});
+            columns_.push_back(row_column{col.type, col.decimals});
+        }
+    }
+
+    void add_row(span<const field_view> fields)
+    {
+        BOOST_ASSERT(fields.size() == columns_.size());
+        if (binary_rows_)
+            add_message(binary_row_message{fields, columns_});
+        else
+            add_message(text_row_message{fields, columns_});
+    }
+
+    void add_rows(rows_view rows)
+    {
+        for (std::size_t i = 0; i < rows.size(); ++i)
+        {
+            auto r = rows.at(i);
+            add_row(span<const field_view>(r.begin(), r.size()));
+        }
+    }
+
+    void add_resultset_end(const server_ok& ok)
+    {
+        columns_.clear();
+        add_message(ok_message{0xfe, ok, server_status_autocommit});
+    }
+};
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
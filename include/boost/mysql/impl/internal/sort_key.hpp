@@ -0,0 +1,239 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_SORT_KEY_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_SORT_KEY_HPP
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/metadata.hpp>
+#include <boost/mysql/metadata_collection_view.hpp>
+#include <boost/mysql/row_view.hpp>
+#include <boost/mysql/sort_rows.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/impl/internal/sort_key_values.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/core/span.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Collations that distinguish letter case. Any other collation is assumed to be case-insensitive
+inline bool is_case_sensitive_collation(std::uint16_t collation) noexcept
+{
+    // In ascending order
+    static constexpr std::uint16_t case_sensitive_collations[] = {
+        2,   20,  34,  42,  43,  46,  47,  49,  50,  52,  53,  55,  58,  61,  62,  63,  64,  65,  66,
+        67,  68,  69,  70,  71,  72,  73,  74,  75,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,
+        87,  88,  89,  90,  91,  93,  96,  98,  249, 278, 279, 280, 281, 282, 283, 284, 285, 286, 287,
+        288, 289, 290, 291, 292, 293, 294, 296, 297, 298, 300, 303, 307, 308, 309,
+    };
+    return std::binary_search(
+        std::begin(case_sensitive_collations),
+        std::end(case_sensitive_collations),
+        collation
+    );
+}
+
+// How a column's fields should be encoded, as derived from its metadata
+enum class sort_key_encoding
+{
+    by_value,       // by field kind
+    decimal,        // strings holding decimal numbers
+    string_nocase,  // strings compared without taking ASCII letter case into account
+};
+
+inline sort_key_encoding get_sort_key_encoding(const metadata& meta) noexcept
+{
+    switch (meta.type())
+    {
+    case column_type::decimal: return sort_key_encoding::decimal;
+    case column_type::char_:
+    case column_type::varchar:
+    case column_type::text:
+    case column_type::enum_:
+    case column_type::set:
+        return is_case_sensitive_collation(meta.column_collation()) ? sort_key_encoding::by_value
+                                                                    : sort_key_encoding::string_nocase;
+    default: return sort_key_encoding::by_value;
+    }
+}
+
+// The encoding for each column in a key. Without metadata, all fields are encoded by value
+inline std::vector<sort_key_encoding> get_sort_key_encodings(
+    metadata_collection_view meta,
+    span<const sort_column> columns
+)
+{
+    std::vector<sort_key_encoding> res(columns.size(), sort_key_encoding::by_value);
+    if (!meta.empty())
+    {
+        for (std::size_t i = 0; i < columns.size(); ++i)
+        {
+            BOOST_ASSERT(columns[i].index < meta.size());
+            res[i] = get_sort_key_encoding(meta[columns[i].index]);
+        }
+    }
+    return res;
+}
+
+// Builds memcmp-comparable keys. Every field is prefixed by a byte telling whether it's NULL,
+// so NULLs sort first. Variable-length values escape zero bytes and are terminated by a
+// double zero, so keys are prefix-free and can be concatenated.
+class sort_key_writer
+{
+    std::vector<unsigned char>& out_;
+
+    void put(unsigned char b) { out_.push_back(b); }
+
+    void put_be(std::uint64_t value, std::size_t num_bytes)
+    {
+        for (std::size_t i = num_bytes; i-- > 0;)
+            put(static_cast<unsigned char>(value >> (8 * i)));
+    }
+
+    void put_bytes(const unsigned char* data, std::size_t size, bool fold_case)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            unsigned char c = data[i];
+            if (fold_case && c >= 'a' && c <= 'z')
+                c = static_cast<unsigned char>(c - 'a' + 'A');
+            put(c);
+            if (c == 0)
+                put(0xff);
+        }
+        put(0);
+        put(0);
+    }
+
+    // Sign (0: negative, 1: zero, 2: positive), number of integral digits,
+    // significant digits and a terminator. Negative numbers are complemented
+    void put_decimal(string_view value)
+    {
+        bool negative = !value.empty() && value.front() == '-';
+        auto first = value.begin() + (negative ? 1 : 0);
+        auto dot = std::find(first, value.end(), '.');
+
+        auto int_first = first;
+        while (int_first != dot && *int_first == '0')
+            ++int_first;
+        auto frac_last = value.end();
+        if (dot != value.end())
+        {
+            while (frac_last != dot + 1 && *(frac_last - 1) == '0')
+                --frac_last;
+        }
+        bool has_frac = dot != value.end() && frac_last != dot + 1;
+
+        if (int_first == dot && !has_frac)
+        {
+            put(1);
+            return;
+        }
+
+        put(negative ? 0 : 2);
+        std::size_t start = out_.size();
+        put(static_cast<unsigned char>(dot - int_first));
+        for (auto it = int_first; it != dot; ++it)
+            put(static_cast<unsigned char>(*it));
+        if (has_frac)
+        {
+            for (auto it = dot + 1; it != frac_last; ++it)
+                put(static_cast<unsigned char>(*it));
+        }
+        put(0);
+        if (negative)
+            complement(start);
+    }
+
+public:
+    sort_key_writer(std::vector<unsigned char>& out) noexcept : out_(out) {}
+
+    std::size_t size() const noexcept { return out_.size(); }
+
+    void complement(std::size_t from) noexcept
+    {
+        for (std::size_t i = from; i < out_.size(); ++i)
+            out_[i] = static_cast<unsigned char>(~out_[i]);
+    }
+
+    void put_field(field_view f, sort_key_encoding enc)
+    {
+        if (f.is_null())
+        {
+            put(0);
+            return;
+        }
+        put(1);
+
+        switch (f.kind())
+        {
+        case field_kind::int64:
+            put(f.get_int64() < 0 ? 0 : 1);
+            put_be(static_cast<std::uint64_t>(f.get_int64()), 8);
+            break;
+        case field_kind::uint64:
+            put(1);
+            put_be(f.get_uint64(), 8);
+            break;
+        case field_kind::string:
+        {
+            auto s = f.get_string();
+            if (enc == sort_key_encoding::decimal)
+                put_decimal(s);
+            else
+                put_bytes(
+                    reinterpret_cast<const unsigned char*>(s.data()),
+                    s.size(),
+                    enc == sort_key_encoding::string_nocase
+                );
+            break;
+        }
+        case field_kind::blob:
+        {
+            auto b = f.get_blob();
+            put_bytes(b.data(), b.size(), false);
+            break;
+        }
+        case field_kind::float_: put_be(double_key(f.get_float()), 8); break;
+        case field_kind::double_: put_be(double_key(f.get_double()), 8); break;
+        case field_kind::date: put_be(date_key(f.get_date()), 4); break;
+        case field_kind::datetime: put_be(datetime_key(f.get_datetime()), 8); break;
+        case field_kind::time: put_be(time_key(f.get_time()), 8); break;
+        default: BOOST_ASSERT(false);
+        }
+    }
+
+    // The key for a row, made of the fields in columns. encodings[i] applies to columns[i]
+    void put_row_key(row_view r, span<const sort_column> columns, const sort_key_encoding* encodings)
+    {
+        for (std::size_t i = 0; i < columns.size(); ++i)
+        {
+            BOOST_ASSERT(columns[i].index < r.size());
+            std::size_t field_start = size();
+            put_field(r[columns[i].index], encodings[i]);
+            if (columns[i].order == sort_order::descending)
+                complement(field_start);
+        }
+    }
+};
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
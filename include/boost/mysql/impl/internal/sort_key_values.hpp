@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_SORT_KEY_VALUES_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_SORT_KEY_VALUES_HPP
+
+#include <boost/mysql/date.hpp>
+#include <boost/mysql/datetime.hpp>
+#include <boost/mysql/time.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// How sort keys (see sort_key.hpp) order individual values. Row filters use these
+// to compare values without building keys.
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Compares keys, or any byte strings, lexicographically. Shorter strings go first on ties
+inline int compare_key_bytes(
+    const unsigned char* lhs,
+    std::size_t lhs_size,
+    const unsigned char* rhs,
+    std::size_t rhs_size
+) noexcept
+{
+    std::size_t common_size = (std::min)(lhs_size, rhs_size);
+    int res = common_size ? std::memcmp(lhs, rhs, common_size) : 0;
+    if (res != 0)
+        return res;
+    return lhs_size < rhs_size ? -1 : (lhs_size > rhs_size ? 1 : 0);
+}
+
+inline int compare_keys(const std::vector<unsigned char>& lhs, const std::vector<unsigned char>& rhs) noexcept
+{
+    return compare_key_bytes(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+
+// Fixed-size values are encoded as big-endian unsigned integers, so comparing
+// the integers is equivalent to comparing the keys
+inline std::uint64_t date_key(date d) noexcept
+{
+    return (static_cast<std::uint64_t>(d.year()) << 16) | (static_cast<std::uint64_t>(d.month()) << 8) |
+           d.day();
+}
+
+inline std::uint64_t datetime_key(datetime d) noexcept
+{
+    std::uint64_t res = d.year();
+    res = res * 13u + d.month();
+    res = res * 32u + d.day();
+    res = res * 24u + d.hour();
+    res = res * 60u + d.minute();
+    res = res * 60u + d.second();
+    return res * 1000000u + d.microsecond();
+}
+
+inline std::uint64_t time_key(time t) noexcept
+{
+    return static_cast<std::uint64_t>(t.count()) ^ (static_cast<std::uint64_t>(1) << 63);
+}
+
+inline std::uint64_t double_key(double value) noexcept
+{
+    // -0.0 == 0.0
+    if (value == 0.0)
+        value = 0.0;
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    constexpr std::uint64_t sign_bit = static_cast<std::uint64_t>(1) << 63;
+    return (bits & sign_bit) ? ~bits : (bits | sign_bit);
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+#endif
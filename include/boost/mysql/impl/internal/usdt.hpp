@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_INTERNAL_USDT_HPP
+#define BOOST_MYSQL_IMPL_INTERNAL_USDT_HPP
+
+// User-level statically defined tracepoints (USDT), for tools like bpftrace or perf.
+// Enabled by defining BOOST_MYSQL_ENABLE_USDT (CMake option BOOST_MYSQL_USDT),
+// which requires <sys/sdt.h> (systemtap-sdt-dev or equivalent). Probes
+// are placed under the boost_mysql provider, and compile to a semaphore check
+// and a nop instruction each. When disabled, probes and their arguments compile to nothing.
+//
+// Probes:
+//   message_read(size, seqnum_first, seqnum_last)
+//   message_written(size, seqnum_first, seqnum_last)
+//   read_buffer_resize(old_size, new_size)
+//   rows_decoded(num_rows, num_bytes)
+//   operation_start(type, query, query_size, statement_id)
+//   operation_finish(type, error_value, duration_ns, rows_read, bytes_read, bytes_written)
+//   handshake_hello(plugin_name, plugin_name_size, use_ssl)
+//   handshake_tls_start()
+//   handshake_tls_finish(error_value)
+//   handshake_auth_switch(plugin_name, plugin_name_size)
+//   handshake_auth_more_data(size)
+//   handshake_auth_finish(error_value)
+//
+// Strings are passed as pointer plus size, since they are not NULL-terminated.
+// type is the integral value of operation_type.
+//
+// Probes use semaphores, which tracers increment while attached. Probe arguments are only
+// evaluated if a tracer is attached, and BOOST_MYSQL_USDT_ENABLED(name) can be used
+// to skip work that is only required by a probe (like tracking operations).
+//
+// <sys/sdt.h> decides whether probes reference semaphores when it's included, based on
+// _SDT_HAS_SEMAPHORES. We only define it while including the header, so it doesn't leak
+// into user code. The header has include guards, though, so probes defined by other code
+// in the same translation unit will reference semaphores, too.
+
+#ifdef BOOST_MYSQL_ENABLE_USDT
+
+#if defined(_SYS_SDT_H) && !defined(_SDT_HAS_SEMAPHORES)
+#error "<sys/sdt.h> must be included with _SDT_HAS_SEMAPHORES defined when USDT probes are enabled"
+#endif
+
+#pragma push_macro("_SDT_HAS_SEMAPHORES")
+#undef _SDT_HAS_SEMAPHORES
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+#pragma pop_macro("_SDT_HAS_SEMAPHORES")
+
+// Semaphores are referenced by name from the probe notes, so they need C linkage.
+// They're weak so this header can be included by several translation units
+#define BOOST_MYSQL_USDT_SEMAPHORE(name) \
+    __attribute__((weak, section(".probes"))) volatile unsigned short boost_mysql_##name##_semaphore = 0;
+
+extern "C" {
+BOOST_MYSQL_USDT_SEMAPHORE(message_read)
+BOOST_MYSQL_USDT_SEMAPHORE(message_written)
+BOOST_MYSQL_USDT_SEMAPHORE(read_buffer_resize)
+BOOST_MYSQL_USDT_SEMAPHORE(rows_decoded)
+BOOST_MYSQL_USDT_SEMAPHORE(operation_start)
+BOOST_MYSQL_USDT_SEMAPHORE(operation_finish)
+BOOST_MYSQL_USDT_SEMAPHORE(handshake_hello)
+BOOST_MYSQL_USDT_SEMAPHORE(handshake_tls_start)
+BOOST_MYSQL_USDT_SEMAPHORE(handshake_tls_finish)
+BOOST_MYSQL_USDT_SEMAPHORE(handshake_auth_switch)
+BOOST_MYSQL_USDT_SEMAPHORE(handshake_auth_more_data)
+BOOST_MYSQL_USDT_SEMAPHORE(handshake_auth_finish)
+}
+
+#undef BOOST_MYSQL_USDT_SEMAPHORE
+
+#define BOOST_MYSQL_USDT_ENABLED(name) (__builtin_expect(boost_mysql_##name##_semaphore != 0, 0))
+
+#define BOOST_MYSQL_USDT0(name)              \
+    do                                       \
+    {                                        \
+        if (BOOST_MYSQL_USDT_ENABLED(name))  \
+            DTRACE_PROBE(boost_mysql, name); \
+    } while (false)
+#define BOOST_MYSQL_USDT1(name, a1)               \
+    do                                            \
+    {                                             \
+        if (BOOST_MYSQL_USDT_ENABLED(name))       \
+            DTRACE_PROBE1(boost_mysql, name, a1); \
+    } while (false)
+#define BOOST_MYSQL_USDT2(name, a1, a2)               \
+    do                                                \
+    {                                                 \
+        if (BOOST_MYSQL_USDT_ENABLED(name))           \
+            DTRACE_PROBE2(boost_mysql, name, a1, a2); \
+    } while (false)
+#define BOOST_MYSQL_USDT3(name, a1, a2, a3)               \
+    do                                                    \
+    {                                                     \
+        if (BOOST_MYSQL_USDT_ENABLED(name))               \
+            DTRACE_PROBE3(boost_mysql, name, a1, a2, a3); \
+    } while (false)
+#define BOOST_MYSQL_USDT4(name, a1, a2, a3, a4)               \
+    do                                                        \
+    {                                                         \
+        if (BOOST_MYSQL_USDT_ENABLED(name))                   \
+            DTRACE_PROBE4(boost_mysql, name, a1, a2, a3, a4); \
+    } while (false)
+#define BOOST_MYSQL_USDT6(name, a1, a2, a3, a4, a5, a6)               \
+    do                                                                \
+    {                                                                 \
+        if (BOOST_MYSQL_USDT_ENABLED(name))                           \
+            DTRACE_PROBE6(boost_mysql, name, a1, a2, a3, a4, a5, a6); \
+    } while (false)
+
+#else
+
+#define BOOST_MYSQL_USDT_ENABLED(name)                  false
+#define BOOST_MYSQL_USDT0(name)                         ((void)0)
+#define BOOST_MYSQL_USDT1(name, a1)                     ((void)0)
+#define BOOST_MYSQL_USDT2(name, a1, a2)                 ((void)0)
+#define BOOST_MYSQL_USDT3(name, a1, a2, a3)             ((void)0)
+#define BOOST_MYSQL_USDT4(name, a1, a2, a3, a4)         ((void)0)
+#define BOOST_MYSQL_USDT6(name, a1, a2, a3, a4, a5, a6) ((void)0)
+
+#endif
+
+#endif
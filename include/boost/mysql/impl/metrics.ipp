@@ -0,0 +1,383 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_METRICS_IPP
+#define BOOST_MYSQL_IMPL_METRICS_IPP
+
+#pragma once
+
+#include <boost/mysql/metrics.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+struct boost::mysql::metrics_observer::stripe
+{
+    std::array<histogram, num_operation_types> latency;
+    std::array<std::atomic<std::uint64_t>, num_operation_types> errors;
+
+    // Set while a thread is recording into this stripe
+    std::atomic<bool> in_use{false};
+
+    stripe() noexcept { reset(); }
+
+    void reset() noexcept
+    {
+        for (auto& h : latency)
+            h.reset();
+        for (auto& e : errors)
+            e.store(0, std::memory_order_relaxed);
+    }
+};
+
+// The stripes claimed by the current thread, one per observer. Stripes are released on thread exit.
+// Entries keep their stripes alive, so this is safe even if the observer has been destroyed
+struct boost::mysql::metrics_observer::thread_stripes
+{
+    struct entry
+    {
+        std::uint64_t observer_id;
+        std::shared_ptr<stripe> st;
+    };
+    std::vector<entry> entries;
+
+    thread_stripes() = default;
+    thread_stripes(const thread_stripes&) = delete;
+    thread_stripes& operator=(const thread_stripes&) = delete;
+    ~thread_stripes()
+    {
+        for (auto& e : entries)
+            e.st->in_use.store(false, std::memory_order_release);
+    }
+
+    stripe* find(std::uint64_t observer_id) const noexcept
+    {
+        for (const auto& e : entries)
+        {
+            if (e.observer_id == observer_id)
+                return e.st.get();
+        }
+        return nullptr;
+    }
+
+    static thread_stripes& current()
+    {
+        static thread_local thread_stripes res;
+        return res;
+    }
+};
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Identifies observers in thread_stripes. Never reused
+inline std::uint64_t next_metrics_observer_id() noexcept
+{
+    static std::atomic<std::uint64_t> next_id{0};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline const char* operation_type_name(operation_type t) noexcept
+{
+    switch (t)
+    {
+    case operation_type::connect: return "connect";
+    case operation_type::handshake: return "handshake";
+    case operation_type::execute: return "execute";
+    case operation_type::start_execution: return "start_execution";
+    case operation_type::read_resultset_head: return "read_resultset_head";
+    case operation_type::read_some_rows: return "read_some_rows";
+    case operation_type::prepare_statement: return "prepare_statement";
+    case operation_type::close_statement: return "close_statement";
+    case operation_type::ping: return "ping";
+    case operation_type::close: return "close";
+    case operation_type::quit: return "quit";
+    default: return "<unknown operation_type>";
+    }
+}
+
+// Histogram buckets are exported at 2^n - 1 nanoseconds, for n in this range
+constexpr unsigned openmetrics_first_bucket_exp = 10;  // ~1us
+constexpr unsigned openmetrics_last_bucket_exp = 36;   // ~68s
+
+// Formats a number of nanoseconds as an exact decimal number of seconds, without trailing zeros
+inline void format_nanos_as_seconds(std::uint64_t nanos, char (&output)[32]) noexcept
+{
+    int size = std::snprintf(
+        output,
+        sizeof(output),
+        "%llu.%09llu",
+        static_cast<unsigned long long>(nanos / 1000000000u),
+        static_cast<unsigned long long>(nanos % 1000000000u)
+    );
+    while (output[size - 1] == '0')
+        output[--size] = '\0';
+    if (output[size - 1] == '.')
+        output[size - 1] = '\0';
+}
+
+class openmetrics_writer
+{
+    std::string& output_;
+    char buff_[128];
+
+    void append_buff(int size) { output_.append(buff_, static_cast<std::size_t>(size)); }
+
+public:
+    openmetrics_writer(std::string& output) noexcept : output_(output) {}
+
+    void family(const char* name, const char* type, const char* help)
+    {
+        output_ += "# TYPE ";
+        output_ += name;
+        output_ += ' ';
+        output_ += type;
+        output_ += "\n# HELP ";
+        output_ += name;
+        output_ += ' ';
+        output_ += help;
+        output_ += '\n';
+    }
+
+    void sample(const char* name, const char* suffix, const char* labels, std::uint64_t value)
+    {
+        append_buff(std::snprintf(
+            buff_,
+            sizeof(buff_),
+            "%s%s%s %llu\n",
+            name,
+            suffix,
+            labels,
+            static_cast<unsigned long long>(value)
+        ));
+    }
+
+    void sample(const char* name, const char* suffix, const char* labels, double value)
+    {
+        append_buff(std::snprintf(buff_, sizeof(buff_), "%s%s%s %.9g\n", name, suffix, labels, value));
+    }
+
+    void operation_histogram(const char* name, const char* operation, const histogram_snapshot& h)
+    {
+        char labels[96];
+        std::uint64_t cumulative = 0;
+        std::size_t next_bucket = 0;
+        const auto& counts = h.bucket_counts();
+        for (unsigned exp = openmetrics_first_bucket_exp; exp <= openmetrics_last_bucket_exp; ++exp)
+        {
+            std::uint64_t upper = (std::uint64_t(1) << exp) - 1u;
+            std::size_t last_bucket = histogram::bucket_index(upper);
+            if (!counts.empty())
+            {
+                for (; next_bucket <= last_bucket; ++next_bucket)
+                    cumulative += counts[next_bucket];
+            }
+            char le[32];
+            format_nanos_as_seconds(upper, le);
+            std::snprintf(labels, sizeof(labels), "{operation=\"%s\",le=\"%s\"}", operation, le);
+            sample(name, "_bucket", labels, cumulative);
+        }
+        std::snprintf(labels, sizeof(labels), "{operation=\"%s\",le=\"+Inf\"}", operation);
+        sample(name, "_bucket", labels, h.count());
+        std::snprintf(labels, sizeof(labels), "{operation=\"%s\"}", operation);
+        sample(name, "_count", labels, h.count());
+        sample(name, "_sum", labels, static_cast<double>(h.sum()) * 1e-9);
+    }
+
+    void operations(const metrics_snapshot& metrics)
+    {
+        const char* duration_name = "boost_mysql_operation_duration_seconds";
+        family(duration_name, "histogram", "Latency of client operations.");
+        for (std::size_t i = 0; i < num_operation_types; ++i)
+        {
+            operation_histogram(
+                duration_name,
+                operation_type_name(static_cast<operation_type>(i)),
+                metrics.operations[i].latency
+            );
+        }
+
+        const char* errors_name = "boost_mysql_operation_errors";
+        family(errors_name, "counter", "Number of client operations that failed.");
+        for (std::size_t i = 0; i < num_operation_types; ++i)
+        {
+            char labels[64];
+            std::snprintf(
+                labels,
+                sizeof(labels),
+                "{operation=\"%s\"}",
+                operation_type_name(static_cast<operation_type>(i))
+            );
+            sample(errors_name, "_total", labels, metrics.operations[i].errors);
+        }
+    }
+
+    void counter(const char* name, const char* help, std::uint64_t value)
+    {
+        family(name, "counter", help);
+        sample(name, "_total", "", value);
+    }
+
+    void counter(const char* name, const char* help, std::chrono::nanoseconds value)
+    {
+        family(name, "counter", help);
+        sample(name, "_total", "", static_cast<double>(value.count()) * 1e-9);
+    }
+
+    void connection_counters(const connection_stats& st)
+    {
+        counter("boost_mysql_connection_read_bytes", "Bytes read from the network.", st.bytes_read);
+        counter("boost_mysql_connection_written_bytes", "Bytes written to the network.", st.bytes_written);
+        counter("boost_mysql_connection_read_calls", "Stream read operations.", st.read_calls);
+        counter("boost_mysql_connection_write_calls", "Stream write operations.", st.write_calls);
+        counter("boost_mysql_connection_messages_read", "Protocol messages received.", st.messages_read);
+        counter("boost_mysql_connection_messages_written", "Protocol messages sent.", st.messages_written);
+        counter("boost_mysql_connection_frames_read", "Protocol frames received.", st.frames_read);
+        counter(
+            "boost_mysql_connection_multiframe_messages_read",
+            "Received messages spanning more than one frame.",
+            st.multiframe_messages_read
+        );
+        counter(
+            "boost_mysql_connection_read_buffer_growths",
+            "Times a read buffer was enlarged.",
+            st.read_buffer_growths
+        );
+        counter("boost_mysql_connection_rows_read", "Rows decoded.", st.rows_read);
+        counter("boost_mysql_connection_io_seconds", "Time spent in stream operations.", st.io_time);
+        counter("boost_mysql_connection_decode_seconds", "Time spent decoding rows.", st.decode_time);
+
+        const char* buffer_name = "boost_mysql_connection_read_buffer_bytes";
+        family(buffer_name, "gauge", "Current size of read buffers.");
+        sample(buffer_name, "", "", static_cast<std::uint64_t>(st.read_buffer_size));
+    }
+
+    void eof() { output_ += "# EOF\n"; }
+};
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+boost::mysql::metrics_observer::metrics_observer(std::size_t num_stripes)
+    : id_(detail::next_metrics_observer_id())
+{
+    stripes_.resize(num_stripes ? num_stripes : 1u);
+    for (auto& st : stripes_)
+        st = std::make_shared<stripe>();
+}
+
+boost::mysql::metrics_observer::~metrics_observer() = default;
+
+std::size_t boost::mysql::metrics_observer::num_stripes() const noexcept
+{
+    std::lock_guard<std::mutex> guard(mtx_);
+    return stripes_.size();
+}
+
+boost::mysql::metrics_observer::stripe& boost::mysql::metrics_observer::claim_stripe()
+{
+    auto& entries = thread_stripes::current().entries;
+
+    // Entries for destroyed observers hold the only reference to their stripes
+    entries.erase(
+        std::remove_if(
+            entries.begin(),
+            entries.end(),
+            [](const thread_stripes::entry& e) { return e.st.use_count() == 1; }
+        ),
+        entries.end()
+    );
+    entries.reserve(entries.size() + 1u);
+
+    // Reuse a stripe released by an exited thread, if any
+    std::lock_guard<std::mutex> guard(mtx_);
+    auto it = std::find_if(stripes_.begin(), stripes_.end(), [](const std::shared_ptr<stripe>& st) {
+        return !st->in_use.load(std::memory_order_acquire);
+    });
+    if (it == stripes_.end())
+    {
+        stripes_.push_back(std::make_shared<stripe>());
+        it = stripes_.end() - 1;
+    }
+    (*it)->in_use.store(true, std::memory_order_relaxed);
+    entries.push_back({id_, *it});
+    return **it;
+}
+
+void boost::mysql::metrics_observer::on_operation_finish(const operation_info& info) noexcept
+{
+    auto type_idx = static_cast<std::size_t>(info.type);
+    if (type_idx >= num_operation_types)
+        return;
+
+    // Only the first operation recorded by each thread claims a stripe. Samples are dropped
+    // if this fails, as observers can't report errors
+    stripe* st_ptr = thread_stripes::current().find(id_);
+    if (!st_ptr)
+    {
+        try
+        {
+            st_ptr = &claim_stripe();
+        }
+        catch (...)
+        {
+            return;
+        }
+    }
+    auto& st = *st_ptr;
+    auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(info.finished - info.started);
+    st.latency[type_idx].record(static_cast<std::uint64_t>(latency.count()));
+    if (info.error)
+        st.errors[type_idx].fetch_add(1, std::memory_order_relaxed);
+}
+
+boost::mysql::metrics_snapshot boost::mysql::metrics_observer::snapshot() const
+{
+    metrics_snapshot res;
+    std::lock_guard<std::mutex> guard(mtx_);
+    for (const auto& st : stripes_)
+    {
+        for (std::size_t j = 0; j < num_operation_types; ++j)
+        {
+            res.operations[j].latency.merge(st->latency[j].snapshot());
+            res.operations[j].errors += st->errors[j].load(std::memory_order_relaxed);
+        }
+    }
+    return res;
+}
+
+void boost::mysql::metrics_observer::reset() noexcept
+{
+    std::lock_guard<std::mutex> guard(mtx_);
+    for (const auto& st : stripes_)
+        st->reset();
+}
+
+std::string boost::mysql::to_openmetrics(const metrics_snapshot& metrics)
+{
+    std::string res;
+    detail::openmetrics_writer writer(res);
+    writer.operations(metrics);
+    writer.eof();
+    return res;
+}
+
+std::string boost::mysql::to_openmetrics(const metrics_snapshot& metrics, const connection_stats& conn_stats)
+{
+    std::string res;
+    detail::openmetrics_writer writer(res);
+    writer.operations(metrics);
+    writer.connection_counters(conn_stats);
+    writer.eof();
+    return res;
+}
+
+#endif
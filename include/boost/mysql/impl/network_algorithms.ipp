@@ -16,7 +16,9 @@
 #include <boost/mysql/impl/internal/network_algorithms/close_statement.hpp>
 #include <boost/mysql/impl/internal/network_algorithms/connect.hpp>
 #include <boost/mysql/impl/internal/network_algorithms/execute.hpp>
+#include <boost/mysql/impl/internal/network_algorithms/execute_prepared_once.hpp>
 #include <boost/mysql/impl/internal/network_algorithms/handshake.hpp>
+#include <boost/mysql/impl/internal/network_algorithms/observe_operation.hpp>
 #include <boost/mysql/impl/internal/network_algorithms/ping.hpp>
 #include <boost/mysql/impl/internal/network_algorithms/prepare_statement.hpp>
 #include <boost/mysql/impl/internal/network_algorithms/quit_connection.hpp>
@@ -25,6 +27,11 @@
 #include <boost/mysql/impl/internal/network_algorithms/read_some_rows_dynamic.hpp>
 #include <boost/mysql/impl/internal/network_algorithms/start_execution.hpp>
 
+boost::mysql::error_code boost::mysql::detail::finish_async_operation(channel& chan, error_code err) noexcept
+{
+    return chan.finish_async_operation(err);
+}
+
 void boost::mysql::detail::connect_erased(
     channel& chan,
     const void* endpoint,
@@ -33,6 +40,7 @@ void boost::mysql::detail::connect_erased(
     diagnostics& diag
 )
 {
+    operation_guard guard(chan, chan.start_operation(operation_type::connect), err);
     connect_impl(chan, endpoint, params, err, diag);
 }
 
@@ -44,6 +52,8 @@ void boost::mysql::detail::async_connect_erased(
     any_void_handler handler
 )
 {
+    bool observed = chan.start_operation(operation_type::connect);
+    chan.start_async_operation(observed);
     async_connect_impl(chan, endpoint, params, diag, std::move(handler));
 }
 
@@ -54,6 +64,7 @@ void boost::mysql::detail::handshake_erased(
     diagnostics& diag
 )
 {
+    operation_guard guard(channel, channel.start_operation(operation_type::handshake), err);
     handshake_impl(channel, params, err, diag);
 }
 
@@ -64,6 +75,8 @@ void boost::mysql::detail::async_handshake_erased(
     any_void_handler handler
 )
 {
+    bool observed = chan.start_operation(operation_type::handshake);
+    chan.start_async_operation(observed);
     async_handshake_impl(chan, params, diag, std::move(handler));
 }
 
@@ -75,6 +88,7 @@ void boost::mysql::detail::execute_erased(
     diagnostics& diag
 )
 {
+    operation_guard guard(channel, start_operation(channel, operation_type::execute, req), err);
     execute_impl(channel, req, output, err, diag);
 }
 
@@ -86,6 +100,8 @@ void boost::mysql::detail::async_execute_erased(
     any_void_handler handler
 )
 {
+    bool observed = start_operation(chan, operation_type::execute, req);
+    chan.start_async_operation(observed);
     async_execute_impl(chan, req, output, diag, std::move(handler));
 }
 
@@ -97,6 +113,7 @@ void boost::mysql::detail::start_execution_erased(
     diagnostics& diag
 )
 {
+    operation_guard guard(channel, start_operation(channel, operation_type::start_execution, req), err);
     start_execution_impl(channel, req, proc, err, diag);
 }
 
@@ -108,6 +125,8 @@ void boost::mysql::detail::async_start_execution_erased(
     any_void_handler handler
 )
 {
+    bool observed = start_operation(channel, operation_type::start_execution, req);
+    channel.start_async_operation(observed);
     async_start_execution_impl(channel, req, proc, diag, std::move(handler));
 }
 
@@ -118,6 +137,7 @@ boost::mysql::statement boost::mysql::detail::prepare_statement_erased(
     diagnostics& diag
 )
 {
+    operation_guard guard(chan, chan.start_operation(operation_type::prepare_statement, stmt), err);
     return prepare_statement_impl(chan, stmt, err, diag);
 }
 
@@ -128,6 +148,8 @@ void boost::mysql::detail::async_prepare_statement_erased(
     any_handler<statement> handler
 )
 {
+    bool observed = chan.start_operation(operation_type::prepare_statement, stmt);
+    chan.start_async_operation(observed);
     async_prepare_statement_impl(chan, stmt, diag, std::move(handler));
 }
 
@@ -138,6 +160,7 @@ void boost::mysql::detail::close_statement_erased(
     diagnostics& diag
 )
 {
+    operation_guard guard(chan, chan.start_operation(operation_type::close_statement, {}, stmt.id()), err);
     close_statement_impl(chan, stmt, err, diag);
 }
 
@@ -148,9 +171,38 @@ void boost::mysql::detail::async_close_statement_erased(
     any_void_handler handler
 )
 {
+    bool observed = chan.start_operation(operation_type::close_statement, {}, stmt.id());
+    chan.start_async_operation(observed);
     async_close_statement_impl(chan, stmt, diag, std::move(handler));
 }
 
+void boost::mysql::detail::execute_prepared_once_erased(
+    channel& chan,
+    string_view sql,
+    span<const field_view> params,
+    execution_processor& proc,
+    error_code& err,
+    diagnostics& diag
+)
+{
+    operation_guard guard(chan, chan.start_operation(operation_type::execute, sql), err);
+    execute_prepared_once_impl(chan, sql, params, proc, err, diag);
+}
+
+void boost::mysql::detail::async_execute_prepared_once_erased(
+    channel& chan,
+    string_view sql,
+    span<const field_view> params,
+    execution_processor& proc,
+    diagnostics& diag,
+    any_void_handler handler
+)
+{
+    bool observed = chan.start_operation(operation_type::execute, sql);
+    chan.start_async_operation(observed);
+    async_execute_prepared_once_impl(chan, sql, params, proc, diag, std::move(handler));
+}
+
 boost::mysql::rows_view boost::mysql::detail::read_some_rows_dynamic_erased(
     channel& chan,
     execution_state_impl& st,
@@ -158,6 +210,7 @@ boost::mysql::rows_view boost::mysql::detail::read_some_rows_dynamic_erased(
     diagnostics& diag
 )
 {
+    operation_guard guard(chan, chan.start_operation(operation_type::read_some_rows), err);
     return read_some_rows_dynamic_impl(chan, st, err, diag);
 }
 
@@ -168,6 +221,8 @@ void boost::mysql::detail::async_read_some_rows_dynamic_erased(
     any_handler<rows_view> handler
 )
 {
+    bool observed = chan.start_operation(operation_type::read_some_rows);
+    chan.start_async_operation(observed);
     async_read_some_rows_dynamic_impl(chan, st, diag, std::move(handler));
 }
 
@@ -179,6 +234,7 @@ std::size_t boost::mysql::detail::read_some_rows_static_erased(
     diagnostics& diag
 )
 {
+    operation_guard guard(chan, chan.start_operation(operation_type::read_some_rows), err);
     return read_some_rows_impl(chan, proc, output, err, diag);
 }
 
@@ -190,6 +246,8 @@ void boost::mysql::detail::async_read_some_rows_erased(
     any_handler<std::size_t> handler
 )
 {
+    bool observed = chan.start_operation(operation_type::read_some_rows);
+    chan.start_async_operation(observed);
     async_read_some_rows_impl(chan, proc, output, diag, std::move(handler));
 }
 
@@ -200,6 +258,7 @@ void boost::mysql::detail::read_resultset_head_erased(
     diagnostics& diag
 )
 {
+    operation_guard guard(channel, channel.start_operation(operation_type::read_resultset_head), err);
     read_resultset_head_impl(channel, proc, err, diag);
 }
 
@@ -210,21 +269,27 @@ void boost::mysql::detail::async_read_resultset_head_erased(
     any_void_handler handler
 )
 {
+    bool observed = chan.start_operation(operation_type::read_resultset_head);
+    chan.start_async_operation(observed);
     async_read_resultset_head_impl(chan, proc, diag, std::move(handler));
 }
 
 void boost::mysql::detail::ping_erased(channel& chan, error_code& code, diagnostics& diag)
 {
+    operation_guard guard(chan, chan.start_operation(operation_type::ping), code);
     ping_impl(chan, code, diag);
 }
 
 void boost::mysql::detail::async_ping_erased(channel& chan, diagnostics& diag, any_void_handler handler)
 {
+    bool observed = chan.start_operation(operation_type::ping);
+    chan.start_async_operation(observed);
     async_ping_impl(chan, diag, std::move(handler));
 }
 
 void boost::mysql::detail::close_connection_erased(channel& chan, error_code& code, diagnostics& diag)
 {
+    operation_guard guard(chan, chan.start_operation(operation_type::close), code);
     close_connection_impl(chan, code, diag);
 }
 
@@ -234,11 +299,14 @@ void boost::mysql::detail::async_close_connection_erased(
     any_void_handler handler
 )
 {
+    bool observed = chan.start_operation(operation_type::close);
+    chan.start_async_operation(observed);
     async_close_connection_impl(chan, diag, std::move(handler));
 }
 
 void boost::mysql::detail::quit_connection_erased(channel& chan, error_code& err, diagnostics& diag)
 {
+    operation_guard guard(chan, chan.start_operation(operation_type::quit), err);
     quit_connection_impl(chan, err, diag);
 }
 
@@ -248,6 +316,8 @@ void boost::mysql::detail::async_quit_connection_erased(
     any_void_handler handler
 )
 {
+    bool observed = chan.start_operation(operation_type::quit);
+    chan.start_async_operation(observed);
     async_quit_connection_impl(chan, diag, std::move(handler));
 }
 
@@ -0,0 +1,266 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_NORMALIZE_QUERY_IPP
+#define BOOST_MYSQL_IMPL_NORMALIZE_QUERY_IPP
+
+#pragma once
+
+#include <boost/mysql/detail/normalize_query.hpp>
+
+#include <cstddef>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+class query_normalizer
+{
+    const char* it_;
+    const char* end_;
+    std::string& output_;
+
+    static bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+    static bool is_hex_digit(char c) noexcept
+    {
+        return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+    static bool is_space(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+    static bool is_word_char(char c) noexcept
+    {
+        return is_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$' ||
+               static_cast<unsigned char>(c) >= 0x80;
+    }
+
+    std::size_t remaining() const noexcept { return static_cast<std::size_t>(end_ - it_); }
+    bool starts_with(string_view s) const noexcept
+    {
+        return remaining() >= s.size() && string_view(it_, s.size()) == s;
+    }
+
+    bool ends_with(string_view s) const noexcept
+    {
+        return output_.size() >= s.size() && string_view(output_).substr(output_.size() - s.size()) == s;
+    }
+
+    void begin_token()
+    {
+        if (!output_.empty())
+            output_.push_back(' ');
+    }
+
+    void emit(string_view token)
+    {
+        begin_token();
+        output_.append(token.data(), token.size());
+    }
+
+    void emit_literal()
+    {
+        // Collapse lists of literals: "? , ?" => "...", "... , ?" => "..."
+        if (ends_with("? ,"))
+        {
+            output_.resize(output_.size() - 3);
+            output_.append("...");
+        }
+        else if (ends_with("... ,"))
+        {
+            output_.resize(output_.size() - 2);
+        }
+        else
+        {
+            emit("?");
+        }
+    }
+
+    // Skips a quoted string or identifier, with it_ pointing to the opening quote.
+    // Quotes can be escaped by doubling them or, except for identifiers, with backslashes
+    void skip_quoted()
+    {
+        char quote = *it_++;
+        while (it_ != end_)
+        {
+            char c = *it_++;
+            if (c == '\\' && quote != '`' && it_ != end_)
+            {
+                ++it_;
+            }
+            else if (c == quote)
+            {
+                if (it_ != end_ && *it_ == quote)
+                    ++it_;
+                else
+                    return;
+            }
+        }
+    }
+
+    // Skips a number if it_ points to one. Returns false if it's not a number
+    // (e.g. an identifier starting with a digit)
+    bool skip_number()
+    {
+        const char* p = it_;
+
+        // Hex and bit literals
+        if (remaining() > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'b'))
+        {
+            const char* q = p + 2;
+            while (q != end_ && (p[1] == 'x' ? is_hex_digit(*q) : (*q == '0' || *q == '1')))
+                ++q;
+            if (q != p + 2 && (q == end_ || !is_word_char(*q)))
+            {
+                it_ = q;
+                return true;
+            }
+        }
+
+        // Decimal, with an optional fractional part and exponent
+        while (p != end_ && is_digit(*p))
+            ++p;
+        if (p != end_ && *p == '.')
+        {
+            ++p;
+            while (p != end_ && is_digit(*p))
+                ++p;
+        }
+        if (p != end_ && (*p == 'e' || *p == 'E'))
+        {
+            const char* q = p + 1;
+            if (q != end_ && (*q == '+' || *q == '-'))
+                ++q;
+            if (q != end_ && is_digit(*q))
+            {
+                while (q != end_ && is_digit(*q))
+                    ++q;
+                p = q;
+            }
+        }
+        if (p == it_ || (p != end_ && is_word_char(*p)))
+            return false;
+        it_ = p;
+        return true;
+    }
+
+    void process_word()
+    {
+        const char* first = it_;
+        while (it_ != end_ && is_word_char(*it_))
+            ++it_;
+        string_view word(first, static_cast<std::size_t>(it_ - first));
+
+        // Hex, bit and national strings: X'0A', B'01', N'abc'
+        if (word.size() == 1 && it_ != end_ && *it_ == '\'')
+        {
+            char c = word[0];
+            if (c == 'x' || c == 'X' || c == 'b' || c == 'B' || c == 'n' || c == 'N')
+            {
+                skip_quoted();
+                emit_literal();
+                return;
+            }
+        }
+        emit(word);
+    }
+
+    void process_operator()
+    {
+        static constexpr const char* multi_char_ops[] =
+            {"<=>", "->>", "<=", ">=", "<>", "!=", ":=", "||", "&&", "<<", ">>", "->"};
+        for (const char* op : multi_char_ops)
+        {
+            if (starts_with(op))
+            {
+                string_view op_view(op);
+                it_ += op_view.size();
+                emit(op_view);
+                return;
+            }
+        }
+        emit(string_view(it_++, 1));
+    }
+
+public:
+    query_normalizer(string_view query, std::string& output) noexcept
+        : it_(query.data()), end_(query.data() + query.size()), output_(output)
+    {
+    }
+
+    void run()
+    {
+        output_.clear();
+        while (it_ != end_)
+        {
+            char c = *it_;
+            if (is_space(c))
+            {
+                ++it_;
+            }
+            else if (c == '#' || (starts_with("--") && (remaining() == 2 || is_space(it_[2]))))
+            {
+                // Single line comment
+                while (it_ != end_ && *it_ != '\n')
+                    ++it_;
+            }
+            else if (starts_with("/*"))
+            {
+                // Block comment
+                it_ += 2;
+                while (it_ != end_ && !starts_with("*/"))
+                    ++it_;
+                it_ = it_ == end_ ? end_ : it_ + 2;
+            }
+            else if (c == '\'' || c == '"')
+            {
+                skip_quoted();
+                emit_literal();
+            }
+            else if (c == '?')
+            {
+                // Placeholders are treated like literals
+                ++it_;
+                emit_literal();
+            }
+            else if (c == '`')
+            {
+                const char* first = it_;
+                skip_quoted();
+                emit(string_view(first, static_cast<std::size_t>(it_ - first)));
+            }
+            else if (is_digit(c) || (c == '.' && remaining() > 1 && is_digit(it_[1])))
+            {
+                if (skip_number())
+                    emit_literal();
+                else if (is_word_char(c))
+                    process_word();
+                else
+                    process_operator();
+            }
+            else if (is_word_char(c))
+            {
+                process_word();
+            }
+            else
+            {
+                process_operator();
+            }
+        }
+    }
+};
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+void boost::mysql::detail::normalize_query(string_view query, std::string& output)
+{
+    query_normalizer(query, output).run();
+}
+
+#endif
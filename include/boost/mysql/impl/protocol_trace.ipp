@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_PROTOCOL_TRACE_IPP
+#define BOOST_MYSQL_IMPL_PROTOCOL_TRACE_IPP
+
+#pragma once
+
+#include <boost/mysql/protocol_trace.hpp>
+
+#include <cstdio>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+inline void format_trace_records(const protocol_trace& trace, std::string& output)
+{
+    char buff[128];
+    int size = std::snprintf(
+        buff,
+        sizeof(buff),
+        "protocol trace: %zu records (%llu total)\n",
+        trace.size(),
+        static_cast<unsigned long long>(trace.total_records())
+    );
+    output.append(buff, static_cast<std::size_t>(size));
+    if (trace.size() == 0u)
+        return;
+
+    auto newest = trace[trace.size() - 1].timestamp;
+    for (std::size_t i = 0; i < trace.size(); ++i)
+    {
+        const auto& rec = trace[i];
+        auto delta = std::chrono::duration_cast<std::chrono::microseconds>(newest - rec.timestamp);
+        size = std::snprintf(
+            buff,
+            sizeof(buff),
+            "%10lldus %s seq=%-3u frames=%-3u size=%-9zu |",
+            -static_cast<long long>(delta.count()),
+            rec.direction == trace_direction::write ? "C->S" : "S->C",
+            static_cast<unsigned>(rec.seqnum),
+            static_cast<unsigned>(rec.num_frames),
+            rec.size
+        );
+        output.append(buff, static_cast<std::size_t>(size));
+        for (std::size_t j = 0; j < rec.prefix_size; ++j)
+        {
+            size = std::snprintf(buff, sizeof(buff), " %02x", static_cast<unsigned>(rec.prefix[j]));
+            output.append(buff, static_cast<std::size_t>(size));
+        }
+        if (rec.size > rec.prefix_size)
+            output += " ...";
+        output += '\n';
+    }
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+std::string boost::mysql::format_protocol_trace(const protocol_trace& trace)
+{
+    std::string res;
+    detail::format_trace_records(trace, res);
+    return res;
+}
+
+std::string boost::mysql::format_protocol_trace(
+    const protocol_trace& trace,
+    error_code ec,
+    const diagnostics& diag
+)
+{
+    std::string res = "error: ";
+    res += ec.message();
+    res += " [";
+    res += ec.category().name();
+    res += ':';
+    res += std::to_string(ec.value());
+    res += "]\n";
+    if (!diag.server_message().empty())
+    {
+        res += "server message: ";
+        res.append(diag.server_message().data(), diag.server_message().size());
+        res += '\n';
+    }
+    if (!diag.client_message().empty())
+    {
+        res += "client message: ";
+        res.append(diag.client_message().data(), diag.client_message().size());
+        res += '\n';
+    }
+    detail::format_trace_records(trace, res);
+    return res;
+}
+
+#endif
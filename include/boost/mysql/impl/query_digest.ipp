@@ -0,0 +1,250 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_QUERY_DIGEST_IPP
+#define BOOST_MYSQL_IMPL_QUERY_DIGEST_IPP
+
+#pragma once
+
+#include <boost/mysql/query_digest.hpp>
+
+#include <boost/mysql/detail/normalize_query.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+struct boost::mysql::query_digest_table::entry
+{
+    std::uint64_t fingerprint;
+    operation_type type;
+    std::string normalized_query;
+    std::uint32_t statement_id;
+    std::atomic<std::uint64_t> errors{0};
+    histogram latency;
+    histogram rows;
+    histogram bytes_read;
+
+    entry(std::uint64_t fp, operation_type t, string_view q, std::uint32_t stmt_id)
+        : fingerprint(fp), type(t), normalized_query(q.data(), q.size()), statement_id(stmt_id)
+    {
+    }
+
+    // Fingerprints may collide. Comparing the identifying fields guarantees
+    // that different queries never share a digest
+    bool matches(std::uint64_t fp, operation_type t, string_view q, std::uint32_t stmt_id) const noexcept
+    {
+        return fingerprint == fp && type == t && statement_id == stmt_id && normalized_query == q;
+    }
+};
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+inline bool is_digestable(operation_type t) noexcept
+{
+    return t == operation_type::execute || t == operation_type::start_execution ||
+           t == operation_type::prepare_statement;
+}
+
+inline bool is_statement_execution(const operation_info& info) noexcept
+{
+    return info.type != operation_type::prepare_statement && info.query.empty();
+}
+
+inline std::uint64_t digest_fingerprint(const operation_info& info, string_view normalized) noexcept
+{
+    char type_byte = static_cast<char>(info.type);
+    auto res = fnv1a_hash(string_view(&type_byte, 1));
+    if (is_statement_execution(info))
+    {
+        char id_bytes[5]{'#'};
+        for (std::size_t i = 0; i < 4; ++i)
+            id_bytes[i + 1] = static_cast<char>((info.statement_id >> (8 * i)) & 0xff);
+        return fnv1a_hash(string_view(id_bytes, sizeof(id_bytes)), res);
+    }
+    return fnv1a_hash(normalized, res);
+}
+
+inline const char* digest_type_prefix(operation_type t) noexcept
+{
+    switch (t)
+    {
+    case operation_type::start_execution: return "[start_execution] ";
+    case operation_type::prepare_statement: return "[prepare_statement] ";
+    default: return "";
+    }
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+boost::mysql::query_digest_table::query_digest_table(std::size_t max_digests)
+    : shard_size_((std::max)((max_digests + num_shards - 1) / num_shards, std::size_t(1))),
+      slots_(new std::atomic<entry*>[num_shards * shard_size_])
+{
+    for (std::size_t i = 0; i < num_shards * shard_size_; ++i)
+        slots_[i].store(nullptr, std::memory_order_relaxed);
+}
+
+boost::mysql::query_digest_table::~query_digest_table()
+{
+    for (std::size_t i = 0; i < num_shards * shard_size_; ++i)
+        delete slots_[i].load(std::memory_order_relaxed);
+}
+
+bool boost::mysql::query_digest_table::record_impl(
+    std::uint64_t fingerprint,
+    const operation_info& info,
+    string_view normalized
+)
+{
+    // The shard is selected by the upper bits, the position within it by the lower ones
+    std::atomic<entry*>* shard = slots_.get() + (fingerprint >> 60) % num_shards * shard_size_;
+    std::size_t first = static_cast<std::size_t>(fingerprint % shard_size_);
+    std::unique_ptr<entry> new_entry;
+    bool is_stmt = detail::is_statement_execution(info);
+    string_view query = is_stmt ? string_view() : normalized;
+    std::uint32_t stmt_id = is_stmt ? info.statement_id : 0u;
+
+    for (std::size_t i = 0; i < shard_size_; ++i)
+    {
+        auto& slot = shard[(first + i) % shard_size_];
+        entry* e = slot.load(std::memory_order_acquire);
+        if (e == nullptr)
+        {
+            // Try to claim this slot
+            if (!new_entry)
+            {
+                new_entry.reset(new entry(fingerprint, info.type, query, stmt_id));
+            }
+            if (slot.compare_exchange_strong(e, new_entry.get(), std::memory_order_acq_rel))
+                e = new_entry.release();
+        }
+
+        // e is non-null here, either because we inserted it or because another thread did
+        if (e->matches(fingerprint, info.type, query, stmt_id))
+        {
+            if (info.error)
+                e->errors.fetch_add(1, std::memory_order_relaxed);
+            e->latency.record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(info.finished - info.started).count()
+            ));
+            e->rows.record(info.rows_read);
+            e->bytes_read.record(info.bytes_read);
+            return true;
+        }
+    }
+
+    // The shard is full
+    return false;
+}
+
+void boost::mysql::query_digest_table::record(const operation_info& info) noexcept
+{
+    if (!detail::is_digestable(info.type))
+        return;
+
+    bool ok = false;
+    try
+    {
+        // Reuse the buffer to avoid allocating in the common case
+        static thread_local std::string normalized;
+        if (!detail::is_statement_execution(info))
+            detail::normalize_query(info.query, normalized);
+        else
+            normalized.clear();
+        ok = record_impl(detail::digest_fingerprint(info, normalized), info, normalized);
+    }
+    catch (...)
+    {
+    }
+
+    if (!ok)
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<boost::mysql::query_digest> boost::mysql::query_digest_table::snapshot() const
+{
+    std::vector<query_digest> res;
+    for (std::size_t i = 0; i < num_shards * shard_size_; ++i)
+    {
+        const entry* e = slots_[i].load(std::memory_order_acquire);
+        if (e)
+        {
+            query_digest d;
+            d.fingerprint = e->fingerprint;
+            d.type = e->type;
+            d.normalized_query = e->normalized_query;
+            d.statement_id = e->statement_id;
+            d.errors = e->errors.load(std::memory_order_relaxed);
+            d.latency = e->latency.snapshot();
+            d.rows = e->rows.snapshot();
+            d.bytes_read = e->bytes_read.snapshot();
+            res.push_back(std::move(d));
+        }
+    }
+    std::sort(res.begin(), res.end(), [](const query_digest& lhs, const query_digest& rhs) {
+        return lhs.latency.sum() > rhs.latency.sum();
+    });
+    return res;
+}
+
+std::string boost::mysql::format_query_digests(const std::vector<query_digest>& digests)
+{
+    std::string res;
+    char buff[256];
+    std::snprintf(
+        buff,
+        sizeof(buff),
+        "%10s %8s %12s %12s %12s %12s %12s %14s  %s\n",
+        "count",
+        "errors",
+        "p50_us",
+        "p95_us",
+        "p99_us",
+        "max_us",
+        "rows",
+        "bytes_read",
+        "query"
+    );
+    res += buff;
+
+    for (const auto& d : digests)
+    {
+        std::snprintf(
+            buff,
+            sizeof(buff),
+            "%10llu %8llu %12.1f %12.1f %12.1f %12.1f %12llu %14llu  %s",
+            static_cast<unsigned long long>(d.latency.count()),
+            static_cast<unsigned long long>(d.errors),
+            d.latency.value_at_quantile(0.5) / 1000.0,
+            d.latency.value_at_quantile(0.95) / 1000.0,
+            d.latency.value_at_quantile(0.99) / 1000.0,
+            d.latency.max() / 1000.0,
+            static_cast<unsigned long long>(d.rows.sum()),
+            static_cast<unsigned long long>(d.bytes_read.sum()),
+            detail::digest_type_prefix(d.type)
+        );
+        res += buff;
+        if (d.normalized_query.empty())
+        {
+            res += "<statement ";
+            res += std::to_string(d.statement_id);
+            res += '>';
+        }
+        else
+        {
+            res += d.normalized_query;
+        }
+        res += '\n';
+    }
+    return res;
+}
+
+#endif
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_REPLAY_STREAM_IPP
+#define BOOST_MYSQL_IMPL_REPLAY_STREAM_IPP
+
+#pragma once
+
+#include <boost/mysql/replay_stream.hpp>
+
+#include <boost/asio/compose.hpp>
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+struct boost::mysql::replay_stream::read_op : asio::coroutine
+{
+    replay_stream& stream_;
+    asio::mutable_buffer buff_;
+
+    read_op(replay_stream& stream, asio::mutable_buffer buff) noexcept : stream_(stream), buff_(buff) {}
+
+    template <class Self>
+    void operator()(Self& self, error_code err = {})
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            // Wait until the data is due, if required. Otherwise, don't complete inline
+            if (stream_.next_read_deadline() > std::chrono::steady_clock::now())
+            {
+                stream_.timer_.expires_at(stream_.next_read_deadline());
+                BOOST_ASIO_CORO_YIELD stream_.timer_.async_wait(std::move(self));
+                if (err)
+                {
+                    self.complete(err, 0);
+                    return;
+                }
+            }
+            else
+            {
+                BOOST_ASIO_CORO_YIELD asio::post(stream_.get_executor(), std::move(self));
+            }
+
+            {
+                std::size_t bytes_read = stream_.do_read(buff_, err);
+                self.complete(err, bytes_read);
+            }
+        }
+    }
+};
+
+struct boost::mysql::replay_stream::write_op : asio::coroutine
+{
+    replay_stream& stream_;
+    asio::const_buffer buff_;
+
+    write_op(replay_stream& stream, asio::const_buffer buff) noexcept : stream_(stream), buff_(buff) {}
+
+    template <class Self>
+    void operator()(Self& self)
+    {
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            BOOST_ASIO_CORO_YIELD asio::post(stream_.get_executor(), std::move(self));
+            stream_.start();
+            self.complete(error_code(), buff_.size());
+        }
+    }
+};
+
+boost::mysql::replay_stream::replay_stream(
+    executor_type ex,
+    std::vector<wire_capture_record> records,
+    bool use_original_timing
+)
+    : records_(std::move(records)), use_original_timing_(use_original_timing), timer_(std::move(ex))
+{
+}
+
+bool boost::mysql::replay_stream::done() const noexcept
+{
+    for (std::size_t i = current_record_; i < records_.size(); ++i)
+    {
+        if (records_[i].direction == trace_direction::read && current_offset_ < records_[i].data.size())
+            return false;
+    }
+    return true;
+}
+
+void boost::mysql::replay_stream::rewind() noexcept
+{
+    current_record_ = 0;
+    current_offset_ = 0;
+    started_ = false;
+}
+
+void boost::mysql::replay_stream::start() noexcept
+{
+    if (!started_)
+    {
+        started_ = true;
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+std::chrono::steady_clock::time_point boost::mysql::replay_stream::next_read_deadline() noexcept
+{
+    start();
+
+    // Skip writes and records that have already been served
+    while (current_record_ < records_.size() &&
+           (records_[current_record_].direction != trace_direction::read ||
+            current_offset_ == records_[current_record_].data.size()))
+    {
+        ++current_record_;
+        current_offset_ = 0;
+    }
+
+    // Only the first read of each record waits
+    if (!use_original_timing_ || current_record_ == records_.size() || current_offset_ != 0)
+        return std::chrono::steady_clock::time_point();
+    auto offset = records_[current_record_].timestamp - records_.front().timestamp;
+    return start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset);
+}
+
+std::size_t boost::mysql::replay_stream::do_read(asio::mutable_buffer buff, error_code& ec) noexcept
+{
+    // Zero-sized reads always succeed, as in Asio streams
+    if (buff.size() == 0)
+    {
+        ec = error_code();
+        return 0;
+    }
+
+    next_read_deadline();
+    if (current_record_ == records_.size())
+    {
+        ec = asio::error::eof;
+        return 0;
+    }
+
+    const auto& data = records_[current_record_].data;
+    std::size_t size = (std::min)(buff.size(), data.size() - current_offset_);
+    std::memcpy(buff.data(), data.data() + current_offset_, size);
+    current_offset_ += size;
+    ec = error_code();
+    return size;
+}
+
+std::size_t boost::mysql::replay_stream::read_some(asio::mutable_buffer buff, error_code& ec)
+{
+    if (buff.size() != 0)
+        std::this_thread::sleep_until(next_read_deadline());
+    return do_read(buff, ec);
+}
+
+std::size_t boost::mysql::replay_stream::read_some(asio::mutable_buffer buff)
+{
+    error_code ec;
+    std::size_t res = read_some(buff, ec);
+    if (ec)
+        BOOST_THROW_EXCEPTION(system::system_error(ec));
+    return res;
+}
+
+void boost::mysql::replay_stream::do_async_read_some(
+    asio::mutable_buffer buff,
+    asio::any_completion_handler<void(error_code, std::size_t)> handler
+)
+{
+    asio::async_compose<
+        asio::any_completion_handler<void(error_code, std::size_t)>,
+        void(error_code, std::size_t)>(read_op(*this, buff), handler, get_executor());
+}
+
+std::size_t boost::mysql::replay_stream::write_some(asio::const_buffer buff, error_code& ec)
+{
+    start();
+    ec = error_code();
+    return buff.size();
+}
+
+std::size_t boost::mysql::replay_stream::write_some(asio::const_buffer buff)
+{
+    start();
+    return buff.size();
+}
+
+void boost::mysql::replay_stream::do_async_write_some(
+    asio::const_buffer buff,
+    asio::any_completion_handler<void(error_code, std::size_t)> handler
+)
+{
+    asio::async_compose<
+        asio::any_completion_handler<void(error_code, std::size_t)>,
+        void(error_code, std::size_t)>(write_op(*this, buff), handler, get_executor());
+}
+
+#endif
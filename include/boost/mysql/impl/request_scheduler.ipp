@@ -0,0 +1,201 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_REQUEST_SCHEDULER_IPP
+#define BOOST_MYSQL_IMPL_REQUEST_SCHEDULER_IPP
+
+#pragma once
+
+#include <boost/mysql/request_scheduler.hpp>
+
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+#include <memory>
+
+boost::mysql::detail::request_scheduler_impl::~request_scheduler_impl()
+{
+    // Requests that were never run
+    for (auto& grp : groups_)
+    {
+        auto* req = grp->inbox.load(std::memory_order_acquire);
+        while (req)
+        {
+            auto* next = req->next;
+            delete req;
+            req = next;
+        }
+        while (auto* pending = grp->pending.steal())
+            delete pending;
+        for (auto* overflowed : grp->overflow)
+            delete overflowed;
+    }
+}
+
+std::size_t boost::mysql::detail::request_scheduler_impl::add_group(asio::any_io_executor ex)
+{
+    groups_.push_back(std::unique_ptr<group>(new group(std::move(ex), queue_capacity_)));
+    return groups_.size() - 1u;
+}
+
+std::size_t boost::mysql::detail::request_scheduler_impl::add_slot(std::size_t group_idx)
+{
+    BOOST_ASSERT(group_idx < groups_.size());
+    auto& grp = *groups_[group_idx];
+    grp.idle_slots.push_back(grp.num_slots);
+    grp.num_idle.fetch_add(1);
+    return grp.num_slots++;
+}
+
+void boost::mysql::detail::request_scheduler_impl::submit(scheduled_request* req, std::size_t group_idx)
+{
+    BOOST_ASSERT(group_idx < groups_.size());
+    auto& grp = *groups_[group_idx];
+
+    // Push to the submission queue
+    auto* head = grp.inbox.load(std::memory_order_relaxed);
+    do
+    {
+        req->next = head;
+    } while (!grp.inbox.compare_exchange_weak(head, req, std::memory_order_acq_rel, std::memory_order_relaxed)
+    );
+
+    notify(group_idx);
+}
+
+void boost::mysql::detail::request_scheduler_impl::release(std::size_t group_idx, std::size_t slot)
+{
+    auto& grp = *groups_[group_idx];
+    grp.idle_slots.push_back(slot);
+    grp.num_idle.fetch_add(1);
+
+    // If a request released its connection synchronously, the loop in dispatch() picks it up
+    if (!grp.dispatching)
+        dispatch(group_idx);
+}
+
+void boost::mysql::detail::request_scheduler_impl::notify(std::size_t group_idx)
+{
+    auto& grp = *groups_[group_idx];
+    if (!grp.drain_pending.exchange(true, std::memory_order_acq_rel))
+        asio::post(grp.ex, [this, group_idx] { drain(group_idx); });
+}
+
+void boost::mysql::detail::request_scheduler_impl::drain(std::size_t group_idx)
+{
+    auto& grp = *groups_[group_idx];
+
+    // Submissions after this point trigger another drain
+    grp.drain_pending.store(false, std::memory_order_release);
+    auto* req = grp.inbox.exchange(nullptr, std::memory_order_acq_rel);
+
+    // The submission queue is LIFO. Reverse it to preserve submission order
+    scheduled_request* reversed = nullptr;
+    while (req)
+    {
+        auto* next = req->next;
+        req->next = reversed;
+        reversed = req;
+        req = next;
+    }
+    for (req = reversed; req; req = req->next)
+        grp.overflow.push_back(req);
+
+    dispatch(group_idx);
+}
+
+boost::mysql::detail::scheduled_request* boost::mysql::detail::request_scheduler_impl::take_request(
+    std::size_t group_idx
+)
+{
+    auto& grp = *groups_[group_idx];
+    refill(grp);
+
+    // Our own requests. steal() may fail spuriously if another group is stealing
+    while (grp.pending.size())
+    {
+        if (auto* res = grp.pending.steal())
+            return res;
+    }
+
+    // Other groups' requests
+    for (std::size_t i = 1; i < groups_.size(); ++i)
+    {
+        auto& other = *groups_[(group_idx + i) % groups_.size()];
+        while (other.pending.size())
+        {
+            if (auto* res = other.pending.steal())
+            {
+                num_stolen_.fetch_add(1, std::memory_order_relaxed);
+                return res;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void boost::mysql::detail::request_scheduler_impl::dispatch(std::size_t group_idx)
+{
+    auto& grp = *groups_[group_idx];
+
+    struct dispatch_guard
+    {
+        bool& value;
+        dispatch_guard(bool& v) noexcept : value(v) { value = true; }
+        ~dispatch_guard() { value = false; }
+    } guard{grp.dispatching};
+
+    // Make submitted requests visible to other groups, even if we can't run any of them now
+    refill(grp);
+
+    while (!grp.idle_slots.empty())
+    {
+        std::unique_ptr<scheduled_request> req(take_request(group_idx));
+        if (!req)
+            break;
+        std::size_t slot = grp.idle_slots.back();
+        grp.idle_slots.pop_back();
+        grp.num_idle.fetch_sub(1);
+        try
+        {
+            req->run(group_idx, slot);
+        }
+        catch (...)
+        {
+            // Don't lose the connection. While dispatching, release() just adds the slot
+            // to idle_slots, so it's there if the request released it before throwing
+            if (std::find(grp.idle_slots.begin(), grp.idle_slots.end(), slot) == grp.idle_slots.end())
+            {
+                grp.idle_slots.push_back(slot);
+                grp.num_idle.fetch_add(1);
+            }
+
+            // Resume running requests the next time the executor runs
+            notify(group_idx);
+            throw;
+        }
+    }
+
+    // Let groups with idle connections steal what we can't run
+    if (grp.idle_slots.empty() && grp.pending.size())
+        wake_idle_groups(group_idx);
+}
+
+void boost::mysql::detail::request_scheduler_impl::wake_idle_groups(std::size_t group_idx)
+{
+    // Pairs with the fence in steal(), so either we see a group becoming idle,
+    // or that group sees our requests when it tries to steal them
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (std::size_t i = 1; i < groups_.size(); ++i)
+    {
+        std::size_t other_idx = (group_idx + i) % groups_.size();
+        if (groups_[other_idx]->num_idle.load() > 0u)
+            notify(other_idx);
+    }
+}
+
+#endif
@@ -10,10 +10,13 @@
 
 #pragma once
 
+#include <boost/mysql/detail/access.hpp>
 #include <boost/mysql/detail/execution_processor/results_impl.hpp>
 
 #include <boost/mysql/impl/internal/protocol/protocol.hpp>
 
+#include <algorithm>
+
 boost::mysql::detail::per_resultset_data& boost::mysql::detail::resultset_container::emplace_back()
 {
     if (!first_has_data_)
@@ -50,6 +53,8 @@ void boost::mysql::detail::results_impl::reset_impl() noexcept
     info_.clear();
     rows_.clear();
     num_fields_at_batch_start_ = no_batch;
+    has_filtered_first_row_ = false;
+    has_rows_ = false;
 }
 
 void boost::mysql::detail::results_impl::on_num_meta_impl(std::size_t num_columns)
@@ -89,11 +94,46 @@ boost::mysql::error_code boost::mysql::detail::results_impl::
     if (err)
         return err;
 
+    // discard the row if it doesn't match the filter. Strings still point into the read buffer,
+    // so nothing has been copied yet. Filters only apply to the first resultset. A binary resultset
+    // may contain OUT params, which are never filtered, but this is only known once it finishes.
+    // They are sent as a single row, so a discarded first row is kept aside until then
+    if (per_result_.size() == 1u && !filter_.empty() &&
+        !filter_.matches(access::construct<row_view>(storage.data(), storage.size())))
+    {
+        if (encoding() == resultset_encoding::binary && !has_rows_)
+        {
+            filtered_first_row_.assign(storage.data(), storage.size());
+            has_filtered_first_row_ = true;
+        }
+        else
+        {
+            // A resultset with more than one row can't contain OUT params
+            has_filtered_first_row_ = false;
+        }
+        rows_.remove_last_fields(num_fields);
+        --current_resultset().num_rows;
+    }
+    has_rows_ = true;
+
     return error_code();
 }
 
 boost::mysql::error_code boost::mysql::detail::results_impl::on_row_ok_packet_impl(const ok_view& pack)
 {
+    // Restore OUT params discarded by the filter. Strings are copied when the batch finishes
+    if (has_filtered_first_row_ && pack.is_out_params())
+    {
+        const auto& fields = filtered_first_row_.fields();
+        std::size_t first = rows_.fields().size();
+        auto storage = rows_.add_fields(fields.size());
+        std::copy(fields.begin(), fields.end(), storage.begin());
+        if (!has_active_batch())
+            rows_.copy_strings_as_offsets(first, fields.size());
+        ++current_resultset().num_rows;
+    }
+    has_filtered_first_row_ = false;
+
     on_ok_packet_impl(pack);
     return error_code();
 }
@@ -125,6 +165,7 @@ boost::mysql::detail::per_resultset_data& boost::mysql::detail::results_impl::ad
     resultset_data.meta_offset = meta_.size();
     resultset_data.field_offset = rows_.fields().size();
     resultset_data.info_offset = info_.size();
+    has_rows_ = false;
     return resultset_data;
 }
 
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_RESULTSET_DIFF_IPP
+#define BOOST_MYSQL_IMPL_RESULTSET_DIFF_IPP
+
+#pragma once
+
+#include <boost/mysql/resultset_diff.hpp>
+
+#include <boost/mysql/detail/access.hpp>
+#include <boost/mysql/detail/hash.hpp>
+
+#include <boost/mysql/impl/internal/sort_key.hpp>
+
+void boost::mysql::resultset_diff::init(metadata_collection_view meta)
+{
+    BOOST_ASSERT(!key_columns_.empty());
+    encodings_ = detail::get_sort_key_encodings(meta, key_columns_);
+    key_fields_.reserve(key_columns_.size());
+}
+
+void boost::mysql::resultset_diff::load_current(side_state& s)
+{
+    row_view r = s.current();
+    s.key.clear();
+    detail::sort_key_writer(s.key).put_row_key(r, key_columns_, encodings_.data());
+    s.hash = hash_value(r);
+    s.checksum = detail::hash_combine(s.checksum, s.hash);
+    ++s.num_rows;
+}
+
+void boost::mysql::resultset_diff::mark_different(row_view r, std::size_t left_rows, std::size_t right_rows)
+{
+    key_fields_.clear();
+    for (const auto& col : key_columns_)
+        key_fields_.push_back(r[col.index]);
+    auto key = detail::access::construct<row_view>(key_fields_.data(), key_fields_.size());
+
+    if (!range_open_)
+    {
+        ranges_.push_back(diff_range{row(key), row(key), 0u, 0u});
+        range_open_ = true;
+    }
+    else
+    {
+        ranges_.back().last_key = key;
+    }
+    ranges_.back().left_rows += left_rows;
+    ranges_.back().right_rows += right_rows;
+}
+
+// A merge join by key. Keys present in a single side and keys with different rows
+// are accumulated into the current range, and keys with equal rows close it
+void boost::mysql::resultset_diff::process()
+{
+    auto& left = side(diff_side::left);
+    auto& right = side(diff_side::right);
+
+    auto advance = [this](side_state& s) {
+        ++s.pos;
+        if (s.has_current())
+            load_current(s);
+    };
+
+    while (!done_)
+    {
+        bool left_has = left.has_current(), right_has = right.has_current();
+        if ((!left_has && !left.finished) || (!right_has && !right.finished))
+            return;  // more rows required
+        if (!left_has && !right_has)
+        {
+            done_ = true;
+            range_open_ = false;
+            return;
+        }
+
+        int cmp = !left_has ? 1 : (!right_has ? -1 : detail::compare_keys(left.key, right.key));
+        if (cmp < 0)
+        {
+            mark_different(left.current(), 1u, 0u);
+            advance(left);
+        }
+        else if (cmp > 0)
+        {
+            mark_different(right.current(), 0u, 1u);
+            advance(right);
+        }
+        else
+        {
+            if (left.hash != right.hash)
+                mark_different(left.current(), 1u, 1u);
+            else
+                range_open_ = false;
+            advance(left);
+            advance(right);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_ROW_FILTER_IPP
+#define BOOST_MYSQL_IMPL_ROW_FILTER_IPP
+
+#pragma once
+
+#include <boost/mysql/field_kind.hpp>
+#include <boost/mysql/row_filter.hpp>
+
+#include <boost/mysql/impl/internal/sort_key_values.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Result of comparing two fields. Values that can't be compared don't satisfy any condition
+enum class filter_ordering
+{
+    less,
+    equal,
+    greater,
+    unordered,
+};
+
+template <class T>
+filter_ordering filter_compare_values(const T& lhs, const T& rhs) noexcept
+{
+    if (lhs < rhs)
+        return filter_ordering::less;
+    return rhs < lhs ? filter_ordering::greater : filter_ordering::equal;
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+filter_ordering filter_compare_bytes(
+    const void* lhs,
+    std::size_t lhs_size,
+    const void* rhs,
+    std::size_t rhs_size
+) noexcept
+{
+    int cmp = compare_key_bytes(
+        static_cast<const unsigned char*>(lhs),
+        lhs_size,
+        static_cast<const unsigned char*>(rhs),
+        rhs_size
+    );
+    return cmp < 0 ? filter_ordering::less : (cmp > 0 ? filter_ordering::greater : filter_ordering::equal);
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+bool filter_is_integer(field_kind k) noexcept { return k == field_kind::int64 || k == field_kind::uint64; }
+
+BOOST_MYSQL_STATIC_OR_INLINE
+bool filter_is_number(field_kind k) noexcept
+{
+    return filter_is_integer(k) || k == field_kind::float_ || k == field_kind::double_;
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+double filter_to_double(field_view f) noexcept
+{
+    switch (f.kind())
+    {
+    case field_kind::int64: return static_cast<double>(f.get_int64());
+    case field_kind::uint64: return static_cast<double>(f.get_uint64());
+    case field_kind::float_: return f.get_float();
+    default: return f.get_double();
+    }
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+filter_ordering filter_compare_integers(field_view lhs, field_view rhs) noexcept
+{
+    // Negative int64 values are smaller than any uint64
+    bool lhs_negative = lhs.kind() == field_kind::int64 && lhs.get_int64() < 0;
+    bool rhs_negative = rhs.kind() == field_kind::int64 && rhs.get_int64() < 0;
+    if (lhs_negative || rhs_negative)
+    {
+        if (lhs_negative && rhs_negative)
+            return filter_compare_values(lhs.get_int64(), rhs.get_int64());
+        return lhs_negative ? filter_ordering::less : filter_ordering::greater;
+    }
+    auto to_unsigned = [](field_view f) {
+        return f.kind() == field_kind::int64 ? static_cast<std::uint64_t>(f.get_int64()) : f.get_uint64();
+    };
+    return filter_compare_values(to_unsigned(lhs), to_unsigned(rhs));
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+filter_ordering filter_compare(field_view lhs, field_view rhs) noexcept
+{
+    field_kind lhs_kind = lhs.kind(), rhs_kind = rhs.kind();
+
+    // Numbers of different kinds can be compared
+    if (filter_is_number(lhs_kind) && filter_is_number(rhs_kind))
+    {
+        if (filter_is_integer(lhs_kind) && filter_is_integer(rhs_kind))
+            return filter_compare_integers(lhs, rhs);
+        double lhs_dbl = filter_to_double(lhs), rhs_dbl = filter_to_double(rhs);
+        if (lhs_dbl != lhs_dbl || rhs_dbl != rhs_dbl)  // NaN
+            return filter_ordering::unordered;
+        return filter_compare_values(lhs_dbl, rhs_dbl);
+    }
+
+    // Anything else needs the same kind, and is ordered like sort keys (see sort_rows)
+    if (lhs_kind != rhs_kind)
+        return filter_ordering::unordered;
+    switch (lhs_kind)
+    {
+    case field_kind::string:
+    {
+        auto lhs_str = lhs.get_string(), rhs_str = rhs.get_string();
+        return filter_compare_bytes(lhs_str.data(), lhs_str.size(), rhs_str.data(), rhs_str.size());
+    }
+    case field_kind::blob:
+    {
+        auto lhs_blob = lhs.get_blob(), rhs_blob = rhs.get_blob();
+        return filter_compare_bytes(lhs_blob.data(), lhs_blob.size(), rhs_blob.data(), rhs_blob.size());
+    }
+    case field_kind::date: return filter_compare_values(date_key(lhs.get_date()), date_key(rhs.get_date()));
+    case field_kind::datetime:
+        return filter_compare_values(datetime_key(lhs.get_datetime()), datetime_key(rhs.get_datetime()));
+    case field_kind::time: return filter_compare_values(time_key(lhs.get_time()), time_key(rhs.get_time()));
+    default: return filter_ordering::unordered;  // NULL
+    }
+}
+
+BOOST_MYSQL_STATIC_OR_INLINE
+bool filter_condition_matches(const filter_condition& cond, field_view f) noexcept
+{
+    switch (cond.op)
+    {
+    case filter_op::is_null: return f.is_null();
+    case filter_op::is_not_null: return !f.is_null();
+    default: break;
+    }
+
+    auto ord = filter_compare(f, cond.value);
+    switch (cond.op)
+    {
+    case filter_op::eq: return ord == filter_ordering::equal;
+    case filter_op::ne: return ord == filter_ordering::less || ord == filter_ordering::greater;
+    case filter_op::lt: return ord == filter_ordering::less;
+    case filter_op::le: return ord == filter_ordering::less || ord == filter_ordering::equal;
+    case filter_op::gt: return ord == filter_ordering::greater;
+    case filter_op::ge: return ord == filter_ordering::greater || ord == filter_ordering::equal;
+    default: return false;
+    }
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+bool boost::mysql::row_filter::matches(row_view r) const noexcept
+{
+    for (const auto& cond : conditions_)
+    {
+        if (cond.column >= r.size() || !detail::filter_condition_matches(cond, r[cond.column]))
+            return false;
+    }
+    return true;
+}
+
+#endif
@@ -136,11 +136,13 @@ boost::mysql::detail::row_impl::row_impl(const field_view* fields, std::size_t s
     : fields_(fields, fields + size)
 {
     copy_strings(fields_, string_buffer_);
+    update_accounted_memory();
 }
 
 boost::mysql::detail::row_impl::row_impl(const row_impl& rhs) : fields_(rhs.fields_)
 {
     copy_strings(fields_, string_buffer_);
+    update_accounted_memory();
 }
 
 boost::mysql::detail::row_impl& boost::mysql::detail::row_impl::operator=(const row_impl& rhs)
@@ -162,6 +164,7 @@ void boost::mysql::detail::row_impl::assign(const field_view* fields, std::size_
         fields_.assign(fields, fields + size);
         string_buffer_.clear();
         copy_strings(fields_, string_buffer_);
+        update_accounted_memory();
     }
 }
 
@@ -195,6 +198,7 @@ void boost::mysql::detail::row_impl::copy_strings_as_offsets(std::size_t first,
         }
     }
     BOOST_ASSERT(offset == string_buffer_.size());
+    update_accounted_memory();
 }
 
 void boost::mysql::detail::row_impl::offsets_to_string_views()
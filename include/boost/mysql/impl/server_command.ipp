@@ -0,0 +1,28 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_SERVER_COMMAND_IPP
+#define BOOST_MYSQL_IMPL_SERVER_COMMAND_IPP
+
+#pragma once
+
+#include <boost/mysql/server_command.hpp>
+
+#include <boost/mysql/impl/internal/protocol/server_protocol.hpp>
+
+#include <boost/assert.hpp>
+
+boost::mysql::error_code boost::mysql::parse_statement_params(
+    const server_command& cmd,
+    span<field_view> output
+) noexcept
+{
+    BOOST_ASSERT(cmd.type == server_command_type::stmt_execute);
+    return detail::deserialize_statement_params(cmd.payload, output);
+}
+
+#endif
@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_SERVER_NETWORK_ALGORITHMS_IPP
+#define BOOST_MYSQL_IMPL_SERVER_NETWORK_ALGORITHMS_IPP
+
+#pragma once
+
+#include <boost/mysql/detail/server_network_algorithms.hpp>
+
+#include <boost/mysql/impl/internal/server/server_algorithms.hpp>
+
+void boost::mysql::detail::server_handshake_erased(
+    server_session& sess,
+    const server_handshake_params& params,
+    error_code& err
+)
+{
+    server_handshake_impl(sess, params, err);
+}
+
+void boost::mysql::detail::async_server_handshake_erased(
+    server_session& sess,
+    const server_handshake_params& params,
+    any_void_handler handler
+)
+{
+    async_server_handshake_impl(sess, params, std::move(handler));
+}
+
+boost::mysql::server_command boost::mysql::detail::server_read_command_erased(
+    server_session& sess,
+    error_code& err
+)
+{
+    return server_read_command_impl(sess, err);
+}
+
+void boost::mysql::detail::async_server_read_command_erased(
+    server_session& sess,
+    any_handler<server_command> handler
+)
+{
+    async_server_read_command_impl(sess, std::move(handler));
+}
+
+void boost::mysql::detail::server_flush_erased(server_session& sess, error_code& err)
+{
+    server_flush_impl(sess, err);
+}
+
+void boost::mysql::detail::async_server_flush_erased(server_session& sess, any_void_handler handler)
+{
+    async_server_flush_impl(sess, std::move(handler));
+}
+
+#endif
@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_SERVER_SESSION_PTR_IPP
+#define BOOST_MYSQL_IMPL_SERVER_SESSION_PTR_IPP
+
+#pragma once
+
+#include <boost/mysql/detail/server_session_ptr.hpp>
+
+#include <boost/mysql/impl/internal/server/server_session.hpp>
+
+boost::mysql::detail::server_session_ptr::server_session_ptr(
+    std::size_t read_buff_size,
+    std::unique_ptr<any_stream> stream
+)
+    : sess_(new server_session(read_buff_size, std::move(stream)))
+{
+}
+
+boost::mysql::detail::server_session_ptr::server_session_ptr(server_session_ptr&& rhs) noexcept
+    : sess_(std::move(rhs.sess_))
+{
+}
+
+boost::mysql::detail::server_session_ptr& boost::mysql::detail::server_session_ptr::operator=(
+    server_session_ptr&& rhs
+) noexcept
+{
+    sess_ = std::move(rhs.sess_);
+    return *this;
+}
+
+boost::mysql::detail::server_session_ptr::~server_session_ptr() {}
+
+boost::mysql::detail::any_stream& boost::mysql::detail::server_session_ptr::get_stream() const
+{
+    return sess_->stream();
+}
+
+const boost::mysql::server_login& boost::mysql::detail::server_session_ptr::login() const noexcept
+{
+    return sess_->login();
+}
+
+bool boost::mysql::detail::server_session_ptr::check_password(string_view password) const
+{
+    return sess_->check_password(password);
+}
+
+void boost::mysql::detail::server_session_ptr::add_ok(const server_ok& ok) { sess_->add_ok(ok); }
+
+void boost::mysql::detail::server_session_ptr::add_error(std::uint16_t code, string_view message)
+{
+    sess_->add_error(code, message);
+}
+
+void boost::mysql::detail::server_session_ptr::add_prepare_ok(
+    std::uint32_t statement_id,
+    span<const server_column> params,
+    span<const server_column> columns
+)
+{
+    sess_->add_prepare_ok(statement_id, params, columns);
+}
+
+void boost::mysql::detail::server_session_ptr::add_resultset_head(span<const server_column> columns)
+{
+    sess_->add_resultset_head(columns);
+}
+
+void boost::mysql::detail::server_session_ptr::add_row(span<const field_view> fields) { sess_->add_row(fields); }
+
+void boost::mysql::detail::server_session_ptr::add_rows(rows_view rows) { sess_->add_rows(rows); }
+
+void boost::mysql::detail::server_session_ptr::add_resultset_end(const server_ok& ok)
+{
+    sess_->add_resultset_end(ok);
+}
+
+std::size_t boost::mysql::detail::server_session_ptr::pending_bytes() const noexcept
+{
+    return sess_->pending().size();
+}
+
+#endif
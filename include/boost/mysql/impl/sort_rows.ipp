@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_SORT_ROWS_IPP
+#define BOOST_MYSQL_IMPL_SORT_ROWS_IPP
+
+#pragma once
+
+#include <boost/mysql/sort_rows.hpp>
+
+#include <boost/mysql/detail/access.hpp>
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/mysql/impl/internal/sort_key.hpp>
+#include <boost/mysql/impl/internal/sort_key_values.hpp>
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Sorts row positions by their keys. Keys are stored contiguously, and offsets[i]
+// is where the key for row i begins
+class radix_sorter
+{
+    // Groups smaller than this are sorted by comparison
+    static constexpr std::size_t small_group_size = 32;
+
+    struct group
+    {
+        std::size_t first;
+        std::size_t last;
+        std::size_t depth;
+    };
+
+    const std::vector<unsigned char>& keys_;
+    const std::vector<std::size_t>& offsets_;
+
+    std::size_t key_size(std::size_t row) const noexcept { return offsets_[row + 1] - offsets_[row]; }
+
+    // 0 means the key has ended, so shorter keys go first
+    unsigned bucket(std::size_t row, std::size_t depth) const noexcept
+    {
+        return depth < key_size(row) ? keys_[offsets_[row] + depth] + 1u : 0u;
+    }
+
+    // Ties are broken by position, which keeps the sort stable
+    bool less(std::size_t lhs, std::size_t rhs, std::size_t depth) const noexcept
+    {
+        int cmp = compare_key_bytes(
+            keys_.data() + offsets_[lhs] + depth,
+            key_size(lhs) - depth,
+            keys_.data() + offsets_[rhs] + depth,
+            key_size(rhs) - depth
+        );
+        return cmp != 0 ? cmp < 0 : lhs < rhs;
+    }
+
+public:
+    radix_sorter(const std::vector<unsigned char>& keys, const std::vector<std::size_t>& offsets) noexcept
+        : keys_(keys), offsets_(offsets)
+    {
+    }
+
+    // An explicit stack is used instead of recursion, since its depth is bound by key length
+    void sort(std::vector<std::size_t>& perm) const
+    {
+        std::vector<std::size_t> tmp(perm.size());
+        std::vector<group> pending{
+            {0, perm.size(), 0}
+        };
+        std::array<std::size_t, 257> counts;
+
+        while (!pending.empty())
+        {
+            group g = pending.back();
+            pending.pop_back();
+
+            if (g.last - g.first < small_group_size)
+            {
+                std::sort(
+                    perm.begin() + g.first,
+                    perm.begin() + g.last,
+                    [this, g](std::size_t lhs, std::size_t rhs) { return less(lhs, rhs, g.depth); }
+                );
+                continue;
+            }
+
+            counts.fill(0);
+            for (std::size_t i = g.first; i < g.last; ++i)
+                ++counts[bucket(perm[i], g.depth)];
+
+            // Everything in the same bucket: no need to move anything
+            auto it = std::find(counts.begin(), counts.end(), g.last - g.first);
+            if (it != counts.end())
+            {
+                if (it != counts.begin())
+                    pending.push_back({g.first, g.last, g.depth + 1});
+                continue;
+            }
+
+            // Stable counting sort by the current byte
+            std::array<std::size_t, 257> starts;
+            std::size_t pos = g.first;
+            for (std::size_t b = 0; b < counts.size(); ++b)
+            {
+                starts[b] = pos;
+                pos += counts[b];
+            }
+            for (std::size_t i = g.first; i < g.last; ++i)
+                tmp[starts[bucket(perm[i], g.depth)]++] = perm[i];
+            std::copy(tmp.begin() + g.first, tmp.begin() + g.last, perm.begin() + g.first);
+
+            // Keys in bucket 0 have ended, so they're equal and already in order
+            pos = g.first + counts[0];
+            for (std::size_t b = 1; b < counts.size(); ++b)
+            {
+                if (counts[b] > 1u)
+                    pending.push_back({pos, pos + counts[b], g.depth + 1});
+                pos += counts[b];
+            }
+        }
+    }
+};
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+std::vector<std::size_t> boost::mysql::sort_permutation(
+    rows_view input,
+    metadata_collection_view meta,
+    span<const sort_column> columns
+)
+{
+    BOOST_ASSERT(meta.empty() || meta.size() == input.num_columns());
+
+    std::size_t num_rows = input.size();
+    std::vector<std::size_t> res(num_rows);
+    std::iota(res.begin(), res.end(), std::size_t(0));
+    if (num_rows < 2u || columns.empty())
+        return res;
+
+    // Per-column encodings
+    auto encodings = detail::get_sort_key_encodings(meta, columns);
+
+    // Build the keys
+    std::vector<unsigned char> keys;
+    std::vector<std::size_t> offsets;
+    keys.reserve(num_rows * columns.size() * 10u);
+    offsets.reserve(num_rows + 1u);
+    detail::sort_key_writer writer(keys);
+    for (std::size_t i = 0; i < num_rows; ++i)
+    {
+        offsets.push_back(writer.size());
+        writer.put_row_key(input[i], columns, encodings.data());
+    }
+    offsets.push_back(writer.size());
+
+    detail::radix_sorter(keys, offsets).sort(res);
+    return res;
+}
+
+boost::mysql::rows boost::mysql::sort_rows(
+    rows_view input,
+    metadata_collection_view meta,
+    span<const sort_column> columns
+)
+{
+    auto perm = sort_permutation(input, meta, columns);
+
+    std::vector<field_view> fields;
+    fields.reserve(input.size() * input.num_columns());
+    for (std::size_t idx : perm)
+    {
+        row_view r = input[idx];
+        fields.insert(fields.end(), r.begin(), r.end());
+    }
+    return rows(detail::access::construct<rows_view>(fields.data(), fields.size(), input.num_columns()));
+}
+
+#endif
@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_IMPL_WIRE_CAPTURE_IPP
+#define BOOST_MYSQL_IMPL_WIRE_CAPTURE_IPP
+
+#pragma once
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/throw_on_error.hpp>
+#include <boost/mysql/wire_capture.hpp>
+
+#include <boost/mysql/impl/internal/channel/capture_stream.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+
+namespace boost {
+namespace mysql {
+namespace detail {
+
+// Reads exactly size bytes. Returns false if the input ended before that
+inline bool read_capture_bytes(std::istream& input, void* to, std::size_t size)
+{
+    input.read(static_cast<char*>(to), static_cast<std::streamsize>(size));
+    return static_cast<std::size_t>(input.gcount()) == size;
+}
+
+// Reads size bytes into to, which is grown in bounded chunks as data arrives.
+// The record size comes from the input, so memory is never allocated for bytes that
+// aren't there. Returns false if the input ended before size bytes were read
+inline bool read_capture_record_data(std::istream& input, std::vector<std::uint8_t>& to, std::size_t size)
+{
+    constexpr std::size_t chunk_size = 64u * 1024u;
+    to.clear();
+    while (to.size() < size)
+    {
+        std::size_t offset = to.size();
+        std::size_t chunk = (std::min)(size - offset, chunk_size);
+        to.resize(offset + chunk);
+        if (!read_capture_bytes(input, to.data() + offset, chunk))
+            return false;
+    }
+    return true;
+}
+
+}  // namespace detail
+}  // namespace mysql
+}  // namespace boost
+
+std::vector<boost::mysql::wire_capture_record> boost::mysql::read_wire_capture(
+    std::istream& input,
+    error_code& ec
+)
+{
+    std::vector<wire_capture_record> res;
+
+    // Header
+    std::uint8_t header[detail::wire_capture_header_size];
+    if (!detail::read_capture_bytes(input, header, sizeof(header)) ||
+        std::memcmp(header, detail::wire_capture_magic, detail::wire_capture_magic_size) != 0 ||
+        endian::load_little_u32(header + detail::wire_capture_magic_size) != detail::wire_capture_version)
+    {
+        ec = client_errc::protocol_value_error;
+        return res;
+    }
+
+    // Records, until the end of the input
+    std::uint8_t record_header[detail::wire_capture_record_header_size];
+    while (input.peek() != std::istream::traits_type::eof())
+    {
+        if (!detail::read_capture_bytes(input, record_header, sizeof(record_header)))
+        {
+            ec = client_errc::incomplete_message;
+            return res;
+        }
+        if (record_header[0] > static_cast<std::uint8_t>(trace_direction::write))
+        {
+            ec = client_errc::protocol_value_error;
+            return res;
+        }
+        wire_capture_record rec{
+            static_cast<trace_direction>(record_header[0]),
+            std::chrono::nanoseconds(static_cast<std::int64_t>(endian::load_little_u64(record_header + 1))),
+            {},
+        };
+        if (!detail::read_capture_record_data(input, rec.data, endian::load_little_u32(record_header + 9)))
+        {
+            ec = client_errc::incomplete_message;
+            return res;
+        }
+        res.push_back(std::move(rec));
+    }
+
+    ec = error_code();
+    return res;
+}
+
+std::vector<boost::mysql::wire_capture_record> boost::mysql::read_wire_capture(std::istream& input)
+{
+    error_code ec;
+    auto res = read_wire_capture(input, ec);
+    throw_on_error(ec);
+    return res;
+}
+
+#endif
@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_MEMORY_USAGE_HPP
+#define BOOST_MYSQL_MEMORY_USAGE_HPP
+
+#include <boost/mysql/detail/memory_accounting.hpp>
+
+#include <cstddef>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Dynamic memory owned by a connection, in bytes.
+ * \details
+ * Returned by \ref connection::memory_usage. Sizes refer to allocated capacity,
+ * rather than the part of it currently in use.
+ */
+struct connection_memory_usage
+{
+    /// The buffer where messages are read into. Grows to fit the largest message received.
+    std::size_t read_buffer{};
+
+    /// The buffer where messages are serialized before being sent.
+    std::size_t write_buffer{};
+
+    /// Storage for the fields returned by \ref connection::read_some_rows.
+    std::size_t shared_fields{};
+
+    /// Storage for the diagnostics used by async operations without a diagnostics argument.
+    std::size_t shared_diagnostics{};
+
+    /// Records held by the protocol trace, if enabled (see \ref connection::enable_protocol_trace).
+    std::size_t protocol_trace{};
+
+    /// Returns the sum of all the above.
+    std::size_t total() const noexcept
+    {
+        return read_buffer + write_buffer + shared_fields + shared_diagnostics + protocol_trace;
+    }
+};
+
+/**
+ * \brief Whether the global memory counter returned by \ref accounted_memory is maintained.
+ * \details
+ * `true` if `BOOST_MYSQL_ENABLE_MEMORY_ACCOUNTING` is defined (CMake option
+ * `BOOST_MYSQL_MEMORY_ACCOUNTING`). Like `BOOST_MYSQL_SEPARATE_COMPILATION`, this macro must
+ * be defined consistently across all translation units.
+ */
+#ifdef BOOST_MYSQL_ENABLE_MEMORY_ACCOUNTING
+constexpr bool memory_accounting_enabled = true;
+#else
+constexpr bool memory_accounting_enabled = false;
+#endif
+
+/**
+ * \brief Returns the number of bytes currently allocated by library-managed buffers, process-wide.
+ * \details
+ * Accounts for connection read and write buffers and for the storage of owning row
+ * containers (\ref row, \ref rows and the rows in \ref results). Metadata, diagnostics
+ * and user-defined types in \ref static_results are not included.
+ * \n
+ * The counter is only maintained if \ref memory_accounting_enabled is `true`. Otherwise,
+ * this function always returns zero. Updating the counter costs an atomic addition
+ * every time one of the above buffers is reallocated or destroyed.
+ *
+ * \par Exception safety
+ * No-throw guarantee.
+ *
+ * \par Thread safety
+ * Can be called concurrently with any other function.
+ */
+inline std::size_t accounted_memory() noexcept
+{
+#ifdef BOOST_MYSQL_ENABLE_MEMORY_ACCOUNTING
+    return detail::accounted_memory_counter().load(std::memory_order_relaxed);
+#else
+    return 0u;
+#endif
+}
+
+}  // namespace mysql
+}  // namespace boost
+
+#endif
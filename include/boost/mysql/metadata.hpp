@@ -14,7 +14,9 @@
 #include <boost/mysql/detail/access.hpp>
 #include <boost/mysql/detail/coldef_view.hpp>
 #include <boost/mysql/detail/flags.hpp>
+#include <boost/mysql/detail/memory_accounting.hpp>
 
+#include <cstddef>
 #include <string>
 
 namespace boost {
@@ -264,6 +266,22 @@ public:
      */
     bool is_set_to_now_on_update() const noexcept { return flag_set(detail::column_flags::on_update_now); }
 
+    /**
+     * \brief Returns the dynamic memory owned by this object, in bytes.
+     * \details
+     * Accounts for the heap storage of the strings held by this object.
+     * Strings short enough to be stored inline don't contribute. Doesn't include `sizeof(*this)`.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    std::size_t memory_usage() const noexcept
+    {
+        return detail::string_memory_usage(schema_) + detail::string_memory_usage(table_) +
+               detail::string_memory_usage(org_table_) + detail::string_memory_usage(name_) +
+               detail::string_memory_usage(org_name_);
+    }
+
 private:
     std::string schema_;
     std::string table_;      // virtual table
@@ -0,0 +1,178 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_METRICS_HPP
+#define BOOST_MYSQL_METRICS_HPP
+
+#include <boost/mysql/connection_stats.hpp>
+#include <boost/mysql/histogram.hpp>
+#include <boost/mysql/operation_observer.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/// Aggregated metrics for all the operations of a certain \ref operation_type.
+struct operation_metrics
+{
+    /// Operation latency, in nanoseconds. Includes failed operations.
+    histogram_snapshot latency;
+
+    /// Number of operations that completed with an error.
+    std::uint64_t errors{};
+};
+
+/**
+ * \brief A point-in-time copy of the metrics collected by a \ref metrics_observer.
+ */
+struct metrics_snapshot
+{
+    /// Metrics for each operation type, indexed by \ref operation_type.
+    std::array<operation_metrics, num_operation_types> operations;
+
+    /// Retrieves the metrics for a given operation type.
+    const operation_metrics& operation(operation_type t) const noexcept
+    {
+        BOOST_ASSERT(static_cast<std::size_t>(t) < num_operation_types);
+        return operations[static_cast<std::size_t>(t)];
+    }
+};
+
+/**
+ * \brief An \ref operation_observer that collects latency histograms per operation type.
+ * \details
+ * Each operation type gets a \ref histogram with the operation latencies and an error counter.
+ * \n
+ * To avoid contention, counters are split in stripes. Each thread records into a stripe
+ * of its own, claimed the first time it records a value and released when the thread exits,
+ * so it can be reused by other threads. Once a thread has claimed its stripe, recording uses
+ * only relaxed atomic loads, stores and increments, and is thus wait-free on platforms with native
+ * 64-bit atomics. Stripes are only aggregated when calling \ref snapshot,
+ * which is intended to be called at scrape time.
+ * \n
+ * A single observer may be shared between connections running in different threads.
+ * Each stripe takes around `num_operation_types * 4KB` of memory. Some stripes are allocated
+ * on construction, and more are allocated if more threads record values concurrently.
+ * \n
+ * Observers are neither copyable nor movable.
+ */
+class metrics_observer final : public operation_observer
+{
+public:
+    /**
+     * \brief Constructor.
+     * \details
+     * Allocates `num_stripes` stripes, which should be around the number of threads that
+     * will be running operations concurrently. A value of zero is treated as one.
+     *
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    BOOST_MYSQL_DECL
+    explicit metrics_observer(std::size_t num_stripes = 8);
+
+    metrics_observer(const metrics_observer&) = delete;
+    metrics_observer& operator=(const metrics_observer&) = delete;
+
+    /// Destructor.
+    BOOST_MYSQL_DECL
+    ~metrics_observer();
+
+    /// Returns the number of stripes, including the ones allocated after construction.
+    BOOST_MYSQL_DECL
+    std::size_t num_stripes() const noexcept;
+
+    /// Does nothing.
+    void on_operation_start(const operation_info&) noexcept override {}
+
+    /// Records the operation's latency and outcome.
+    BOOST_MYSQL_DECL
+    void on_operation_finish(const operation_info& info) noexcept override;
+
+    /**
+     * \brief Aggregates the metrics recorded by all threads.
+     * \details
+     * May be called concurrently with operations being recorded.
+     *
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    BOOST_MYSQL_DECL
+    metrics_snapshot snapshot() const;
+
+    /**
+     * \brief Sets all counters to zero.
+     * \details
+     * Not atomic with respect to concurrent recordings.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    BOOST_MYSQL_DECL
+    void reset() noexcept;
+
+private:
+    struct stripe;
+    struct thread_stripes;
+
+    std::uint64_t id_;
+    mutable std::mutex mtx_;
+    std::vector<std::shared_ptr<stripe>> stripes_;
+
+    BOOST_MYSQL_DECL
+    stripe& claim_stripe();
+};
+
+/**
+ * \brief Renders operation metrics in the OpenMetrics text format.
+ * \details
+ * The output is compatible with Prometheus and terminated by `# EOF`. It should be
+ * served with content type `application/openmetrics-text; version=1.0.0; charset=utf-8`.
+ * \n
+ * Exposes the `boost_mysql_operation_duration_seconds` histogram and the
+ * `boost_mysql_operation_errors` counter, labelled by `operation`.
+ * Histogram buckets are exported at powers of two nanoseconds, from around one microsecond
+ * to around one minute, so that exported counts are exact.
+ *
+ * \par Exception safety
+ * Strong guarantee. Memory allocations may throw.
+ */
+BOOST_MYSQL_DECL
+std::string to_openmetrics(const metrics_snapshot& metrics);
+
+/**
+ * \brief Renders operation metrics and connection counters in the OpenMetrics text format.
+ * \details
+ * Like the single-argument overload, but also exposes the counters in `conn_stats`
+ * as `boost_mysql_connection_*` metrics. To report several connections, aggregate their
+ * statistics using `connection_stats::operator+=`.
+ *
+ * \par Exception safety
+ * Strong guarantee. Memory allocations may throw.
+ */
+BOOST_MYSQL_DECL
+std::string to_openmetrics(const metrics_snapshot& metrics, const connection_stats& conn_stats);
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/metrics.ipp>
+#endif
+
+#endif
@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_OPERATION_OBSERVER_HPP
+#define BOOST_MYSQL_OPERATION_OBSERVER_HPP
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+
+/// The type of a network operation run by a \ref connection.
+enum class operation_type
+{
+    /// \ref connection::connect or \ref connection::async_connect
+    connect,
+
+    /// \ref connection::handshake or \ref connection::async_handshake
+    handshake,
+
+    /// \ref connection::execute or \ref connection::async_execute
+    execute,
+
+    /// \ref connection::start_execution or \ref connection::async_start_execution
+    start_execution,
+
+    /// \ref connection::read_resultset_head or \ref connection::async_read_resultset_head
+    read_resultset_head,
+
+    /// \ref connection::read_some_rows or \ref connection::async_read_some_rows
+    read_some_rows,
+
+    /// \ref connection::prepare_statement or \ref connection::async_prepare_statement
+    prepare_statement,
+
+    /// \ref connection::close_statement or \ref connection::async_close_statement
+    close_statement,
+
+    /// \ref connection::ping or \ref connection::async_ping
+    ping,
+
+    /// \ref connection::close or \ref connection::async_close
+    close,
+
+    /// \ref connection::quit or \ref connection::async_quit
+    quit,
+};
+
+/// The number of members in \ref operation_type.
+constexpr std::size_t num_operation_types = 11;
+
+/**
+ * \brief An internal phase of a network operation.
+ * \details
+ * Not all operations go through all phases. Phases that didn't happen
+ * are reported as empty \ref phase_timing objects.
+ */
+enum class operation_phase
+{
+    /// Establishing the physical connection (e.g. TCP connect). Only for \ref operation_type::connect.
+    tcp_connect = 0,
+
+    /// Performing the TLS handshake, if TLS is used.
+    tls_handshake,
+
+    /// Exchanging authentication messages with the server, after TLS has been negotiated.
+    authentication,
+
+    /// Writing requests to the stream. Spans from the first write to the end of the last one.
+    request_write,
+
+    /// Waiting for the server to respond. Spans until the first byte is received, starting from
+    /// the end of the request write. If nothing was written, it starts when the physical connection
+    /// was established or, failing that, when the operation started.
+    first_byte,
+
+    /// Reading resultset heads, including column metadata.
+    metadata_read,
+
+    /// Reading rows. Spans from the start of the first row batch to the end of the last one,
+    /// including any network waits between batches.
+    rows_read,
+};
+
+/// The number of members in \ref operation_phase.
+constexpr std::size_t num_operation_phases = 7;
+
+/// A time interval covering an \ref operation_phase.
+struct phase_timing
+{
+    /// The time point when the phase started. Default-constructed if the phase didn't happen.
+    std::chrono::steady_clock::time_point begin{};
+
+    /// The time point when the phase ended. Default-constructed if the phase didn't happen or didn't finish.
+    std::chrono::steady_clock::time_point end{};
+
+    /// Returns whether the phase was recorded, i.e. whether both `begin` and `end` are set.
+    bool recorded() const noexcept
+    {
+        return begin != std::chrono::steady_clock::time_point() &&
+               end != std::chrono::steady_clock::time_point();
+    }
+
+    /// Returns `end - begin` if the phase was recorded, zero otherwise.
+    std::chrono::nanoseconds duration() const noexcept
+    {
+        return recorded() ? std::chrono::nanoseconds(end - begin) : std::chrono::nanoseconds(0);
+    }
+};
+
+/**
+ * \brief Information about a network operation, passed to \ref operation_observer.
+ * \details
+ * Objects of this type are owned by the connection. References passed to the observer
+ * are only valid until the callback returns. The same applies to the \ref query view.
+ */
+struct operation_info
+{
+    /// The type of operation.
+    operation_type type{operation_type::execute};
+
+    /// The SQL text being executed or prepared. Empty if the operation doesn't involve SQL text.
+    string_view query;
+
+    /// The ID of the statement being executed or closed. Zero if the operation doesn't involve a statement.
+    std::uint32_t statement_id{};
+
+    /// The time point when the operation was initiated.
+    std::chrono::steady_clock::time_point started{};
+
+    /// The time point when the operation finished. Only set in \ref operation_observer::on_operation_finish.
+    std::chrono::steady_clock::time_point finished{};
+
+    /// The result of the operation. Only set in \ref operation_observer::on_operation_finish.
+    error_code error;
+
+    /// The number of rows decoded by the operation. Only set in \ref operation_observer::on_operation_finish.
+    std::uint64_t rows_read{};
+
+    /// Time spent decoding rows. Only set in \ref operation_observer::on_operation_finish.
+    std::chrono::nanoseconds decode_time{};
+
+    /// Number of bytes read from the stream by the operation.
+    /// Only set in \ref operation_observer::on_operation_finish.
+    std::uint64_t bytes_read{};
+
+    /// Number of bytes written to the stream by the operation.
+    /// Only set in \ref operation_observer::on_operation_finish.
+    std::uint64_t bytes_written{};
+
+    /// Timing for each phase, indexed by \ref operation_phase.
+    std::array<phase_timing, num_operation_phases> phases{};
+
+    /// Retrieves the timing for a given phase.
+    const phase_timing& phase(operation_phase p) const noexcept
+    {
+        BOOST_ASSERT(static_cast<std::size_t>(p) < num_operation_phases);
+        return phases[static_cast<std::size_t>(p)];
+    }
+
+    /// Retrieves the timing for a given phase.
+    phase_timing& phase(operation_phase p) noexcept
+    {
+        BOOST_ASSERT(static_cast<std::size_t>(p) < num_operation_phases);
+        return phases[static_cast<std::size_t>(p)];
+    }
+};
+
+/**
+ * \brief Interface to get notified when a connection starts and finishes network operations.
+ * \details
+ * Install an observer in a connection by calling \ref connection::set_observer.
+ * `on_operation_start` is invoked when the operation is initiated, before any I/O is performed.
+ * `on_operation_finish` is invoked when the operation completes, before the completion
+ * handler is invoked (for async operations) or the function returns (for sync operations).
+ * Callbacks run in the thread that initiated or completed the operation and must not throw.
+ * \n
+ * When no observer is installed, the cost of the hooks is a pointer comparison per operation
+ * and phase. If `BOOST_MYSQL_NO_OPERATION_OBSERVER` is defined, the hooks are not compiled
+ * at all and installed observers are never invoked.
+ */
+class operation_observer
+{
+public:
+    /// Destructor.
+    virtual ~operation_observer() {}
+
+    /// Invoked when an operation starts.
+    virtual void on_operation_start(const operation_info& info) noexcept = 0;
+
+    /// Invoked when an operation finishes, successfully or not.
+    virtual void on_operation_finish(const operation_info& info) noexcept = 0;
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#endif
@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_PROTOCOL_TRACE_HPP
+#define BOOST_MYSQL_PROTOCOL_TRACE_HPP
+
+#include <boost/mysql/diagnostics.hpp>
+#include <boost/mysql/error_code.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/// Maximum number of payload bytes stored by each \ref protocol_trace_record.
+constexpr std::size_t protocol_trace_prefix_size = 16;
+
+/// Whether a protocol message was sent or received.
+enum class trace_direction : std::uint8_t
+{
+    /// The message was received from the server.
+    read,
+
+    /// The message was sent to the server.
+    write,
+};
+
+/**
+ * \brief Summary of a protocol message, as stored by \ref protocol_trace.
+ * \details
+ * For client messages, the first payload byte is usually the command type
+ * (e.g. `0x03` for text queries).
+ */
+struct protocol_trace_record
+{
+    /// When the message was received, or serialized to be sent.
+    std::chrono::steady_clock::time_point timestamp;
+
+    /// The message's total payload size, excluding frame headers.
+    std::size_t size;
+
+    /// Sequence number of the first frame of the message.
+    std::uint8_t seqnum;
+
+    /// Number of frames the message spanned.
+    std::uint8_t num_frames;
+
+    /// Whether the message was sent or received.
+    trace_direction direction;
+
+    /// Number of valid bytes in \ref prefix.
+    std::uint8_t prefix_size;
+
+    /// The first bytes of the message payload.
+    std::array<std::uint8_t, protocol_trace_prefix_size> prefix;
+};
+
+/**
+ * \brief A fixed-size ring buffer with the last protocol messages exchanged by a connection.
+ * \details
+ * Enabled by \ref connection::enable_protocol_trace. Once enabled, the connection appends
+ * a record to the ring for every message it reads or writes, overwriting the oldest one when
+ * the ring is full. Appending is a handful of stores and doesn't allocate or lock.
+ * \n
+ * Use \ref format_protocol_trace to get a human-readable dump, e.g. when an operation fails.
+ * \n
+ * Like connections, this class is not thread-safe. It should be inspected when no operation
+ * is outstanding on the connection that owns it.
+ */
+class protocol_trace
+{
+public:
+    /**
+     * \brief Constructs a trace able to hold `capacity` records.
+     * \details
+     * A `capacity` of zero is treated as one.
+     *
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    explicit protocol_trace(std::size_t capacity)
+        : capacity_(capacity ? capacity : 1u), records_(new protocol_trace_record[capacity_])
+    {
+    }
+
+    /// Returns the maximum number of records the trace can hold.
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    /// Returns the number of records held, which is never greater than \ref capacity.
+    std::size_t size() const noexcept
+    {
+        return total_ < capacity_ ? static_cast<std::size_t>(total_) : capacity_;
+    }
+
+    /// Returns the number of records appended since construction or the last \ref clear.
+    std::uint64_t total_records() const noexcept { return total_; }
+
+    /**
+     * \brief Returns the record at position `i`, where zero is the oldest one held.
+     * \par Preconditions
+     * `i < this->size()`
+     */
+    const protocol_trace_record& operator[](std::size_t i) const noexcept
+    {
+        BOOST_ASSERT(i < size());
+        std::size_t first = total_ < capacity_ ? 0u : next_;
+        std::size_t idx = first + i;
+        return records_[idx < capacity_ ? idx : idx - capacity_];
+    }
+
+    /**
+     * \brief Returns a copy of the held records, from oldest to newest.
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    std::vector<protocol_trace_record> records() const
+    {
+        std::vector<protocol_trace_record> res;
+        res.reserve(size());
+        for (std::size_t i = 0; i < size(); ++i)
+            res.push_back((*this)[i]);
+        return res;
+    }
+
+    /// Removes all records.
+    void clear() noexcept
+    {
+        next_ = 0;
+        total_ = 0;
+    }
+
+    /**
+     * \brief Appends a record, overwriting the oldest one if the trace is full.
+     * \details
+     * Called by the connection for every message read or written.
+     * Only the first \ref protocol_trace_prefix_size bytes of the payload are accessed.
+     */
+    void append(
+        trace_direction dir,
+        std::uint8_t seqnum_first,
+        std::uint8_t seqnum_last,
+        const std::uint8_t* payload,
+        std::size_t payload_size,
+        std::chrono::steady_clock::time_point timestamp = std::chrono::steady_clock::now()
+    ) noexcept
+    {
+        auto& rec = records_[next_];
+        rec.timestamp = timestamp;
+        rec.size = payload_size;
+        rec.seqnum = seqnum_first;
+        rec.num_frames = static_cast<std::uint8_t>(seqnum_last - seqnum_first + 1u);
+        rec.direction = dir;
+        rec.prefix_size = static_cast<std::uint8_t>(
+            payload_size < protocol_trace_prefix_size ? payload_size : protocol_trace_prefix_size
+        );
+        if (rec.prefix_size)
+            std::memcpy(rec.prefix.data(), payload, rec.prefix_size);
+        next_ = next_ + 1u == capacity_ ? 0u : next_ + 1u;
+        ++total_;
+    }
+
+private:
+    std::size_t capacity_;
+    std::unique_ptr<protocol_trace_record[]> records_;
+    std::size_t next_{};
+    std::uint64_t total_{};
+};
+
+/**
+ * \brief Formats a protocol trace as human-readable text.
+ * \details
+ * Outputs one line per record, from oldest to newest, with the time relative to the
+ * newest record, the direction (`C->S` for client messages, `S->C` for server messages),
+ * sequence number, number of frames, payload size and a hex dump of the payload prefix.
+ *
+ * \par Exception safety
+ * Strong guarantee. Memory allocations may throw.
+ */
+BOOST_MYSQL_DECL
+std::string format_protocol_trace(const protocol_trace& trace);
+
+/**
+ * \brief Formats a protocol trace together with an error, as human-readable text.
+ * \details
+ * Like the single-argument overload, but prepends the error code and the
+ * messages contained in `diag`. Intended to be called after an operation fails.
+ *
+ * \par Exception safety
+ * Strong guarantee. Memory allocations may throw.
+ */
+BOOST_MYSQL_DECL
+std::string format_protocol_trace(const protocol_trace& trace, error_code ec, const diagnostics& diag);
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/protocol_trace.ipp>
+#endif
+
+#endif
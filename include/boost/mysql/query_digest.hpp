@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_QUERY_DIGEST_HPP
+#define BOOST_MYSQL_QUERY_DIGEST_HPP
+
+#include <boost/mysql/histogram.hpp>
+#include <boost/mysql/operation_observer.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Client-observed statistics for a group of equivalent queries.
+ * \details
+ * Obtained by calling \ref query_digest_table::snapshot.
+ */
+struct query_digest
+{
+    /// A 64-bit hash of the digest's query. Different digests may share it if their hashes collide.
+    std::uint64_t fingerprint{};
+
+    /// The type of the operations in this digest.
+    operation_type type{operation_type::execute};
+
+    /**
+     * \brief The normalized query text.
+     * \details
+     * Literals are replaced by `?`, comments are removed and whitespace is collapsed.
+     * Empty for prepared statement executions.
+     */
+    std::string normalized_query;
+
+    /// For prepared statement executions, the statement ID. Zero otherwise.
+    std::uint32_t statement_id{};
+
+    /// Number of operations that completed with an error.
+    std::uint64_t errors{};
+
+    /// Operation latency, in nanoseconds.
+    histogram_snapshot latency;
+
+    /// Number of rows read by each operation.
+    histogram_snapshot rows;
+
+    /// Number of bytes read from the network by each operation.
+    histogram_snapshot bytes_read;
+};
+
+/**
+ * \brief A thread-safe table aggregating client-side statistics per normalized query.
+ * \details
+ * Records operations of type \ref operation_type::execute, \ref operation_type::start_execution
+ * and \ref operation_type::prepare_statement, as reported by \ref operation_observer.
+ * Text queries are normalized (see \ref query_digest::normalized_query) and grouped by their
+ * normalized text. Digests are looked up by a hash of the text, but hash collisions
+ * never merge different queries. Prepared statement executions are grouped by statement ID. Note
+ * that statement IDs are assigned per connection by the server, so executions of different statements
+ * in different connections may share a digest.
+ * \n
+ * For \ref operation_type::start_execution, latency and rows only cover reading the first resultset head.
+ * \n
+ * The table is split in shards with a fixed number of slots, allocated on construction.
+ * \ref record is lock-free: looking up a digest is a probe over atomic pointers, and statistics
+ * are updated with relaxed atomic operations. Memory for a digest is allocated the first time
+ * it's seen. When all slots are in use, new digests are counted in \ref num_dropped and not recorded.
+ * \n
+ * Counters are cumulative. To report periodically, take snapshots at regular intervals
+ * (e.g. using a timer) and compute the differences.
+ * \n
+ * Tables are neither copyable nor movable.
+ */
+class query_digest_table
+{
+public:
+    /**
+     * \brief Constructor.
+     * \details
+     * `max_digests` is rounded up so it can be evenly split across shards.
+     *
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    BOOST_MYSQL_DECL
+    explicit query_digest_table(std::size_t max_digests = 1024);
+
+    query_digest_table(const query_digest_table&) = delete;
+    query_digest_table& operator=(const query_digest_table&) = delete;
+
+    /// Destructor.
+    BOOST_MYSQL_DECL
+    ~query_digest_table();
+
+    /// Returns the maximum number of digests the table can hold.
+    std::size_t max_digests() const noexcept { return num_shards * shard_size_; }
+
+    /**
+     * \brief Returns the number of operations that couldn't be recorded.
+     * \details
+     * Operations are dropped if the table is full or if allocating memory for a digest failed.
+     */
+    std::uint64_t num_dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * \brief Records a finished operation.
+     * \details
+     * Operations with types other than the ones listed in the class description are ignored.
+     * May be called concurrently from several threads.
+     *
+     * \par Exception safety
+     * No-throw guarantee. Allocation failures are reported by \ref num_dropped.
+     */
+    BOOST_MYSQL_DECL
+    void record(const operation_info& info) noexcept;
+
+    /**
+     * \brief Returns a copy of the statistics for all digests.
+     * \details
+     * Digests are sorted by total latency, in descending order. May be called concurrently with \ref record.
+     *
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    BOOST_MYSQL_DECL
+    std::vector<query_digest> snapshot() const;
+
+private:
+    struct entry;
+    static constexpr std::size_t num_shards = 16;
+
+    std::size_t shard_size_;
+    std::unique_ptr<std::atomic<entry*>[]> slots_;
+    std::atomic<std::uint64_t> dropped_{0};
+
+    bool record_impl(std::uint64_t fingerprint, const operation_info& info, string_view normalized);
+};
+
+/**
+ * \brief An \ref operation_observer that records finished operations in a \ref query_digest_table.
+ * \details
+ * The observer doesn't own the table. A single table (and observer) may be shared between
+ * connections running in different threads.
+ */
+class query_digest_observer final : public operation_observer
+{
+    query_digest_table* table_;
+
+public:
+    /// Constructor.
+    explicit query_digest_observer(query_digest_table& table) noexcept : table_(&table) {}
+
+    /// Does nothing.
+    void on_operation_start(const operation_info&) noexcept override {}
+
+    /// Records the operation in the table.
+    void on_operation_finish(const operation_info& info) noexcept override { table_->record(info); }
+};
+
+/**
+ * \brief Formats digests as a human-readable text table.
+ * \details
+ * Outputs one line per digest with the number of executions, errors, latency quantiles
+ * (in microseconds), total rows and bytes, and the query text.
+ *
+ * \par Exception safety
+ * Strong guarantee. Memory allocations may throw.
+ */
+BOOST_MYSQL_DECL
+std::string format_query_digests(const std::vector<query_digest>& digests);
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/query_digest.ipp>
+#endif
+
+#endif
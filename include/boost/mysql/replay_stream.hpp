@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_REPLAY_STREAM_HPP
+#define BOOST_MYSQL_REPLAY_STREAM_HPP
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/wire_capture.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/asio/any_completion_handler.hpp>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief A stream that replays the server side of a wire capture.
+ * \details
+ * Satisfies the `Stream` concept, so it can be used as `connection<replay_stream>`
+ * to re-run the exact conversation recorded by \ref connection::start_wire_capture
+ * without a server, e.g. to reproduce bugs or benchmark the client deterministically.
+ * \n
+ * Reads are served with the bytes of the captured reads (records with
+ * \ref trace_direction::read), in order. A read may return fewer bytes than the captured one,
+ * if the supplied buffer is smaller, but never joins bytes from two captured reads.
+ * Once all captured bytes have been served, reads fail with `asio::error::eof`.
+ * Writes always succeed and their data is discarded.
+ * \n
+ * If `use_original_timing` is `true`, the first read of every captured record doesn't complete
+ * before the time it was originally received. Times are relative to the first record,
+ * which is mapped to the first read or write performed on this stream. Sync reads
+ * sleep the calling thread, while async reads use a timer.
+ * \n
+ * This is not a `SocketStream`, so `connection::connect` and `connection::close` are not available.
+ * Use `connection::handshake` if the capture was started before the handshake. TLS is not supported
+ * by this stream, but captures of TLS connections can be replayed, since plaintext is captured.
+ * \n
+ * Like other streams, this class is not thread-safe.
+ */
+class replay_stream
+{
+public:
+    /// The executor type associated to this stream.
+    using executor_type = asio::any_io_executor;
+
+    /**
+     * \brief Constructs a stream replaying the given records.
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    BOOST_MYSQL_DECL
+    replay_stream(
+        executor_type ex,
+        std::vector<wire_capture_record> records,
+        bool use_original_timing = false
+    );
+
+    /// Retrieves the executor associated to this stream.
+    executor_type get_executor() { return timer_.get_executor(); }
+
+    /// Returns the records being replayed.
+    const std::vector<wire_capture_record>& records() const noexcept { return records_; }
+
+    /**
+     * \brief Returns whether all the captured reads have been served.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    BOOST_MYSQL_DECL bool done() const noexcept;
+
+    /**
+     * \brief Restarts the replay from the first record.
+     * \details
+     * No asynchronous operation should be outstanding when this function is called.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    BOOST_MYSQL_DECL void rewind() noexcept;
+
+    /// Reads some captured bytes. See the class description for more info.
+    BOOST_MYSQL_DECL std::size_t read_some(asio::mutable_buffer buff, error_code& ec);
+
+    /// Reads some captured bytes, throwing on error.
+    BOOST_MYSQL_DECL std::size_t read_some(asio::mutable_buffer buff);
+
+    /// Reads some captured bytes. See the class description for more info.
+    template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::size_t)) CompletionToken>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_read_some(asio::mutable_buffer buff, CompletionToken&& token)
+    {
+        return asio::async_initiate<CompletionToken, void(error_code, std::size_t)>(
+            initiate_read_some(),
+            token,
+            this,
+            buff
+        );
+    }
+
+    /// Discards the supplied bytes. Always succeeds.
+    BOOST_MYSQL_DECL std::size_t write_some(asio::const_buffer buff, error_code& ec);
+
+    /// Discards the supplied bytes. Always succeeds.
+    BOOST_MYSQL_DECL std::size_t write_some(asio::const_buffer buff);
+
+    /// Discards the supplied bytes. Always succeeds.
+    template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(error_code, std::size_t)) CompletionToken>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+    async_write_some(asio::const_buffer buff, CompletionToken&& token)
+    {
+        return asio::async_initiate<CompletionToken, void(error_code, std::size_t)>(
+            initiate_write_some(),
+            token,
+            this,
+            buff
+        );
+    }
+
+private:
+    std::vector<wire_capture_record> records_;
+    bool use_original_timing_;
+    asio::steady_timer timer_;
+    std::size_t current_record_{0};
+    std::size_t current_offset_{0};
+    bool started_{false};
+    std::chrono::steady_clock::time_point start_;
+
+    BOOST_MYSQL_DECL void start() noexcept;
+    BOOST_MYSQL_DECL std::chrono::steady_clock::time_point next_read_deadline() noexcept;
+    BOOST_MYSQL_DECL std::size_t do_read(asio::mutable_buffer buff, error_code& ec) noexcept;
+    BOOST_MYSQL_DECL void do_async_read_some(
+        asio::mutable_buffer buff,
+        asio::any_completion_handler<void(error_code, std::size_t)> handler
+    );
+    BOOST_MYSQL_DECL void do_async_write_some(
+        asio::const_buffer buff,
+        asio::any_completion_handler<void(error_code, std::size_t)> handler
+    );
+
+    struct initiate_read_some
+    {
+        template <class Handler>
+        void operator()(Handler&& handler, replay_stream* self, asio::mutable_buffer buff)
+        {
+            self->do_async_read_some(buff, std::forward<Handler>(handler));
+        }
+    };
+
+    struct initiate_write_some
+    {
+        template <class Handler>
+        void operator()(Handler&& handler, replay_stream* self, asio::const_buffer buff)
+        {
+            self->do_async_write_some(buff, std::forward<Handler>(handler));
+        }
+    };
+
+    struct read_op;
+    struct write_op;
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/replay_stream.ipp>
+#endif
+
+#endif
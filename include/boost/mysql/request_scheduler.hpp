@@ -0,0 +1,273 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_REQUEST_SCHEDULER_HPP
+#define BOOST_MYSQL_REQUEST_SCHEDULER_HPP
+
+#include <boost/mysql/connection.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+#include <boost/mysql/detail/work_stealing_deque.hpp>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+namespace detail {
+
+// A request waiting for a connection. Owned by the scheduler until it's run
+struct scheduled_request
+{
+    scheduled_request* next{};  // used by the submission queue
+
+    // Runs the request using the given connection, identified by its group and its index in the group
+    virtual void run(std::size_t group, std::size_t slot) = 0;
+    virtual ~scheduled_request() {}
+};
+
+class request_scheduler_impl
+{
+    struct group
+    {
+        asio::any_io_executor ex;
+
+        // Lock-free submission queue, where any thread may push. Moved to the deque by drain()
+        std::atomic<scheduled_request*> inbox{nullptr};
+        std::atomic<bool> drain_pending{false};
+
+        // Requests waiting for a connection. Pushed only by this group, stolen by any
+        work_stealing_deque<scheduled_request> pending;
+
+        // Read by other groups to decide whether to wake this one up
+        std::atomic<std::size_t> num_idle{0};
+
+        // Only accessed from ex
+        std::vector<std::size_t> idle_slots;
+        std::deque<scheduled_request*> overflow;  // drained requests that didn't fit in pending
+        std::size_t num_slots{};
+        bool dispatching{};
+
+        group(asio::any_io_executor ex, std::size_t queue_capacity)
+            : ex(std::move(ex)), pending(queue_capacity)
+        {
+        }
+    };
+
+    std::vector<std::unique_ptr<group>> groups_;
+    std::size_t queue_capacity_;
+    std::atomic<std::size_t> next_group_{0};
+    std::atomic<std::size_t> num_stolen_{0};
+
+    // Moves requests that didn't fit in the deque, if there's room for them now
+    static void refill(group& grp)
+    {
+        while (!grp.overflow.empty() && grp.pending.push(grp.overflow.front()))
+            grp.overflow.pop_front();
+    }
+
+    BOOST_MYSQL_DECL void notify(std::size_t group_idx);
+    BOOST_MYSQL_DECL void drain(std::size_t group_idx);
+    BOOST_MYSQL_DECL void dispatch(std::size_t group_idx);
+    BOOST_MYSQL_DECL scheduled_request* take_request(std::size_t group_idx);
+    BOOST_MYSQL_DECL void wake_idle_groups(std::size_t group_idx);
+
+public:
+    explicit request_scheduler_impl(std::size_t queue_capacity) noexcept : queue_capacity_(queue_capacity) {}
+    request_scheduler_impl(const request_scheduler_impl&) = delete;
+    request_scheduler_impl& operator=(const request_scheduler_impl&) = delete;
+    BOOST_MYSQL_DECL ~request_scheduler_impl();
+
+    BOOST_MYSQL_DECL std::size_t add_group(asio::any_io_executor ex);
+    BOOST_MYSQL_DECL std::size_t add_slot(std::size_t group_idx);
+    BOOST_MYSQL_DECL void submit(scheduled_request* req, std::size_t group_idx);
+    void submit(scheduled_request* req)
+    {
+        BOOST_ASSERT(!groups_.empty());
+        submit(req, next_group_.fetch_add(1, std::memory_order_relaxed) % groups_.size());
+    }
+    BOOST_MYSQL_DECL void release(std::size_t group_idx, std::size_t slot);
+
+    std::size_t num_groups() const noexcept { return groups_.size(); }
+    std::size_t num_stolen() const noexcept { return num_stolen_.load(std::memory_order_relaxed); }
+};
+
+}  // namespace detail
+
+/**
+ * \brief Returns a connection to a \ref request_scheduler once a request is done with it.
+ * \details
+ * Request functions receive an object of this type. It must be invoked exactly once,
+ * from the connection's group executor, once the request no longer needs the connection.
+ * Objects of this type are cheap to copy.
+ */
+class request_release_handle
+{
+    detail::request_scheduler_impl* impl_;
+    std::size_t group_;
+    std::size_t slot_;
+
+public:
+#ifndef BOOST_MYSQL_DOXYGEN
+    request_release_handle(detail::request_scheduler_impl& impl, std::size_t group, std::size_t slot) noexcept
+        : impl_(&impl), group_(group), slot_(slot)
+    {
+    }
+#endif
+
+    /// Makes the connection available for other requests.
+    void operator()() const { impl_->release(group_, slot_); }
+
+    /// Returns the index of the group the connection belongs to.
+    std::size_t group() const noexcept { return group_; }
+};
+
+/**
+ * \brief Runs requests on connections distributed in groups, balancing work between groups.
+ * \details
+ * A common architecture runs one `io_context` per core, each with its own connections.
+ * Requests arriving to a busy core would queue up while connections in other cores sit idle.
+ * This class spreads requests between connection groups (typically, one group per core),
+ * without ever sharing a connection between threads.
+ * \n
+ * Requests can be submitted from any thread. They're placed in a group's queue, and run on one of its
+ * connections as soon as one is free. Groups with idle connections steal requests queued in
+ * other groups, so requests never wait while there are idle connections.
+ * Within a group, requests run in submission order.
+ * \n
+ * Each group has a lock-free work-stealing deque of bounded capacity, and a lock-free
+ * submission queue. Requests that don't fit in the deque are kept aside and can't be stolen
+ * until there is room for them.
+ * \n
+ * A request is a function invoked as `fn(conn, release)`, from the group's executor.
+ * `conn` is a free connection, and `release` is a \ref request_release_handle that must be
+ * invoked once the request is done with `conn`. Usually, the request initiates an async
+ * operation on `conn`, and invokes `release` in its completion handler.
+ * If a request function throws, the exception propagates to the caller of the group's
+ * `io_context::run`, and the connection is made available again, unless the request released it
+ * before throwing. Other requests are not affected.
+ * \n
+ * \par Thread safety
+ * \ref add_group and \ref add_connection must be called before submitting any request,
+ * and are not thread-safe. \ref submit may be called concurrently from any thread.
+ * \n
+ * \par Object lifetimes
+ * The scheduler and the connections added to it must outlive the requests submitted to it,
+ * and must not be destroyed while the groups' executors may run handlers that reference it.
+ * This is usually achieved by destroying it after the `io_context` objects have stopped running.
+ * Requests that have not been run when the scheduler is destroyed are destroyed without being run.
+ */
+template <class Stream>
+class request_scheduler
+{
+public:
+    /// The type of the connections handled by this scheduler.
+    using connection_type = connection<Stream>;
+
+    /// The type of the functions representing a request.
+    using request_function = std::function<void(connection_type&, request_release_handle)>;
+
+    /**
+     * \brief Constructor.
+     * \details
+     * `queue_capacity` is the capacity of the work-stealing deque of each group,
+     * rounded up to a power of two.
+     */
+    explicit request_scheduler(std::size_t queue_capacity = 1024) : impl_(queue_capacity) {}
+
+    request_scheduler(const request_scheduler&) = delete;
+    request_scheduler& operator=(const request_scheduler&) = delete;
+
+    /**
+     * \brief Adds a connection group, returning its index.
+     * \details
+     * Request functions for this group are run from `ex`, which should be the executor
+     * of the connections added to the group.
+     */
+    std::size_t add_group(asio::any_io_executor ex)
+    {
+        conns_.emplace_back();
+        return impl_.add_group(std::move(ex));
+    }
+
+    /**
+     * \brief Adds a connection to a group.
+     * \details
+     * The connection should be connected and only be used through the scheduler from now on.
+     * \par Preconditions
+     * `group < this->num_groups()`
+     */
+    void add_connection(std::size_t group, connection_type& conn)
+    {
+        BOOST_ASSERT(group < conns_.size());
+        conns_[group].push_back(&conn);
+        impl_.add_slot(group);
+    }
+
+    /**
+     * \brief Submits a request, placing it in a group chosen in a round-robin fashion.
+     * \details
+     * This function is thread-safe.
+     * \par Preconditions
+     * `this->num_groups() > 0`
+     */
+    void submit(request_function fn) { impl_.submit(new request_node(*this, std::move(fn))); }
+
+    /**
+     * \brief Submits a request, placing it in the given group's queue.
+     * \details
+     * Use this overload to keep requests in the current core's group when possible.
+     * The request may still run in another group if it gets stolen. This function is thread-safe.
+     * \par Preconditions
+     * `group < this->num_groups()`
+     */
+    void submit(std::size_t group, request_function fn)
+    {
+        impl_.submit(new request_node(*this, std::move(fn)), group);
+    }
+
+    /// Returns the number of groups.
+    std::size_t num_groups() const noexcept { return impl_.num_groups(); }
+
+    /// Returns the number of requests that have been run by a group other than the one they were placed in.
+    std::size_t num_stolen() const noexcept { return impl_.num_stolen(); }
+
+private:
+    detail::request_scheduler_impl impl_;
+    std::vector<std::vector<connection_type*>> conns_;
+
+    struct request_node final : detail::scheduled_request
+    {
+        request_scheduler& self;
+        request_function fn;
+
+        request_node(request_scheduler& self, request_function&& fn) : self(self), fn(std::move(fn)) {}
+
+        void run(std::size_t group, std::size_t slot) override
+        {
+            fn(*self.conns_[group][slot], request_release_handle(self.impl_, group, slot));
+        }
+    };
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/request_scheduler.ipp>
+#endif
+
+#endif
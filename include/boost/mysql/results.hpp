@@ -11,6 +11,7 @@
 #include <boost/mysql/metadata_collection_view.hpp>
 #include <boost/mysql/resultset.hpp>
 #include <boost/mysql/resultset_view.hpp>
+#include <boost/mysql/row_filter.hpp>
 #include <boost/mysql/rows_view.hpp>
 #include <boost/mysql/string_view.hpp>
 
@@ -22,6 +23,7 @@
 #include <boost/throw_exception.hpp>
 
 #include <stdexcept>
+#include <utility>
 
 namespace boost {
 namespace mysql {
@@ -471,6 +473,37 @@ public:
         return impl_.get_out_params();
     }
 
+    /**
+     * \brief Sets the filter that rows must match to be stored in this object.
+     * \details
+     * Rows read by subsequent operations using this object are checked against `filter`
+     * as soon as they are deserialized. Rows not matching it are discarded before being copied
+     * into `*this`, so they don't consume memory. The filter only applies to the first resultset,
+     * and never to OUT parameters, which are always stored. Pass an empty \ref row_filter to
+     * store all rows again.
+     * \n
+     * The filter is kept when `*this` is reused for other operations.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    void set_row_filter(row_filter filter) noexcept { impl_.set_row_filter(std::move(filter)); }
+
+    /**
+     * \brief Returns the dynamic memory owned by this object, in bytes.
+     * \details
+     * Includes the storage for rows, metadata and info strings, measured as allocated capacity.
+     * Doesn't include `sizeof(*this)`. Storage is kept when the object is reused, so this value
+     * reflects the largest result held since construction.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Complexity
+     * Linear on the number of columns.
+     */
+    std::size_t memory_usage() const noexcept { return impl_.memory_usage(); }
+
 private:
     detail::results_impl impl_;
 #ifndef BOOST_MYSQL_DOXYGEN
@@ -0,0 +1,469 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_RESULTSET_DIFF_HPP
+#define BOOST_MYSQL_RESULTSET_DIFF_HPP
+
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/diagnostics.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/execution_state.hpp>
+#include <boost/mysql/metadata_collection_view.hpp>
+#include <boost/mysql/row.hpp>
+#include <boost/mysql/row_view.hpp>
+#include <boost/mysql/rows_view.hpp>
+#include <boost/mysql/sort_rows.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+#include <boost/mysql/detail/throw_on_error_loc.hpp>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/coroutine.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/span.hpp>
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+namespace detail {
+enum class sort_key_encoding;
+}
+
+/// Identifies one of the two resultsets compared by a \ref resultset_diff.
+enum class diff_side
+{
+    /// The first resultset.
+    left = 0,
+
+    /// The second resultset.
+    right,
+};
+
+/**
+ * \brief A range of consecutive keys where two resultsets differ, as reported by \ref resultset_diff.
+ * \details
+ * Keys are visited in the order the resultsets are sorted by. A range starts with the first
+ * key that is missing in one of the resultsets or whose rows differ, and ends before the next
+ * key with identical rows in both resultsets.
+ */
+struct diff_range
+{
+    /// The key columns of the first row in the range.
+    row first_key;
+
+    /// The key columns of the last row in the range.
+    row last_key;
+
+    /// The number of rows in the range that come from the left resultset.
+    std::size_t left_rows{};
+
+    /// The number of rows in the range that come from the right resultset.
+    std::size_t right_rows{};
+};
+
+/**
+ * \brief Compares two resultsets sorted by the same key, without materializing them.
+ * \details
+ * Meant to verify replicas and migrations, by running the same query, ordered by a unique key,
+ * on two servers. Rows are fed in batches, as returned by \ref connection::read_some_rows,
+ * and merged by key as they arrive: only the current batch of each resultset needs to be kept
+ * alive. \ref diff_resultsets and \ref async_diff_resultsets drive this process on two
+ * connections.
+ * \n
+ * Keys are compared as in \ref sort_rows, so the key columns and their \ref sort_order
+ * must match the query's `ORDER BY` clause. Rows with the same key are compared
+ * by the hash of all their fields, as computed by \ref hash_value(const row_view&).
+ * Differences are reported as ranges of keys in \ref ranges.
+ * \n
+ * A checksum for each resultset is computed as well, combining the hashes of all its rows
+ * in order. Equal resultsets have equal checksums.
+ * \n
+ * Typical usage, when driving the comparison manually:
+ * \code
+ * while (!diff.done())
+ * {
+ *     for (diff_side side : {diff_side::left, diff_side::right})
+ *     {
+ *         if (diff.needs_rows(side))
+ *         {
+ *             // get the next batch for side, or call finish(side) if there are no more rows
+ *         }
+ *     }
+ * }
+ * \endcode
+ */
+class resultset_diff
+{
+    struct side_state
+    {
+        rows_view batch;
+        std::size_t pos{};
+        bool finished{};
+        std::vector<unsigned char> key;  // of the current row
+        std::size_t hash{};              // of the current row
+        std::size_t checksum{};
+        std::size_t num_rows{};
+
+        bool has_current() const noexcept { return pos < batch.size(); }
+        row_view current() const noexcept { return batch[pos]; }
+    };
+
+    std::vector<sort_column> key_columns_;
+    std::vector<detail::sort_key_encoding> encodings_;  // one per key column
+    std::array<side_state, 2> sides_;
+    std::vector<diff_range> ranges_;
+    bool range_open_{};
+    bool done_{};
+    std::vector<field_view> key_fields_;  // scratch buffer
+
+    side_state& side(diff_side s) noexcept { return sides_[static_cast<std::size_t>(s)]; }
+    const side_state& side(diff_side s) const noexcept { return sides_[static_cast<std::size_t>(s)]; }
+
+    BOOST_MYSQL_DECL
+    void init(metadata_collection_view meta);
+
+    BOOST_MYSQL_DECL
+    void load_current(side_state& s);
+
+    BOOST_MYSQL_DECL
+    void mark_different(row_view r, std::size_t left_rows, std::size_t right_rows);
+
+    BOOST_MYSQL_DECL
+    void process();
+
+public:
+    /**
+     * \brief Constructor.
+     * \details
+     * `meta` describes the columns of the compared resultsets, and is used to choose
+     * how key fields compare (see \ref sort_rows). It may be empty. `key` contains the columns
+     * the resultsets are sorted by. It is copied.
+     *
+     * \par Preconditions
+     * `!key.empty()`, and every element in `key` has an `index` less than
+     * the number of columns in the compared resultsets. If `!meta.empty()`, `meta.size()`
+     * equals the number of columns in the compared resultsets.
+     *
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    resultset_diff(metadata_collection_view meta, span<const sort_column> key)
+        : key_columns_(key.begin(), key.end())
+    {
+        init(meta);
+    }
+
+    /// \copydoc resultset_diff(metadata_collection_view,span<const sort_column>)
+    resultset_diff(metadata_collection_view meta, std::initializer_list<sort_column> key)
+        : key_columns_(key)
+    {
+        init(meta);
+    }
+
+    /**
+     * \brief Returns whether another batch of rows for the given side is required to progress.
+     * \details
+     * Returns `true` once all the rows for `s` passed to \ref add_rows have been processed,
+     * unless \ref finish has been called for `s`.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    bool needs_rows(diff_side s) const noexcept
+    {
+        const auto& st = side(s);
+        return !st.finished && !st.has_current();
+    }
+
+    /**
+     * \brief Adds a batch of rows to one of the resultsets, and compares as many rows as possible.
+     * \details
+     * `rows` is not copied. It must be kept valid until \ref needs_rows returns `true`
+     * for `s` again, or the comparison is \ref done. Batches obtained by calling
+     * \ref connection::read_some_rows on different connections for each side fulfill this.
+     * `rows` may be empty.
+     *
+     * \par Preconditions
+     * `this->needs_rows(s)`
+     *
+     * \par Exception safety
+     * Basic guarantee. Memory allocations may throw.
+     */
+    void add_rows(diff_side s, rows_view rows)
+    {
+        BOOST_ASSERT(needs_rows(s));
+        auto& st = side(s);
+        st.batch = rows;
+        st.pos = 0;
+        if (st.has_current())
+            load_current(st);
+        process();
+    }
+
+    /**
+     * \brief Signals that a resultset has no more rows, and compares as many rows as possible.
+     * \par Preconditions
+     * `this->needs_rows(s)`
+     *
+     * \par Exception safety
+     * Basic guarantee. Memory allocations may throw.
+     */
+    void finish(diff_side s)
+    {
+        BOOST_ASSERT(needs_rows(s));
+        side(s).finished = true;
+        process();
+    }
+
+    /**
+     * \brief Returns whether all the rows in both resultsets have been compared.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    bool done() const noexcept { return done_; }
+
+    /**
+     * \brief Returns the ranges where the resultsets differ, found so far.
+     * \details
+     * Once \ref done returns `true`, this contains all the differences.
+     * The resultsets are equal if this is empty.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    const std::vector<diff_range>& ranges() const noexcept { return ranges_; }
+
+    /**
+     * \brief Returns the checksum of the rows processed so far for a resultset.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    std::size_t checksum(diff_side s) const noexcept { return side(s).checksum; }
+
+    /**
+     * \brief Returns the number of rows processed so far for a resultset.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    std::size_t num_rows(diff_side s) const noexcept { return side(s).num_rows; }
+};
+
+namespace detail {
+
+template <class LeftConnection, class RightConnection>
+struct diff_resultsets_op : asio::coroutine
+{
+    LeftConnection& left_conn_;
+    execution_state& left_st_;
+    RightConnection& right_conn_;
+    execution_state& right_st_;
+    resultset_diff& diff_;
+    diagnostics& diag_;
+    bool has_read_{};
+
+    diff_resultsets_op(
+        LeftConnection& left_conn,
+        execution_state& left_st,
+        RightConnection& right_conn,
+        execution_state& right_st,
+        resultset_diff& diff,
+        diagnostics& diag
+    ) noexcept
+        : left_conn_(left_conn),
+          left_st_(left_st),
+          right_conn_(right_conn),
+          right_st_(right_st),
+          diff_(diff),
+          diag_(diag)
+    {
+    }
+
+    template <class Self>
+    void operator()(Self& self, error_code err = {}, rows_view rows = {})
+    {
+        if (err)
+        {
+            self.complete(err);
+            return;
+        }
+
+        BOOST_ASIO_CORO_REENTER(*this)
+        {
+            while (!diff_.done())
+            {
+                if (diff_.needs_rows(diff_side::left))
+                {
+                    if (left_st_.should_read_rows())
+                    {
+                        has_read_ = true;
+                        BOOST_ASIO_CORO_YIELD left_conn_.async_read_some_rows(left_st_, diag_, std::move(self));
+                        diff_.add_rows(diff_side::left, rows);
+                    }
+                    else
+                    {
+                        diff_.finish(diff_side::left);
+                    }
+                }
+                if (diff_.needs_rows(diff_side::right))
+                {
+                    if (right_st_.should_read_rows())
+                    {
+                        has_read_ = true;
+                        BOOST_ASIO_CORO_YIELD right_conn_.async_read_some_rows(right_st_, diag_, std::move(self));
+                        diff_.add_rows(diff_side::right, rows);
+                    }
+                    else
+                    {
+                        diff_.finish(diff_side::right);
+                    }
+                }
+            }
+
+            // Don't complete within the initiating function
+            if (!has_read_)
+            {
+                BOOST_ASIO_CORO_YIELD asio::post(left_conn_.get_executor(), std::move(self));
+            }
+            self.complete(error_code());
+        }
+    }
+};
+
+}  // namespace detail
+
+/**
+ * \brief Compares the rows of two executions, reading from two connections.
+ * \details
+ * `left_st` and `right_st` must have been started by calling \ref connection::start_execution
+ * on `left_conn` and `right_conn`, respectively. Rows are read using \ref connection::read_some_rows
+ * and fed to `diff`, reading from the resultset that is behind, until both resultsets have been
+ * read. Only the current batch of each connection is kept in memory. While rows from one
+ * connection are processed, the other server keeps sending rows, which are buffered by the network.
+ * \n
+ * Only the current resultset of each execution is compared. After this function returns,
+ * the remaining resultsets, if any, may be read as usual.
+ *
+ * \par Preconditions
+ * `!diff.done()`. `left_conn` and `right_conn` are different connections.
+ */
+template <class LeftStream, class RightStream>
+void diff_resultsets(
+    connection<LeftStream>& left_conn,
+    execution_state& left_st,
+    connection<RightStream>& right_conn,
+    execution_state& right_st,
+    resultset_diff& diff,
+    error_code& err,
+    diagnostics& diag
+)
+{
+    err.clear();
+    diag.clear();
+    while (!diff.done())
+    {
+        if (diff.needs_rows(diff_side::left))
+        {
+            if (left_st.should_read_rows())
+            {
+                auto rows = left_conn.read_some_rows(left_st, err, diag);
+                if (err)
+                    return;
+                diff.add_rows(diff_side::left, rows);
+            }
+            else
+            {
+                diff.finish(diff_side::left);
+            }
+        }
+        if (diff.needs_rows(diff_side::right))
+        {
+            if (right_st.should_read_rows())
+            {
+                auto rows = right_conn.read_some_rows(right_st, err, diag);
+                if (err)
+                    return;
+                diff.add_rows(diff_side::right, rows);
+            }
+            else
+            {
+                diff.finish(diff_side::right);
+            }
+        }
+    }
+}
+
+/// \copydoc diff_resultsets
+template <class LeftStream, class RightStream>
+void diff_resultsets(
+    connection<LeftStream>& left_conn,
+    execution_state& left_st,
+    connection<RightStream>& right_conn,
+    execution_state& right_st,
+    resultset_diff& diff
+)
+{
+    error_code err;
+    diagnostics diag;
+    diff_resultsets(left_conn, left_st, right_conn, right_st, diff, err, diag);
+    detail::throw_on_error_loc(err, diag, BOOST_CURRENT_LOCATION);
+}
+
+/**
+ * \copydoc diff_resultsets
+ * \details
+ * The handler signature for this operation is `void(boost::mysql::error_code)`.
+ * Reads are performed one at a time, so `diag` is shared by both connections.
+ * `left_conn`, `right_conn`, the execution states, `diff` and `diag` must be kept alive
+ * until the operation completes.
+ */
+template <
+    class LeftStream,
+    class RightStream,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void(::boost::mysql::error_code))
+        CompletionToken BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(typename LeftStream::executor_type)>
+BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(::boost::mysql::error_code))
+async_diff_resultsets(
+    connection<LeftStream>& left_conn,
+    execution_state& left_st,
+    connection<RightStream>& right_conn,
+    execution_state& right_st,
+    resultset_diff& diff,
+    diagnostics& diag,
+    CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(typename LeftStream::executor_type)
+)
+{
+    diag.clear();
+    return asio::async_compose<CompletionToken, void(error_code)>(
+        detail::diff_resultsets_op<connection<LeftStream>, connection<RightStream>>(
+            left_conn,
+            left_st,
+            right_conn,
+            right_st,
+            diff,
+            diag
+        ),
+        token,
+        left_conn,
+        right_conn
+    );
+}
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/resultset_diff.ipp>
+#endif
+
+#endif
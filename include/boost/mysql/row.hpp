@@ -214,6 +214,20 @@ public:
 
     /// \copydoc row_view::as_vector
     std::vector<field> as_vector() const { return std::vector<field>(begin(), end()); }
+
+    /**
+     * \brief Returns the dynamic memory owned by this object, in bytes.
+     * \details
+     * Includes the storage for fields and strings, measured as allocated capacity.
+     * Doesn't include `sizeof(*this)`.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Complexity
+     * Constant.
+     */
+    std::size_t memory_usage() const noexcept { return impl_.memory_usage(); }
 };
 
 /**
@@ -266,7 +280,28 @@ inline bool operator==(const row_view& lhs, const row& rhs) noexcept { return lh
  */
 inline bool operator!=(const row_view& lhs, const row& rhs) noexcept { return !(lhs == rhs); }
 
+/**
+ * \relates row
+ * \brief Computes a hash value for a `row`.
+ * \details The same considerations as \ref hash_value(const row_view&) apply.
+ *
+ * \par Exception safety
+ * No-throw guarantee.
+ */
+inline std::size_t hash_value(const row& r) noexcept { return hash_value(row_view(r)); }
+
 }  // namespace mysql
 }  // namespace boost
 
+namespace std {
+
+/// Allows using \ref boost::mysql::row as a key in unordered containers.
+template <>
+struct hash<::boost::mysql::row>
+{
+    std::size_t operator()(const ::boost::mysql::row& v) const noexcept { return ::boost::mysql::hash_value(v); }
+};
+
+}  // namespace std
+
 #endif
@@ -0,0 +1,231 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_ROW_FILTER_HPP
+#define BOOST_MYSQL_ROW_FILTER_HPP
+
+#include <boost/mysql/field.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/row_view.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+namespace detail {
+
+enum class filter_op
+{
+    eq,
+    ne,
+    lt,
+    le,
+    gt,
+    ge,
+    is_null,
+    is_not_null,
+};
+
+struct filter_condition
+{
+    std::size_t column;
+    filter_op op;
+    field value;
+};
+
+}  // namespace detail
+
+/**
+ * \brief A predicate over rows, used to discard rows before they are stored.
+ * \details
+ * A filter is a conjunction of conditions over individual columns, like "column 2 equals 42"
+ * or "column 0 is greater than or equal to 2023-01-01". A row matches the filter
+ * if it satisfies all of its conditions. An empty filter matches all rows.
+ * \n
+ * Filters are attached to \ref results and \ref execution_state objects by calling
+ * `set_row_filter`. Rows are then checked as soon as they are deserialized, while their strings
+ * and blobs still point into the connection's read buffer. Rows not matching the filter
+ * are discarded without being copied into the object's storage. This is useful to apply
+ * conditions that can't be expressed in SQL, without paying the memory cost of rows
+ * that are going to be discarded.
+ * \n
+ * Conditions compare fields to constants, following these rules:
+ * \n
+ *   - `NULL` fields don't satisfy any condition but \ref row_filter::is_null. Comparisons
+ *     with `NULL` constants are never satisfied, either.
+ *   - Integers (`int64` and `uint64`) are compared by value, even if their kind is different.
+ *     If either of the values is a `float` or `double`, both are compared as `double`.
+ *   - Strings and blobs are compared byte by byte. Note that `DECIMAL` values are represented
+ *     as strings, so they're not compared numerically.
+ *   - Dates, datetimes and times are compared chronologically.
+ *   - Values of any other pair of kinds (e.g. a string and an integer) never satisfy the
+ *     condition, not even \ref row_filter::not_equal.
+ * \n
+ * Conditions referencing a column that the row doesn't have are never satisfied.
+ *
+ * Member functions adding conditions return `*this`, so calls can be chained:
+ * \code
+ * auto filter = row_filter()
+ *                   .equal(1, field_view("active"))
+ *                   .between(2, field_view(date(2023, 1, 1)), field_view(date(2023, 12, 31)));
+ * \endcode
+ */
+class row_filter
+{
+public:
+    /**
+     * \brief Constructs an empty filter, which matches all rows.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    row_filter() = default;
+
+    /**
+     * \brief Adds a condition satisfied when the field in `column` is equal to `value`.
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     * \par Object lifetimes
+     * Strings and blobs in `value` are copied into `*this`.
+     */
+    row_filter& equal(std::size_t column, field_view value)
+    {
+        return add(column, detail::filter_op::eq, value);
+    }
+
+    /**
+     * \brief Adds a condition satisfied when the field in `column` is not equal to `value`.
+     * \copydetails equal
+     */
+    row_filter& not_equal(std::size_t column, field_view value)
+    {
+        return add(column, detail::filter_op::ne, value);
+    }
+
+    /**
+     * \brief Adds a condition satisfied when the field in `column` is less than `value`.
+     * \copydetails equal
+     */
+    row_filter& less(std::size_t column, field_view value)
+    {
+        return add(column, detail::filter_op::lt, value);
+    }
+
+    /**
+     * \brief Adds a condition satisfied when the field in `column` is less than or equal to `value`.
+     * \copydetails equal
+     */
+    row_filter& less_equal(std::size_t column, field_view value)
+    {
+        return add(column, detail::filter_op::le, value);
+    }
+
+    /**
+     * \brief Adds a condition satisfied when the field in `column` is greater than `value`.
+     * \copydetails equal
+     */
+    row_filter& greater(std::size_t column, field_view value)
+    {
+        return add(column, detail::filter_op::gt, value);
+    }
+
+    /**
+     * \brief Adds a condition satisfied when the field in `column` is greater than or equal to `value`.
+     * \copydetails equal
+     */
+    row_filter& greater_equal(std::size_t column, field_view value)
+    {
+        return add(column, detail::filter_op::ge, value);
+    }
+
+    /**
+     * \brief Adds a condition satisfied when the field in `column` is in the closed range `[lower, upper]`.
+     * \copydetails equal
+     */
+    row_filter& between(std::size_t column, field_view lower, field_view upper)
+    {
+        // Copying values may throw, so both conditions are built before modifying *this
+        detail::filter_condition lower_cond{column, detail::filter_op::ge, field(lower)};
+        detail::filter_condition upper_cond{column, detail::filter_op::le, field(upper)};
+        conditions_.reserve(conditions_.size() + 2u);
+        conditions_.push_back(std::move(lower_cond));
+        conditions_.push_back(std::move(upper_cond));
+        return *this;
+    }
+
+    /**
+     * \brief Adds a condition satisfied when the field in `column` is `NULL`.
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    row_filter& is_null(std::size_t column) { return add(column, detail::filter_op::is_null, field_view()); }
+
+    /**
+     * \brief Adds a condition satisfied when the field in `column` is not `NULL`.
+     * \par Exception safety
+     * Strong guarantee. Memory allocations may throw.
+     */
+    row_filter& is_not_null(std::size_t column)
+    {
+        return add(column, detail::filter_op::is_not_null, field_view());
+    }
+
+    /**
+     * \brief Returns whether this filter has no conditions.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    bool empty() const noexcept { return conditions_.empty(); }
+
+    /**
+     * \brief Returns the number of conditions in this filter.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    std::size_t size() const noexcept { return conditions_.size(); }
+
+    /**
+     * \brief Removes all conditions, making this filter match all rows.
+     * \par Exception safety
+     * No-throw guarantee.
+     */
+    void clear() noexcept { conditions_.clear(); }
+
+    /**
+     * \brief Returns whether `r` satisfies all the conditions in this filter.
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Complexity
+     * Linear in the number of conditions.
+     */
+    BOOST_MYSQL_DECL
+    bool matches(row_view r) const noexcept;
+
+private:
+    std::vector<detail::filter_condition> conditions_;
+
+    row_filter& add(std::size_t column, detail::filter_op op, field_view value)
+    {
+        detail::filter_condition cond{column, op, field(value)};
+        conditions_.push_back(std::move(cond));
+        return *this;
+    }
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/row_filter.ipp>
+#endif
+
+#endif
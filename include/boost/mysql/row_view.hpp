@@ -12,6 +12,7 @@
 #include <boost/mysql/field_view.hpp>
 
 #include <boost/mysql/detail/access.hpp>
+#include <boost/mysql/detail/hash.hpp>
 
 #include <boost/throw_exception.hpp>
 
@@ -248,7 +249,43 @@ inline bool operator==(const row_view& lhs, const row_view& rhs) noexcept
  */
 inline bool operator!=(const row_view& lhs, const row_view& rhs) noexcept { return !(lhs == rhs); }
 
+/**
+ * \relates row_view
+ * \brief Computes a hash value for a `row_view`.
+ * \details
+ * Combines the hashes of all the fields, as computed by \ref hash_value(const field_view&),
+ * in order. The hash is consistent with \ref row_view::operator==. To hash a subset of a row's
+ * fields, use \ref hash_index::hash_key.
+ *
+ * \par Exception safety
+ * No-throw guarantee.
+ *
+ * \par Complexity
+ * Linear in `r.size()`.
+ */
+inline std::size_t hash_value(const row_view& r) noexcept
+{
+    std::size_t res = r.size();
+    for (const field_view& f : r)
+        res = detail::hash_combine(res, hash_value(f));
+    return res;
+}
+
 }  // namespace mysql
 }  // namespace boost
 
+namespace std {
+
+/// Allows using \ref boost::mysql::row_view as a key in unordered containers.
+template <>
+struct hash<::boost::mysql::row_view>
+{
+    std::size_t operator()(const ::boost::mysql::row_view& v) const noexcept
+    {
+        return ::boost::mysql::hash_value(v);
+    }
+};
+
+}  // namespace std
+
 #endif
@@ -229,6 +229,20 @@ public:
         return rows_view(impl_.fields().data(), impl_.fields().size(), num_columns_);
     }
 
+    /**
+     * \brief Returns the dynamic memory owned by this object, in bytes.
+     * \details
+     * Includes the storage for fields and strings, measured as allocated capacity.
+     * Doesn't include `sizeof(*this)`.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Complexity
+     * Constant.
+     */
+    std::size_t memory_usage() const noexcept { return impl_.memory_usage(); }
+
 private:
     detail::row_impl impl_;
     std::size_t num_columns_{};
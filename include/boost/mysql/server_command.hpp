@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_SERVER_COMMAND_HPP
+#define BOOST_MYSQL_SERVER_COMMAND_HPP
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/core/span.hpp>
+
+#include <cstdint>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief The type of a command sent by a client.
+ * \details
+ * See \ref server_command.
+ */
+enum class server_command_type
+{
+    /// `COM_QUIT`: the client is closing the connection. No response should be sent.
+    quit,
+
+    /// `COM_INIT_DB`: changes the current database. \ref server_command::text holds the database name.
+    init_db,
+
+    /// `COM_QUERY`: runs a text query. \ref server_command::text holds the query.
+    query,
+
+    /// `COM_PING`: checks that the server is alive. Should be answered with an OK packet.
+    ping,
+
+    /// `COM_RESET_CONNECTION`: resets the session state. Should be answered with an OK packet.
+    reset_connection,
+
+    /// `COM_STMT_PREPARE`: prepares a statement. \ref server_command::text holds the statement text.
+    stmt_prepare,
+
+    /**
+     * \brief `COM_STMT_EXECUTE`: executes a prepared statement.
+     * \details
+     * \ref server_command::statement_id holds the statement ID. Use \ref parse_statement_params
+     * to retrieve the parameters.
+     */
+    stmt_execute,
+
+    /**
+     * \brief `COM_STMT_CLOSE`: deallocates a prepared statement. No response should be sent.
+     * \details \ref server_command::statement_id holds the statement ID.
+     */
+    stmt_close,
+
+    /// Any other command. Inspect \ref server_command::payload to process it.
+    other,
+};
+
+/**
+ * \brief A command sent by a client, as read by \ref server_connection::read_command.
+ * \details
+ * This is a view type. It points into the connection's internal read buffer,
+ * and is valid until the next read operation is initiated on the connection.
+ */
+struct server_command
+{
+    /// The type of the command.
+    server_command_type type{server_command_type::other};
+
+    /// The query, statement text or database name, depending on \ref type. Empty otherwise.
+    string_view text;
+
+    /// The statement ID, for statement commands. Zero otherwise.
+    std::uint32_t statement_id{};
+
+    /// The entire message, starting with the command byte.
+    span<const std::uint8_t> payload;
+};
+
+/**
+ * \brief Decodes the parameters of a `COM_STMT_EXECUTE` command.
+ * \details
+ * The server is responsible for tracking the number of parameters of every statement
+ * it prepares. `output` should point to as many fields as the executed statement has parameters.
+ * On success, they're populated with the parameter values. String and blob fields point
+ * into the command's payload, and have the same lifetime.
+ * \n
+ * Parameter types must be included in the command. Boost.MySQL always includes them,
+ * but other clients may only send them the first time a statement is executed.
+ * Commands without them fail with \ref client_errc::protocol_value_error.
+ * Malformed commands also fail with \ref client_errc::protocol_value_error
+ * or \ref client_errc::incomplete_message.
+ *
+ * \par Preconditions
+ * `cmd.type == server_command_type::stmt_execute`
+ *
+ * \par Exception safety
+ * No-throw guarantee.
+ */
+BOOST_MYSQL_DECL
+error_code parse_statement_params(const server_command& cmd, span<field_view> output) noexcept;
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/server_command.ipp>
+#endif
+
+#endif
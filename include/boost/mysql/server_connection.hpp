@@ -0,0 +1,345 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_SERVER_CONNECTION_HPP
+#define BOOST_MYSQL_SERVER_CONNECTION_HPP
+
+#include <boost/mysql/buffer_params.hpp>
+#include <boost/mysql/diagnostics.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/rows_view.hpp>
+#include <boost/mysql/server_command.hpp>
+#include <boost/mysql/server_messages.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/any_stream_impl.hpp>
+#include <boost/mysql/detail/server_network_algorithms.hpp>
+#include <boost/mysql/detail/server_session_ptr.hpp>
+#include <boost/mysql/detail/throw_on_error_loc.hpp>
+
+#include <boost/core/span.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief The server side of a connection, to build proxies and stand-in servers.
+ * \details
+ * Implements the server side of the MySQL protocol over an already established `Stream`
+ * (e.g. a socket returned by an acceptor). A typical session:
+ * \n
+ *   - Call \ref handshake to send the server greeting and read the client's credentials.
+ *     Verify them with \ref login and \ref check_password, and answer with \ref add_ok or
+ *     \ref add_error.
+ *   - Call \ref read_command in a loop, answering every command (except
+ *     \ref server_command_type::quit and \ref server_command_type::stmt_close) with an OK packet,
+ *     an error or a resultset.
+ * \n
+ * The `add_xxx` functions serialize responses into an internal buffer, without performing I/O.
+ * They're sent when \ref flush is called, or before reading the next command.
+ * This allows batching many rows and responses in a single network write.
+ * \n
+ * Only `mysql_native_password` authentication is supported. Clients attempting to use
+ * other plugins are asked to switch to it. TLS and multi-resultset responses are not supported.
+ * \n
+ * Like \ref connection, this class is not thread-safe, and at most one async operation
+ * may be outstanding at a time.
+ */
+template <class Stream>
+class server_connection
+{
+    detail::server_session_ptr sess_;
+
+public:
+    /**
+     * \brief Initializing constructor.
+     * \details
+     * As part of the initialization, a `Stream` object is created
+     * by forwarding any passed in arguments to its constructor.
+     */
+    template <
+        class... Args,
+        class EnableIf = typename std::enable_if<std::is_constructible<Stream, Args...>::value>::type>
+    server_connection(Args&&... args) : server_connection(buffer_params(), std::forward<Args>(args)...)
+    {
+    }
+
+    /**
+     * \brief Initializing constructor with buffer parameters.
+     * \details
+     * As part of the initialization, a `Stream` object is created
+     * by forwarding any passed in arguments to its constructor.
+     * `buff_params` controls the size of the read buffer.
+     */
+    template <
+        class... Args,
+        class EnableIf = typename std::enable_if<std::is_constructible<Stream, Args...>::value>::type>
+    server_connection(const buffer_params& buff_params, Args&&... args)
+        : sess_(
+              buff_params.initial_read_size(),
+              std::unique_ptr<detail::any_stream>(new detail::any_stream_impl<Stream>(std::forward<Args>(args
+              )...))
+          )
+    {
+    }
+
+    /**
+     * \brief Move constructor.
+     */
+    server_connection(server_connection&& other) = default;
+
+    /**
+     * \brief Move assignment.
+     */
+    server_connection& operator=(server_connection&& rhs) = default;
+
+#ifndef BOOST_MYSQL_DOXYGEN
+    server_connection(const server_connection&) = delete;
+    server_connection& operator=(const server_connection&) = delete;
+#endif
+
+    /// The executor type associated to this object.
+    using executor_type = typename Stream::executor_type;
+
+    /// Retrieves the executor associated to this object.
+    executor_type get_executor() { return stream().get_executor(); }
+
+    /// The `Stream` type this connection is using.
+    using stream_type = Stream;
+
+    /// Retrieves the underlying Stream object.
+    Stream& stream() noexcept { return detail::cast<Stream>(sess_.stream()); }
+
+    /// \copydoc stream
+    const Stream& stream() const noexcept { return detail::cast<Stream>(sess_.stream()); }
+
+    /**
+     * \brief Performs the server side of the handshake.
+     * \details
+     * Sends the server greeting described by `params` and reads the client's login request.
+     * If the client requested an authentication plugin other than `mysql_native_password`,
+     * it's asked to switch to it. After this function completes successfully, use \ref login
+     * and \ref check_password to verify the credentials, and answer with \ref add_ok
+     * or \ref add_error.
+     * \n
+     * Fails with \ref client_errc::server_unsupported if the client doesn't support
+     * the minimum capabilities required by this class.
+     */
+    void handshake(const server_handshake_params& params, error_code& err)
+    {
+        detail::server_handshake_interface(sess_.get(), params, err);
+    }
+
+    /// \copydoc handshake(const server_handshake_params&,error_code&)
+    void handshake(const server_handshake_params& params = {})
+    {
+        error_code err;
+        handshake(params, err);
+        detail::throw_on_error_loc(err, diagnostics(), BOOST_CURRENT_LOCATION);
+    }
+
+    /**
+     * \copydoc handshake(const server_handshake_params&,error_code&)
+     * \details
+     * \n
+     * \par Object lifetimes
+     * params is copied by the initiating function.
+     *
+     * \par Handler signature
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(::boost::mysql::error_code))
+                  CompletionToken BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_handshake(
+        const server_handshake_params& params,
+        CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type)
+    )
+    {
+        return detail::async_server_handshake_interface(
+            sess_.get(),
+            params,
+            std::forward<CompletionToken>(token)
+        );
+    }
+
+    /**
+     * \brief Returns the credentials sent by the client during the handshake.
+     * \details
+     * The returned reference is valid until the next handshake.
+     */
+    const server_login& login() const noexcept { return sess_.login(); }
+
+    /**
+     * \brief Checks the password sent by the client.
+     * \details
+     * Returns `true` if the authentication response sent by the client during the handshake
+     * matches `password`. Passwords are not stored by the server, so credentials need to be
+     * provided by the user (e.g. from a configuration file).
+     */
+    bool check_password(string_view password) const { return sess_.check_password(password); }
+
+    /**
+     * \brief Reads the next command sent by the client.
+     * \details
+     * Any pending response is written before reading. The returned command points into
+     * the connection's internal buffers, and is valid until the next read is initiated.
+     * \n
+     * Fails with \ref client_errc::sequence_number_mismatch if the client didn't start
+     * a new command, and with \ref client_errc::incomplete_message or
+     * \ref client_errc::protocol_value_error for malformed commands.
+     */
+    server_command read_command(error_code& err)
+    {
+        return detail::server_read_command_interface(sess_.get(), err);
+    }
+
+    /// \copydoc read_command(error_code&)
+    server_command read_command()
+    {
+        error_code err;
+        auto res = read_command(err);
+        detail::throw_on_error_loc(err, diagnostics(), BOOST_CURRENT_LOCATION);
+        return res;
+    }
+
+    /**
+     * \copydoc read_command(error_code&)
+     * \details
+     * \par Handler signature
+     * The handler signature for this operation is
+     * `void(boost::mysql::error_code, boost::mysql::server_command)`.
+     */
+    template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(::boost::mysql::error_code, ::boost::mysql::server_command))
+                  CompletionToken BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code, server_command))
+    async_read_command(CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    {
+        return detail::async_server_read_command_interface(sess_.get(), std::forward<CompletionToken>(token));
+    }
+
+    /**
+     * \brief Adds an OK packet to the pending responses.
+     * \details
+     * Used to accept the client's credentials and to answer commands that don't
+     * return resultsets.
+     */
+    void add_ok(const server_ok& ok = {}) { sess_.add_ok(ok); }
+
+    /**
+     * \brief Adds an error packet to the pending responses.
+     * \details
+     * Clients report `code` as a server error, and `message` as the server diagnostics.
+     */
+    void add_error(std::uint16_t code, string_view message) { sess_.add_error(code, message); }
+
+    /**
+     * \brief Adds a response to a \ref server_command_type::stmt_prepare command.
+     * \details
+     * The server is responsible for choosing statement IDs and for tracking the number of
+     * parameters of every statement. `params` and `columns` describe the statement's
+     * parameters and the resultset it will produce.
+     *
+     * \par Preconditions
+     * `params.size() <= 0xffff && columns.size() <= 0xffff` (the protocol limit).
+     */
+    void add_prepare_ok(
+        std::uint32_t statement_id,
+        span<const server_column> params,
+        span<const server_column> columns
+    )
+    {
+        sess_.add_prepare_ok(statement_id, params, columns);
+    }
+
+    /**
+     * \brief Starts a resultset, adding its column definitions to the pending responses.
+     * \details
+     * Rows are encoded using the text protocol if the last command read was a
+     * \ref server_command_type::query, and the binary protocol if it was a
+     * \ref server_command_type::stmt_execute. Resultsets must be completed by
+     * \ref add_resultset_end. Commands that don't return rows should be answered
+     * with \ref add_ok instead.
+     *
+     * \par Preconditions
+     * `!columns.empty()`
+     */
+    void add_resultset_head(span<const server_column> columns) { sess_.add_resultset_head(columns); }
+
+    /**
+     * \brief Adds a row to the resultset being sent.
+     * \details
+     * Fields are encoded according to the column types passed to \ref add_resultset_head.
+     * Numbers may be sent to any numeric column, dates to `DATETIME` columns and the other way
+     * around, and any value to string-like columns, which receive its text representation.
+     * `DATETIME` and `TIME` values are truncated to the column's decimals.
+     *
+     * \par Preconditions
+     * A resultset has been started with \ref add_resultset_head, and `fields.size()` matches
+     * its number of columns. Field kinds are compatible with their columns. Floating point values
+     * are not NaN or infinities.
+     */
+    void add_row(span<const field_view> fields) { sess_.add_row(fields); }
+
+    /**
+     * \brief Adds several rows to the resultset being sent.
+     * \details
+     * Equivalent to calling \ref add_row for every row in `rows`.
+     */
+    void add_rows(rows_view rows) { sess_.add_rows(rows); }
+
+    /**
+     * \brief Completes the resultset being sent.
+     */
+    void add_resultset_end(const server_ok& ok = {}) { sess_.add_resultset_end(ok); }
+
+    /**
+     * \brief Returns the number of bytes serialized by `add_xxx` functions but not written yet.
+     */
+    std::size_t pending_bytes() const noexcept { return sess_.pending_bytes(); }
+
+    /**
+     * \brief Writes any pending responses.
+     * \details
+     * Call this function to control batching. It's implicitly called by \ref read_command.
+     */
+    void flush(error_code& err) { detail::server_flush_interface(sess_.get(), err); }
+
+    /// \copydoc flush(error_code&)
+    void flush()
+    {
+        error_code err;
+        flush(err);
+        detail::throw_on_error_loc(err, diagnostics(), BOOST_CURRENT_LOCATION);
+    }
+
+    /**
+     * \copydoc flush(error_code&)
+     * \details
+     * \par Handler signature
+     * The handler signature for this operation is `void(boost::mysql::error_code)`.
+     */
+    template <BOOST_ASIO_COMPLETION_TOKEN_FOR(void(::boost::mysql::error_code))
+                  CompletionToken BOOST_ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+    BOOST_ASIO_INITFN_AUTO_RESULT_TYPE(CompletionToken, void(error_code))
+    async_flush(CompletionToken&& token BOOST_ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+    {
+        return detail::async_server_flush_interface(sess_.get(), std::forward<CompletionToken>(token));
+    }
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#endif
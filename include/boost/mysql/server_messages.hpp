@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_SERVER_MESSAGES_HPP
+#define BOOST_MYSQL_SERVER_MESSAGES_HPP
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/mysql_collations.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief Describes a column of a resultset or a statement parameter sent by a \ref server_connection.
+ * \details
+ * Clients compute the column's \ref metadata from these values.
+ * String members are only used during the call they're passed to.
+ */
+struct server_column
+{
+    /// The column name.
+    string_view name;
+
+    /// The column type. Determines how fields are encoded in binary resultsets.
+    column_type type{column_type::varchar};
+
+    /// Whether the column is `UNSIGNED`. Only relevant for integer types.
+    bool is_unsigned{false};
+
+    /**
+     * \brief The number of decimals.
+     * \details
+     * For `TIME`, `DATETIME` and `TIMESTAMP` columns, the number of fractional second digits (0 to 6)
+     * sent in text resultsets. For `DECIMAL`, `FLOAT` and `DOUBLE`, the number of decimals
+     * reported to the client.
+     */
+    std::uint8_t decimals{};
+
+    /**
+     * \brief The collation of the column.
+     * \details
+     * Only used for `CHAR`, `VARCHAR`, `TEXT`, `ENUM`, `SET`, `DECIMAL` and `JSON` columns.
+     * Binary types always use the binary collation, as this is how clients tell
+     * `BLOB` from `TEXT` columns.
+     */
+    std::uint16_t collation{mysql_collations::utf8mb4_general_ci};
+
+    /// The maximum length of the column, as reported by \ref metadata::column_length.
+    std::uint32_t column_length{};
+
+    /// The database the column belongs to.
+    string_view database;
+
+    /// The table the column belongs to.
+    string_view table;
+};
+
+/**
+ * \brief The contents of an OK packet sent by a \ref server_connection.
+ * \details
+ * Clients expose these values in \ref results and \ref execution_state.
+ */
+struct server_ok
+{
+    /// The number of rows affected by the operation.
+    std::uint64_t affected_rows{};
+
+    /// The last ID generated by an `AUTO_INCREMENT` column.
+    std::uint64_t last_insert_id{};
+
+    /// The number of warnings generated by the operation.
+    std::uint16_t warnings{};
+
+    /// Additional information about the operation. Must be valid during the call it's passed to.
+    string_view info;
+};
+
+/**
+ * \brief Options for \ref server_connection::handshake.
+ */
+struct server_handshake_params
+{
+    /**
+     * \brief The server version reported to clients.
+     * \details
+     * Clients use it to tell MySQL from MariaDB: it should contain `MariaDB` to emulate the latter.
+     * Must be valid until the handshake operation completes.
+     */
+    string_view server_version{"8.0.33-boost-mysql"};
+
+    /// The connection ID reported to clients.
+    std::uint32_t connection_id{};
+
+    /// The server's default collation, reported to clients.
+    std::uint16_t collation{mysql_collations::utf8mb4_general_ci};
+};
+
+/**
+ * \brief The login information sent by a client during the handshake.
+ * \details
+ * Obtained by calling \ref server_connection::login after a successful handshake.
+ */
+struct server_login
+{
+    /// The user name.
+    std::string username;
+
+    /// The database the client wants to use, or an empty string if none was specified.
+    std::string database;
+
+    /**
+     * \brief The authentication plugin that computed \ref auth_response.
+     * \details
+     * Always `mysql_native_password`: clients using other plugins are asked
+     * to switch during the handshake.
+     */
+    std::string auth_plugin_name;
+
+    /// The authentication response computed by the client from its password and the server challenge.
+    std::vector<std::uint8_t> auth_response;
+
+    /// The collation requested by the client.
+    std::uint16_t collation{};
+};
+
+}  // namespace mysql
+}  // namespace boost
+
+#endif
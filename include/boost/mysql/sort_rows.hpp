@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_SORT_ROWS_HPP
+#define BOOST_MYSQL_SORT_ROWS_HPP
+
+#include <boost/mysql/metadata_collection_view.hpp>
+#include <boost/mysql/rows.hpp>
+#include <boost/mysql/rows_view.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/core/span.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/// The direction in which a column is sorted by \ref sort_rows.
+enum class sort_order
+{
+    /// Smaller values first. `NULL` values go before any other value.
+    ascending,
+
+    /// Bigger values first. `NULL` values go after any other value.
+    descending,
+};
+
+/**
+ * \brief A column to sort by, as used by \ref sort_rows.
+ */
+struct sort_column
+{
+    /// The zero-based position of the column, as it appears in the rows being sorted.
+    std::size_t index;
+
+    /// The sort direction.
+    sort_order order;
+
+    /// Constructor.
+    constexpr sort_column(std::size_t index, sort_order order = sort_order::ascending) noexcept
+        : index(index), order(order)
+    {
+    }
+};
+
+/**
+ * \brief Computes the order in which rows should be placed to be sorted by the given columns.
+ * \details
+ * Returns a vector `v` with `rows.size()` elements, such that `rows[v[0]]`, `rows[v[1]]`, ...
+ * are sorted by `columns`. The first element in `columns` is the primary sort key, the second one
+ * is used to break ties, and so on. The sort is stable: rows comparing equal keep their
+ * relative order.
+ * \n
+ * For every row, the fields in the sort columns are encoded into a byte sequence that can be
+ * compared using `memcmp`. Row positions are then sorted using a most-significant-digit
+ * radix sort on these keys. This avoids the per-comparison type dispatch performed by
+ * \ref field_view comparisons, and is much faster than `std::sort` for large or
+ * multi-column sorts.
+ * \n
+ * `meta` is used to order values like the server would:
+ * \n
+ *   - `DECIMAL` values (which are represented as strings) are sorted numerically.
+ *   - `CHAR`, `VARCHAR`, `TEXT`, `ENUM` and `SET` values using case-insensitive collations
+ *     (like `utf8mb4_general_ci`) are compared ignoring ASCII letter case. Binary and case-sensitive
+ *     collations (like `utf8mb4_bin`) compare byte by byte. Other collation rules
+ *     (like accent or trailing space insensitivity) are not taken into account.
+ *   - Values of other types are sorted by value. Blobs compare byte by byte.
+ * \n
+ * `meta` may be empty, in which case strings are compared byte by byte.
+ *
+ * \par Preconditions
+ * `meta.empty() || meta.size() == rows.num_columns()`. Every element in `columns` has an `index`
+ * less than `rows.num_columns()` (unless `rows` is empty). Fields in a column have the same kind,
+ * or are `NULL`.
+ *
+ * \par Exception safety
+ * Basic guarantee. Memory allocations may throw.
+ *
+ * \par Complexity
+ * Linear in the total size of the sort keys, plus `O(n log n)` for small groups of rows
+ * sharing a key prefix.
+ */
+BOOST_MYSQL_DECL
+std::vector<std::size_t> sort_permutation(
+    rows_view rows,
+    metadata_collection_view meta,
+    span<const sort_column> columns
+);
+
+/// \copydoc sort_permutation(rows_view,metadata_collection_view,span<const sort_column>)
+inline std::vector<std::size_t> sort_permutation(
+    rows_view rows,
+    metadata_collection_view meta,
+    std::initializer_list<sort_column> columns
+)
+{
+    return sort_permutation(rows, meta, span<const sort_column>(columns.begin(), columns.size()));
+}
+
+/**
+ * \brief Returns a sorted copy of `rows`.
+ * \details
+ * Rows are sorted as described in \ref sort_permutation. Strings and blobs are copied
+ * into the returned object, so it doesn't depend on `rows`.
+ *
+ * \par Preconditions
+ * The same as \ref sort_permutation.
+ *
+ * \par Exception safety
+ * Basic guarantee. Memory allocations may throw.
+ */
+BOOST_MYSQL_DECL
+rows sort_rows(rows_view rows, metadata_collection_view meta, span<const sort_column> columns);
+
+/// \copydoc sort_rows(rows_view,metadata_collection_view,span<const sort_column>)
+inline rows sort_rows(rows_view rows, metadata_collection_view meta, std::initializer_list<sort_column> columns)
+{
+    return sort_rows(rows, meta, span<const sort_column>(columns.begin(), columns.size()));
+}
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/sort_rows.ipp>
+#endif
+
+#endif
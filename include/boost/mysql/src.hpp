@@ -19,8 +19,10 @@
 #endif
 
 #include <boost/mysql/impl/any_stream_impl.ipp>
+#include <boost/mysql/impl/auth_plugin_cache.ipp>
 #include <boost/mysql/impl/channel_ptr.ipp>
 #include <boost/mysql/impl/column_type.ipp>
+#include <boost/mysql/impl/connection_handoff.ipp>
 #include <boost/mysql/impl/date.ipp>
 #include <boost/mysql/impl/datetime.ipp>
 #include <boost/mysql/impl/error_categories.ipp>
@@ -28,6 +30,8 @@
 #include <boost/mysql/impl/field.ipp>
 #include <boost/mysql/impl/field_kind.ipp>
 #include <boost/mysql/impl/field_view.ipp>
+#include <boost/mysql/impl/hash_index.ipp>
+#include <boost/mysql/impl/histogram.ipp>
 #include <boost/mysql/impl/internal/auth/auth.ipp>
 #include <boost/mysql/impl/internal/channel/message_parser.ipp>
 #include <boost/mysql/impl/internal/error/server_error_to_string.ipp>
@@ -36,12 +40,26 @@
 #include <boost/mysql/impl/internal/protocol/deserialize_text_field.ipp>
 #include <boost/mysql/impl/internal/protocol/protocol.ipp>
 #include <boost/mysql/impl/internal/protocol/protocol_field_type.ipp>
+#include <boost/mysql/impl/internal/protocol/server_protocol.ipp>
 #include <boost/mysql/impl/meta_check_context.ipp>
+#include <boost/mysql/impl/metrics.ipp>
 #include <boost/mysql/impl/network_algorithms.ipp>
+#include <boost/mysql/impl/normalize_query.ipp>
+#include <boost/mysql/impl/protocol_trace.ipp>
+#include <boost/mysql/impl/query_digest.ipp>
+#include <boost/mysql/impl/replay_stream.ipp>
+#include <boost/mysql/impl/request_scheduler.ipp>
 #include <boost/mysql/impl/results_impl.ipp>
 #include <boost/mysql/impl/resultset.ipp>
+#include <boost/mysql/impl/resultset_diff.ipp>
+#include <boost/mysql/impl/row_filter.ipp>
 #include <boost/mysql/impl/row_impl.ipp>
+#include <boost/mysql/impl/server_command.ipp>
+#include <boost/mysql/impl/server_network_algorithms.ipp>
+#include <boost/mysql/impl/server_session_ptr.ipp>
+#include <boost/mysql/impl/sort_rows.ipp>
 #include <boost/mysql/impl/static_execution_state_impl.ipp>
 #include <boost/mysql/impl/static_results_impl.ipp>
+#include <boost/mysql/impl/wire_capture.ipp>
 
 #endif
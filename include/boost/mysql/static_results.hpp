@@ -281,6 +281,21 @@ public:
         return impl_.get_interface().get_info(I);
     }
 
+    /**
+     * \brief Returns the dynamic memory owned by this object, in bytes.
+     * \details
+     * Includes the storage for the row vectors, metadata and info strings, measured as allocated
+     * capacity. Memory owned by the `StaticRow` objects themselves (e.g. by `std::string` members)
+     * is not included. Doesn't include `sizeof(*this)`.
+     *
+     * \par Exception safety
+     * No-throw guarantee.
+     *
+     * \par Complexity
+     * Linear on the number of columns.
+     */
+    std::size_t memory_usage() const noexcept { return impl_.memory_usage(); }
+
 private:
     detail::static_results_impl<StaticRow...> impl_;
 #ifndef BOOST_MYSQL_DOXYGEN
@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_WIRE_CAPTURE_HPP
+#define BOOST_MYSQL_WIRE_CAPTURE_HPP
+
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/protocol_trace.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace boost {
+namespace mysql {
+
+/**
+ * \brief A read or write recorded by a wire capture.
+ * \details
+ * See \ref connection::start_wire_capture. Each record holds the bytes transferred by a single
+ * successful read or write on the underlying stream, so messages may span several records
+ * and a record may contain several messages.
+ */
+struct wire_capture_record
+{
+    /// Whether the bytes were received from or sent to the server.
+    trace_direction direction;
+
+    /// When the read or write completed, relative to the start of the capture.
+    std::chrono::nanoseconds timestamp;
+
+    /// The bytes transferred.
+    std::vector<std::uint8_t> data;
+};
+
+/**
+ * \brief Reads a wire capture, as written by \ref connection::start_wire_capture.
+ * \details
+ * Reads from `input` until its end. If the capture header is invalid,
+ * fails with \ref client_errc::protocol_value_error. If `input` ends in the middle of a record,
+ * fails with \ref client_errc::incomplete_message. A capture with no records is valid.
+ *
+ * \par Exception safety
+ * Basic guarantee. Memory allocations may throw. Reading from `input` may throw,
+ * depending on its exception mask.
+ */
+BOOST_MYSQL_DECL
+std::vector<wire_capture_record> read_wire_capture(std::istream& input, error_code& ec);
+
+/**
+ * \brief Reads a wire capture, as written by \ref connection::start_wire_capture.
+ * \details
+ * Like the overload taking an \ref error_code, but throws on error.
+ *
+ * \par Exception safety
+ * Basic guarantee. Throws \ref error_with_diagnostics if the capture is invalid.
+ * Memory allocations may throw.
+ */
+BOOST_MYSQL_DECL
+std::vector<wire_capture_record> read_wire_capture(std::istream& input);
+
+}  // namespace mysql
+}  // namespace boost
+
+#ifdef BOOST_MYSQL_HEADER_ONLY
+#include <boost/mysql/impl/wire_capture.ipp>
+#endif
+
+#endif
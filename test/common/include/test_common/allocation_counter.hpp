@@ -0,0 +1,43 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_MYSQL_TEST_COMMON_INCLUDE_TEST_COMMON_ALLOCATION_COUNTER_HPP
+#define BOOST_MYSQL_TEST_COMMON_INCLUDE_TEST_COMMON_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Allocation counting, used by the unit tests and the benchmarks.
+// Works by replacing the global operator new (see src/allocation_counter.cpp),
+// so that file must be linked into the executables using these functions.
+
+namespace boost {
+namespace mysql {
+namespace test {
+
+// Counts the calls to the global operator new performed by the current thread
+// while the object is alive. Counters can't be nested.
+class allocation_counter
+{
+public:
+    allocation_counter() noexcept;
+    allocation_counter(const allocation_counter&) = delete;
+    allocation_counter& operator=(const allocation_counter&) = delete;
+    ~allocation_counter();
+
+    std::size_t count() const noexcept;
+};
+
+// Returns the number of calls to the global operator new performed by any thread
+// since the program started
+std::uint64_t total_allocations() noexcept;
+
+}  // namespace test
+}  // namespace mysql
+}  // namespace boost
+
+#endif
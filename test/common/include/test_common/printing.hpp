@@ -13,6 +13,8 @@
 #include <boost/mysql/diagnostics.hpp>
 #include <boost/mysql/field_view.hpp>
 #include <boost/mysql/metadata_mode.hpp>
+#include <boost/mysql/operation_observer.hpp>
+#include <boost/mysql/protocol_trace.hpp>
 #include <boost/mysql/row.hpp>
 #include <boost/mysql/row_view.hpp>
 
@@ -64,6 +66,35 @@ inline std::ostream& operator<<(std::ostream& os, metadata_mode v)
     }
 }
 
+inline std::ostream& operator<<(std::ostream& os, operation_type v)
+{
+    switch (v)
+    {
+    case operation_type::connect: return os << "connect";
+    case operation_type::handshake: return os << "handshake";
+    case operation_type::execute: return os << "execute";
+    case operation_type::start_execution: return os << "start_execution";
+    case operation_type::read_resultset_head: return os << "read_resultset_head";
+    case operation_type::read_some_rows: return os << "read_some_rows";
+    case operation_type::prepare_statement: return os << "prepare_statement";
+    case operation_type::close_statement: return os << "close_statement";
+    case operation_type::ping: return os << "ping";
+    case operation_type::close: return os << "close";
+    case operation_type::quit: return os << "quit";
+    default: return os << "<unknown operation_type>";
+    }
+}
+
+inline std::ostream& operator<<(std::ostream& os, trace_direction v)
+{
+    switch (v)
+    {
+    case trace_direction::read: return os << "read";
+    case trace_direction::write: return os << "write";
+    default: return os << "<unknown trace_direction>";
+    }
+}
+
 }  // namespace mysql
 }  // namespace boost
 
@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "test_common/allocation_counter.hpp"
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local bool counting_enabled = false;
+thread_local std::size_t num_allocations = 0;
+std::atomic<std::uint64_t> num_total_allocations{0};
+
+}  // namespace
+
+boost::mysql::test::allocation_counter::allocation_counter() noexcept
+{
+    BOOST_ASSERT(!counting_enabled);
+    num_allocations = 0;
+    counting_enabled = true;
+}
+
+boost::mysql::test::allocation_counter::~allocation_counter() { counting_enabled = false; }
+
+std::size_t boost::mysql::test::allocation_counter::count() const noexcept { return num_allocations; }
+
+std::uint64_t boost::mysql::test::total_allocations() noexcept
+{
+    return num_total_allocations.load(std::memory_order_relaxed);
+}
+
+// Replacements for the global allocation functions. The array and nothrow
+// versions call these by default.
+void* operator new(std::size_t size)
+{
+    num_total_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (counting_enabled)
+        ++num_allocations;
+    void* res = std::malloc(size ? size : 1u);
+    if (!res)
+        throw std::bad_alloc();
+    return res;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
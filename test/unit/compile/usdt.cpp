@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compile-only check for USDT tracepoints. Builds the library with probes enabled,
+// if <sys/sdt.h> is available. Otherwise, checks that disabled probes compile.
+
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>) && !defined(BOOST_MYSQL_ENABLE_USDT)
+#define BOOST_MYSQL_ENABLE_USDT
+#endif
+#endif
+
+#ifndef BOOST_MYSQL_SEPARATE_COMPILATION
+#define BOOST_MYSQL_SEPARATE_COMPILATION
+#endif
+
+#include <boost/mysql.hpp>
+
+#include <boost/mysql/impl/internal/usdt.hpp>
+
+#include <boost/mysql/src.hpp>
+
+#include <boost/core/ignore_unused.hpp>
+
+#include <cstddef>
+
+// Defining _SDT_HAS_SEMAPHORES is an implementation detail of the probes
+#ifdef _SDT_HAS_SEMAPHORES
+#error "_SDT_HAS_SEMAPHORES leaked from Boost.MySQL headers"
+#endif
+
+// Use every probe arity, in case the library doesn't instantiate all of them
+static void emit_probes(const char* str, std::size_t size, int value)
+{
+    // Probe arguments are unused when probes are disabled
+    boost::ignore_unused(str, size, value);
+    BOOST_MYSQL_USDT0(handshake_tls_start);
+    BOOST_MYSQL_USDT1(handshake_auth_more_data, size);
+    BOOST_MYSQL_USDT2(handshake_auth_switch, str, size);
+    BOOST_MYSQL_USDT3(handshake_hello, str, size, value);
+    BOOST_MYSQL_USDT4(operation_start, value, str, size, value);
+    BOOST_MYSQL_USDT6(operation_finish, value, value, size, size, size, size);
+    if (BOOST_MYSQL_USDT_ENABLED(message_read))
+        BOOST_MYSQL_USDT3(message_read, size, value, value);
+}
+
+int main()
+{
+    emit_probes("abc", 3u, 0);
+    return 0;
+}
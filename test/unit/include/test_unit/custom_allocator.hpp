@@ -8,13 +8,15 @@
 #ifndef BOOST_MYSQL_TEST_UNIT_INCLUDE_TEST_UNIT_CUSTOM_ALLOCATOR_HPP
 #define BOOST_MYSQL_TEST_UNIT_INCLUDE_TEST_UNIT_CUSTOM_ALLOCATOR_HPP
 
-// This is used for concept checks. Not implemented anywhere.
 #include <cstddef>
+#include <cstdlib>
+#include <new>
 
 namespace boost {
 namespace mysql {
 namespace test {
 
+// This is used for concept checks. Not implemented anywhere.
 template <class T>
 struct custom_allocator
 {
@@ -38,6 +40,46 @@ constexpr bool operator==(const custom_allocator<T>&, const custom_allocator<U>&
 template <class T, class U>
 constexpr bool operator!=(const custom_allocator<T>&, const custom_allocator<U>&) noexcept;
 
+// A working allocator that counts the allocations it performs into an external counter.
+// Uses malloc, so its allocations are not seen by allocation_counter.
+template <class T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    std::size_t* num_allocations;
+
+    explicit counting_allocator(std::size_t* num_allocations) noexcept : num_allocations(num_allocations) {}
+
+    template <class U>
+    counting_allocator(const counting_allocator<U>& rhs) noexcept : num_allocations(rhs.num_allocations)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        ++*num_allocations;
+        void* res = std::malloc(n * sizeof(T));
+        if (!res)
+            throw std::bad_alloc();
+        return static_cast<T*>(res);
+    }
+
+    void deallocate(T* p, std::size_t) noexcept { std::free(p); }
+};
+
+template <class T, class U>
+bool operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept
+{
+    return lhs.num_allocations == rhs.num_allocations;
+}
+
+template <class T, class U>
+bool operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
 }  // namespace test
 }  // namespace mysql
 }  // namespace boost
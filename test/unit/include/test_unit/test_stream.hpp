@@ -56,6 +56,21 @@ public:
         return *this;
     }
 
+    // Makes get_executor() return the io_context's executor directly, rather than
+    // a tracking executor. Tracking executors allocate every time they're created
+    test_stream& disable_executor_tracking() noexcept
+    {
+        track_executor_ = false;
+        return *this;
+    }
+
+    // Makes writes not allocate until size bytes have been written
+    test_stream& reserve_bytes_written(std::size_t size)
+    {
+        bytes_written_.reserve(size);
+        return *this;
+    }
+
     // Getting test results
     std::size_t num_bytes_read() const noexcept { return num_bytes_read_; }
     std::size_t num_unread_bytes() const noexcept { return bytes_to_read_.size() - num_bytes_read_; }
@@ -81,6 +96,7 @@ private:
     fail_count fail_count_;
     std::size_t write_break_size_{1024};  // max number of bytes to be written in each write_some
     executor_info executor_info_{};
+    bool track_executor_{true};
 
     std::size_t get_size_to_read(std::size_t buffer_size) const;
     std::size_t do_read(asio::mutable_buffer buff, error_code& ec);
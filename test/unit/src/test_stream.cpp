@@ -142,6 +142,8 @@ struct boost::mysql::test::test_stream::write_op : boost::asio::coroutine
 
 boost::mysql::test::test_stream::executor_type boost::mysql::test::test_stream::get_executor()
 {
+    if (!track_executor_)
+        return ctx.get_executor();
     return create_tracker_executor(ctx.get_executor(), &executor_info_);
 }
 
@@ -0,0 +1,616 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/diagnostics.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/execution_state.hpp>
+#include <boost/mysql/results.hpp>
+#include <boost/mysql/statement.hpp>
+#include <boost/mysql/static_execution_state.hpp>
+#include <boost/mysql/static_results.hpp>
+#include <boost/mysql/throw_on_error.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/core/span.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "test_common/allocation_counter.hpp"
+#include "test_common/buffer_concat.hpp"
+#include "test_common/netfun_helpers.hpp"
+#include "test_unit/create_coldef_frame.hpp"
+#include "test_unit/create_frame.hpp"
+#include "test_unit/create_meta.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/create_row_message.hpp"
+#include "test_unit/create_statement.hpp"
+#include "test_unit/custom_allocator.hpp"
+#include "test_unit/run_coroutine.hpp"
+#include "test_unit/test_stream.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+// Verifies the number of allocations performed by each operation once it reaches
+// steady state (i.e. buffers have grown to fit the messages involved).
+// Sync operations that reuse their output objects should not allocate at all.
+//
+// Async operations are pinned to an exact number of allocations per operation.
+// The stream uses the io_context's executor directly, so all allocations come from
+// the library and Asio. For every async operation, these are:
+//   - Type-erasing the final handler (any_completion_handler).
+//   - For each network read and write, type-erasing the intermediate handler passed to the stream,
+//     plus the handler memory that Asio's recycling allocator can't serve from its per-thread cache
+//     because several operations are in flight at the same time.
+// Counts depend on the Asio version, so they may need to be adjusted when upgrading Boost.
+//
+// The tokens covered are plain callbacks (with and without diagnostics), callbacks
+// with an associated allocator, use_future and, when the compiler supports coroutines,
+// use_awaitable. Tokens that adapt the handler through async_result add their own allocations
+// on top of the callback ones, so they are pinned separately:
+//   - use_future allocates the future's shared state, among others.
+//   - use_awaitable allocates coroutine frames. The count includes spawning the coroutine
+//     that runs the operation, which uses use_future itself.
+
+BOOST_AUTO_TEST_SUITE(test_allocations)
+
+using test_connection = connection<test_stream>;
+
+// Number of times each operation is run before measuring
+constexpr std::size_t num_warmup_runs = 3;
+
+enum class token_kind
+{
+    sync_errc,
+    sync_exc,
+    async_errinfo,
+    async_noerrinfo,
+    async_allocator,
+    async_future,
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    async_awaitable,
+#endif
+};
+
+const char* to_string(token_kind v) noexcept
+{
+    switch (v)
+    {
+    case token_kind::sync_errc: return "sync_errc";
+    case token_kind::sync_exc: return "sync_exc";
+    case token_kind::async_errinfo: return "async_errinfo";
+    case token_kind::async_noerrinfo: return "async_noerrinfo";
+    case token_kind::async_allocator: return "async_allocator";
+    case token_kind::async_future: return "async_future";
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    case token_kind::async_awaitable: return "async_awaitable";
+#endif
+    default: return "<unknown token_kind>";
+    }
+}
+
+constexpr token_kind all_tokens[] = {
+    token_kind::sync_errc,
+    token_kind::sync_exc,
+    token_kind::async_errinfo,
+    token_kind::async_noerrinfo,
+    token_kind::async_allocator,
+    token_kind::async_future,
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    token_kind::async_awaitable,
+#endif
+};
+
+bool is_async(token_kind v) noexcept { return v != token_kind::sync_errc && v != token_kind::sync_exc; }
+
+// Stores the operation's error code, ignoring any other argument
+struct callback_handler
+{
+    error_code* output;
+
+    template <class... Args>
+    void operator()(error_code ec, Args&&...) const
+    {
+        *output = ec;
+    }
+};
+
+// Like callback_handler, but with an associated allocator
+struct allocator_handler : callback_handler
+{
+    std::size_t* num_allocations;
+
+    using allocator_type = counting_allocator<void>;
+    allocator_type get_allocator() const noexcept { return allocator_type(num_allocations); }
+};
+
+// The number of allocations performed by a run of an operation
+struct allocation_result
+{
+    std::size_t global;             // by the global operator new
+    std::size_t handler_allocator;  // by the handler's associated allocator
+};
+
+// The number of allocations expected for each async run of an operation
+struct expected_allocations
+{
+    std::size_t callback;   // plain callbacks, or through the handler's allocator
+    std::size_t future;     // use_future
+    std::size_t awaitable;  // use_awaitable
+
+    std::size_t get(token_kind token) const noexcept
+    {
+        switch (token)
+        {
+        case token_kind::sync_errc:
+        case token_kind::sync_exc: return 0u;
+        case token_kind::async_future: return future;
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+        case token_kind::async_awaitable: return awaitable;
+#endif
+        default: return callback;
+        }
+    }
+};
+
+// Runs the operation represented by Op with the given token kind.
+// Op should have the member functions sync_errc, sync_exc, async_errinfo and async_noerrinfo.
+// When coroutines are supported, it should also have async_awaitable
+template <class Op>
+void run_op(Op& op, test_connection& conn, token_kind token, std::size_t* handler_allocations)
+{
+    error_code ec;
+    diagnostics diag;
+    switch (token)
+    {
+    case token_kind::sync_errc: op.sync_errc(conn, ec, diag); break;
+    case token_kind::sync_exc: op.sync_exc(conn); break;
+    case token_kind::async_errinfo: op.async_errinfo(conn, diag, callback_handler{&ec}); break;
+    case token_kind::async_noerrinfo: op.async_noerrinfo(conn, callback_handler{&ec}); break;
+    case token_kind::async_allocator:
+    {
+        allocator_handler handler;
+        handler.output = &ec;
+        handler.num_allocations = handler_allocations;
+        op.async_errinfo(conn, diag, handler);
+        break;
+    }
+    case token_kind::async_future:
+        // The packaged form of use_future lets us retrieve the error code
+        op.async_errinfo(conn, diag, boost::asio::use_future(callback_handler{&ec}));
+        break;
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    case token_kind::async_awaitable:
+        // Errors are reported as exceptions, which run_coroutine rethrows
+        run_coroutine(conn.get_executor(), [&]() { return op.async_awaitable(conn, diag); });
+        return;
+#endif
+    }
+    if (is_async(token))
+        run_until_completion(conn.get_executor());
+    throw_on_error(ec, diag);
+}
+
+template <class Op>
+allocation_result measure_run(Op& op, test_connection& conn, token_kind token)
+{
+    allocation_result res{};
+    allocation_counter counter;
+    run_op(op, conn, token, &res.handler_allocator);
+    res.global = counter.count();
+    return res;
+}
+
+// Runs the operation num_warmup_runs times, then measures two more runs.
+// The stream is fed with response for every run. expected contains the number of
+// allocations performed by each async run, either globally or through the handler's allocator
+template <class Op>
+void check_op(
+    Op op,
+    token_kind token,
+    const std::vector<std::uint8_t>& response,
+    const expected_allocations& expected
+)
+{
+    test_connection conn;
+    conn.stream().disable_executor_tracking();
+    for (std::size_t i = 0; i < num_warmup_runs + 2; ++i)
+        conn.stream().add_bytes(response);
+    conn.stream().reserve_bytes_written(4096);
+
+    std::size_t handler_allocations = 0;
+    for (std::size_t i = 0; i < num_warmup_runs; ++i)
+        run_op(op, conn, token, &handler_allocations);
+
+    auto first = measure_run(op, conn, token);
+    auto second = measure_run(op, conn, token);
+    BOOST_TEST(conn.stream().num_unread_bytes() == 0u);
+    BOOST_TEST_MESSAGE(
+        to_string(token) << ": global=" << second.global << " handler_allocator=" << second.handler_allocator
+    );
+
+    BOOST_TEST(first.global + first.handler_allocator == expected.get(token));
+    BOOST_TEST(second.global + second.handler_allocator == expected.get(token));
+}
+
+template <class Op>
+void check_op(const Op& op, const std::vector<std::uint8_t>& response, const expected_allocations& expected)
+{
+    for (auto token : all_tokens)
+    {
+        BOOST_TEST_CONTEXT(to_string(token)) { check_op(op, token, response, expected); }
+    }
+}
+
+// Responses
+std::vector<std::uint8_t> text_resultset_response()
+{
+    std::vector<std::uint8_t> res;
+    concat(res, create_frame(1, {0x02}));
+    concat(
+        res,
+        create_coldef_frame(2, meta_builder().type(column_type::bigint).nullable(false).build_coldef())
+    );
+    concat(res, create_coldef_frame(3, meta_builder().type(column_type::varchar).build_coldef()));
+    concat(res, create_text_row_message(4, 42, "abc"));
+    concat(res, create_text_row_message(5, 43, "a longer string value, which will need a heap allocation"));
+    concat(res, create_eof_frame(6, ok_builder().affected_rows(2).info("some info").build()));
+    return res;
+}
+
+std::vector<std::uint8_t> binary_resultset_response()
+{
+    std::vector<std::uint8_t> res;
+    concat(res, create_frame(1, {0x01}));
+    concat(
+        res,
+        create_coldef_frame(2, meta_builder().type(column_type::bigint).nullable(false).build_coldef())
+    );
+    concat(res, create_frame(3, {0x00, 0x00, 0x2a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+    concat(res, create_frame(4, {0x00, 0x00, 0x2b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+    concat(res, create_eof_frame(5, ok_builder().build()));
+    return res;
+}
+
+std::vector<std::uint8_t> prepare_statement_response()
+{
+    // COM_STMT_PREPARE_OK: statement ID 1, 1 column, 1 param, then the param and column definitions
+    std::vector<std::uint8_t> res;
+    concat(res, create_frame(1, {0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00}));
+    concat(res, create_coldef_frame(2, meta_builder().type(column_type::bigint).build_coldef()));
+    concat(res, create_coldef_frame(3, meta_builder().type(column_type::bigint).build_coldef()));
+    return res;
+}
+
+// Operations
+struct execute_query_op
+{
+    results* result;
+
+    void sync_errc(test_connection& conn, error_code& ec, diagnostics& diag)
+    {
+        conn.execute("SELECT 1", *result, ec, diag);
+    }
+    void sync_exc(test_connection& conn) { conn.execute("SELECT 1", *result); }
+    template <class Handler>
+    void async_errinfo(test_connection& conn, diagnostics& diag, Handler h)
+    {
+        conn.async_execute("SELECT 1", *result, diag, std::move(h));
+    }
+    template <class Handler>
+    void async_noerrinfo(test_connection& conn, Handler h)
+    {
+        conn.async_execute("SELECT 1", *result, std::move(h));
+    }
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    boost::asio::awaitable<void> async_awaitable(test_connection& conn, diagnostics& diag)
+    {
+        co_await conn.async_execute("SELECT 1", *result, diag, boost::asio::use_awaitable);
+    }
+#endif
+};
+
+struct execute_statement_op
+{
+    results* result;
+    statement stmt{statement_builder().id(1).num_params(1).build()};
+
+    void sync_errc(test_connection& conn, error_code& ec, diagnostics& diag)
+    {
+        conn.execute(stmt.bind(42), *result, ec, diag);
+    }
+    void sync_exc(test_connection& conn) { conn.execute(stmt.bind(42), *result); }
+    template <class Handler>
+    void async_errinfo(test_connection& conn, diagnostics& diag, Handler h)
+    {
+        conn.async_execute(stmt.bind(42), *result, diag, std::move(h));
+    }
+    template <class Handler>
+    void async_noerrinfo(test_connection& conn, Handler h)
+    {
+        conn.async_execute(stmt.bind(42), *result, std::move(h));
+    }
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    boost::asio::awaitable<void> async_awaitable(test_connection& conn, diagnostics& diag)
+    {
+        co_await conn.async_execute(stmt.bind(42), *result, diag, boost::asio::use_awaitable);
+    }
+#endif
+};
+
+// start_execution followed by read_some_rows until the operation completes
+struct multi_function_op
+{
+    execution_state* st;
+
+    void sync_errc(test_connection& conn, error_code& ec, diagnostics& diag)
+    {
+        conn.start_execution("SELECT 1", *st, ec, diag);
+        while (!ec && !st->complete())
+            conn.read_some_rows(*st, ec, diag);
+    }
+    void sync_exc(test_connection& conn)
+    {
+        conn.start_execution("SELECT 1", *st);
+        while (!st->complete())
+            conn.read_some_rows(*st);
+    }
+    template <class Handler>
+    void async_errinfo(test_connection& conn, diagnostics& diag, Handler h)
+    {
+        conn.async_start_execution("SELECT 1", *st, diag, Handler(h));
+        run_until_completion(conn.get_executor());
+        while (!st->complete())
+        {
+            conn.async_read_some_rows(*st, diag, Handler(h));
+            run_until_completion(conn.get_executor());
+        }
+    }
+    template <class Handler>
+    void async_noerrinfo(test_connection& conn, Handler h)
+    {
+        conn.async_start_execution("SELECT 1", *st, Handler(h));
+        run_until_completion(conn.get_executor());
+        while (!st->complete())
+        {
+            conn.async_read_some_rows(*st, Handler(h));
+            run_until_completion(conn.get_executor());
+        }
+    }
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    boost::asio::awaitable<void> async_awaitable(test_connection& conn, diagnostics& diag)
+    {
+        co_await conn.async_start_execution("SELECT 1", *st, diag, boost::asio::use_awaitable);
+        while (!st->complete())
+            co_await conn.async_read_some_rows(*st, diag, boost::asio::use_awaitable);
+    }
+#endif
+};
+
+struct prepare_statement_op
+{
+    void sync_errc(test_connection& conn, error_code& ec, diagnostics& diag)
+    {
+        conn.prepare_statement("SELECT ?", ec, diag);
+    }
+    void sync_exc(test_connection& conn) { conn.prepare_statement("SELECT ?"); }
+    template <class Handler>
+    void async_errinfo(test_connection& conn, diagnostics& diag, Handler h)
+    {
+        conn.async_prepare_statement("SELECT ?", diag, std::move(h));
+    }
+    template <class Handler>
+    void async_noerrinfo(test_connection& conn, Handler h)
+    {
+        conn.async_prepare_statement("SELECT ?", std::move(h));
+    }
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    boost::asio::awaitable<void> async_awaitable(test_connection& conn, diagnostics& diag)
+    {
+        co_await conn.async_prepare_statement("SELECT ?", diag, boost::asio::use_awaitable);
+    }
+#endif
+};
+
+BOOST_AUTO_TEST_CASE(execute_query)
+{
+    results result;
+    check_op(execute_query_op{&result}, text_resultset_response(), {5, 8, 13});
+}
+
+BOOST_AUTO_TEST_CASE(execute_statement)
+{
+    results result;
+    check_op(execute_statement_op{&result}, binary_resultset_response(), {5, 8, 13});
+}
+
+BOOST_AUTO_TEST_CASE(start_execution_read_some_rows)
+{
+    execution_state st;
+    // Two async operations, each with a read and a type-erased final handler
+    check_op(multi_function_op{&st}, text_resultset_response(), {8, 14, 16});
+}
+
+BOOST_AUTO_TEST_CASE(prepare_statement)
+{
+    // The returned statement object doesn't own dynamic memory
+    check_op(prepare_statement_op{}, prepare_statement_response(), {5, 8, 13});
+}
+
+// Timeouts only apply to socket streams. Timed operations don't allocate more than untimed ones
+using socket_connection = connection<boost::asio::local::stream_protocol::socket>;
+
+// Runs a query a few times, returning the number of allocations performed by the last run
+std::size_t measure_socket_execute(std::chrono::nanoseconds timeout)
+{
+    boost::asio::io_context ctx;
+    socket_connection conn(ctx.get_executor());
+    boost::asio::local::stream_protocol::socket peer(ctx);
+    boost::asio::local::connect_pair(conn.stream(), peer);
+    conn.set_operation_timeout(timeout);
+    auto response = text_resultset_response();
+    results result;
+
+    std::size_t res = 0;
+    for (std::size_t i = 0; i < num_warmup_runs + 1; ++i)
+    {
+        boost::asio::write(peer, boost::asio::buffer(response));
+        allocation_counter counter;
+        error_code ec;
+        diagnostics diag;
+        conn.async_execute("SELECT 1", result, diag, callback_handler{&ec});
+        ctx.restart();
+        ctx.run();
+        res = counter.count();
+        throw_on_error(ec, diag);
+    }
+    return res;
+}
+
+BOOST_AUTO_TEST_CASE(timed_operations)
+{
+    auto untimed = measure_socket_execute(std::chrono::nanoseconds(0));
+    auto timed = measure_socket_execute(std::chrono::hours(1));
+    BOOST_TEST_MESSAGE("untimed=" << untimed << " timed=" << timed);
+    BOOST_TEST(timed <= untimed);
+}
+
+#ifdef BOOST_MYSQL_CXX14
+
+using static_row = std::tuple<std::int64_t, std::string>;
+
+struct execute_static_op
+{
+    static_results<static_row>* result;
+
+    void sync_errc(test_connection& conn, error_code& ec, diagnostics& diag)
+    {
+        conn.execute("SELECT 1", *result, ec, diag);
+    }
+    void sync_exc(test_connection& conn) { conn.execute("SELECT 1", *result); }
+    template <class Handler>
+    void async_errinfo(test_connection& conn, diagnostics& diag, Handler h)
+    {
+        conn.async_execute("SELECT 1", *result, diag, std::move(h));
+    }
+    template <class Handler>
+    void async_noerrinfo(test_connection& conn, Handler h)
+    {
+        conn.async_execute("SELECT 1", *result, std::move(h));
+    }
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    boost::asio::awaitable<void> async_awaitable(test_connection& conn, diagnostics& diag)
+    {
+        co_await conn.async_execute("SELECT 1", *result, diag, boost::asio::use_awaitable);
+    }
+#endif
+};
+
+struct multi_function_static_op
+{
+    static_execution_state<static_row>* st;
+    std::array<static_row, 4>* storage;
+
+    boost::span<static_row> output() const noexcept { return *storage; }
+
+    void sync_errc(test_connection& conn, error_code& ec, diagnostics& diag)
+    {
+        conn.start_execution("SELECT 1", *st, ec, diag);
+        while (!ec && !st->complete())
+            conn.read_some_rows(*st, output(), ec, diag);
+    }
+    void sync_exc(test_connection& conn)
+    {
+        conn.start_execution("SELECT 1", *st);
+        while (!st->complete())
+            conn.read_some_rows(*st, output());
+    }
+    template <class Handler>
+    void async_errinfo(test_connection& conn, diagnostics& diag, Handler h)
+    {
+        conn.async_start_execution("SELECT 1", *st, diag, Handler(h));
+        run_until_completion(conn.get_executor());
+        while (!st->complete())
+        {
+            conn.async_read_some_rows(*st, output(), diag, Handler(h));
+            run_until_completion(conn.get_executor());
+        }
+    }
+    template <class Handler>
+    void async_noerrinfo(test_connection& conn, Handler h)
+    {
+        conn.async_start_execution("SELECT 1", *st, Handler(h));
+        run_until_completion(conn.get_executor());
+        while (!st->complete())
+        {
+            conn.async_read_some_rows(*st, output(), Handler(h));
+            run_until_completion(conn.get_executor());
+        }
+    }
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    boost::asio::awaitable<void> async_awaitable(test_connection& conn, diagnostics& diag)
+    {
+        co_await conn.async_start_execution("SELECT 1", *st, diag, boost::asio::use_awaitable);
+        while (!st->complete())
+            co_await conn.async_read_some_rows(*st, output(), diag, boost::asio::use_awaitable);
+    }
+#endif
+};
+
+// Strings are short, so assigning them doesn't allocate
+std::vector<std::uint8_t> static_resultset_response()
+{
+    std::vector<std::uint8_t> res;
+    concat(res, create_frame(1, {0x02}));
+    concat(
+        res,
+        create_coldef_frame(2, meta_builder().type(column_type::bigint).nullable(false).build_coldef())
+    );
+    concat(
+        res,
+        create_coldef_frame(3, meta_builder().type(column_type::varchar).nullable(false).build_coldef())
+    );
+    concat(res, create_text_row_message(4, 42, "abc"));
+    concat(res, create_text_row_message(5, 43, "def"));
+    concat(res, create_eof_frame(6, ok_builder().build()));
+    return res;
+}
+
+BOOST_AUTO_TEST_CASE(execute_static)
+{
+    static_results<static_row> result;
+    check_op(execute_static_op{&result}, static_resultset_response(), {5, 8, 13});
+}
+
+BOOST_AUTO_TEST_CASE(start_execution_read_some_rows_static)
+{
+    static_execution_state<static_row> st;
+    std::array<static_row, 4> storage;
+    check_op(multi_function_static_op{&st, &storage}, static_resultset_response(), {8, 14, 16});
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
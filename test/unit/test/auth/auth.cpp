@@ -196,4 +196,25 @@ BOOST_AUTO_TEST_CASE(unknown_auth_plugin_empty)
     BOOST_TEST(err == make_error_code(client_errc::unknown_auth_plugin));
 }
 
+// Server side
+BOOST_AUTO_TEST_CASE(generate_auth_scramble_no_zeros)
+{
+    std::uint8_t scramble[20]{};
+    generate_auth_scramble(scramble);
+    for (auto b : scramble)
+        BOOST_TEST(b != 0u);
+}
+
+BOOST_AUTO_TEST_CASE(auth_responses_equal_)
+{
+    constexpr std::uint8_t resp1[] = {0x01, 0x02, 0x03};
+    constexpr std::uint8_t resp2[] = {0x01, 0x02, 0x04};
+    constexpr std::uint8_t resp3[] = {0x01, 0x02};
+    BOOST_TEST(auth_responses_equal(resp1, resp1));
+    BOOST_TEST(!auth_responses_equal(resp1, resp2));
+    BOOST_TEST(!auth_responses_equal(resp1, resp3));
+    BOOST_TEST(!auth_responses_equal(resp3, resp1));
+    BOOST_TEST(auth_responses_equal({}, {}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
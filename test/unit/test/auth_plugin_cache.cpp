@@ -0,0 +1,174 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/auth_plugin_cache.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/handshake_params.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/impl/internal/protocol/server_protocol.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "test_common/printing.hpp"
+#include "test_unit/create_frame.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/test_stream.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+BOOST_AUTO_TEST_SUITE(test_auth_plugin_cache)
+
+using test_connection = connection<test_stream>;
+
+constexpr std::array<std::uint8_t, 20> scramble{
+    {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20}
+};
+
+template <class Message>
+std::vector<std::uint8_t> create_message_frame(std::uint8_t seqnum, const Message& msg)
+{
+    std::vector<std::uint8_t> body(msg.get_size());
+    msg.serialize(body);
+    return create_frame(seqnum, body);
+}
+
+// A hello advertising caching_sha2_password as the default plugin
+std::vector<std::uint8_t> create_hello_frame()
+{
+    return create_message_frame(
+        0,
+        detail::server_hello_message{"8.0.33", 42, scramble, 45, "caching_sha2_password"}
+    );
+}
+
+std::vector<std::uint8_t> create_auth_switch_frame(std::uint8_t seqnum)
+{
+    return create_message_frame(seqnum, detail::auth_switch_message{"mysql_native_password", scramble});
+}
+
+bool contains(const std::vector<std::uint8_t>& bytes, string_view s)
+{
+    return std::search(bytes.begin(), bytes.end(), s.begin(), s.end()) != bytes.end();
+}
+
+handshake_params params("user", "pass");
+
+BOOST_AUTO_TEST_CASE(switch_is_remembered)
+{
+    auth_plugin_cache cache;
+
+    // The first handshake requires an auth switch
+    test_connection conn1;
+    conn1.set_auth_cache(&cache);
+    conn1.stream()
+        .add_bytes(create_hello_frame())
+        .add_bytes(create_auth_switch_frame(2))
+        .add_bytes(create_ok_frame(4, ok_builder().build()));
+    conn1.handshake(params);
+    BOOST_TEST(cache.size() == 1u);
+
+    // The second one sends mysql_native_password from the start
+    test_connection conn2;
+    conn2.set_auth_cache(&cache);
+    BOOST_TEST(conn2.auth_cache() == &cache);
+    conn2.stream().add_bytes(create_hello_frame()).add_bytes(create_ok_frame(2, ok_builder().build()));
+    conn2.handshake(params);
+    BOOST_TEST(contains(conn2.stream().bytes_written(), "mysql_native_password"));
+    BOOST_TEST(!contains(conn2.stream().bytes_written(), "caching_sha2_password"));
+    BOOST_TEST(conn2.stream().num_unread_bytes() == 0u);
+    BOOST_TEST(cache.size() == 1u);
+
+    // Other users don't use the entry
+    test_connection conn3;
+    conn3.set_auth_cache(&cache);
+    conn3.stream().add_bytes(create_hello_frame()).add_bytes(create_ok_frame(2, ok_builder().build()));
+    conn3.handshake(handshake_params("other_user", "pass"));
+    BOOST_TEST(contains(conn3.stream().bytes_written(), "caching_sha2_password"));
+}
+
+BOOST_AUTO_TEST_CASE(stale_entry_is_updated)
+{
+    auth_plugin_cache cache;
+
+    // Populate the cache
+    test_connection conn1;
+    conn1.set_auth_cache(&cache);
+    conn1.stream()
+        .add_bytes(create_hello_frame())
+        .add_bytes(create_auth_switch_frame(2))
+        .add_bytes(create_ok_frame(4, ok_builder().build()));
+    conn1.handshake(params);
+
+    // The account now uses the default plugin, so the server requests a switch back
+    test_connection conn2;
+    conn2.set_auth_cache(&cache);
+    conn2.stream()
+        .add_bytes(create_hello_frame())
+        .add_bytes(create_message_frame(2, detail::auth_switch_message{"caching_sha2_password", scramble}))
+        .add_bytes(create_ok_frame(4, ok_builder().build()));
+    conn2.handshake(params);
+
+    // Following handshakes use the default plugin again
+    test_connection conn3;
+    conn3.set_auth_cache(&cache);
+    conn3.stream().add_bytes(create_hello_frame()).add_bytes(create_ok_frame(2, ok_builder().build()));
+    conn3.handshake(params);
+    BOOST_TEST(contains(conn3.stream().bytes_written(), "caching_sha2_password"));
+    BOOST_TEST(!contains(conn3.stream().bytes_written(), "mysql_native_password"));
+}
+
+BOOST_AUTO_TEST_CASE(no_switch_no_entry)
+{
+    auth_plugin_cache cache;
+    test_connection conn;
+    conn.set_auth_cache(&cache);
+    conn.stream().add_bytes(create_hello_frame()).add_bytes(create_ok_frame(2, ok_builder().build()));
+    conn.handshake(params);
+    BOOST_TEST(cache.size() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(no_cache)
+{
+    // Without a cache, every handshake performs the switch
+    for (int i = 0; i < 2; ++i)
+    {
+        test_connection conn;
+        BOOST_TEST(conn.auth_cache() == nullptr);
+        conn.stream()
+            .add_bytes(create_hello_frame())
+            .add_bytes(create_auth_switch_frame(2))
+            .add_bytes(create_ok_frame(4, ok_builder().build()));
+        conn.handshake(params);
+        BOOST_TEST(contains(conn.stream().bytes_written(), "caching_sha2_password"));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(clear)
+{
+    auth_plugin_cache cache;
+    test_connection conn;
+    conn.set_auth_cache(&cache);
+    conn.stream()
+        .add_bytes(create_hello_frame())
+        .add_bytes(create_auth_switch_frame(2))
+        .add_bytes(create_ok_frame(4, ok_builder().build()));
+    conn.handshake(params);
+    BOOST_TEST(cache.size() == 1u);
+
+    cache.clear();
+    BOOST_TEST(cache.size() == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -27,6 +27,8 @@ using namespace boost::mysql::test;
 using boost::span;
 using boost::mysql::client_errc;
 using boost::mysql::error_code;
+using boost::mysql::protocol_trace;
+using boost::mysql::trace_direction;
 
 BOOST_AUTO_TEST_SUITE(test_message_reader)
 
@@ -263,6 +265,93 @@ BOOST_AUTO_TEST_CASE(error)
             // Read with error
             fn.read_some(fix.stream, reader).validate_error_exact(client_errc::wrong_num_params);
             BOOST_TEST(!reader.has_message());
+            BOOST_TEST(reader.stats().read_calls == 1u);
+            BOOST_TEST(reader.stats().bytes_read == 0u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(stats)
+{
+    for (auto fn : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fn.name)
+        {
+            fixture fix;
+            message_reader reader(0, 8);
+            std::uint8_t seqnum = 2;
+            fix.inner_stream()
+                .add_bytes(create_frame(2, {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08}))
+                .add_bytes(create_frame(3, {0x09}))
+                .add_bytes(create_frame(4, {0x0a, 0x0b}))
+                .add_break(12);
+            error_code err(client_errc::server_unsupported);
+
+            // Initially, everything is zero
+            BOOST_TEST(reader.stats().messages_read == 0u);
+
+            // Read the multi-frame message, which doesn't fit in the buffer
+            fn.read_some(fix.stream, reader).validate_no_error();
+            reader.get_next_message(seqnum, err);
+            BOOST_TEST_REQUIRE(err == error_code());
+
+            // Read the second message
+            fn.read_some(fix.stream, reader).validate_no_error();
+            reader.get_next_message(seqnum, err);
+            BOOST_TEST_REQUIRE(err == error_code());
+
+            // Verify
+            const auto& st = reader.stats();
+            BOOST_TEST(st.bytes_read == 23u);
+            BOOST_TEST(st.read_calls >= 2u);
+            BOOST_TEST(st.messages_read == 2u);
+            BOOST_TEST(st.frames_read == 3u);
+            BOOST_TEST(st.multiframe_messages_read == 1u);
+            BOOST_TEST(st.read_buffer_growths >= 1u);
+            BOOST_TEST(st.io_time.count() >= 0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(protocol_trace_)
+{
+    for (auto fn : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fn.name)
+        {
+            fixture fix;
+            message_reader reader(0, 8);
+            protocol_trace trace(4);
+            reader.set_protocol_trace(&trace);
+            std::uint8_t seqnum = 2;
+            fix.inner_stream()
+                .add_bytes(create_frame(2, {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08}))
+                .add_bytes(create_frame(3, {0x09}))
+                .add_bytes(create_frame(4, {0x0a, 0x0b}));
+            error_code err(client_errc::server_unsupported);
+
+            // Read both messages
+            fn.read_some(fix.stream, reader).validate_no_error();
+            reader.get_next_message(seqnum, err);
+            BOOST_TEST_REQUIRE(err == error_code());
+            fn.read_some(fix.stream, reader).validate_no_error();
+            reader.get_next_message(seqnum, err);
+            BOOST_TEST_REQUIRE(err == error_code());
+
+            // Verify
+            BOOST_TEST_REQUIRE(trace.size() == 2u);
+            BOOST_TEST(trace[0].direction == trace_direction::read);
+            BOOST_TEST(trace[0].seqnum == 2u);
+            BOOST_TEST(trace[0].num_frames == 2u);
+            BOOST_TEST(trace[0].size == 9u);
+            BOOST_TEST(trace[0].prefix_size == 9u);
+            BOOST_MYSQL_ASSERT_BUFFER_EQUALS(
+                span<const std::uint8_t>(trace[0].prefix.data(), trace[0].prefix_size),
+                std::vector<std::uint8_t>({0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09})
+            );
+            BOOST_TEST(trace[1].seqnum == 4u);
+            BOOST_TEST(trace[1].num_frames == 1u);
+            BOOST_TEST(trace[1].size == 2u);
         }
     }
 }
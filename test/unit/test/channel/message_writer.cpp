@@ -15,6 +15,7 @@
 
 #include "test_common/assert_buffer_equals.hpp"
 #include "test_common/buffer_concat.hpp"
+#include "test_common/printing.hpp"
 #include "test_unit/create_frame.hpp"
 
 using namespace boost::mysql::detail;
@@ -290,6 +291,50 @@ BOOST_AUTO_TEST_CASE(multiframe_message)
     BOOST_TEST(processor.done());
 }
 
+BOOST_AUTO_TEST_CASE(protocol_trace_)
+{
+    struct
+    {
+        const char* name;
+        std::size_t msg_size;
+        std::uint8_t expected_frames;
+        std::uint8_t expected_prefix_size;
+    } test_cases[] = {
+        {"empty",                   0,  1, 0 },
+        {"regular",                 3,  1, 3 },
+        {"multiframe",              20, 3, 16},
+        {"multiframe_empty_frame", 16, 3, 16},
+    };
+
+    for (const auto& tc : test_cases)
+    {
+        BOOST_TEST_CONTEXT(tc.name)
+        {
+            message_writer processor(8);
+            boost::mysql::protocol_trace trace(2);
+            processor.set_protocol_trace(&trace);
+            std::uint8_t seqnum = 254;
+
+            // Serialize
+            auto mutbuf = processor.prepare_buffer(tc.msg_size, seqnum);
+            for (std::size_t i = 0; i < mutbuf.size(); ++i)
+                mutbuf[i] = static_cast<std::uint8_t>(i);
+            processor.on_message_serialized();
+
+            // Verify
+            BOOST_TEST_REQUIRE(trace.size() == 1u);
+            const auto& rec = trace[0];
+            BOOST_TEST(rec.direction == boost::mysql::trace_direction::write);
+            BOOST_TEST(rec.seqnum == 254u);
+            BOOST_TEST(rec.num_frames == tc.expected_frames);
+            BOOST_TEST(rec.size == tc.msg_size);
+            BOOST_TEST(rec.prefix_size == tc.expected_prefix_size);
+            for (std::size_t i = 0; i < rec.prefix_size; ++i)
+                BOOST_TEST(rec.prefix[i] == i);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(multiframe_message_with_max_frame_size)
 {
     message_writer processor(8);
@@ -419,6 +464,67 @@ BOOST_AUTO_TEST_CASE(several_messages)
     BOOST_TEST(processor.done());
 }
 
+BOOST_AUTO_TEST_CASE(pipeline)
+{
+    message_writer processor(8);
+    std::vector<std::uint8_t> msg_1{0x01, 0x02, 0x03};
+    std::vector<std::uint8_t> msg_2_frame_1{0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18};
+    std::vector<std::uint8_t> msg_2_frame_2{0x21, 0x22};
+    auto msg_2 = concat_copy(msg_2_frame_1, msg_2_frame_2);
+    std::uint8_t seqnum_1 = 0;
+    std::uint8_t seqnum_2 = 0xff;
+    std::uint8_t seqnum_3 = 4;
+
+    // Each message gets its own sequence numbers, assigned on serialization
+    processor.begin_pipeline();
+    auto mutbuf = processor.prepare_pipelined_buffer(msg_1.size(), seqnum_1);
+    BOOST_TEST(mutbuf.size() == msg_1.size());
+    copy(msg_1, mutbuf);
+    processor.on_message_serialized();
+    BOOST_TEST(seqnum_1 == 1u);
+
+    mutbuf = processor.prepare_pipelined_buffer(msg_2.size(), seqnum_2);
+    BOOST_TEST(mutbuf.size() == msg_2.size());
+    copy(msg_2, mutbuf);
+    processor.on_message_serialized();
+    BOOST_TEST(seqnum_2 == 1u);
+
+    mutbuf = processor.prepare_pipelined_buffer(0, seqnum_3);
+    BOOST_TEST(mutbuf.size() == 0u);
+    processor.on_message_serialized();
+    BOOST_TEST(seqnum_3 == 5u);
+
+    // All messages are written in a single chunk
+    auto expected = buffer_builder()
+                        .add(create_frame(0, msg_1))
+                        .add(create_frame(0xff, msg_2_frame_1))
+                        .add(create_frame(0, msg_2_frame_2))
+                        .add(create_empty_frame(4))
+                        .build();
+    BOOST_TEST(!processor.done());
+    auto chunk = processor.next_chunk();
+    BOOST_MYSQL_ASSERT_BUFFER_EQUALS(chunk, expected);
+
+    // Short writes work
+    processor.on_bytes_written(10);
+    BOOST_TEST(!processor.done());
+    chunk = processor.next_chunk();
+    span<const std::uint8_t> expected_rest(expected.data() + 10, expected.size() - 10);
+    BOOST_MYSQL_ASSERT_BUFFER_EQUALS(chunk, expected_rest);
+    processor.on_bytes_written(expected.size() - 10);
+    BOOST_TEST(processor.done());
+
+    // A regular message can be written afterwards
+    std::uint8_t seqnum_4 = 7;
+    mutbuf = processor.prepare_buffer(msg_1.size(), seqnum_4);
+    copy(msg_1, mutbuf);
+    chunk = processor.next_chunk();
+    BOOST_MYSQL_ASSERT_BUFFER_EQUALS(chunk, create_frame(7, msg_1));
+    processor.on_bytes_written(7);
+    BOOST_TEST(seqnum_4 == 8u);
+    BOOST_TEST(processor.done());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace
@@ -0,0 +1,186 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/detail/any_stream_impl.hpp>
+
+#include <boost/mysql/impl/internal/channel/operation_deadline.hpp>
+
+#include <boost/asio/basic_waitable_timer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+using namespace boost::mysql::detail;
+namespace asio = boost::asio;
+
+namespace {
+
+// A clock that only advances when told to, so tests don't depend on wall-clock time
+struct manual_clock
+{
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<manual_clock>;
+    static constexpr bool is_steady = true;
+
+    static time_point& current() noexcept
+    {
+        static time_point res;
+        return res;
+    }
+    static time_point now() noexcept { return current(); }
+    static void advance(duration d) noexcept { current() += d; }
+};
+
+// Never block waiting for the clock, which won't advance by itself
+struct manual_wait_traits
+{
+    static manual_clock::duration to_wait_duration(manual_clock::duration) { return {}; }
+    static manual_clock::duration to_wait_duration(manual_clock::time_point) { return {}; }
+};
+
+using manual_timer = asio::basic_waitable_timer<manual_clock, manual_wait_traits>;
+using deadline_t = basic_operation_deadline<manual_timer>;
+using socket_t = asio::local::stream_protocol::socket;
+
+struct fixture
+{
+    asio::io_context ctx;
+    any_stream_impl<socket_t> stream{ctx};
+    socket_t peer{ctx};
+    deadline_t deadline{ctx.get_executor(), stream};
+
+    fixture() { asio::local::connect_pair(stream.stream(), peer); }
+};
+
+BOOST_AUTO_TEST_SUITE(test_operation_deadline)
+
+BOOST_FIXTURE_TEST_CASE(expires, fixture)
+{
+    deadline.arm(std::chrono::milliseconds(10));
+    ctx.poll();
+    BOOST_TEST(stream.is_open());
+
+    // Expiring closes the stream
+    manual_clock::advance(std::chrono::milliseconds(10));
+    ctx.restart();
+    ctx.poll();
+    BOOST_TEST(!stream.is_open());
+    BOOST_TEST(deadline.disarm());
+}
+
+BOOST_FIXTURE_TEST_CASE(disarmed_before_expiry, fixture)
+{
+    deadline.arm(std::chrono::milliseconds(10));
+    BOOST_TEST(!deadline.disarm());
+    manual_clock::advance(std::chrono::milliseconds(20));
+    ctx.poll();
+    BOOST_TEST(stream.is_open());
+}
+
+BOOST_FIXTURE_TEST_CASE(disarmed_after_expiry_before_close, fixture)
+{
+    // The timer expires while the operation's completion is pending.
+    // The operation completes before the close runs, so it's not interrupted
+    deadline.arm(std::chrono::milliseconds(10));
+    manual_clock::advance(std::chrono::milliseconds(10));
+    BOOST_TEST_REQUIRE(ctx.poll_one() == 1u);  // the wait handler, which defers the close
+    BOOST_TEST(stream.is_open());
+    BOOST_TEST(!deadline.disarm());
+    ctx.poll();
+    BOOST_TEST(stream.is_open());
+}
+
+BOOST_FIXTURE_TEST_CASE(rearm, fixture)
+{
+    // A completed operation doesn't affect the next one
+    deadline.arm(std::chrono::milliseconds(10));
+    manual_clock::advance(std::chrono::milliseconds(5));
+    ctx.poll();
+    BOOST_TEST(!deadline.disarm());
+
+    // The next operation's deadline counts from when it started
+    deadline.arm(std::chrono::milliseconds(10));
+    manual_clock::advance(std::chrono::milliseconds(5));
+    ctx.restart();
+    ctx.poll();
+    BOOST_TEST(stream.is_open());
+    manual_clock::advance(std::chrono::milliseconds(5));
+    ctx.restart();
+    ctx.poll();
+    BOOST_TEST(!stream.is_open());
+    BOOST_TEST(deadline.disarm());
+
+    // Disarming resets the expired state
+    deadline.arm(std::chrono::milliseconds(10));
+    BOOST_TEST(!deadline.disarm());
+}
+
+BOOST_FIXTURE_TEST_CASE(paused, fixture)
+{
+    // Expiring while paused doesn't close the stream
+    deadline.arm(std::chrono::milliseconds(10));
+    deadline.pause();
+    manual_clock::advance(std::chrono::milliseconds(20));
+    ctx.poll();
+    BOOST_TEST(stream.is_open());
+
+    // Resuming keeps the original expiry time, which has already passed
+    deadline.resume();
+    ctx.restart();
+    ctx.poll();
+    BOOST_TEST(!stream.is_open());
+    BOOST_TEST(deadline.disarm());
+}
+
+BOOST_FIXTURE_TEST_CASE(paused_after_expiry_before_close, fixture)
+{
+    // A close already scheduled doesn't run once paused
+    deadline.arm(std::chrono::milliseconds(10));
+    manual_clock::advance(std::chrono::milliseconds(10));
+    BOOST_TEST_REQUIRE(ctx.poll_one() == 1u);
+    deadline.pause();
+    ctx.poll();
+    BOOST_TEST(stream.is_open());
+    deadline.resume();
+    ctx.restart();
+    ctx.poll();
+    BOOST_TEST(!stream.is_open());
+    BOOST_TEST(deadline.disarm());
+}
+
+BOOST_FIXTURE_TEST_CASE(pause_not_armed, fixture)
+{
+    // Pausing and resuming without an armed deadline does nothing
+    deadline.pause();
+    deadline.resume();
+    manual_clock::advance(std::chrono::hours(1));
+    ctx.poll();
+    BOOST_TEST(stream.is_open());
+    BOOST_TEST(!deadline.disarm());
+}
+
+BOOST_FIXTURE_TEST_CASE(destroyed_before_expiry, fixture)
+{
+    // The pending wait doesn't access the stream once the deadline is gone
+    {
+        deadline_t other(ctx.get_executor(), stream);
+        other.arm(std::chrono::milliseconds(10));
+    }
+    manual_clock::advance(std::chrono::milliseconds(10));
+    ctx.poll();
+    BOOST_TEST(stream.is_open());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
@@ -171,6 +171,38 @@ BOOST_AUTO_TEST_CASE(error)
 
             // Write
             fns.write(fix.stream, fix.writer).validate_error_exact(client_errc::server_unsupported);
+
+            // The failed write is accounted for
+            BOOST_TEST(fix.writer.stats().write_calls == 1u);
+            BOOST_TEST(fix.writer.stats().bytes_written == 0u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(stats)
+{
+    for (auto fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            // Data
+            fixture fix;
+            fix.inner_stream().set_write_break_size(5);
+            const std::vector<std::uint8_t> msg{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a};
+
+            // Write two messages. The first one spans two frames
+            auto mutbuf = fix.writer.prepare_buffer(msg.size(), fix.seqnum);
+            copy(msg, mutbuf);
+            fns.write(fix.stream, fix.writer).validate_no_error();
+            fix.writer.prepare_buffer(0, fix.seqnum);
+            fns.write(fix.stream, fix.writer).validate_no_error();
+
+            // Verify. Frames are 4 + 8, 4 + 2 and 4 + 0 bytes long
+            const auto& st = fix.writer.stats();
+            BOOST_TEST(st.messages_written == 2u);
+            BOOST_TEST(st.bytes_written == 22u);
+            BOOST_TEST(st.write_calls == 6u);
+            BOOST_TEST(st.io_time.count() >= 0);
         }
     }
 }
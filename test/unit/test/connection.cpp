@@ -6,22 +6,41 @@
 //
 
 #include <boost/mysql/buffer_params.hpp>
+#include <boost/mysql/column_type.hpp>
 #include <boost/mysql/connection.hpp>
+#include <boost/mysql/handshake_params.hpp>
 #include <boost/mysql/metadata_mode.hpp>
 #include <boost/mysql/results.hpp>
 #include <boost/mysql/tcp.hpp>
 #include <boost/mysql/tcp_ssl.hpp>
 
+#include <boost/mysql/impl/internal/protocol/server_protocol.hpp>
+
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/ssl/stream.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include "test_common/printing.hpp"
+#include "test_unit/create_coldef_frame.hpp"
+#include "test_unit/create_frame.hpp"
+#include "test_unit/create_meta.hpp"
 #include "test_unit/create_ok.hpp"
 #include "test_unit/create_ok_frame.hpp"
+#include "test_unit/create_row_message.hpp"
 #include "test_unit/test_stream.hpp"
 #include "test_unit/unit_netfun_maker.hpp"
 
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
 using namespace boost::mysql;
 using namespace boost::mysql::test;
 namespace net = boost::asio;
@@ -159,6 +178,196 @@ BOOST_AUTO_TEST_CASE(set_meta_mode)
     BOOST_TEST(conn.meta_mode() == metadata_mode::full);
 }
 
+BOOST_AUTO_TEST_CASE(stats)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            test_connection conn;
+
+            // Initially, no counters have been incremented
+            BOOST_TEST(conn.stats().bytes_read == 0u);
+            BOOST_TEST(conn.stats().rows_read == 0u);
+
+            // Run a query returning two rows
+            conn.stream()
+                .add_bytes(create_frame(1, {0x01}))
+                .add_bytes(create_coldef_frame(2, meta_builder().type(column_type::bigint).build_coldef()))
+                .add_bytes(create_text_row_message(3, 42))
+                .add_bytes(create_text_row_message(4, 43))
+                .add_bytes(create_eof_frame(5, ok_builder().build()));
+            const auto bytes_to_read = conn.stream().num_unread_bytes();
+            results result;
+            fns.query(conn, "SELECT 1", result).validate_no_error();
+
+            // Verify
+            auto st = conn.stats();
+            BOOST_TEST(st.bytes_read == bytes_to_read);
+            BOOST_TEST(st.bytes_written == conn.stream().bytes_written().size());
+            BOOST_TEST(st.read_calls >= 1u);
+            BOOST_TEST(st.write_calls == 1u);
+            BOOST_TEST(st.messages_read == 5u);
+            BOOST_TEST(st.messages_written == 1u);
+            BOOST_TEST(st.frames_read == 5u);
+            BOOST_TEST(st.multiframe_messages_read == 0u);
+            BOOST_TEST(st.read_buffer_size > 0u);
+            BOOST_TEST(st.rows_read == 2u);
+        }
+    }
+}
+
+// operation timeouts
+using local_connection = connection<net::local::stream_protocol::socket>;
+
+BOOST_AUTO_TEST_CASE(operation_timeout_default)
+{
+    net::io_context ctx;
+    tcp_connection conn{ctx.get_executor()};
+    BOOST_TEST(conn.operation_timeout().count() == 0);
+
+    conn.set_operation_timeout(std::chrono::seconds(5));
+    BOOST_TEST((conn.operation_timeout() == std::chrono::seconds(5)));
+}
+
+BOOST_AUTO_TEST_CASE(operation_timeout_expires)
+{
+    net::io_context ctx;
+    local_connection conn{ctx.get_executor()};
+    net::local::stream_protocol::socket peer{ctx};
+    net::local::connect_pair(conn.stream(), peer);
+    conn.set_operation_timeout(std::chrono::milliseconds(1));
+
+    // The peer never replies, so the operation can only finish by timing out, closing the socket
+    error_code ec;
+    conn.async_ping([&ec](error_code err) { ec = err; });
+    ctx.run();
+    BOOST_TEST(ec == client_errc::timeout);
+    BOOST_TEST(!conn.stream().is_open());
+}
+
+BOOST_AUTO_TEST_CASE(operation_timeout_not_expired)
+{
+    net::io_context ctx;
+    local_connection conn{ctx.get_executor()};
+    net::local::stream_protocol::socket peer{ctx};
+    net::local::connect_pair(conn.stream(), peer);
+    conn.set_operation_timeout(std::chrono::hours(1));
+
+    // Several operations completing on time reuse the timer and leave the connection untouched.
+    // Disarming the timer cancels its wait, so run() returns once the operation finishes
+    for (int i = 0; i < 2; ++i)
+    {
+        net::write(peer, net::buffer(create_ok_frame(1, ok_builder().build())));
+        error_code ec = client_errc::wrong_num_params;
+        conn.async_ping([&ec](error_code err) { ec = err; });
+        ctx.restart();
+        ctx.run();
+        BOOST_TEST(ec == error_code());
+        BOOST_TEST(conn.stream().is_open());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(operation_timeout_disabled)
+{
+    net::io_context ctx;
+    local_connection conn{ctx.get_executor()};
+    net::local::stream_protocol::socket peer{ctx};
+    net::local::connect_pair(conn.stream(), peer);
+    conn.set_operation_timeout(std::chrono::nanoseconds(1));
+    conn.set_operation_timeout(std::chrono::nanoseconds(0));
+
+    // Without a timeout, the operation is outstanding until the peer replies
+    error_code ec = client_errc::wrong_num_params;
+    conn.async_ping([&ec](error_code err) { ec = err; });
+    ctx.poll();
+    BOOST_TEST(ec == client_errc::wrong_num_params);
+    BOOST_TEST(conn.stream().is_open());
+
+    net::write(peer, net::buffer(create_ok_frame(1, ok_builder().build())));
+    ctx.restart();
+    ctx.run();
+    BOOST_TEST(ec == error_code());
+}
+
+// TLS handshake offloading
+using local_ssl_connection = connection<net::ssl::stream<net::local::stream_protocol::socket>>;
+
+BOOST_AUTO_TEST_CASE(tls_handshake_executor_default)
+{
+    net::io_context ctx, offload_ctx;
+    net::ssl::context ssl_ctx(net::ssl::context::tls_client);
+    tcp_ssl_connection conn{ctx.get_executor(), ssl_ctx};
+    BOOST_TEST(!conn.tls_handshake_executor());
+
+    conn.set_tls_handshake_executor(offload_ctx.get_executor());
+    BOOST_TEST((conn.tls_handshake_executor() == net::any_io_executor(offload_ctx.get_executor())));
+
+    conn.set_tls_handshake_executor(net::any_io_executor());
+    BOOST_TEST(!conn.tls_handshake_executor());
+}
+
+// A server hello advertising TLS support
+std::vector<std::uint8_t> create_tls_hello_frame()
+{
+    constexpr std::array<std::uint8_t, 20> scramble{{}};
+    detail::server_hello_message msg{"8.0.33", 42, scramble, 45, "mysql_native_password"};
+    std::vector<std::uint8_t> body(msg.get_size());
+    msg.serialize(body);
+    body[22] |= 0x08;  // CLIENT_SSL, in the lower capability flags
+    return create_frame(0, body);
+}
+
+void check_tls_handshake_offloaded(std::chrono::nanoseconds timeout)
+{
+    net::io_context ctx, offload_ctx;
+    net::ssl::context ssl_ctx(net::ssl::context::tls_client);
+    local_ssl_connection conn{ctx.get_executor(), ssl_ctx};
+    net::local::stream_protocol::socket peer{ctx};
+    net::local::connect_pair(conn.stream().lowest_layer(), peer);
+    conn.set_tls_handshake_executor(offload_ctx.get_executor());
+    conn.set_operation_timeout(timeout);
+
+    // The peer reads the SSL request and the TLS client hello, then closes the connection
+    net::write(peer, net::buffer(create_tls_hello_frame()));
+    std::array<std::uint8_t, 36> ssl_request{};
+    std::array<std::uint8_t, 4096> client_hello{};
+    net::async_read(peer, net::buffer(ssl_request), [&](error_code err, std::size_t) {
+        BOOST_TEST_REQUIRE(err == error_code());
+        peer.async_read_some(net::buffer(client_hello), [&](error_code, std::size_t) { peer.close(); });
+    });
+
+    // The handshake fails, but the TLS steps run in the offload executor,
+    // and the operation completes in the connection's
+    bool done = false;
+    error_code ec;
+    conn.async_handshake(handshake_params("user", "pass"), [&](error_code err) {
+        done = true;
+        ec = err;
+        BOOST_TEST(ctx.get_executor().running_in_this_thread());
+    });
+
+    std::size_t offloaded_handlers = 0;
+    for (int i = 0; i < 10000 && !done; ++i)
+    {
+        ctx.restart();
+        ctx.poll();
+        offload_ctx.restart();
+        offloaded_handlers += offload_ctx.poll();
+    }
+    BOOST_TEST_REQUIRE(done);
+    BOOST_TEST(ec != error_code());
+    BOOST_TEST(offloaded_handlers > 0u);
+}
+
+BOOST_AUTO_TEST_CASE(tls_handshake_offloaded) { check_tls_handshake_offloaded(std::chrono::nanoseconds(0)); }
+
+// The deadline is paused while the handshake runs in the offload executor, and resumed afterwards
+BOOST_AUTO_TEST_CASE(tls_handshake_offloaded_timeout)
+{
+    check_tls_handshake_offloaded(std::chrono::hours(1));
+}
+
 // rebind_executor
 using other_exec = net::strand<net::any_io_executor>;
 static_assert(
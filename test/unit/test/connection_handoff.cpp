@@ -0,0 +1,290 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/connection_handoff.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/handshake_params.hpp>
+#include <boost/mysql/server_command.hpp>
+#include <boost/mysql/server_connection.hpp>
+#include <boost/mysql/tcp.hpp>
+
+#include <boost/mysql/impl/internal/protocol/capabilities.hpp>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <vector>
+
+#include "test_common/printing.hpp"
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+
+#include <sys/socket.h>
+
+using namespace boost::mysql;
+namespace asio = boost::asio;
+
+BOOST_AUTO_TEST_SUITE(test_connection_handoff)
+
+using socket_type = asio::local::stream_protocol::socket;
+
+// An authenticated client connection, talking to a server connection,
+// and a pair of sockets to hand it off
+struct fixture
+{
+    asio::io_context ctx;
+    server_connection<socket_type> server{ctx};
+    connection<socket_type> client{ctx};
+    socket_type sender{ctx};
+    socket_type receiver{ctx};
+
+    fixture()
+    {
+        asio::local::connect_pair(client.stream(), server.stream());
+        asio::local::connect_pair(sender, receiver);
+
+        auto fut = std::async(std::launch::async, [this] {
+            client.handshake(handshake_params("user", "pass"));
+        });
+        server.handshake();
+        BOOST_TEST_REQUIRE(server.check_password("pass"));
+        server.add_ok();
+        server.flush();
+        fut.get();
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(success, fixture)
+{
+    export_connection(client, sender);
+    BOOST_TEST(!client.stream().is_open());
+
+    // The received connection is usable without handshaking again
+    connection<socket_type> imported(ctx);
+    import_connection(receiver, imported);
+    BOOST_TEST(imported.stream().is_open());
+
+    auto fut = std::async(std::launch::async, [&imported] { imported.ping(); });
+    auto cmd = server.read_command();
+    BOOST_TEST((cmd.type == server_command_type::ping));
+    server.add_ok();
+    server.flush();
+    fut.get();
+}
+
+BOOST_FIXTURE_TEST_CASE(import_closes_previous_socket, fixture)
+{
+    export_connection(client, sender);
+
+    connection<socket_type> imported(ctx);
+    socket_type other(ctx);
+    asio::local::connect_pair(imported.stream(), other);
+    import_connection(receiver, imported);
+    BOOST_TEST(imported.stream().is_open());
+
+    // The previous socket was closed
+    std::array<std::uint8_t, 1> buff{};
+    error_code err;
+    other.read_some(asio::buffer(buff), err);
+    BOOST_TEST(err == error_code(asio::error::eof));
+}
+
+BOOST_FIXTURE_TEST_CASE(import_no_descriptor, fixture)
+{
+    // A well-formed message, but without the socket
+    const std::uint8_t msg[] = {0x4d, 0x59, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00};
+    asio::write(sender, asio::buffer(msg));
+
+    connection<socket_type> imported(ctx);
+    error_code err;
+    import_connection(receiver, imported, err);
+    BOOST_TEST(err == error_code(client_errc::protocol_value_error));
+    BOOST_TEST(!imported.stream().is_open());
+}
+
+// Sends a handoff message, together with the passed descriptors
+void send_handoff_message(
+    socket_type& sock,
+    const std::vector<std::uint8_t>& msg,
+    const std::vector<int>& fds
+)
+{
+    std::vector<char> control(CMSG_SPACE(fds.size() * sizeof(int)));
+    iovec iov{const_cast<std::uint8_t*>(msg.data()), msg.size()};
+    msghdr hdr{};
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control.data();
+    hdr.msg_controllen = control.size();
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(fds.size() * sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), fds.data(), fds.size() * sizeof(int));
+    BOOST_TEST_REQUIRE(::sendmsg(sock.native_handle(), &hdr, 0) == static_cast<ssize_t>(msg.size()));
+}
+
+// A valid message, with the capabilities negotiated by a connection
+std::vector<std::uint8_t> create_handoff_message(std::uint8_t flavor, std::uint32_t caps)
+{
+    return {
+        0x4d,
+        0x59,
+        0x01,
+        flavor,
+        static_cast<std::uint8_t>(caps),
+        static_cast<std::uint8_t>(caps >> 8),
+        static_cast<std::uint8_t>(caps >> 16),
+        static_cast<std::uint8_t>(caps >> 24),
+    };
+}
+
+constexpr std::uint32_t valid_caps = detail::mandatory_capabilities.get();
+
+// Checks that all the descriptors for the socket whose peer is passed have been closed
+void check_closed(socket_type& peer)
+{
+    std::array<std::uint8_t, 1> buff{};
+    error_code err;
+    peer.read_some(asio::buffer(buff), err);
+    BOOST_TEST(err == error_code(asio::error::eof));
+}
+
+// A socket and its peer, to send as the connection's socket
+struct sent_socket
+{
+    socket_type sock;
+    socket_type peer;
+
+    sent_socket(asio::io_context& ctx) : sock(ctx), peer(ctx) { asio::local::connect_pair(sock, peer); }
+};
+
+BOOST_FIXTURE_TEST_CASE(import_valid_message, fixture)
+{
+    // Sanity check for the message used by the tests below
+    sent_socket s(ctx);
+    send_handoff_message(sender, create_handoff_message(1, valid_caps), {s.sock.native_handle()});
+
+    connection<socket_type> imported(ctx);
+    import_connection(receiver, imported);
+    BOOST_TEST(imported.stream().is_open());
+}
+
+BOOST_FIXTURE_TEST_CASE(import_several_descriptors, fixture)
+{
+    // The extra descriptor is closed, too
+    sent_socket s1(ctx), s2(ctx);
+    send_handoff_message(
+        sender,
+        create_handoff_message(0, valid_caps),
+        {s1.sock.native_handle(), s2.sock.native_handle()}
+    );
+    s1.sock.close();
+    s2.sock.close();
+
+    connection<socket_type> imported(ctx);
+    error_code err;
+    import_connection(receiver, imported, err);
+    BOOST_TEST(err == error_code(client_errc::protocol_value_error));
+    BOOST_TEST(!imported.stream().is_open());
+    check_closed(s1.peer);
+    check_closed(s2.peer);
+}
+
+BOOST_FIXTURE_TEST_CASE(import_truncated_descriptors, fixture)
+{
+    // More descriptors than fit in the receiver's control buffer
+    std::vector<sent_socket> socks;
+    std::vector<int> fds;
+    socks.reserve(16);
+    for (int i = 0; i < 16; ++i)
+    {
+        socks.emplace_back(ctx);
+        fds.push_back(socks.back().sock.native_handle());
+    }
+    send_handoff_message(sender, create_handoff_message(0, valid_caps), fds);
+    for (auto& s : socks)
+        s.sock.close();
+
+    connection<socket_type> imported(ctx);
+    error_code err;
+    import_connection(receiver, imported, err);
+    BOOST_TEST(err == error_code(client_errc::protocol_value_error));
+    BOOST_TEST(!imported.stream().is_open());
+    for (auto& s : socks)
+        check_closed(s.peer);
+}
+
+BOOST_FIXTURE_TEST_CASE(import_invalid_state, fixture)
+{
+    struct
+    {
+        const char* name;
+        std::uint8_t flavor;
+        std::uint32_t caps;
+    } test_cases[] = {
+        {"invalid_flavor",                 2, valid_caps                          },
+        {"missing_mandatory_capabilities", 0, detail::CLIENT_PROTOCOL_41         },
+        {"tls",                            0, valid_caps | detail::CLIENT_SSL     },
+        {"unknown_capabilities",           0, valid_caps | detail::CLIENT_COMPRESS},
+    };
+
+    for (const auto& tc : test_cases)
+    {
+        BOOST_TEST_CONTEXT(tc.name)
+        {
+            sent_socket s(ctx);
+            auto msg = create_handoff_message(tc.flavor, tc.caps);
+            send_handoff_message(sender, msg, {s.sock.native_handle()});
+            s.sock.close();
+
+            connection<socket_type> imported(ctx);
+            error_code err;
+            import_connection(receiver, imported, err);
+            BOOST_TEST(err == error_code(client_errc::protocol_value_error));
+            BOOST_TEST(!imported.stream().is_open());
+            check_closed(s.peer);
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(import_eof, fixture)
+{
+    sender.close();
+
+    connection<socket_type> imported(ctx);
+    error_code err;
+    import_connection(receiver, imported, err);
+    BOOST_TEST(err == error_code(asio::error::eof));
+    BOOST_TEST(!imported.stream().is_open());
+}
+
+BOOST_FIXTURE_TEST_CASE(import_protocol_mismatch, fixture)
+{
+    export_connection(client, sender);
+
+    // A UNIX socket can't be used by a TCP connection
+    tcp_connection imported(ctx);
+    error_code err;
+    import_connection(receiver, imported, err);
+    BOOST_TEST(err == error_code(client_errc::protocol_value_error));
+    BOOST_TEST(!imported.stream().is_open());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -771,6 +771,86 @@ BOOST_AUTO_TEST_CASE(operator_stream)
     }
 }
 
+BOOST_AUTO_TEST_SUITE(hash)
+BOOST_AUTO_TEST_CASE(equal_fields_hash_equally)
+{
+    struct
+    {
+        const char* name;
+        field_view f1;
+        field_view f2;
+    } test_cases[] = {
+        {"null",                  field_view(),                   field_view()                  },
+        {"int64_int64",           field_view(42),                 field_view(42)                },
+        {"int64_uint64",          field_view(42),                 field_view(42u)               },
+        {"int64_uint64_zero",     field_view(0),                  field_view(0u)                },
+        {"uint64_uint64",         field_view(0xffffffffffffffffu), field_view(0xffffffffffffffffu)},
+        {"string",                field_view("abc"),              field_view("abc")             },
+        {"string_long",           field_view("some long string"), field_view("some long string")},
+        {"blob",                  field_view(makebv("\0\1\2")),    field_view(makebv("\0\1\2"))   },
+        {"float",                 field_view(4.2f),               field_view(4.2f)              },
+        {"float_zero_signs",      field_view(0.0f),               field_view(-0.0f)             },
+        {"double",                field_view(4.2),                field_view(4.2)               },
+        {"double_zero_signs",     field_view(0.0),                field_view(-0.0)              },
+        {"date",                  field_view(date(2020, 1, 2)),   field_view(date(2020, 1, 2))  },
+        {"datetime",
+         field_view(datetime(2020, 1, 2, 3, 4, 5, 6)),
+         field_view(datetime(2020, 1, 2, 3, 4, 5, 6))                                           },
+        {"time",                  field_view(maket(1, 2, 3)),     field_view(maket(1, 2, 3))    },
+    };
+
+    for (const auto& tc : test_cases)
+    {
+        BOOST_TEST_CONTEXT(tc.name)
+        {
+            BOOST_TEST_REQUIRE(tc.f1 == tc.f2);
+            BOOST_TEST(hash_value(tc.f1) == hash_value(tc.f2));
+            BOOST_TEST(std::hash<field_view>()(tc.f1) == hash_value(tc.f2));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(different_fields_hash_differently)
+{
+    // Hashes may collide in general, but shouldn't for these simple cases
+    auto fields = make_fv_vector(
+        nullptr,
+        0,
+        1,
+        -1,
+        "",
+        "a",
+        "b",
+        "ab",
+        "ba",
+        "012345678",
+        "012345679",
+        makebv("a"),
+        1.0f,
+        1.0,
+        date(2020, 1, 2),
+        date(2020, 2, 1),
+        datetime(2020, 1, 2),
+        datetime(2020, 1, 2, 0, 0, 0, 1),
+        maket(0, 0, 1)
+    );
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < fields.size(); ++j)
+        {
+            BOOST_TEST_CONTEXT(i << ", " << j) { BOOST_TEST(hash_value(fields[i]) != hash_value(fields[j])); }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(owning_field)
+{
+    field f("abc");
+    BOOST_TEST(hash_value(f) == hash_value(field_view("abc")));
+    BOOST_TEST(std::hash<field>()(f) == hash_value(f));
+}
+BOOST_AUTO_TEST_SUITE_END()
+
 // Make sure constxpr can actually be used in a constexpr context
 // C++14+ only
 #ifndef BOOST_NO_CXX14_CONSTEXPR
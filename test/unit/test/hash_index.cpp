@@ -0,0 +1,194 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/hash_index.hpp>
+#include <boost/mysql/rows.hpp>
+#include <boost/mysql/rows_view.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "test_common/create_basic.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+namespace {
+
+// Positions of the rows in a match range
+std::vector<std::size_t> indices(hash_index::match_range r)
+{
+    std::vector<std::size_t> res;
+    for (auto it = r.begin(); it != r.end(); ++it)
+        res.push_back(it.index());
+    return res;
+}
+
+using idx_vector = std::vector<std::size_t>;
+
+BOOST_AUTO_TEST_SUITE(test_hash_index)
+
+BOOST_AUTO_TEST_CASE(default_ctor)
+{
+    hash_index idx;
+    BOOST_TEST(idx.size() == 0u);
+    BOOST_TEST(idx.num_keys() == 0u);
+    BOOST_TEST(idx.rows().empty());
+    BOOST_TEST(idx.key_columns().empty());
+}
+
+BOOST_AUTO_TEST_CASE(empty_rows)
+{
+    rows r;
+    hash_index idx(r, {0});
+    BOOST_TEST(idx.size() == 0u);
+    BOOST_TEST(idx.num_keys() == 0u);
+    BOOST_TEST(idx.find({field_view(1)}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(unique_keys)
+{
+    auto r = makerows(2, 1, "one", 2, "two", 3, "three");
+    hash_index idx(r, {0});
+    BOOST_TEST(idx.size() == 3u);
+    BOOST_TEST(idx.num_keys() == 3u);
+    BOOST_TEST(idx.rows() == rows_view(r));
+    BOOST_TEST(idx.key_columns().size() == 1u);
+
+    auto m = idx.find({field_view(2)});
+    BOOST_TEST(!m.empty());
+    BOOST_TEST(m.size() == 1u);
+    BOOST_TEST(m.front() == makerow(2, "two"));
+    BOOST_TEST(indices(m) == idx_vector{1});
+
+    BOOST_TEST(idx.find({field_view(3)}).front().at(1) == field_view("three"));
+}
+
+BOOST_AUTO_TEST_CASE(missing_key)
+{
+    auto r = makerows(1, 1, 2, 3);
+    hash_index idx(r, {0});
+    BOOST_TEST(idx.find({field_view(4)}).empty());
+    BOOST_TEST(idx.find({field_view("1")}).empty());
+    BOOST_TEST(idx.find({field_view()}).empty());
+    BOOST_TEST(idx.find({field_view(4)}).size() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(duplicate_keys)
+{
+    auto r = makerows(2, "a", 0, "b", 1, "a", 2, "c", 3, "a", 4, "b", 5);
+    hash_index idx(r, {0});
+    BOOST_TEST(idx.size() == 6u);
+    BOOST_TEST(idx.num_keys() == 3u);
+
+    // Matches are returned in row order
+    BOOST_TEST(indices(idx.find({field_view("a")})) == (idx_vector{0, 2, 4}));
+    BOOST_TEST(indices(idx.find({field_view("b")})) == (idx_vector{1, 5}));
+    BOOST_TEST(indices(idx.find({field_view("c")})) == (idx_vector{3}));
+
+    std::vector<row_view> matches;
+    for (row_view rv : idx.find({field_view("b")}))
+        matches.push_back(rv);
+    BOOST_TEST_REQUIRE(matches.size() == 2u);
+    BOOST_TEST(matches[0] == makerow("b", 1));
+    BOOST_TEST(matches[1] == makerow("b", 5));
+}
+
+BOOST_AUTO_TEST_CASE(key_comparison)
+{
+    // Keys are compared like field_view::operator== does
+    auto r = makerows(2, 10u, "u64", nullptr, "null", 0.0, "zero");
+    hash_index idx(r, {0});
+    BOOST_TEST(indices(idx.find({field_view(10)})) == idx_vector{0});
+    BOOST_TEST(indices(idx.find({field_view()})) == idx_vector{1});
+    BOOST_TEST(indices(idx.find({field_view(-0.0)})) == idx_vector{2});
+    BOOST_TEST(idx.find({field_view(0.0f)}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(multi_column_key)
+{
+    auto r = makerows(3, "eu", 1, "x", "eu", 2, "y", "us", 1, "z", "eu", 1, "w");
+    hash_index idx(r, {1, 0});
+    BOOST_TEST(idx.num_keys() == 3u);
+    BOOST_TEST(indices(idx.find({field_view(1), field_view("eu")})) == (idx_vector{0, 3}));
+    BOOST_TEST(indices(idx.find({field_view(1), field_view("us")})) == idx_vector{2});
+    BOOST_TEST(idx.find({field_view("eu"), field_view(1)}).empty());
+    BOOST_TEST(idx.find({field_view(2), field_view("us")}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(span_key_columns)
+{
+    auto r = makerows(2, 1, "a", 2, "b");
+    std::vector<std::size_t> cols{1};
+    hash_index idx(r, cols);
+    std::vector<field_view> key{field_view("b")};
+    BOOST_TEST(indices(idx.find(key)) == idx_vector{1});
+}
+
+BOOST_AUTO_TEST_CASE(join)
+{
+    // customers: id, name
+    auto customers = makerows(2, 1, "alice", 2, "bob", 3, "carol");
+    // orders: id, customer_id, amount
+    auto orders = makerows(3, 100, 2, 10.0, 101, 1, 20.0, 102, 4, 30.0, 103, 2, 40.0);
+
+    hash_index idx(customers, {0});
+    std::vector<std::string> res;
+    for (row_view order : orders)
+    {
+        for (row_view customer : idx.find(order, {1}))
+            res.push_back(std::to_string(order.at(0).as_int64()) + ":" + std::string(customer.at(1).as_string()));
+    }
+    BOOST_TEST(res == (std::vector<std::string>{"100:bob", "101:alice", "103:bob"}));
+}
+
+BOOST_AUTO_TEST_CASE(probe_hash_matches_key_hash)
+{
+    auto r = makerows(3, "abc", 42, nullptr);
+    std::vector<field_view> key{r.at(0).at(1), r.at(0).at(0)};
+    hash_index idx(r, {1, 0});
+    BOOST_TEST(indices(idx.find(r.at(0), {1, 0})) == idx_vector{0});
+    BOOST_TEST(indices(idx.find(key)) == idx_vector{0});
+    BOOST_TEST(hash_index::hash_key(key) == hash_value(makerow(42, "abc")));
+}
+
+BOOST_AUTO_TEST_CASE(many_rows)
+{
+    // Enough rows to cause collisions and long probe sequences
+    std::vector<field_view> fields;
+    for (std::int64_t i = 0; i < 5000; ++i)
+    {
+        fields.push_back(field_view(i % 1000));
+        fields.push_back(field_view(i));
+    }
+    auto r = makerowsv(fields.data(), fields.size(), 2);
+    hash_index idx(r, {0});
+    BOOST_TEST(idx.size() == 5000u);
+    BOOST_TEST(idx.num_keys() == 1000u);
+    for (std::int64_t i = 0; i < 1000; ++i)
+    {
+        auto m = indices(idx.find({field_view(i)}));
+        auto expected = idx_vector{
+            static_cast<std::size_t>(i),
+            static_cast<std::size_t>(i + 1000),
+            static_cast<std::size_t>(i + 2000),
+            static_cast<std::size_t>(i + 3000),
+            static_cast<std::size_t>(i + 4000),
+        };
+        BOOST_TEST(m == expected);
+    }
+    BOOST_TEST(idx.find({field_view(1000)}).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
@@ -0,0 +1,167 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/histogram.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <limits>
+
+using namespace boost::mysql;
+
+BOOST_AUTO_TEST_SUITE(test_histogram)
+
+BOOST_AUTO_TEST_CASE(bucket_index)
+{
+    struct
+    {
+        std::uint64_t value;
+        std::size_t expected;
+    } test_cases[] = {
+        {0u,                                      0u                        },
+        {1u,                                      1u                        },
+        {7u,                                      7u                        },
+        {8u,                                      8u                        },
+        {9u,                                      9u                        },
+        {15u,                                     15u                       },
+        {16u,                                     16u                       },
+        {17u,                                     16u                       },
+        {18u,                                     17u                       },
+        {31u,                                     23u                       },
+        {32u,                                     24u                       },
+        {(std::numeric_limits<std::uint64_t>::max)(), histogram_num_buckets - 1u},
+    };
+
+    for (const auto& tc : test_cases)
+    {
+        BOOST_TEST_CONTEXT(tc.value)
+        {
+            BOOST_TEST(histogram::bucket_index(tc.value) == tc.expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bucket_bounds)
+{
+    // Buckets are contiguous and cover the whole range
+    BOOST_TEST(histogram::bucket_lower_bound(0) == 0u);
+    for (std::size_t i = 0; i < histogram_num_buckets; ++i)
+    {
+        BOOST_TEST_CONTEXT(i)
+        {
+            auto lower = histogram::bucket_lower_bound(i);
+            auto upper = histogram::bucket_upper_bound(i);
+            BOOST_TEST(lower <= upper);
+            BOOST_TEST(histogram::bucket_index(lower) == i);
+            BOOST_TEST(histogram::bucket_index(upper) == i);
+            if (i + 1 < histogram_num_buckets)
+                BOOST_TEST(histogram::bucket_lower_bound(i + 1) == upper + 1u);
+        }
+    }
+    BOOST_TEST(
+        histogram::bucket_upper_bound(histogram_num_buckets - 1) ==
+        (std::numeric_limits<std::uint64_t>::max)()
+    );
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+    histogram h;
+    auto snap = h.snapshot();
+    BOOST_TEST(snap.count() == 0u);
+    BOOST_TEST(snap.sum() == 0u);
+    BOOST_TEST(snap.max() == 0u);
+    BOOST_TEST(snap.bucket_counts().empty());
+    BOOST_TEST(snap.value_at_quantile(0.5) == 0u);
+
+    // Default constructed
+    BOOST_TEST(histogram_snapshot().value_at_quantile(0.99) == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(record)
+{
+    histogram h;
+    h.record(3);
+    h.record(100);
+    h.record(100);
+
+    auto snap = h.snapshot();
+    BOOST_TEST(snap.count() == 3u);
+    BOOST_TEST(snap.sum() == 203u);
+    BOOST_TEST(snap.max() == 100u);
+    BOOST_TEST_REQUIRE(snap.bucket_counts().size() == histogram_num_buckets);
+    BOOST_TEST(snap.bucket_counts()[3] == 1u);
+    BOOST_TEST(snap.bucket_counts()[histogram::bucket_index(100)] == 2u);
+}
+
+BOOST_AUTO_TEST_CASE(value_at_quantile)
+{
+    histogram h;
+    for (std::uint64_t i = 1; i <= 100; ++i)
+        h.record(i);
+    auto snap = h.snapshot();
+
+    // Exact in the linear range
+    BOOST_TEST(snap.value_at_quantile(0.0) == 1u);
+    BOOST_TEST(snap.value_at_quantile(0.05) == 5u);
+
+    // Upper bound of the bucket, so the result is >= the real value
+    // and within the bucket's relative error
+    auto p50 = snap.value_at_quantile(0.5);
+    BOOST_TEST(p50 >= 50u);
+    BOOST_TEST(p50 <= 56u);
+    auto p99 = snap.value_at_quantile(0.99);
+    BOOST_TEST(p99 >= 99u);
+    BOOST_TEST(p99 <= 100u);
+
+    // Capped to max
+    BOOST_TEST(snap.value_at_quantile(1.0) == 100u);
+
+    // Out of range quantiles are clamped
+    BOOST_TEST(snap.value_at_quantile(-1.0) == 1u);
+    BOOST_TEST(snap.value_at_quantile(2.0) == 100u);
+}
+
+BOOST_AUTO_TEST_CASE(reset)
+{
+    histogram h;
+    h.record(42);
+    h.reset();
+    auto snap = h.snapshot();
+    BOOST_TEST(snap.count() == 0u);
+    BOOST_TEST(snap.sum() == 0u);
+    BOOST_TEST(snap.max() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(merge)
+{
+    histogram h1, h2;
+    h1.record(1);
+    h1.record(10);
+    h2.record(1000);
+
+    auto snap = h1.snapshot();
+    snap.merge(h2.snapshot());
+    BOOST_TEST(snap.count() == 3u);
+    BOOST_TEST(snap.sum() == 1011u);
+    BOOST_TEST(snap.max() == 1000u);
+    BOOST_TEST(snap.bucket_counts()[1] == 1u);
+    BOOST_TEST(snap.bucket_counts()[histogram::bucket_index(1000)] == 1u);
+
+    // Merging into an empty snapshot
+    histogram_snapshot empty;
+    empty.merge(snap);
+    BOOST_TEST(empty.count() == 3u);
+    BOOST_TEST(empty.bucket_counts() == snap.bucket_counts());
+
+    // Merging an empty snapshot is a no-op
+    snap.merge(histogram_snapshot());
+    BOOST_TEST(snap.count() == 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
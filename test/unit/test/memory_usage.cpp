@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/execution_state.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/memory_usage.hpp>
+#include <boost/mysql/metadata_mode.hpp>
+#include <boost/mysql/results.hpp>
+#include <boost/mysql/row.hpp>
+#include <boost/mysql/rows.hpp>
+#include <boost/mysql/static_results.hpp>
+
+#include <boost/mysql/detail/config.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+
+#include "test_common/create_basic.hpp"
+#include "test_unit/create_execution_processor.hpp"
+#include "test_unit/create_meta.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/test_stream.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+BOOST_AUTO_TEST_SUITE(test_memory_usage)
+
+using test_connection = connection<test_stream>;
+
+// Long enough to never fit in a string's small buffer
+const std::string long_string(200, 'a');
+
+BOOST_AUTO_TEST_CASE(row_)
+{
+    row r;
+    BOOST_TEST(r.memory_usage() == 0u);
+
+    r = makerow(42, long_string);
+    BOOST_TEST(r.memory_usage() >= 2 * sizeof(field_view) + long_string.size());
+}
+
+BOOST_AUTO_TEST_CASE(rows_)
+{
+    rows r;
+    BOOST_TEST(r.memory_usage() == 0u);
+
+    r = makerows(1, long_string, long_string);
+    BOOST_TEST(r.memory_usage() >= 2 * sizeof(field_view) + 2 * long_string.size());
+
+    // Clearing keeps capacity
+    auto prev = r.memory_usage();
+    r = rows_view();
+    BOOST_TEST(r.memory_usage() == prev);
+}
+
+BOOST_AUTO_TEST_CASE(metadata_)
+{
+    // Strings are only copied in full metadata mode
+    results result;
+    exec_access(get_iface(result))
+        .reset(detail::resultset_encoding::text, metadata_mode::full)
+        .meta({meta_builder().type(column_type::varchar).name(long_string).build_coldef()})
+        .ok(ok_builder().build());
+    BOOST_TEST(result.meta()[0].memory_usage() >= long_string.size());
+}
+
+BOOST_AUTO_TEST_CASE(results_)
+{
+    results result;
+    BOOST_TEST(result.memory_usage() == 0u);
+
+    exec_access(get_iface(result))
+        .meta({meta_builder().type(column_type::varchar).build_coldef()})
+        .row(long_string)
+        .ok(ok_builder().info("info").build());
+    BOOST_TEST(result.memory_usage() >= sizeof(metadata) + sizeof(field_view) + long_string.size() + 4u);
+}
+
+BOOST_AUTO_TEST_CASE(execution_state_)
+{
+    execution_state st;
+    BOOST_TEST(st.memory_usage() == 0u);
+
+    exec_access(get_iface(st))
+        .meta({
+            meta_builder().type(column_type::varchar).build_coldef(),
+            meta_builder().type(column_type::int_).build_coldef(),
+        })
+        .ok(ok_builder().info("info").build());
+    BOOST_TEST(st.memory_usage() >= 2 * sizeof(metadata) + 4u);
+}
+
+#ifdef BOOST_MYSQL_CXX14
+BOOST_AUTO_TEST_CASE(static_results_)
+{
+    static_results<std::tuple<std::int32_t>> result;
+    BOOST_TEST(result.memory_usage() == 0u);
+
+    exec_access(get_iface(result))
+        .meta({meta_builder().type(column_type::int_).nullable(false).build_coldef()})
+        .row(42)
+        .row(43)
+        .ok(ok_builder().build());
+    BOOST_TEST(result.memory_usage() >= sizeof(metadata) + 2 * sizeof(std::tuple<std::int32_t>));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(connection_)
+{
+    test_connection conn(buffer_params(1024));
+    auto usage = conn.memory_usage();
+    BOOST_TEST(usage.read_buffer >= 1024u);
+    BOOST_TEST(usage.write_buffer == 0u);
+    BOOST_TEST(usage.shared_fields == 0u);
+    BOOST_TEST(usage.shared_diagnostics == 0u);
+    BOOST_TEST(usage.protocol_trace == 0u);
+
+    // Run an operation, so the write buffer gets allocated
+    conn.enable_protocol_trace(8);
+    conn.stream().add_bytes(create_ok_frame(1, ok_builder().build()));
+    conn.ping();
+
+    usage = conn.memory_usage();
+    BOOST_TEST(usage.write_buffer > 0u);
+    BOOST_TEST(usage.protocol_trace == 8 * sizeof(protocol_trace_record));
+    BOOST_TEST(
+        usage.total() == usage.read_buffer + usage.write_buffer + usage.shared_fields +
+                             usage.shared_diagnostics + usage.protocol_trace
+    );
+}
+
+BOOST_AUTO_TEST_CASE(accounted_memory_)
+{
+    auto before = accounted_memory();
+    {
+        row r = makerow(long_string);
+        if (memory_accounting_enabled)
+        {
+            BOOST_TEST(accounted_memory() == before + r.memory_usage());
+        }
+        else
+        {
+            BOOST_TEST(accounted_memory() == 0u);
+        }
+
+        // Moves transfer the accounted amount, copies add to it
+        row r2(std::move(r));
+        row r3(r2);
+        if (memory_accounting_enabled)
+            BOOST_TEST(accounted_memory() == before + r2.memory_usage() + r3.memory_usage());
+    }
+    BOOST_TEST(accounted_memory() == before);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
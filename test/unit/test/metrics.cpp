@@ -0,0 +1,271 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/connection_stats.hpp>
+#include <boost/mysql/metrics.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test_common/printing.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/test_stream.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+BOOST_AUTO_TEST_SUITE(test_metrics)
+
+using test_connection = connection<test_stream>;
+
+operation_info make_info(operation_type type, std::chrono::nanoseconds latency, error_code err = {})
+{
+    operation_info res;
+    res.type = type;
+    res.started = std::chrono::steady_clock::time_point();
+    res.finished = res.started + latency;
+    res.error = err;
+    return res;
+}
+
+bool contains(const std::string& haystack, const std::string& needle)
+{
+    return haystack.find(needle) != std::string::npos;
+}
+
+BOOST_AUTO_TEST_CASE(num_stripes)
+{
+    BOOST_TEST(metrics_observer().num_stripes() == 8u);
+    BOOST_TEST(metrics_observer(3).num_stripes() == 3u);
+    BOOST_TEST(metrics_observer(0).num_stripes() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(threads_get_exclusive_stripes)
+{
+    constexpr std::size_t num_threads = 4;
+    constexpr std::uint64_t ops_per_thread = 1000;
+    metrics_observer obs(1);
+
+    // Records values until all threads have recorded some
+    std::atomic<std::size_t> num_started{0};
+    auto record = [&obs, &num_started](std::uint64_t max_latency) {
+        for (std::uint64_t i = 1; i <= ops_per_thread; ++i)
+        {
+            auto latency = i == ops_per_thread ? max_latency : i;
+            obs.on_operation_finish(make_info(operation_type::execute, std::chrono::nanoseconds(latency)));
+            if (i == 1u)
+                ++num_started;
+        }
+        while (num_started.load() % num_threads)
+            std::this_thread::yield();
+    };
+
+    // Threads running concurrently get a stripe each
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; ++i)
+        threads.emplace_back(record, 100000 + i);
+    for (auto& t : threads)
+        t.join();
+    BOOST_TEST(obs.num_stripes() == num_threads);
+
+    // Stripes are released on thread exit, and reused by other threads
+    threads.clear();
+    for (std::size_t i = 0; i < num_threads; ++i)
+        threads.emplace_back(record, 200000 + i);
+    for (auto& t : threads)
+        t.join();
+    BOOST_TEST(obs.num_stripes() == num_threads);
+
+    // As every stripe has a single writer, the maximum is exact
+    auto snap = obs.snapshot();
+    const auto& exec = snap.operation(operation_type::execute);
+    BOOST_TEST(exec.latency.count() == 2u * num_threads * ops_per_thread);
+    BOOST_TEST(exec.latency.max() == 200000u + num_threads - 1u);
+}
+
+BOOST_AUTO_TEST_CASE(observer_destroyed_before_thread_exit)
+{
+    // The thread's stripe outlives the observer
+    std::atomic<bool> recorded{false}, destroyed{false};
+    std::unique_ptr<metrics_observer> obs(new metrics_observer(1));
+    std::thread t([&] {
+        obs->on_operation_finish(make_info(operation_type::ping, std::chrono::nanoseconds(10)));
+        recorded = true;
+        while (!destroyed.load())
+            std::this_thread::yield();
+    });
+    while (!recorded.load())
+        std::this_thread::yield();
+    BOOST_TEST(obs->snapshot().operation(operation_type::ping).latency.count() == 1u);
+    obs.reset();
+    destroyed = true;
+    t.join();
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+    metrics_observer obs;
+    auto snap = obs.snapshot();
+    for (const auto& op : snap.operations)
+    {
+        BOOST_TEST(op.latency.count() == 0u);
+        BOOST_TEST(op.errors == 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(record)
+{
+    metrics_observer obs(2);
+    obs.on_operation_finish(make_info(operation_type::execute, std::chrono::nanoseconds(100)));
+    obs.on_operation_finish(make_info(operation_type::execute, std::chrono::nanoseconds(300)));
+    obs.on_operation_finish(
+        make_info(operation_type::ping, std::chrono::nanoseconds(50), client_errc::incomplete_message)
+    );
+
+    auto snap = obs.snapshot();
+    const auto& exec = snap.operation(operation_type::execute);
+    BOOST_TEST(exec.latency.count() == 2u);
+    BOOST_TEST(exec.latency.sum() == 400u);
+    BOOST_TEST(exec.latency.max() == 300u);
+    BOOST_TEST(exec.errors == 0u);
+    const auto& ping = snap.operation(operation_type::ping);
+    BOOST_TEST(ping.latency.count() == 1u);
+    BOOST_TEST(ping.errors == 1u);
+    BOOST_TEST(snap.operation(operation_type::quit).latency.count() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(reset)
+{
+    metrics_observer obs;
+    obs.on_operation_finish(
+        make_info(operation_type::execute, std::chrono::nanoseconds(100), client_errc::incomplete_message)
+    );
+    obs.reset();
+
+    auto snap = obs.snapshot();
+    BOOST_TEST(snap.operation(operation_type::execute).latency.count() == 0u);
+    BOOST_TEST(snap.operation(operation_type::execute).errors == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(connection)
+{
+    metrics_observer obs;
+    test_connection conn;
+    conn.set_observer(&obs);
+    conn.stream().add_bytes(create_ok_frame(1, ok_builder().build()));
+
+    conn.ping();
+
+    auto snap = obs.snapshot();
+    BOOST_TEST(snap.operation(operation_type::ping).latency.count() == 1u);
+    BOOST_TEST(snap.operation(operation_type::ping).errors == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(openmetrics_operations)
+{
+    metrics_observer obs;
+    obs.on_operation_finish(make_info(operation_type::execute, std::chrono::microseconds(3)));
+    obs.on_operation_finish(make_info(operation_type::execute, std::chrono::milliseconds(2)));
+    obs.on_operation_finish(
+        make_info(operation_type::execute, std::chrono::minutes(5), client_errc::incomplete_message)
+    );
+
+    auto output = to_openmetrics(obs.snapshot());
+
+    // Histogram
+    BOOST_TEST(contains(output, "# TYPE boost_mysql_operation_duration_seconds histogram\n"));
+    BOOST_TEST(contains(
+        output,
+        "boost_mysql_operation_duration_seconds_bucket{operation=\"execute\",le=\"0.000001023\"} 0\n"
+    ));
+    BOOST_TEST(contains(
+        output,
+        "boost_mysql_operation_duration_seconds_bucket{operation=\"execute\",le=\"0.000004095\"} 1\n"
+    ));
+    BOOST_TEST(contains(
+        output,
+        "boost_mysql_operation_duration_seconds_bucket{operation=\"execute\",le=\"0.002097151\"} 2\n"
+    ));
+    BOOST_TEST(contains(
+        output,
+        "boost_mysql_operation_duration_seconds_bucket{operation=\"execute\",le=\"68.719476735\"} 2\n"
+    ));
+    BOOST_TEST(contains(
+        output,
+        "boost_mysql_operation_duration_seconds_bucket{operation=\"execute\",le=\"+Inf\"} 3\n"
+    ));
+    BOOST_TEST(contains(output, "boost_mysql_operation_duration_seconds_count{operation=\"execute\"} 3\n"));
+    BOOST_TEST(contains(output, "boost_mysql_operation_duration_seconds_sum{operation=\"execute\"} 300.002003\n"));
+
+    // Operations without samples are reported, too
+    BOOST_TEST(contains(output, "boost_mysql_operation_duration_seconds_count{operation=\"quit\"} 0\n"));
+    BOOST_TEST(contains(output, "boost_mysql_operation_duration_seconds_bucket{operation=\"quit\",le=\"+Inf\"} 0\n"));
+
+    // Errors
+    BOOST_TEST(contains(output, "# TYPE boost_mysql_operation_errors counter\n"));
+    BOOST_TEST(contains(output, "boost_mysql_operation_errors_total{operation=\"execute\"} 1\n"));
+    BOOST_TEST(contains(output, "boost_mysql_operation_errors_total{operation=\"ping\"} 0\n"));
+
+    // No connection counters
+    BOOST_TEST(!contains(output, "boost_mysql_connection"));
+
+    // Terminator
+    BOOST_TEST(output.substr(output.size() - 6) == "# EOF\n");
+}
+
+BOOST_AUTO_TEST_CASE(openmetrics_connection_stats)
+{
+    connection_stats st;
+    st.bytes_read = 100;
+    st.bytes_written = 20;
+    st.read_buffer_size = 1024;
+    st.io_time = std::chrono::milliseconds(1500);
+
+    auto output = to_openmetrics(metrics_snapshot(), st);
+
+    BOOST_TEST(contains(output, "# TYPE boost_mysql_connection_read_bytes counter\n"));
+    BOOST_TEST(contains(output, "boost_mysql_connection_read_bytes_total 100\n"));
+    BOOST_TEST(contains(output, "boost_mysql_connection_written_bytes_total 20\n"));
+    BOOST_TEST(contains(output, "boost_mysql_connection_rows_read_total 0\n"));
+    BOOST_TEST(contains(output, "boost_mysql_connection_io_seconds_total 1.5\n"));
+    BOOST_TEST(contains(output, "# TYPE boost_mysql_connection_read_buffer_bytes gauge\n"));
+    BOOST_TEST(contains(output, "boost_mysql_connection_read_buffer_bytes 1024\n"));
+    BOOST_TEST(contains(output, "boost_mysql_operation_errors_total{operation=\"execute\"} 0\n"));
+    BOOST_TEST(output.substr(output.size() - 6) == "# EOF\n");
+}
+
+BOOST_AUTO_TEST_CASE(connection_stats_add)
+{
+    connection_stats st1, st2;
+    st1.bytes_read = 10;
+    st1.read_buffer_size = 512;
+    st1.decode_time = std::chrono::nanoseconds(5);
+    st2.bytes_read = 20;
+    st2.rows_read = 3;
+    st2.read_buffer_size = 1024;
+    st2.decode_time = std::chrono::nanoseconds(7);
+
+    st1 += st2;
+
+    BOOST_TEST(st1.bytes_read == 30u);
+    BOOST_TEST(st1.rows_read == 3u);
+    BOOST_TEST(st1.read_buffer_size == 1536u);
+    BOOST_TEST(st1.decode_time.count() == 12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,260 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/common_server_errc.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/string_view.hpp>
+
+#include <boost/mysql/detail/execution_processor/execution_processor.hpp>
+#include <boost/mysql/detail/resultset_encoding.hpp>
+
+#include <boost/mysql/impl/internal/channel/channel.hpp>
+#include <boost/mysql/impl/internal/network_algorithms/execute_prepared_once.hpp>
+#include <boost/mysql/impl/internal/protocol/db_flavor.hpp>
+
+#include <boost/core/span.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "test_common/assert_buffer_equals.hpp"
+#include "test_common/buffer_concat.hpp"
+#include "test_unit/create_channel.hpp"
+#include "test_unit/create_coldef_frame.hpp"
+#include "test_unit/create_err.hpp"
+#include "test_unit/create_frame.hpp"
+#include "test_unit/create_meta.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/mock_execution_processor.hpp"
+#include "test_unit/printing.hpp"
+#include "test_unit/test_stream.hpp"
+#include "test_unit/unit_netfun_maker.hpp"
+
+using namespace boost::mysql::test;
+using namespace boost::mysql;
+using boost::span;
+using boost::mysql::detail::channel;
+using boost::mysql::detail::db_flavor;
+using boost::mysql::detail::execution_processor;
+using boost::mysql::detail::resultset_encoding;
+
+BOOST_AUTO_TEST_SUITE(test_execute_prepared_once)
+
+using netfun_maker = netfun_maker_fn<void, channel&, string_view, span<const field_view>, execution_processor&>;
+
+struct
+{
+    typename netfun_maker::signature execute;
+    const char* name;
+} all_fns[] = {
+    {netfun_maker::sync_errc(&detail::execute_prepared_once_impl),           "sync" },
+    {netfun_maker::async_errinfo(&detail::async_execute_prepared_once_impl), "async"}
+};
+
+struct fixture
+{
+    mock_execution_processor proc;
+    channel chan{create_channel()};
+    const field_view params[1]{field_view(42)};
+
+    fixture(db_flavor flavor) { chan.set_flavor(flavor); }
+
+    test_stream& stream() noexcept { return get_stream(chan); }
+};
+
+// Serialized requests for "SELECT ?", with the given statement ID and 42 as parameter
+constexpr std::uint8_t serialized_prepare[] = {0x16, 0x53, 0x45, 0x4c, 0x45, 0x43, 0x54, 0x20, 0x3f};
+
+std::vector<std::uint8_t> serialized_execute(std::uint8_t id)
+{
+    return {0x17, id,   id,   id,   id,   0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x08,
+            0x00, 0x2a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+}
+
+std::vector<std::uint8_t> serialized_close(std::uint8_t id) { return {0x19, id, id, id, id}; }
+
+std::vector<std::uint8_t> expected_requests(std::uint8_t id)
+{
+    return buffer_builder()
+        .add(create_frame(0, serialized_prepare))
+        .add(create_frame(0, serialized_execute(id)))
+        .add(create_frame(0, serialized_close(id)))
+        .build();
+}
+
+// A successful prepare response with the given number of params and no columns,
+// including param metadata
+std::vector<std::uint8_t> prepare_response(std::uint8_t id, std::uint8_t num_params)
+{
+    buffer_builder res;
+    res.add(create_frame(1, {0x00, id, id, id, id, 0x00, 0x00, num_params, 0x00, 0x00, 0x00, 0x00}));
+    for (std::uint8_t i = 0; i < num_params; ++i)
+    {
+        res.add(create_coldef_frame(
+            static_cast<std::uint8_t>(i + 2u),
+            meta_builder().type(column_type::bigint).build_coldef()
+        ));
+    }
+    return res.build();
+}
+
+BOOST_AUTO_TEST_CASE(mariadb_success)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix(db_flavor::mariadb);
+            fix.stream()
+                .add_bytes(prepare_response(1, 1))
+                .add_bytes(create_ok_frame(1, ok_builder().affected_rows(10u).info("abc").build()));
+
+            // Call the function
+            fns.execute(fix.chan, "SELECT ?", fix.params, fix.proc).validate_no_error();
+
+            // The three requests were sent together, using the "last statement" ID
+            BOOST_MYSQL_ASSERT_BUFFER_EQUALS(fix.stream().bytes_written(), expected_requests(0xff));
+            BOOST_TEST(fix.stream().num_unread_bytes() == 0u);
+
+            // We've read into the processor
+            fix.proc.num_calls().reset(1).on_head_ok_packet(1).validate();
+            BOOST_TEST(fix.proc.encoding() == resultset_encoding::binary);
+            BOOST_TEST(fix.proc.affected_rows() == 10u);
+            BOOST_TEST(fix.proc.info() == "abc");
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mariadb_prepare_error)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix(db_flavor::mariadb);
+            fix.stream()
+                .add_bytes(err_builder()
+                               .seqnum(1)
+                               .code(common_server_errc::er_parse_error)
+                               .message("bad syntax")
+                               .build_frame())
+                .add_bytes(err_builder()
+                               .seqnum(1)
+                               .code(common_server_errc::er_unknown_stmt_handler)
+                               .message("unknown statement")
+                               .build_frame());
+
+            // The prepare error is reported
+            fns.execute(fix.chan, "SELECT ?", fix.params, fix.proc)
+                .validate_error_exact(common_server_errc::er_parse_error, "bad syntax");
+
+            // The execution error was read, too
+            BOOST_MYSQL_ASSERT_BUFFER_EQUALS(fix.stream().bytes_written(), expected_requests(0xff));
+            BOOST_TEST(fix.stream().num_unread_bytes() == 0u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mariadb_wrong_num_params)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix(db_flavor::mariadb);
+            fix.stream()
+                .add_bytes(prepare_response(1, 2))
+                .add_bytes(err_builder()
+                               .seqnum(1)
+                               .code(common_server_errc::er_wrong_arguments)
+                               .message("wrong arguments")
+                               .build_frame());
+
+            // The mismatch is reported as a client error
+            fns.execute(fix.chan, "SELECT ?", fix.params, fix.proc)
+                .validate_error_exact(client_errc::wrong_num_params);
+            BOOST_TEST(fix.stream().num_unread_bytes() == 0u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mysql_success)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix(db_flavor::mysql);
+            fix.stream()
+                .add_bytes(prepare_response(3, 1))
+                .add_bytes(create_ok_frame(1, ok_builder().affected_rows(10u).info("abc").build()));
+
+            // Call the function
+            fns.execute(fix.chan, "SELECT ?", fix.params, fix.proc).validate_no_error();
+
+            // The three requests were sent, using the actual statement ID
+            BOOST_MYSQL_ASSERT_BUFFER_EQUALS(fix.stream().bytes_written(), expected_requests(3));
+            BOOST_TEST(fix.stream().num_unread_bytes() == 0u);
+
+            // We've read into the processor
+            fix.proc.num_calls().reset(1).on_head_ok_packet(1).validate();
+            BOOST_TEST(fix.proc.encoding() == resultset_encoding::binary);
+            BOOST_TEST(fix.proc.affected_rows() == 10u);
+            BOOST_TEST(fix.proc.info() == "abc");
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mysql_prepare_error)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix(db_flavor::mysql);
+            fix.stream().add_bytes(err_builder()
+                                       .seqnum(1)
+                                       .code(common_server_errc::er_parse_error)
+                                       .message("bad syntax")
+                                       .build_frame());
+
+            // Nothing else is sent
+            fns.execute(fix.chan, "SELECT ?", fix.params, fix.proc)
+                .validate_error_exact(common_server_errc::er_parse_error, "bad syntax");
+            BOOST_MYSQL_ASSERT_BUFFER_EQUALS(fix.stream().bytes_written(), create_frame(0, serialized_prepare));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(mysql_execute_error)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix(db_flavor::mysql);
+            fix.stream()
+                .add_bytes(prepare_response(3, 1))
+                .add_bytes(err_builder()
+                               .seqnum(1)
+                               .code(common_server_errc::er_bad_db_error)
+                               .message("no database")
+                               .build_frame());
+
+            // The execution error is reported, and the statement is closed anyway
+            fns.execute(fix.chan, "SELECT ?", fix.params, fix.proc)
+                .validate_error_exact(common_server_errc::er_bad_db_error, "no database");
+            BOOST_MYSQL_ASSERT_BUFFER_EQUALS(fix.stream().bytes_written(), expected_requests(3));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,252 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/common_server_errc.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/operation_observer.hpp>
+#include <boost/mysql/results.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "test_common/printing.hpp"
+#include "test_unit/create_coldef_frame.hpp"
+#include "test_unit/create_err.hpp"
+#include "test_unit/create_frame.hpp"
+#include "test_unit/create_meta.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/create_row_message.hpp"
+#include "test_unit/create_statement.hpp"
+#include "test_unit/test_stream.hpp"
+#include "test_unit/unit_netfun_maker.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+BOOST_AUTO_TEST_SUITE(test_operation_observer)
+
+using test_connection = connection<test_stream>;
+
+using query_netfun_maker = netfun_maker_mem<void, test_connection, const string_view&, results&>;
+using ping_netfun_maker = netfun_maker_mem<void, test_connection>;
+using close_stmt_netfun_maker = netfun_maker_mem<void, test_connection, const statement&>;
+
+struct
+{
+    query_netfun_maker::signature query;
+    ping_netfun_maker::signature ping;
+    close_stmt_netfun_maker::signature close_statement;
+    const char* name;
+} all_fns[] = {
+    {query_netfun_maker::sync_errc(&test_connection::execute),
+     ping_netfun_maker::sync_errc(&test_connection::ping),
+     close_stmt_netfun_maker::sync_errc(&test_connection::close_statement),
+     "sync" },
+    {query_netfun_maker::async_errinfo(&test_connection::async_execute),
+     ping_netfun_maker::async_errinfo(&test_connection::async_ping),
+     close_stmt_netfun_maker::async_errinfo(&test_connection::async_close_statement),
+     "async"},
+};
+
+struct recording_observer final : operation_observer
+{
+    std::vector<operation_info> started;
+    std::vector<operation_info> finished;
+
+    void on_operation_start(const operation_info& info) noexcept override { started.push_back(info); }
+    void on_operation_finish(const operation_info& info) noexcept override { finished.push_back(info); }
+};
+
+struct fixture
+{
+    test_connection conn;
+    recording_observer obs;
+
+    fixture() { conn.set_observer(&obs); }
+};
+
+BOOST_AUTO_TEST_CASE(set_observer)
+{
+    test_connection conn;
+    recording_observer obs;
+    BOOST_TEST(conn.observer() == nullptr);
+
+    conn.set_observer(&obs);
+    BOOST_TEST(conn.observer() == &obs);
+
+    conn.set_observer(nullptr);
+    BOOST_TEST(conn.observer() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(execute_rows)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix;
+            fix.conn.stream()
+                .add_bytes(create_frame(1, {0x01}))
+                .add_bytes(create_coldef_frame(2, meta_builder().type(column_type::bigint).build_coldef()))
+                .add_bytes(create_text_row_message(3, 42))
+                .add_bytes(create_text_row_message(4, 43))
+                .add_bytes(create_eof_frame(5, ok_builder().build()));
+
+            // Run the query
+            results result;
+            fns.query(fix.conn, "SELECT 1", result).validate_no_error();
+
+            // Start
+            BOOST_TEST_REQUIRE(fix.obs.started.size() == 1u);
+            const auto& start = fix.obs.started[0];
+            BOOST_TEST(start.type == operation_type::execute);
+            BOOST_TEST(start.query == "SELECT 1");
+            BOOST_TEST(start.statement_id == 0u);
+
+            // Finish
+            BOOST_TEST_REQUIRE(fix.obs.finished.size() == 1u);
+            const auto& finish = fix.obs.finished[0];
+            BOOST_TEST(finish.type == operation_type::execute);
+            BOOST_TEST(finish.error == error_code());
+            BOOST_TEST(finish.rows_read == 2u);
+            BOOST_TEST((finish.finished >= finish.started));
+
+            // Phases
+            BOOST_TEST(!finish.phase(operation_phase::tcp_connect).recorded());
+            BOOST_TEST(!finish.phase(operation_phase::tls_handshake).recorded());
+            BOOST_TEST(!finish.phase(operation_phase::authentication).recorded());
+            BOOST_TEST(finish.phase(operation_phase::request_write).recorded());
+            BOOST_TEST(finish.phase(operation_phase::first_byte).recorded());
+            BOOST_TEST(finish.phase(operation_phase::metadata_read).recorded());
+            BOOST_TEST(finish.phase(operation_phase::rows_read).recorded());
+            BOOST_TEST((
+                finish.phase(operation_phase::first_byte).begin ==
+                finish.phase(operation_phase::request_write).end
+            ));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(execute_error)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix;
+            fix.conn.stream().add_bytes(
+                err_builder().seqnum(1).code(common_server_errc::er_bad_db_error).message("my_message").build_frame()
+            );
+
+            // Run the query
+            results result;
+            fns.query(fix.conn, "SELECT 1", result)
+                .validate_error_exact(common_server_errc::er_bad_db_error, "my_message");
+
+            // Finish
+            BOOST_TEST_REQUIRE(fix.obs.finished.size() == 1u);
+            const auto& finish = fix.obs.finished[0];
+            BOOST_TEST(finish.error == common_server_errc::er_bad_db_error);
+            BOOST_TEST(finish.rows_read == 0u);
+            BOOST_TEST(finish.phase(operation_phase::request_write).recorded());
+            BOOST_TEST(finish.phase(operation_phase::first_byte).recorded());
+            BOOST_TEST(!finish.phase(operation_phase::rows_read).recorded());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ping)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix;
+            fix.conn.stream().add_bytes(create_ok_frame(1, ok_builder().build()));
+
+            fns.ping(fix.conn).validate_no_error();
+
+            BOOST_TEST_REQUIRE(fix.obs.finished.size() == 1u);
+            const auto& finish = fix.obs.finished[0];
+            BOOST_TEST(finish.type == operation_type::ping);
+            BOOST_TEST(finish.query == "");
+            BOOST_TEST(finish.phase(operation_phase::request_write).recorded());
+            BOOST_TEST(finish.phase(operation_phase::first_byte).recorded());
+            BOOST_TEST(!finish.phase(operation_phase::metadata_read).recorded());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(close_statement)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix;
+            auto stmt = statement_builder().id(3).build();
+
+            fns.close_statement(fix.conn, stmt).validate_no_error();
+
+            BOOST_TEST_REQUIRE(fix.obs.finished.size() == 1u);
+            const auto& finish = fix.obs.finished[0];
+            BOOST_TEST(finish.type == operation_type::close_statement);
+            BOOST_TEST(finish.statement_id == 3u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(several_operations)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix;
+            fix.conn.stream()
+                .add_bytes(create_ok_frame(1, ok_builder().build()))
+                .add_bytes(create_ok_frame(1, ok_builder().build()));
+
+            // Phases and counters from the first operation are not carried to the second one
+            results result;
+            fns.query(fix.conn, "SELECT 1", result).validate_no_error();
+            fns.ping(fix.conn).validate_no_error();
+
+            BOOST_TEST_REQUIRE(fix.obs.started.size() == 2u);
+            BOOST_TEST_REQUIRE(fix.obs.finished.size() == 2u);
+            BOOST_TEST(fix.obs.finished[0].type == operation_type::execute);
+            BOOST_TEST(fix.obs.finished[1].type == operation_type::ping);
+            BOOST_TEST((
+                fix.obs.finished[1].phase(operation_phase::request_write).begin >=
+                fix.obs.finished[0].finished
+            ));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(observer_removed)
+{
+    for (const auto& fns : all_fns)
+    {
+        BOOST_TEST_CONTEXT(fns.name)
+        {
+            fixture fix;
+            fix.conn.set_observer(nullptr);
+            fix.conn.stream().add_bytes(create_ok_frame(1, ok_builder().build()));
+
+            fns.ping(fix.conn).validate_no_error();
+
+            BOOST_TEST(fix.obs.started.size() == 0u);
+            BOOST_TEST(fix.obs.finished.size() == 0u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
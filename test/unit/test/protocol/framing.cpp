@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/impl/internal/protocol/framing.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "test_common/assert_buffer_equals.hpp"
+#include "test_common/buffer_concat.hpp"
+#include "test_unit/create_frame.hpp"
+
+using namespace boost::mysql::detail;
+using namespace boost::mysql::test;
+
+namespace {
+
+BOOST_AUTO_TEST_SUITE(test_framing)
+
+BOOST_AUTO_TEST_CASE(num_frames_)
+{
+    BOOST_TEST(num_frames(0u, 4u) == 1u);
+    BOOST_TEST(num_frames(3u, 4u) == 1u);
+    BOOST_TEST(num_frames(4u, 4u) == 2u);
+    BOOST_TEST(num_frames(5u, 4u) == 2u);
+    BOOST_TEST(num_frames(8u, 4u) == 3u);
+    BOOST_TEST(num_frames(0xfffffeu) == 1u);
+    BOOST_TEST(num_frames(0xffffffu) == 2u);
+}
+
+// Appends a framed message to buff, as the functions are meant to be used
+std::uint8_t add_message(
+    std::vector<std::uint8_t>& buff,
+    const std::vector<std::uint8_t>& payload,
+    std::uint8_t seqnum,
+    std::size_t max_frame_size
+)
+{
+    std::size_t offset = buff.size();
+    std::size_t payload_offset = reserve_framed_message(buff, payload.size(), max_frame_size);
+    BOOST_TEST(buff.size() == payload_offset + payload.size());
+    if (!payload.empty())
+        std::memcpy(buff.data() + payload_offset, payload.data(), payload.size());
+    return frame_message(buff.data() + offset, payload.size(), seqnum, max_frame_size);
+}
+
+BOOST_AUTO_TEST_CASE(frame_message_)
+{
+    struct
+    {
+        const char* name;
+        std::vector<std::uint8_t> payload;
+        std::vector<std::uint8_t> expected;
+    } test_cases[] = {
+        {"empty", {}, create_empty_frame(2)},
+        {"single_frame", {1, 2, 3}, create_frame(2, {1, 2, 3})},
+        {"exact_multiple", {1, 2, 3, 4}, concat_copy(create_frame(2, {1, 2, 3, 4}), create_empty_frame(3))},
+        {"several_frames",
+         {1, 2, 3, 4, 5, 6, 7, 8, 9},
+         concat_copy(
+             concat_copy(create_frame(2, {1, 2, 3, 4}), create_frame(3, {5, 6, 7, 8})),
+             create_frame(4, {9})
+         )},
+    };
+
+    for (const auto& tc : test_cases)
+    {
+        BOOST_TEST_CONTEXT(tc.name)
+        {
+            // Messages are appended to the existing contents, which are not modified
+            std::vector<std::uint8_t> buff{0xaa, 0xbb};
+            auto seqnum = add_message(buff, tc.payload, 2, 4u);
+            BOOST_TEST(seqnum == 2u + num_frames(tc.payload.size(), 4u));
+            BOOST_MYSQL_ASSERT_BUFFER_EQUALS(buff, concat_copy({0xaa, 0xbb}, tc.expected));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(frame_message_seqnum_wraps)
+{
+    std::vector<std::uint8_t> buff;
+    auto seqnum = add_message(buff, {1, 2, 3, 4, 5}, 0xff, 4u);
+    BOOST_TEST(seqnum == 1u);
+    BOOST_MYSQL_ASSERT_BUFFER_EQUALS(
+        buff,
+        concat_copy(create_frame(0xff, {1, 2, 3, 4}), create_frame(0, {5}))
+    );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
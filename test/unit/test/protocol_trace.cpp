@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/common_server_errc.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/protocol_trace.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "test_common/printing.hpp"
+#include "test_unit/create_err.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/test_stream.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+BOOST_AUTO_TEST_SUITE(test_protocol_trace)
+
+using test_connection = connection<test_stream>;
+
+void append_message(protocol_trace& trace, std::uint8_t seqnum, std::vector<std::uint8_t> payload)
+{
+    trace.append(trace_direction::read, seqnum, seqnum, payload.data(), payload.size());
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+    protocol_trace trace(3);
+    BOOST_TEST(trace.capacity() == 3u);
+    BOOST_TEST(trace.size() == 0u);
+    BOOST_TEST(trace.total_records() == 0u);
+    BOOST_TEST(trace.records().empty());
+
+    // Zero capacity is treated as one
+    BOOST_TEST(protocol_trace(0).capacity() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(append)
+{
+    protocol_trace trace(3);
+    auto tp = std::chrono::steady_clock::now();
+    const std::uint8_t payload[] = {0x03, 0x41, 0x42};
+    trace.append(trace_direction::write, 250, 252, payload, sizeof(payload), tp);
+
+    BOOST_TEST_REQUIRE(trace.size() == 1u);
+    const auto& rec = trace[0];
+    BOOST_TEST((rec.timestamp == tp));
+    BOOST_TEST(rec.direction == trace_direction::write);
+    BOOST_TEST(rec.seqnum == 250u);
+    BOOST_TEST(rec.num_frames == 3u);
+    BOOST_TEST(rec.size == 3u);
+    BOOST_TEST(rec.prefix_size == 3u);
+    BOOST_TEST(rec.prefix[0] == 0x03);
+    BOOST_TEST(rec.prefix[2] == 0x42);
+}
+
+BOOST_AUTO_TEST_CASE(append_seqnum_wrap)
+{
+    protocol_trace trace(1);
+    trace.append(trace_direction::read, 255, 1, nullptr, 0);
+    BOOST_TEST(trace[0].num_frames == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(prefix_truncated)
+{
+    protocol_trace trace(1);
+    std::vector<std::uint8_t> payload(100, 0xab);
+    trace.append(trace_direction::read, 0, 0, payload.data(), payload.size());
+    BOOST_TEST(trace[0].size == 100u);
+    BOOST_TEST(trace[0].prefix_size == protocol_trace_prefix_size);
+}
+
+BOOST_AUTO_TEST_CASE(wrap_around)
+{
+    protocol_trace trace(3);
+    for (std::uint8_t i = 0; i < 5; ++i)
+        append_message(trace, i, {i});
+
+    // Only the last 3 are kept, oldest first
+    BOOST_TEST(trace.size() == 3u);
+    BOOST_TEST(trace.total_records() == 5u);
+    BOOST_TEST(trace[0].seqnum == 2u);
+    BOOST_TEST(trace[1].seqnum == 3u);
+    BOOST_TEST(trace[2].seqnum == 4u);
+
+    auto records = trace.records();
+    BOOST_TEST_REQUIRE(records.size() == 3u);
+    BOOST_TEST(records[0].seqnum == 2u);
+    BOOST_TEST(records[2].seqnum == 4u);
+}
+
+BOOST_AUTO_TEST_CASE(clear)
+{
+    protocol_trace trace(2);
+    append_message(trace, 0, {});
+    append_message(trace, 1, {});
+    append_message(trace, 2, {});
+    trace.clear();
+    BOOST_TEST(trace.size() == 0u);
+    BOOST_TEST(trace.total_records() == 0u);
+
+    append_message(trace, 3, {});
+    BOOST_TEST_REQUIRE(trace.size() == 1u);
+    BOOST_TEST(trace[0].seqnum == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(connection_enable_disable)
+{
+    test_connection conn;
+    BOOST_TEST(conn.get_protocol_trace() == nullptr);
+
+    conn.enable_protocol_trace(10);
+    BOOST_TEST_REQUIRE(conn.get_protocol_trace() != nullptr);
+    BOOST_TEST(conn.get_protocol_trace()->capacity() == 10u);
+
+    conn.disable_protocol_trace();
+    BOOST_TEST(conn.get_protocol_trace() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(connection_messages)
+{
+    test_connection conn;
+    conn.enable_protocol_trace();
+    conn.stream().add_bytes(create_ok_frame(1, ok_builder().build()));
+
+    conn.ping();
+
+    const auto* trace = conn.get_protocol_trace();
+    BOOST_TEST_REQUIRE(trace->size() == 2u);
+
+    // COM_PING
+    BOOST_TEST((*trace)[0].direction == trace_direction::write);
+    BOOST_TEST((*trace)[0].seqnum == 0u);
+    BOOST_TEST((*trace)[0].size == 1u);
+    BOOST_TEST((*trace)[0].prefix[0] == 0x0e);
+
+    // OK packet
+    BOOST_TEST((*trace)[1].direction == trace_direction::read);
+    BOOST_TEST((*trace)[1].seqnum == 1u);
+    BOOST_TEST((*trace)[1].prefix[0] == 0x00);
+}
+
+BOOST_AUTO_TEST_CASE(format)
+{
+    protocol_trace trace(4);
+    auto tp = std::chrono::steady_clock::now();
+    const std::uint8_t query[] = {0x03, 0x53, 0x45};
+    trace.append(trace_direction::write, 0, 0, query, sizeof(query), tp - std::chrono::microseconds(15));
+    std::vector<std::uint8_t> big(20, 0xff);
+    trace.append(trace_direction::read, 1, 1, big.data(), big.size(), tp);
+
+    auto output = format_protocol_trace(trace);
+    BOOST_TEST(output.find("protocol trace: 2 records (2 total)\n") == 0u);
+    BOOST_TEST(output.find("-15us C->S seq=0   frames=1   size=3         | 03 53 45\n") != std::string::npos);
+    BOOST_TEST(output.find("0us S->C seq=1   frames=1   size=20        | ff ff") != std::string::npos);
+    BOOST_TEST(output.find(" ff ...\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(format_empty)
+{
+    protocol_trace trace(4);
+    BOOST_TEST(format_protocol_trace(trace) == "protocol trace: 0 records (0 total)\n");
+}
+
+BOOST_AUTO_TEST_CASE(format_error)
+{
+    // Run an operation that fails
+    test_connection conn;
+    conn.enable_protocol_trace();
+    conn.stream().add_bytes(
+        err_builder().seqnum(1).code(common_server_errc::er_bad_db_error).message("Unknown database").build_frame()
+    );
+    error_code ec;
+    diagnostics diag;
+    conn.ping(ec, diag);
+    BOOST_TEST_REQUIRE(ec == common_server_errc::er_bad_db_error);
+
+    auto output = format_protocol_trace(*conn.get_protocol_trace(), ec, diag);
+    BOOST_TEST(output.find("error: ") == 0u);
+    BOOST_TEST(output.find("[mysql.common-server:1049]\n") != std::string::npos);
+    BOOST_TEST(output.find("server message: Unknown database\n") != std::string::npos);
+    BOOST_TEST(output.find("client message") == std::string::npos);
+    BOOST_TEST(output.find("protocol trace: 2 records (2 total)\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,275 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/common_server_errc.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/query_digest.hpp>
+#include <boost/mysql/results.hpp>
+
+#include <boost/mysql/detail/normalize_query.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <string>
+
+#include "test_common/printing.hpp"
+#include "test_unit/create_coldef_frame.hpp"
+#include "test_unit/create_err.hpp"
+#include "test_unit/create_frame.hpp"
+#include "test_unit/create_meta.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/create_row_message.hpp"
+#include "test_unit/test_stream.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+BOOST_AUTO_TEST_SUITE(test_query_digest)
+
+using test_connection = connection<test_stream>;
+
+operation_info make_info(
+    operation_type type,
+    string_view query,
+    std::uint32_t stmt_id = 0,
+    std::chrono::microseconds latency = std::chrono::microseconds(10)
+)
+{
+    operation_info res;
+    res.type = type;
+    res.query = query;
+    res.statement_id = stmt_id;
+    res.started = std::chrono::steady_clock::time_point();
+    res.finished = res.started + latency;
+    return res;
+}
+
+BOOST_AUTO_TEST_CASE(normalize_query)
+{
+    struct
+    {
+        const char* name;
+        string_view input;
+        string_view expected;
+    } test_cases[] = {
+        {"empty",              "",                                     ""                                  },
+        {"keywords",           "SELECT a FROM t",                      "SELECT a FROM t"                   },
+        {"whitespace",         "  SELECT\n\ta  \r\nFROM   t ",          "SELECT a FROM t"                   },
+        {"integer",            "SELECT 42",                            "SELECT ?"                          },
+        {"decimal",            "SELECT 4.2e-3, .5",                    "SELECT ..."                        },
+        {"hex_number",         "SELECT 0xABCD",                        "SELECT ?"                          },
+        {"bit_number",         "SELECT 0b0101",                        "SELECT ?"                          },
+        {"single_quoted",      "WHERE a = 'it''s \\' ok'",             "WHERE a = ?"                       },
+        {"double_quoted",      "WHERE a = \"abc\"",                    "WHERE a = ?"                       },
+        {"hex_string",         "WHERE a = X'0A'",                      "WHERE a = ?"                       },
+        {"national_string",    "WHERE a = N'abc'",                     "WHERE a = ?"                       },
+        {"placeholder",        "WHERE a = ?",                          "WHERE a = ?"                       },
+        {"identifier_digits",  "SELECT 1a FROM t2",                    "SELECT 1a FROM t2"                 },
+        {"backticks",          "SELECT `col 1` FROM `t`",              "SELECT `col 1` FROM `t`"           },
+        {"qualified",          "SELECT t.a FROM db.t",                 "SELECT t . a FROM db . t"          },
+        {"in_list",            "WHERE a IN (1, 2, 3)",                 "WHERE a IN ( ... )"                },
+        {"values",             "VALUES (1,'a'),(2,'b')",               "VALUES ( ... ) , ( ... )"          },
+        {"operators",          "WHERE a<=1 AND b<>2 OR c!=3",          "WHERE a <= ? AND b <> ? OR c != ?" },
+        {"null_safe_eq",       "WHERE a<=>NULL",                       "WHERE a <=> NULL"                  },
+        {"json",               "SELECT doc->>'$.a'",                   "SELECT doc ->> ?"                  },
+        {"hash_comment",       "SELECT 1 # comment\nFROM t",           "SELECT ? FROM t"                   },
+        {"dash_comment",       "SELECT 1 -- comment\nFROM t",          "SELECT ? FROM t"                   },
+        {"not_a_comment",      "SELECT 1--1",                          "SELECT ? - - ?"                    },
+        {"block_comment",      "SELECT /* hint */ 1",                  "SELECT ?"                          },
+        {"unterminated",       "SELECT 'abc",                          "SELECT ?"                          },
+        {"unterminated_block", "SELECT /* abc",                        "SELECT"                            },
+        {"lone_dot",           "SELECT .",                             "SELECT ."                          },
+    };
+
+    std::string output;
+    for (const auto& tc : test_cases)
+    {
+        BOOST_TEST_CONTEXT(tc.name)
+        {
+            detail::normalize_query(tc.input, output);
+            BOOST_TEST(output == tc.expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(group_by_normalized_query)
+{
+    query_digest_table table;
+    table.record(make_info(operation_type::execute, "SELECT * FROM t WHERE id = 1"));
+    table.record(make_info(operation_type::execute, "SELECT *  FROM t WHERE id = 200"));
+    table.record(make_info(operation_type::execute, "SELECT * FROM t WHERE name = 'abc'"));
+
+    auto digests = table.snapshot();
+    BOOST_TEST_REQUIRE(digests.size() == 2u);
+    BOOST_TEST(digests[0].normalized_query == "SELECT * FROM t WHERE id = ?");
+    BOOST_TEST(digests[0].type == operation_type::execute);
+    BOOST_TEST(digests[0].statement_id == 0u);
+    BOOST_TEST(digests[0].latency.count() == 2u);
+    BOOST_TEST(digests[0].latency.sum() == 20000u);
+    BOOST_TEST(digests[1].normalized_query == "SELECT * FROM t WHERE name = ?");
+    BOOST_TEST(digests[1].latency.count() == 1u);
+    BOOST_TEST(digests[0].fingerprint != digests[1].fingerprint);
+    BOOST_TEST(table.num_dropped() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(group_by_statement_id)
+{
+    query_digest_table table;
+    table.record(make_info(operation_type::execute, "", 1));
+    table.record(make_info(operation_type::execute, "", 1));
+    table.record(make_info(operation_type::execute, "", 2));
+
+    auto digests = table.snapshot();
+    BOOST_TEST_REQUIRE(digests.size() == 2u);
+    BOOST_TEST(digests[0].statement_id == 1u);
+    BOOST_TEST(digests[0].normalized_query == "");
+    BOOST_TEST(digests[0].latency.count() == 2u);
+    BOOST_TEST(digests[1].statement_id == 2u);
+    BOOST_TEST(digests[1].latency.count() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(group_by_type)
+{
+    query_digest_table table;
+    table.record(make_info(operation_type::execute, "SELECT 1"));
+    table.record(make_info(operation_type::start_execution, "SELECT 1"));
+    table.record(make_info(operation_type::prepare_statement, "SELECT 1"));
+
+    auto digests = table.snapshot();
+    BOOST_TEST(digests.size() == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(ignored_types)
+{
+    query_digest_table table;
+    table.record(make_info(operation_type::ping, ""));
+    table.record(make_info(operation_type::close_statement, "", 1));
+    table.record(make_info(operation_type::connect, ""));
+
+    BOOST_TEST(table.snapshot().empty());
+    BOOST_TEST(table.num_dropped() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(stats)
+{
+    query_digest_table table;
+    auto info = make_info(operation_type::execute, "SELECT 1", 0, std::chrono::microseconds(20));
+    info.rows_read = 5;
+    info.bytes_read = 100;
+    table.record(info);
+    info.finished = info.started + std::chrono::microseconds(40);
+    info.rows_read = 0;
+    info.bytes_read = 50;
+    info.error = common_server_errc::er_bad_db_error;
+    table.record(info);
+
+    auto digests = table.snapshot();
+    BOOST_TEST_REQUIRE(digests.size() == 1u);
+    const auto& d = digests[0];
+    BOOST_TEST(d.errors == 1u);
+    BOOST_TEST(d.latency.count() == 2u);
+    BOOST_TEST(d.latency.sum() == 60000u);
+    BOOST_TEST(d.latency.max() == 40000u);
+    BOOST_TEST(d.rows.sum() == 5u);
+    BOOST_TEST(d.rows.max() == 5u);
+    BOOST_TEST(d.bytes_read.sum() == 150u);
+}
+
+BOOST_AUTO_TEST_CASE(sorted_by_total_latency)
+{
+    query_digest_table table;
+    table.record(make_info(operation_type::execute, "SELECT 1", 0, std::chrono::microseconds(10)));
+    table.record(make_info(operation_type::execute, "SELECT a", 0, std::chrono::microseconds(30)));
+    table.record(make_info(operation_type::execute, "SELECT b", 0, std::chrono::microseconds(20)));
+
+    auto digests = table.snapshot();
+    BOOST_TEST_REQUIRE(digests.size() == 3u);
+    BOOST_TEST(digests[0].normalized_query == "SELECT a");
+    BOOST_TEST(digests[1].normalized_query == "SELECT b");
+    BOOST_TEST(digests[2].normalized_query == "SELECT ?");
+}
+
+BOOST_AUTO_TEST_CASE(table_full)
+{
+    // A table with a single slot per shard
+    query_digest_table table(1);
+    BOOST_TEST(table.max_digests() == 16u);
+
+    // Insert many different digests. Some of them will map to a full shard
+    for (int i = 0; i < 200; ++i)
+    {
+        auto query = "SELECT c" + std::to_string(i);
+        table.record(make_info(operation_type::execute, query));
+    }
+
+    auto digests = table.snapshot();
+    BOOST_TEST(digests.size() <= 16u);
+    BOOST_TEST(digests.size() + table.num_dropped() == 200u);
+
+    // Digests already present are still recorded
+    auto num_dropped = table.num_dropped();
+    table.record(make_info(operation_type::execute, digests[0].normalized_query));
+    BOOST_TEST(table.num_dropped() == num_dropped);
+}
+
+BOOST_AUTO_TEST_CASE(observer)
+{
+    query_digest_table table;
+    query_digest_observer obs(table);
+    test_connection conn;
+    conn.set_observer(&obs);
+
+    // Two executions of an equivalent query
+    for (int i = 0; i < 2; ++i)
+    {
+        conn.stream()
+            .add_bytes(create_frame(1, {0x01}))
+            .add_bytes(create_coldef_frame(2, meta_builder().type(column_type::bigint).build_coldef()))
+            .add_bytes(create_text_row_message(3, 42))
+            .add_bytes(create_eof_frame(4, ok_builder().build()));
+    }
+    results result;
+    conn.execute("SELECT 1", result);
+    conn.execute("SELECT  2", result);
+
+    // Non-query operations are not recorded
+    conn.stream().add_bytes(create_ok_frame(1, ok_builder().build()));
+    conn.ping();
+
+    auto digests = table.snapshot();
+    BOOST_TEST_REQUIRE(digests.size() == 1u);
+    const auto& d = digests[0];
+    BOOST_TEST(d.normalized_query == "SELECT ?");
+    BOOST_TEST(d.errors == 0u);
+    BOOST_TEST(d.latency.count() == 2u);
+    BOOST_TEST(d.rows.sum() == 2u);
+    BOOST_TEST(d.bytes_read.sum() > 0u);
+}
+
+BOOST_AUTO_TEST_CASE(format)
+{
+    query_digest_table table;
+    table.record(make_info(operation_type::execute, "SELECT 1"));
+    table.record(make_info(operation_type::execute, "", 7, std::chrono::microseconds(5)));
+    table.record(make_info(operation_type::prepare_statement, "SELECT ?", 0, std::chrono::microseconds(1)));
+
+    auto output = format_query_digests(table.snapshot());
+    BOOST_TEST(output.find("count") != std::string::npos);
+    BOOST_TEST(output.find("  SELECT ?\n") != std::string::npos);
+    BOOST_TEST(output.find("  <statement 7>\n") != std::string::npos);
+    BOOST_TEST(output.find("  [prepare_statement] SELECT ?\n") != std::string::npos);
+    BOOST_TEST(output.find("SELECT ?\n") < output.find("<statement 7>"));
+
+    // Header only
+    auto empty_output = format_query_digests({});
+    BOOST_TEST(empty_output.find('\n') == empty_output.size() - 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,313 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/request_scheduler.hpp>
+
+#include <boost/mysql/detail/work_stealing_deque.hpp>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "test_unit/test_stream.hpp"
+
+using namespace boost::mysql;
+using boost::mysql::detail::work_stealing_deque;
+using boost::mysql::test::test_stream;
+
+namespace {
+
+BOOST_AUTO_TEST_SUITE(test_request_scheduler)
+
+using test_connection = connection<test_stream>;
+using scheduler_t = request_scheduler<test_stream>;
+
+BOOST_AUTO_TEST_CASE(deque_push_steal)
+{
+    int values[5]{};
+    work_stealing_deque<int> deq(3);
+    BOOST_TEST(deq.capacity() == 4u);
+    BOOST_TEST(deq.size() == 0u);
+    BOOST_TEST(deq.steal() == nullptr);
+
+    // Elements are returned in push order
+    BOOST_TEST(deq.push(&values[0]));
+    BOOST_TEST(deq.push(&values[1]));
+    BOOST_TEST(deq.size() == 2u);
+    BOOST_TEST(deq.steal() == &values[0]);
+    BOOST_TEST(deq.size() == 1u);
+
+    // Pushing to a full deque fails
+    BOOST_TEST(deq.push(&values[2]));
+    BOOST_TEST(deq.push(&values[3]));
+    BOOST_TEST(deq.push(&values[4]));
+    BOOST_TEST(!deq.push(&values[0]));
+    BOOST_TEST(deq.size() == 4u);
+
+    // Wrapping around works
+    BOOST_TEST(deq.steal() == &values[1]);
+    BOOST_TEST(deq.push(&values[0]));
+    BOOST_TEST(deq.steal() == &values[2]);
+    BOOST_TEST(deq.steal() == &values[3]);
+    BOOST_TEST(deq.steal() == &values[4]);
+    BOOST_TEST(deq.steal() == &values[0]);
+    BOOST_TEST(deq.steal() == nullptr);
+    BOOST_TEST(deq.size() == 0u);
+}
+
+// Records the requests that have been run, keeping their release handles
+struct request_log
+{
+    struct entry
+    {
+        int id;
+        test_connection* conn;
+        request_release_handle release;
+    };
+    std::vector<entry> entries;
+
+    scheduler_t::request_function make_request(int id)
+    {
+        return [this, id](test_connection& conn, request_release_handle release) {
+            entries.push_back(entry{id, &conn, release});
+        };
+    }
+};
+
+BOOST_AUTO_TEST_CASE(requests_wait_for_connections)
+{
+    boost::asio::io_context ctx;
+    test_connection conn1, conn2;
+    request_log log;
+    scheduler_t sched;
+    auto grp = sched.add_group(ctx.get_executor());
+    sched.add_connection(grp, conn1);
+    sched.add_connection(grp, conn2);
+    BOOST_TEST(sched.num_groups() == 1u);
+
+    // Nothing runs until the group's executor runs
+    for (int i = 0; i < 4; ++i)
+        sched.submit(log.make_request(i));
+    BOOST_TEST(log.entries.empty());
+
+    // Two requests run, one per connection
+    ctx.poll();
+    BOOST_TEST_REQUIRE(log.entries.size() == 2u);
+    BOOST_TEST(log.entries[0].id == 0);
+    BOOST_TEST(log.entries[1].id == 1);
+    BOOST_TEST(log.entries[0].conn != log.entries[1].conn);
+    BOOST_TEST(log.entries[0].release.group() == grp);
+
+    // Releasing a connection makes the next request run, in submission order
+    log.entries[1].release();
+    BOOST_TEST_REQUIRE(log.entries.size() == 3u);
+    BOOST_TEST(log.entries[2].id == 2);
+    BOOST_TEST(log.entries[2].conn == log.entries[1].conn);
+    log.entries[0].release();
+    BOOST_TEST_REQUIRE(log.entries.size() == 4u);
+    BOOST_TEST(log.entries[3].id == 3);
+    BOOST_TEST(log.entries[3].conn == log.entries[0].conn);
+    BOOST_TEST(sched.num_stolen() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(idle_groups_steal)
+{
+    boost::asio::io_context ctx1, ctx2;
+    test_connection conn1, conn2;
+    request_log log;
+    scheduler_t sched;
+    sched.add_group(ctx1.get_executor());
+    sched.add_group(ctx2.get_executor());
+    sched.add_connection(0, conn1);
+    sched.add_connection(1, conn2);
+
+    // Both requests are placed in the first group, which can only run one of them
+    sched.submit(0, log.make_request(0));
+    sched.submit(0, log.make_request(1));
+    ctx1.poll();
+    BOOST_TEST_REQUIRE(log.entries.size() == 1u);
+    BOOST_TEST(log.entries[0].conn == &conn1);
+
+    // The second group is woken up and steals the other one
+    ctx2.poll();
+    BOOST_TEST_REQUIRE(log.entries.size() == 2u);
+    BOOST_TEST(log.entries[1].id == 1);
+    BOOST_TEST(log.entries[1].conn == &conn2);
+    BOOST_TEST(log.entries[1].release.group() == 1u);
+    BOOST_TEST(sched.num_stolen() == 1u);
+
+    // A group becoming idle steals, too
+    sched.submit(0, log.make_request(2));
+    ctx1.restart();
+    ctx1.poll();
+    BOOST_TEST(log.entries.size() == 2u);
+    log.entries[1].release();
+    BOOST_TEST_REQUIRE(log.entries.size() == 3u);
+    BOOST_TEST(log.entries[2].id == 2);
+    BOOST_TEST(log.entries[2].conn == &conn2);
+    BOOST_TEST(sched.num_stolen() == 2u);
+}
+
+BOOST_AUTO_TEST_CASE(synchronous_release)
+{
+    boost::asio::io_context ctx;
+    test_connection conn;
+    std::vector<int> ids;
+    scheduler_t sched(2);  // requests don't fit in the deque
+    sched.add_group(ctx.get_executor());
+    sched.add_connection(0, conn);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        sched.submit([&ids, i](test_connection&, request_release_handle release) {
+            ids.push_back(i);
+            release();
+        });
+    }
+    ctx.poll();
+    BOOST_TEST(ids == (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+BOOST_AUTO_TEST_CASE(request_throws)
+{
+    boost::asio::io_context ctx;
+    test_connection conn;
+    request_log log;
+    scheduler_t sched;
+    sched.add_group(ctx.get_executor());
+    sched.add_connection(0, conn);
+
+    // The exception propagates, and the connection is not lost
+    sched.submit([](test_connection&, request_release_handle) { throw std::runtime_error("fail"); });
+    sched.submit(log.make_request(0));
+    BOOST_CHECK_THROW(ctx.poll(), std::runtime_error);
+    ctx.restart();
+    ctx.poll();
+    BOOST_TEST_REQUIRE(log.entries.size() == 1u);
+    BOOST_TEST(log.entries[0].conn == &conn);
+
+    // A request that released its connection before throwing doesn't make it available twice
+    sched.submit([](test_connection&, request_release_handle release) {
+        release();
+        throw std::runtime_error("fail");
+    });
+    sched.submit(log.make_request(1));
+    sched.submit(log.make_request(2));
+    log.entries[0].release();
+    ctx.restart();
+    BOOST_CHECK_THROW(ctx.poll(), std::runtime_error);
+    ctx.restart();
+    ctx.poll();
+    BOOST_TEST_REQUIRE(log.entries.size() == 2u);
+    BOOST_TEST(log.entries[1].id == 1);
+    log.entries[1].release();
+    BOOST_TEST_REQUIRE(log.entries.size() == 3u);
+    BOOST_TEST(log.entries[2].id == 2);
+}
+
+BOOST_AUTO_TEST_CASE(pending_requests_destroyed)
+{
+    auto tracker = std::make_shared<int>(0);
+    boost::asio::io_context ctx;
+    {
+        test_connection conn;
+        scheduler_t sched(2);
+        sched.add_group(ctx.get_executor());
+        sched.add_connection(0, conn);
+
+        // Requests in the submission queue
+        for (int i = 0; i < 3; ++i)
+            sched.submit([tracker](test_connection&, request_release_handle) {});
+        BOOST_TEST(tracker.use_count() == 4);
+
+        // Requests in the deque and kept aside
+        ctx.poll();
+        for (int i = 0; i < 3; ++i)
+            sched.submit([tracker](test_connection&, request_release_handle) {});
+        ctx.restart();
+        ctx.poll();
+        BOOST_TEST(tracker.use_count() == 6);  // one request ran
+    }
+    BOOST_TEST(tracker.use_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(multithreaded)
+{
+    constexpr std::size_t num_groups = 4;
+    constexpr std::size_t conns_per_group = 2;
+    constexpr std::size_t num_requests = 10000;
+
+    struct group_data
+    {
+        boost::asio::io_context ctx;
+        std::array<test_connection, conns_per_group> conns;
+        std::array<std::atomic<bool>, conns_per_group> in_use{};
+    };
+    std::array<group_data, num_groups> groups;
+    std::atomic<std::size_t> num_run{0};
+    std::atomic<bool> overlapped{false};
+
+    scheduler_t sched(64);
+    for (auto& grp : groups)
+    {
+        auto idx = sched.add_group(grp.ctx.get_executor());
+        for (auto& conn : grp.conns)
+            sched.add_connection(idx, conn);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> guards;
+    for (auto& grp : groups)
+    {
+        guards.push_back(boost::asio::make_work_guard(grp.ctx));
+        threads.emplace_back([&grp] { grp.ctx.run(); });
+    }
+
+    // Most requests go to the first group, so others need to steal them
+    for (std::size_t i = 0; i < num_requests; ++i)
+    {
+        auto fn = [&](test_connection& conn, request_release_handle release) {
+            auto& grp = groups[release.group()];
+            std::size_t idx = static_cast<std::size_t>(&conn - grp.conns.data());
+            if (idx >= conns_per_group || grp.in_use[idx].exchange(true))
+                overlapped = true;
+            boost::asio::post(grp.ctx, [&grp, idx, release, &num_run] {
+                grp.in_use[idx] = false;
+                release();
+                ++num_run;
+            });
+        };
+        if (i % 8u)
+            sched.submit(0, fn);
+        else
+            sched.submit(fn);
+    }
+
+    // Wait for all requests to finish
+    while (num_run.load() < num_requests)
+        std::this_thread::yield();
+    guards.clear();
+    for (auto& t : threads)
+        t.join();
+
+    BOOST_TEST(num_run.load() == num_requests);
+    BOOST_TEST(!overlapped.load());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
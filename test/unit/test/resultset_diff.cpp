@@ -0,0 +1,250 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/diagnostics.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/execution_state.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/resultset_diff.hpp>
+#include <boost/mysql/rows.hpp>
+#include <boost/mysql/sort_rows.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "test_common/create_basic.hpp"
+#include "test_common/netfun_helpers.hpp"
+#include "test_common/printing.hpp"
+#include "test_unit/create_coldef_frame.hpp"
+#include "test_unit/create_frame.hpp"
+#include "test_unit/create_meta.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/create_row_message.hpp"
+#include "test_unit/test_stream.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+namespace {
+
+BOOST_AUTO_TEST_SUITE(test_resultset_diff)
+
+// Feeds each side in batches of the given size
+void run_diff(resultset_diff& diff, rows_view left, rows_view right, std::size_t batch_size)
+{
+    std::size_t left_pos = 0, right_pos = 0;
+    auto feed = [&](diff_side side, rows_view all, std::size_t& pos) {
+        if (!diff.needs_rows(side))
+            return;
+        if (pos == all.size())
+        {
+            diff.finish(side);
+            return;
+        }
+        std::size_t size = (std::min)(batch_size, all.size() - pos);
+        std::size_t ncols = all.num_columns();
+        diff.add_rows(side, makerowsv(all[pos].begin(), size * ncols, ncols));
+        pos += size;
+    };
+
+    while (!diff.done())
+    {
+        feed(diff_side::left, left, left_pos);
+        feed(diff_side::right, right, right_pos);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(equal)
+{
+    auto left = makerows(2, 1, "a", 2, "b", 3, "c", 4, "d");
+    auto right = makerows(2, 1, "a", 2, "b", 3, "c", 4, "d");
+
+    for (std::size_t batch_size : {1u, 2u, 3u, 10u})
+    {
+        BOOST_TEST_CONTEXT(batch_size)
+        {
+            resultset_diff diff({}, {0});
+            run_diff(diff, left, right, batch_size);
+            BOOST_TEST(diff.ranges().empty());
+            BOOST_TEST(diff.num_rows(diff_side::left) == 4u);
+            BOOST_TEST(diff.num_rows(diff_side::right) == 4u);
+            BOOST_TEST(diff.checksum(diff_side::left) == diff.checksum(diff_side::right));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(differences)
+{
+    // 2 differs, 3 is only in left, 4 only in right, 6 only in left, 7 only in right
+    auto left = makerows(2, 1, "a", 2, "b", 3, "c", 5, "e", 6, "f");
+    auto right = makerows(2, 1, "a", 2, "other", 4, "d", 5, "e", 7, "g");
+
+    for (std::size_t batch_size : {1u, 2u, 10u})
+    {
+        BOOST_TEST_CONTEXT(batch_size)
+        {
+            resultset_diff diff({}, {0});
+            run_diff(diff, left, right, batch_size);
+
+            BOOST_TEST_REQUIRE(diff.ranges().size() == 2u);
+            const auto& r0 = diff.ranges()[0];
+            BOOST_TEST(r0.first_key == makerow(2));
+            BOOST_TEST(r0.last_key == makerow(4));
+            BOOST_TEST(r0.left_rows == 2u);
+            BOOST_TEST(r0.right_rows == 2u);
+            const auto& r1 = diff.ranges()[1];
+            BOOST_TEST(r1.first_key == makerow(6));
+            BOOST_TEST(r1.last_key == makerow(7));
+            BOOST_TEST(r1.left_rows == 1u);
+            BOOST_TEST(r1.right_rows == 1u);
+
+            BOOST_TEST(diff.checksum(diff_side::left) != diff.checksum(diff_side::right));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(one_side_empty)
+{
+    rows left;
+    auto right = makerows(1, 1, 2, 3);
+    resultset_diff diff({}, {0});
+    run_diff(diff, left, right, 2);
+
+    BOOST_TEST_REQUIRE(diff.ranges().size() == 1u);
+    BOOST_TEST(diff.ranges()[0].first_key == makerow(1));
+    BOOST_TEST(diff.ranges()[0].last_key == makerow(3));
+    BOOST_TEST(diff.ranges()[0].left_rows == 0u);
+    BOOST_TEST(diff.ranges()[0].right_rows == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(both_empty)
+{
+    resultset_diff diff({}, {0});
+    BOOST_TEST(diff.needs_rows(diff_side::left));
+    diff.add_rows(diff_side::left, rows_view());
+    diff.finish(diff_side::left);
+    BOOST_TEST(!diff.done());
+    diff.finish(diff_side::right);
+    BOOST_TEST(diff.done());
+    BOOST_TEST(diff.ranges().empty());
+    BOOST_TEST(diff.checksum(diff_side::left) == diff.checksum(diff_side::right));
+}
+
+BOOST_AUTO_TEST_CASE(multi_column_descending_key)
+{
+    // Sorted by the second column descending, then by the first one
+    auto left = makerows(3, 1, 20, "a", 2, 10, "b", 3, 10, "c");
+    auto right = makerows(3, 1, 20, "a", 3, 10, "c");
+    resultset_diff diff({}, {sort_column(1, sort_order::descending), 0});
+    run_diff(diff, left, right, 1);
+
+    BOOST_TEST_REQUIRE(diff.ranges().size() == 1u);
+    BOOST_TEST(diff.ranges()[0].first_key == makerow(10, 2));
+    BOOST_TEST(diff.ranges()[0].last_key == makerow(10, 2));
+    BOOST_TEST(diff.ranges()[0].left_rows == 1u);
+    BOOST_TEST(diff.ranges()[0].right_rows == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(case_insensitive_key)
+{
+    // Under a case-insensitive collation, these keys match, but their rows don't
+    auto left = makerows(1, "abc", "def");
+    auto right = makerows(1, "ABC", "def");
+    std::vector<metadata> meta{meta_builder().type(column_type::varchar).collation_id(45).build()};
+    resultset_diff diff(meta, {0});
+    run_diff(diff, left, right, 10);
+
+    BOOST_TEST_REQUIRE(diff.ranges().size() == 1u);
+    BOOST_TEST(diff.ranges()[0].first_key == makerow("abc"));
+    BOOST_TEST(diff.ranges()[0].left_rows == 1u);
+    BOOST_TEST(diff.ranges()[0].right_rows == 1u);
+}
+
+// Running the comparison on connections
+using test_connection = connection<test_stream>;
+
+void add_resultset(test_connection& conn, const std::vector<std::int64_t>& ids)
+{
+    conn.stream()
+        .add_bytes(create_frame(1, {0x01}))
+        .add_bytes(create_coldef_frame(2, meta_builder().type(column_type::bigint).build_coldef()));
+    std::uint8_t seqnum = 3;
+    for (auto id : ids)
+        conn.stream().add_bytes(create_text_row_message(seqnum++, id));
+    conn.stream().add_bytes(create_eof_frame(seqnum++, ok_builder().build()));
+}
+
+BOOST_AUTO_TEST_CASE(diff_resultsets_sync)
+{
+    test_connection left, right;
+    add_resultset(left, {1, 2, 3, 5});
+    add_resultset(right, {1, 2, 4, 5});
+    execution_state left_st, right_st;
+    left.start_execution("SELECT", left_st);
+    right.start_execution("SELECT", right_st);
+
+    resultset_diff diff(left_st.meta(), {0});
+    diff_resultsets(left, left_st, right, right_st, diff);
+
+    BOOST_TEST(diff.done());
+    BOOST_TEST(left_st.complete());
+    BOOST_TEST(right_st.complete());
+    BOOST_TEST_REQUIRE(diff.ranges().size() == 1u);
+    BOOST_TEST(diff.ranges()[0].first_key == makerow(3));
+    BOOST_TEST(diff.ranges()[0].last_key == makerow(4));
+}
+
+BOOST_AUTO_TEST_CASE(diff_resultsets_async)
+{
+    test_connection left, right;
+    add_resultset(left, {1, 2, 3});
+    add_resultset(right, {1, 2, 3});
+    execution_state left_st, right_st;
+    left.start_execution("SELECT", left_st);
+    right.start_execution("SELECT", right_st);
+
+    resultset_diff diff(left_st.meta(), {0});
+    diagnostics diag;
+    error_code err = client_errc::wrong_num_params;
+    async_diff_resultsets(left, left_st, right, right_st, diff, diag, [&err](error_code ec) { err = ec; });
+    run_until_completion(left.get_executor());
+
+    BOOST_TEST(err == error_code());
+    BOOST_TEST(diff.done());
+    BOOST_TEST(diff.ranges().empty());
+    BOOST_TEST(diff.num_rows(diff_side::left) == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(diff_resultsets_error)
+{
+    test_connection left, right;
+    add_resultset(left, {1, 2, 3});
+    right.stream()
+        .add_bytes(create_frame(1, {0x01}))
+        .add_bytes(create_coldef_frame(2, meta_builder().type(column_type::bigint).build_coldef()))
+        .add_bytes(create_text_row_message(3, 1));  // the rest of the resultset never arrives
+    execution_state left_st, right_st;
+    left.start_execution("SELECT", left_st);
+    right.start_execution("SELECT", right_st);
+
+    resultset_diff diff(left_st.meta(), {0});
+    error_code err;
+    diagnostics diag;
+    diff_resultsets(left, left_st, right, right_st, diff, err, diag);
+    BOOST_TEST(err != error_code());
+    BOOST_TEST(!diff.done());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
@@ -0,0 +1,378 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/date.hpp>
+#include <boost/mysql/datetime.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/metadata_mode.hpp>
+#include <boost/mysql/row_filter.hpp>
+#include <boost/mysql/row_view.hpp>
+#include <boost/mysql/time.hpp>
+
+#include <boost/mysql/detail/execution_processor/execution_state_impl.hpp>
+#include <boost/mysql/detail/execution_processor/results_impl.hpp>
+#include <boost/mysql/detail/resultset_encoding.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "test_common/create_basic.hpp"
+#include "test_common/printing.hpp"
+#include "test_unit/create_execution_processor.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_row_message.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+using boost::mysql::detail::execution_state_impl;
+using boost::mysql::detail::output_ref;
+using boost::mysql::detail::results_impl;
+using boost::mysql::detail::resultset_encoding;
+
+BOOST_AUTO_TEST_SUITE(test_row_filter)
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+    row_filter filter;
+    BOOST_TEST(filter.empty());
+    BOOST_TEST(filter.size() == 0u);
+    BOOST_TEST(filter.matches(makerow(1, "abc")));
+    BOOST_TEST(filter.matches(makerow()));
+}
+
+BOOST_AUTO_TEST_CASE(integers)
+{
+    const std::uint64_t big = std::numeric_limits<std::uint64_t>::max();
+
+    // int64 and uint64 compare by value
+    BOOST_TEST(row_filter().equal(0, field_view(42)).matches(makerow(std::uint64_t(42))));
+    BOOST_TEST(row_filter().equal(0, field_view(std::uint64_t(42))).matches(makerow(42)));
+    BOOST_TEST(!row_filter().equal(0, field_view(42)).matches(makerow(43)));
+    BOOST_TEST(row_filter().not_equal(0, field_view(42)).matches(makerow(43)));
+    BOOST_TEST(row_filter().less(0, field_view(big)).matches(makerow(-1)));
+    BOOST_TEST(row_filter().greater(0, field_view(-1)).matches(makerow(big)));
+    BOOST_TEST(row_filter().less(0, field_view(-5)).matches(makerow(-10)));
+    BOOST_TEST(!row_filter().less(0, field_view(-10)).matches(makerow(-10)));
+    BOOST_TEST(row_filter().less_equal(0, field_view(-10)).matches(makerow(-10)));
+    BOOST_TEST(row_filter().greater_equal(0, field_view(0)).matches(makerow(std::uint64_t(0))));
+}
+
+BOOST_AUTO_TEST_CASE(floating_point)
+{
+    BOOST_TEST(row_filter().less(0, field_view(4.5)).matches(makerow(4)));
+    BOOST_TEST(row_filter().greater(0, field_view(4)).matches(makerow(4.5f)));
+    BOOST_TEST(row_filter().equal(0, field_view(2.0)).matches(makerow(std::uint64_t(2))));
+    BOOST_TEST(row_filter().equal(0, field_view(0.5f)).matches(makerow(0.5)));
+    BOOST_TEST(!row_filter().between(0, field_view(1.0), field_view(2.0)).matches(makerow(2.5)));
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    BOOST_TEST(!row_filter().not_equal(0, field_view(1.0)).matches(makerow(nan)));
+}
+
+BOOST_AUTO_TEST_CASE(strings_blobs)
+{
+    BOOST_TEST(row_filter().equal(0, field_view("abc")).matches(makerow("abc")));
+    BOOST_TEST(!row_filter().equal(0, field_view("abc")).matches(makerow("ABC")));
+    BOOST_TEST(row_filter().less(0, field_view("abd")).matches(makerow("abc")));
+    BOOST_TEST(row_filter().less(0, field_view("abc")).matches(makerow("ab")));
+    BOOST_TEST(row_filter().greater(0, field_view("")).matches(makerow("a")));
+    BOOST_TEST(row_filter().equal(0, field_view(makebv("\0\1"))).matches(makerow(makebv("\0\1"))));
+    BOOST_TEST(row_filter().less(0, field_view(makebv("\1"))).matches(makerow(makebv("\0\1"))));
+
+    // Strings and blobs are different kinds
+    BOOST_TEST(!row_filter().equal(0, field_view(makebv("abc"))).matches(makerow("abc")));
+}
+
+BOOST_AUTO_TEST_CASE(dates_times)
+{
+    auto filter = row_filter().between(0, field_view(date(2023, 1, 1)), field_view(date(2023, 12, 31)));
+    BOOST_TEST(filter.size() == 2u);
+    BOOST_TEST(filter.matches(makerow(date(2023, 1, 1))));
+    BOOST_TEST(filter.matches(makerow(date(2023, 6, 15))));
+    BOOST_TEST(filter.matches(makerow(date(2023, 12, 31))));
+    BOOST_TEST(!filter.matches(makerow(date(2022, 12, 31))));
+    BOOST_TEST(!filter.matches(makerow(date(2024, 1, 1))));
+    // Zero dates go first
+    BOOST_TEST(row_filter().less(0, field_view(date(2023, 1, 1))).matches(makerow(date())));
+
+    BOOST_TEST(row_filter()
+                   .greater(0, field_view(datetime(2023, 1, 1, 10, 0, 0, 0)))
+                   .matches(makerow(datetime(2023, 1, 1, 10, 0, 0, 1))));
+    BOOST_TEST(!row_filter()
+                    .greater(0, field_view(datetime(2023, 1, 2, 0, 0, 0, 0)))
+                    .matches(makerow(datetime(2023, 1, 1, 23, 59, 59, 999999))));
+
+    BOOST_TEST(row_filter().less(0, field_view(maket(1, 0, 0))).matches(makerow(-maket(1, 0, 0))));
+    BOOST_TEST(row_filter().equal(0, field_view(maket(10, 2, 3))).matches(makerow(maket(10, 2, 3))));
+
+    // Dates and datetimes are different kinds
+    BOOST_TEST(!row_filter().equal(0, field_view(date(2023, 1, 1))).matches(makerow(datetime(2023, 1, 1)))
+    );
+}
+
+BOOST_AUTO_TEST_CASE(nulls)
+{
+    BOOST_TEST(row_filter().is_null(0).matches(makerow(nullptr)));
+    BOOST_TEST(!row_filter().is_null(0).matches(makerow(0)));
+    BOOST_TEST(row_filter().is_not_null(0).matches(makerow(0)));
+    BOOST_TEST(!row_filter().is_not_null(0).matches(makerow(nullptr)));
+
+    // NULL never satisfies comparisons, on either side
+    BOOST_TEST(!row_filter().equal(0, field_view(1)).matches(makerow(nullptr)));
+    BOOST_TEST(!row_filter().not_equal(0, field_view(1)).matches(makerow(nullptr)));
+    BOOST_TEST(!row_filter().equal(0, field_view(nullptr)).matches(makerow(nullptr)));
+    BOOST_TEST(!row_filter().not_equal(0, field_view(nullptr)).matches(makerow(1)));
+}
+
+BOOST_AUTO_TEST_CASE(incompatible_kinds)
+{
+    BOOST_TEST(!row_filter().equal(0, field_view(1)).matches(makerow("1")));
+    BOOST_TEST(!row_filter().not_equal(0, field_view(1)).matches(makerow("1")));
+    BOOST_TEST(!row_filter().less(0, field_view("1")).matches(makerow(0)));
+}
+
+BOOST_AUTO_TEST_CASE(several_conditions)
+{
+    auto filter = row_filter().equal(1, field_view("active")).greater(0, field_view(10)).is_null(2);
+    BOOST_TEST(filter.size() == 3u);
+    BOOST_TEST(filter.matches(makerow(11, "active", nullptr)));
+    BOOST_TEST(!filter.matches(makerow(10, "active", nullptr)));
+    BOOST_TEST(!filter.matches(makerow(11, "inactive", nullptr)));
+    BOOST_TEST(!filter.matches(makerow(11, "active", 0)));
+
+    filter.clear();
+    BOOST_TEST(filter.empty());
+    BOOST_TEST(filter.matches(makerow(10, "inactive", 0)));
+}
+
+BOOST_AUTO_TEST_CASE(column_out_of_range)
+{
+    BOOST_TEST(!row_filter().is_null(2).matches(makerow(nullptr, nullptr)));
+    BOOST_TEST(!row_filter().not_equal(5, field_view(0)).matches(makerow(1)));
+}
+
+BOOST_AUTO_TEST_CASE(constants_are_copied)
+{
+    std::string value = "abc";
+    auto filter = row_filter().equal(0, field_view(value));
+    value = "xyz";
+    BOOST_TEST(filter.matches(makerow("abc")));
+    BOOST_TEST(!filter.matches(makerow("xyz")));
+}
+
+// Rows are discarded by results before being stored
+BOOST_AUTO_TEST_CASE(results_discards_rows)
+{
+    results_impl r;
+    r.set_row_filter(row_filter().greater_equal(0, field_view(5)));
+    r.reset(resultset_encoding::text, metadata_mode::minimal);
+
+    // First resultset: some rows match
+    add_meta(r, {column_type::bigint, column_type::varchar});
+    std::vector<field_view> fields;
+    auto r1 = create_text_row_body(1, "abc");
+    auto r2 = create_text_row_body(5, "def");
+    auto r3 = create_text_row_body(3, "ghi");
+    auto r4 = create_text_row_body(10, "jkl");
+    r.on_row_batch_start();
+    for (const auto* msg : {&r1, &r2, &r3, &r4})
+    {
+        auto err = r.on_row(*msg, output_ref(), fields);
+        BOOST_TEST_REQUIRE(err == error_code());
+    }
+    r.on_row_batch_finish();
+    add_ok(r, ok_builder().more_results(true).build());
+
+    // Second resultset: the filter only applies to the first one
+    add_meta(r, {column_type::bigint});
+    add_row(r, 0);
+    add_ok(r, ok_builder().build());
+
+    BOOST_TEST_REQUIRE(r.is_complete());
+    BOOST_TEST(r.num_resultsets() == 2u);
+    BOOST_TEST(r.get_rows(0) == makerows(2, 5, "def", 10, "jkl"));
+    BOOST_TEST(r.get_rows(1) == makerows(1, 0));
+    BOOST_TEST(fields.empty());  // unused
+
+    // The filter is kept on reset
+    r.reset(resultset_encoding::text, metadata_mode::minimal);
+    add_meta(r, {column_type::bigint});
+    add_row(r, 4);
+    add_row(r, 6);
+    add_ok(r, ok_builder().build());
+    BOOST_TEST(r.get_rows(0) == makerows(1, 6));
+
+    // Removing it makes all rows be stored
+    r.set_row_filter(row_filter());
+    r.reset(resultset_encoding::text, metadata_mode::minimal);
+    add_meta(r, {column_type::bigint});
+    add_row(r, 4);
+    add_ok(r, ok_builder().build());
+    BOOST_TEST(r.get_rows(0) == makerows(1, 4));
+}
+
+// Rows are discarded by execution_state before being returned
+BOOST_AUTO_TEST_CASE(execution_state_discards_rows)
+{
+    execution_state_impl st;
+    st.set_row_filter(row_filter().equal(1, field_view("def")));
+    st.reset(resultset_encoding::text, metadata_mode::minimal);
+    add_meta(st, {column_type::bigint, column_type::varchar});
+
+    std::vector<field_view> fields;
+    auto r1 = create_text_row_body(1, "abc");
+    auto r2 = create_text_row_body(2, "def");
+    auto r3 = create_text_row_body(3, "ghi");
+    st.on_row_batch_start();
+    for (const auto* msg : {&r1, &r2, &r3})
+    {
+        auto err = st.on_row(*msg, output_ref(), fields);
+        BOOST_TEST_REQUIRE(err == error_code());
+    }
+    st.on_row_batch_finish();
+
+    BOOST_TEST(fields.size() == 2u);
+    BOOST_TEST(makerowsv(fields.data(), fields.size(), 2) == makerows(2, 2, "def"));
+
+    // The filter only applies to the first resultset
+    auto err = st.on_row_ok_packet(ok_builder().more_results(true).build());
+    BOOST_TEST_REQUIRE(err == error_code());
+    add_meta(st, {column_type::bigint, column_type::varchar});
+    fields.clear();
+    st.on_row_batch_start();
+    err = st.on_row(r1, output_ref(), fields);
+    BOOST_TEST_REQUIRE(err == error_code());
+    st.on_row_batch_finish();
+    BOOST_TEST(makerowsv(fields.data(), fields.size(), 2) == makerows(2, 1, "abc"));
+}
+
+// OUT params are sent as a single row in a binary resultset, which may be the first one.
+// They're never filtered, even though this is only known after the row has been read
+const std::uint8_t binary_row_abc[] = {0x00, 0x00, 0x03, 0x61, 0x62, 0x63};
+
+BOOST_AUTO_TEST_CASE(results_out_params)
+{
+    for (bool ok_in_batch : {true, false})
+    {
+        BOOST_TEST_CONTEXT(ok_in_batch)
+        {
+            results_impl r;
+            r.set_row_filter(row_filter().equal(0, field_view("xyz")));
+            r.reset(resultset_encoding::binary, metadata_mode::minimal);
+            add_meta(r, {column_type::varchar});
+
+            // The row is restored once the OK packet tells it's OUT params
+            std::vector<field_view> fields;
+            r.on_row_batch_start();
+            auto err = r.on_row(binary_row_abc, output_ref(), fields);
+            BOOST_TEST_REQUIRE(err == error_code());
+            if (!ok_in_batch)
+                r.on_row_batch_finish();
+            err = r.on_row_ok_packet(ok_builder().out_params(true).more_results(true).build());
+            BOOST_TEST_REQUIRE(err == error_code());
+            if (ok_in_batch)
+                r.on_row_batch_finish();
+            add_ok(r, ok_builder().build());
+
+            BOOST_TEST_REQUIRE(r.is_complete());
+            BOOST_TEST(r.get_rows(0) == makerows(1, "abc"));
+            BOOST_TEST(r.get_out_params() == makerow("abc"));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(results_binary_not_out_params)
+{
+    results_impl r;
+    r.set_row_filter(row_filter().equal(0, field_view("xyz")));
+    r.reset(resultset_encoding::binary, metadata_mode::minimal);
+    add_meta(r, {column_type::varchar});
+
+    std::vector<field_view> fields;
+    r.on_row_batch_start();
+    auto err = r.on_row(binary_row_abc, output_ref(), fields);
+    BOOST_TEST_REQUIRE(err == error_code());
+    r.on_row_batch_finish();
+    add_ok(r, ok_builder().build());
+
+    BOOST_TEST_REQUIRE(r.is_complete());
+    BOOST_TEST(r.get_rows(0) == makerows(1));
+}
+
+BOOST_AUTO_TEST_CASE(results_binary_several_rows_discarded)
+{
+    results_impl r;
+    r.set_row_filter(row_filter().equal(0, field_view("xyz")));
+    r.reset(resultset_encoding::binary, metadata_mode::minimal);
+    add_meta(r, {column_type::varchar});
+
+    // Only the first discarded row is kept aside. Later ones don't use any storage
+    std::vector<field_view> fields;
+    r.on_row_batch_start();
+    auto err = r.on_row(binary_row_abc, output_ref(), fields);
+    BOOST_TEST_REQUIRE(err == error_code());
+    std::size_t usage = r.memory_usage();
+    std::vector<std::uint8_t> long_row{0x00, 0x00, 200};
+    long_row.resize(long_row.size() + 200u, 0x61);
+    for (int i = 0; i < 10; ++i)
+    {
+        err = r.on_row(long_row, output_ref(), fields);
+        BOOST_TEST_REQUIRE(err == error_code());
+    }
+    r.on_row_batch_finish();
+    BOOST_TEST(r.memory_usage() == usage);
+
+    // The resultset had several rows, so they aren't OUT params
+    err = r.on_row_ok_packet(ok_builder().more_results(true).build());
+    BOOST_TEST_REQUIRE(err == error_code());
+    add_ok(r, ok_builder().build());
+    BOOST_TEST_REQUIRE(r.is_complete());
+    BOOST_TEST(r.get_rows(0) == makerows(1));
+    BOOST_TEST(r.get_out_params() == row_view());
+}
+
+BOOST_AUTO_TEST_CASE(execution_state_out_params)
+{
+    execution_state_impl st;
+    st.set_row_filter(row_filter().equal(0, field_view("xyz")));
+    st.reset(resultset_encoding::binary, metadata_mode::minimal);
+    add_meta(st, {column_type::varchar});
+
+    // The row is discarded when read
+    std::vector<field_view> fields;
+    st.on_row_batch_start();
+    auto err = st.on_row(binary_row_abc, output_ref(), fields);
+    BOOST_TEST_REQUIRE(err == error_code());
+    st.on_row_batch_finish();
+    BOOST_TEST(fields.empty());
+
+    // And returned with the OK packet, read by the next operation
+    st.on_row_batch_start();
+    err = st.on_row_ok_packet(ok_builder().out_params(true).more_results(true).build());
+    BOOST_TEST_REQUIRE(err == error_code());
+    st.on_row_batch_finish();
+    BOOST_TEST(st.get_is_out_params());
+    BOOST_TEST(makerowsv(fields.data(), fields.size(), 1) == makerows(1, "abc"));
+}
+
+BOOST_AUTO_TEST_CASE(between_copies_both_values)
+{
+    // Both bounds are copied into the filter
+    std::string lower = "abc", upper = "abd";
+    auto filter = row_filter().between(0, field_view(lower), field_view(upper));
+    lower = upper = "zzz";
+    BOOST_TEST(filter.size() == 2u);
+    BOOST_TEST(filter.matches(makerow("abcd")));
+    BOOST_TEST(!filter.matches(makerow("zzz")));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
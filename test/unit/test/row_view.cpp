@@ -7,11 +7,13 @@
 
 #include <boost/mysql/field.hpp>
 #include <boost/mysql/field_view.hpp>
+#include <boost/mysql/row.hpp>
 #include <boost/mysql/row_view.hpp>
 
 #include <boost/test/unit_test.hpp>
 
 #include <cstddef>
+#include <functional>
 #include <stdexcept>
 #include <vector>
 
@@ -222,4 +224,20 @@ BOOST_AUTO_TEST_CASE(operator_equals)
     }
 }
 
+BOOST_AUTO_TEST_CASE(hash)
+{
+    auto f1 = make_fv_vector("test", 42, nullptr);
+    auto f2 = make_fv_vector("test", 42u, nullptr);  // equal to f1
+    auto f3 = make_fv_vector(42, "test", nullptr);   // same fields, different order
+    auto v1 = makerowv(f1.data(), f1.size());
+    auto v2 = makerowv(f2.data(), f2.size());
+    auto v3 = makerowv(f3.data(), f3.size());
+
+    BOOST_TEST(hash_value(v1) == hash_value(v2));
+    BOOST_TEST(hash_value(v1) != hash_value(v3));
+    BOOST_TEST(hash_value(row_view()) != hash_value(makerowv(f1.data(), 1)));
+    BOOST_TEST(std::hash<row_view>()(v1) == hash_value(v1));
+    BOOST_TEST(hash_value(row(v1)) == hash_value(v1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
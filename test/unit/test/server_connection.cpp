@@ -0,0 +1,401 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/common_server_errc.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/date.hpp>
+#include <boost/mysql/datetime.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/error_with_diagnostics.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/handshake_params.hpp>
+#include <boost/mysql/metadata_mode.hpp>
+#include <boost/mysql/results.hpp>
+#include <boost/mysql/server_command.hpp>
+#include <boost/mysql/server_connection.hpp>
+#include <boost/mysql/server_messages.hpp>
+#include <boost/mysql/statement.hpp>
+#include <boost/mysql/time.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "test_common/create_basic.hpp"
+#include "test_common/printing.hpp"
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+namespace asio = boost::asio;
+using std::chrono::microseconds;
+
+BOOST_AUTO_TEST_SUITE(test_server_connection)
+
+using socket_type = asio::local::stream_protocol::socket;
+
+// A client connection and a server connection talking to each other.
+// The client runs in a separate thread, using sync functions
+struct fixture
+{
+    asio::io_context ctx;
+    server_connection<socket_type> server{ctx};
+    connection<socket_type> client{ctx};
+
+    fixture() { asio::local::connect_pair(client.stream(), server.stream()); }
+
+    template <class Fn>
+    auto run_client(Fn fn) -> std::future<decltype(fn())>
+    {
+        return std::async(std::launch::async, fn);
+    }
+
+    // Performs the server side of a successful handshake
+    void accept_login()
+    {
+        server.handshake();
+        BOOST_TEST(server.check_password("pass"));
+        server.add_ok();
+        server.flush();
+    }
+};
+
+handshake_params client_params() { return handshake_params("user", "pass", "mydb"); }
+
+BOOST_FIXTURE_TEST_CASE(handshake_success, fixture)
+{
+    auto fut = run_client([this] { client.handshake(client_params()); });
+
+    server.handshake();
+    BOOST_TEST(server.login().username == "user");
+    BOOST_TEST(server.login().database == "mydb");
+    BOOST_TEST(server.login().auth_plugin_name == "mysql_native_password");
+    BOOST_TEST(server.check_password("pass"));
+    BOOST_TEST(!server.check_password("bad"));
+    BOOST_TEST(!server.check_password(""));
+    server.add_ok();
+    server.flush();
+
+    fut.get();
+}
+
+BOOST_FIXTURE_TEST_CASE(handshake_empty_password, fixture)
+{
+    auto fut = run_client([this] { client.handshake(handshake_params("user", "")); });
+
+    server.handshake();
+    BOOST_TEST(server.login().database == "");
+    BOOST_TEST(server.check_password(""));
+    BOOST_TEST(!server.check_password("pass"));
+    server.add_ok();
+    server.flush();
+
+    fut.get();
+}
+
+BOOST_FIXTURE_TEST_CASE(handshake_rejected, fixture)
+{
+    auto fut = run_client([this] {
+        error_code err;
+        diagnostics diag;
+        client.handshake(client_params(), err, diag);
+        BOOST_TEST(err == common_server_errc::er_access_denied_error);
+        BOOST_TEST(diag.server_message() == "Access denied");
+    });
+
+    server.handshake();
+    BOOST_TEST(!server.check_password("other"));
+    server.add_error(1045, "Access denied");
+    server.flush();
+
+    fut.get();
+}
+
+BOOST_FIXTURE_TEST_CASE(query_text_resultset, fixture)
+{
+    auto fut = run_client([this] {
+        client.set_meta_mode(metadata_mode::full);
+        client.handshake(client_params());
+        results result;
+        client.execute("SELECT * FROM mytable", result);
+        return result;
+    });
+    accept_login();
+
+    // Command
+    auto cmd = server.read_command();
+    BOOST_TEST((cmd.type == server_command_type::query));
+    BOOST_TEST(cmd.text == "SELECT * FROM mytable");
+
+    // Response
+    std::array<server_column, 9> columns{};
+    column_type types[] = {
+        column_type::bigint,
+        column_type::bigint,
+        column_type::varchar,
+        column_type::double_,
+        column_type::float_,
+        column_type::datetime,
+        column_type::time,
+        column_type::date,
+        column_type::bit,
+    };
+    for (std::size_t i = 0; i < columns.size(); ++i)
+        columns[i].type = types[i];
+    columns[0].name = "id";
+    columns[0].table = "mytable";
+    columns[1].is_unsigned = true;
+    columns[5].decimals = 3;
+    columns[6].decimals = 6;
+    server.add_resultset_head(columns);
+    server.add_row(make_fv_arr(
+        -42,
+        0xffffffffffffffffu,
+        "abc",
+        0.1,
+        4.2f,
+        datetime(2020, 1, 2, 10, 20, 30, 123000),
+        -(std::chrono::hours(100) + microseconds(5)),
+        date(2021, 12, 31),
+        0x1234u
+    ));
+    server.add_row(make_fv_arr(nullptr, 1u, "", -1e300, nullptr, nullptr, maket(0, 0, 0), nullptr, nullptr));
+    server.add_resultset_end(server_ok{0, 0, 2, "info"});
+    BOOST_TEST(server.pending_bytes() > 0u);
+    server.flush();
+    BOOST_TEST(server.pending_bytes() == 0u);
+
+    // Check the client got it right
+    auto result = fut.get();
+    BOOST_TEST_REQUIRE(result.meta().size() == 9u);
+    BOOST_TEST(result.meta()[0].column_name() == "id");
+    BOOST_TEST(result.meta()[0].table() == "mytable");
+    BOOST_TEST(result.meta()[1].is_unsigned());
+    for (std::size_t i = 0; i < columns.size(); ++i)
+        BOOST_TEST(result.meta()[i].type() == types[i]);
+    BOOST_TEST(
+        result.rows() ==
+        makerows(
+            9,
+            -42,
+            0xffffffffffffffffu,
+            "abc",
+            0.1,
+            4.2f,
+            datetime(2020, 1, 2, 10, 20, 30, 123000),
+            -(std::chrono::hours(100) + microseconds(5)),
+            date(2021, 12, 31),
+            0x1234u,
+            nullptr,
+            1u,
+            "",
+            -1e300,
+            nullptr,
+            nullptr,
+            maket(0, 0, 0),
+            nullptr,
+            nullptr
+        )
+    );
+    BOOST_TEST(result.warning_count() == 2u);
+    BOOST_TEST(result.info() == "info");
+}
+
+BOOST_FIXTURE_TEST_CASE(query_ok, fixture)
+{
+    auto fut = run_client([this] {
+        client.handshake(client_params());
+        results result;
+        client.execute("DELETE FROM mytable", result);
+        return result;
+    });
+    accept_login();
+
+    auto cmd = server.read_command();
+    BOOST_TEST(cmd.text == "DELETE FROM mytable");
+    server.add_ok(server_ok{10, 20, 0, ""});
+    server.flush();
+
+    auto result = fut.get();
+    BOOST_TEST(result.rows().empty());
+    BOOST_TEST(result.affected_rows() == 10u);
+    BOOST_TEST(result.last_insert_id() == 20u);
+}
+
+BOOST_FIXTURE_TEST_CASE(query_error, fixture)
+{
+    auto fut = run_client([this] {
+        client.handshake(client_params());
+        results result;
+        error_code err;
+        diagnostics diag;
+        client.execute("SELECT bad", result, err, diag);
+        BOOST_TEST(err == common_server_errc::er_bad_field_error);
+        BOOST_TEST(diag.server_message() == "Unknown column");
+    });
+    accept_login();
+
+    server.read_command();
+    server.add_error(1054, "Unknown column");
+    server.flush();
+
+    fut.get();
+}
+
+BOOST_FIXTURE_TEST_CASE(statements, fixture)
+{
+    auto fut = run_client([this] {
+        client.handshake(client_params());
+        auto stmt = client.prepare_statement("SELECT ?, ?, ?");
+        BOOST_TEST(stmt.id() == 7u);
+        BOOST_TEST(stmt.num_params() == 3u);
+        results result;
+        client.execute(stmt.bind(42, "abc", nullptr), result);
+        client.close_statement(stmt);
+        client.ping();
+        client.close();
+        return result;
+    });
+    accept_login();
+
+    // Prepare
+    auto cmd = server.read_command();
+    BOOST_TEST((cmd.type == server_command_type::stmt_prepare));
+    BOOST_TEST(cmd.text == "SELECT ?, ?, ?");
+    std::array<server_column, 3> params{};
+    std::array<server_column, 4> columns{};
+    columns[0].type = column_type::int_;
+    columns[1].type = column_type::varchar;
+    columns[2].type = column_type::datetime;
+    columns[3].type = column_type::smallint;
+    server.add_prepare_ok(7, params, columns);
+
+    // Execute. Binary rows are sent in response
+    cmd = server.read_command();
+    BOOST_TEST((cmd.type == server_command_type::stmt_execute));
+    BOOST_TEST(cmd.statement_id == 7u);
+    std::array<field_view, 3> values;
+    BOOST_TEST(parse_statement_params(cmd, values) == error_code());
+    BOOST_TEST(values[0] == field_view(42));
+    BOOST_TEST(values[1] == field_view("abc"));
+    BOOST_TEST(values[2] == field_view());
+    server.add_resultset_head(columns);
+    server.add_row(make_fv_arr(values[0], values[1], datetime(2020, 1, 1), -3));
+    server.add_row(make_fv_arr(nullptr, "def", date(2021, 2, 3), nullptr));
+    server.add_resultset_end();
+
+    // Close statement: no response
+    cmd = server.read_command();
+    BOOST_TEST((cmd.type == server_command_type::stmt_close));
+    BOOST_TEST(cmd.statement_id == 7u);
+
+    // Ping
+    cmd = server.read_command();
+    BOOST_TEST((cmd.type == server_command_type::ping));
+    server.add_ok();
+
+    // Quit
+    cmd = server.read_command();
+    BOOST_TEST((cmd.type == server_command_type::quit));
+
+    // The client closed the connection
+    error_code err;
+    server.read_command(err);
+    BOOST_TEST(err == asio::error::eof);
+
+    auto result = fut.get();
+    BOOST_TEST(
+        result.rows() ==
+        makerows(4, 42, "abc", datetime(2020, 1, 1), -3, nullptr, "def", datetime(2021, 2, 3), nullptr)
+    );
+}
+
+BOOST_FIXTURE_TEST_CASE(batched_rows, fixture)
+{
+    auto fut = run_client([this] {
+        client.handshake(client_params());
+        results result;
+        client.execute("SELECT 1", result);
+        return result;
+    });
+    accept_login();
+
+    server.read_command();
+    std::array<server_column, 2> columns{};
+    columns[0].type = column_type::int_;
+    columns[1].type = column_type::text;
+    server.add_resultset_head(columns);
+    auto rws = makerows(2, 1, "a", 2, "b", 3, "c");
+    server.add_rows(rws);
+    server.add_resultset_end();
+    server.flush();
+
+    auto result = fut.get();
+    BOOST_TEST(result.rows() == rws);
+}
+
+BOOST_FIXTURE_TEST_CASE(async_functions, fixture)
+{
+    auto fut = run_client([this] {
+        client.handshake(client_params());
+        client.ping();
+    });
+
+    server.async_handshake({}, [this](error_code err) {
+        BOOST_TEST(err == error_code());
+        BOOST_TEST(server.check_password("pass"));
+        server.add_ok();
+        server.async_read_command([this](error_code err, server_command cmd) {
+            BOOST_TEST(err == error_code());
+            BOOST_TEST((cmd.type == server_command_type::ping));
+            server.add_ok();
+            server.async_flush([](error_code err) { BOOST_TEST(err == error_code()); });
+        });
+    });
+    ctx.run();
+
+    fut.get();
+}
+
+BOOST_AUTO_TEST_CASE(parse_statement_params_errors)
+{
+    std::array<field_view, 1> values;
+    server_command cmd;
+    cmd.type = server_command_type::stmt_execute;
+
+    // No types (new_params_bind_flag = 0)
+    const std::uint8_t no_types[] = {0x17, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0x00, 0x00};
+    cmd.payload = no_types;
+    BOOST_TEST(parse_statement_params(cmd, values) == client_errc::protocol_value_error);
+
+    // Truncated
+    const std::uint8_t truncated[] = {0x17, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0x00, 0x01, 0x08};
+    cmd.payload = truncated;
+    BOOST_TEST(parse_statement_params(cmd, values) == client_errc::incomplete_message);
+
+    // NULL value
+    const std::uint8_t null_value[] = {0x17, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0x01, 0x01, 0x06, 0x00};
+    cmd.payload = null_value;
+    values[0] = field_view(42);
+    BOOST_TEST(parse_statement_params(cmd, values) == error_code());
+    BOOST_TEST(values[0] == field_view());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/field_view.hpp>
+#include <boost/mysql/metadata.hpp>
+#include <boost/mysql/mysql_collations.hpp>
+#include <boost/mysql/rows.hpp>
+#include <boost/mysql/sort_rows.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_common/create_basic.hpp"
+#include "test_unit/create_meta.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+
+namespace {
+
+using idx_vector = std::vector<std::size_t>;
+
+// Sorts a single column without metadata
+idx_vector sort_single(const std::vector<field_view>& fields, sort_order order = sort_order::ascending)
+{
+    return sort_permutation(makerowsv(fields.data(), fields.size(), 1), {}, {sort_column(0, order)});
+}
+
+BOOST_AUTO_TEST_SUITE(test_sort_rows)
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+    rows r;
+    BOOST_TEST(sort_permutation(r, {}, {0}).empty());
+    BOOST_TEST(sort_rows(r, {}, {0}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(no_columns)
+{
+    auto r = makerows(1, 3, 1, 2);
+    BOOST_TEST(sort_permutation(r, {}, {}) == (idx_vector{0, 1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(by_kind)
+{
+    struct
+    {
+        const char* name;
+        std::vector<field_view> fields;
+        idx_vector expected;
+    } test_cases[] = {
+        {"int64",    make_fv_vector(3, -1, 0, -100, 100),                      {3, 1, 2, 0, 4}},
+        {"int64_limits",
+         make_fv_vector(INT64_MAX, INT64_MIN, 0),                                 {1, 2, 0}      },
+        {"uint64",   make_fv_vector(10u, 0u, 0xffffffffffffffffu, 5u),          {1, 3, 0, 2}   },
+        {"int64_uint64", make_fv_vector(10u, -5, 3, 0xffffffffffffffffu),       {1, 2, 0, 3}   },
+        {"double",   make_fv_vector(2.5, -1.0, 0.0, -0.5, 1e300, -1e300),       {5, 1, 3, 2, 0, 4}},
+        {"float",    make_fv_vector(2.5f, -1.0f, 0.0f),                         {1, 2, 0}      },
+        {"string",   make_fv_vector("b", "a", "", "ab", "B"),                   {2, 4, 1, 3, 0}},
+        {"string_zeros",
+         make_fv_vector(makesv("a\0b"), "a", makesv("a\0"), "a\x01"),          {1, 2, 0, 3}   },
+        {"blob",     make_fv_vector(makebv("\2"), makebv(""), makebv("\1\5")),  {1, 2, 0}      },
+        {"date",
+         make_fv_vector(date(2020, 1, 2), date(2019, 12, 31), date(2020, 1, 1)), {1, 2, 0}      },
+        {"datetime",
+         make_fv_vector(
+             datetime(2020, 1, 1, 0, 0, 0, 1),
+             datetime(2020, 1, 1),
+             datetime(2019, 1, 1, 23, 59, 59, 999999)
+         ),                                                                     {2, 1, 0}      },
+        {"time",     make_fv_vector(maket(1, 0, 0), -maket(2, 0, 0), maket(0, 0, 0)), {1, 2, 0}},
+        {"nulls",    make_fv_vector(2, nullptr, 1, nullptr),                    {1, 3, 2, 0}   },
+    };
+
+    for (const auto& tc : test_cases)
+    {
+        BOOST_TEST_CONTEXT(tc.name) { BOOST_TEST(sort_single(tc.fields) == tc.expected); }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(descending)
+{
+    auto fields = make_fv_vector(2, nullptr, 3, 1);
+    BOOST_TEST(sort_single(fields, sort_order::descending) == (idx_vector{2, 0, 3, 1}));
+
+    auto strings = make_fv_vector("a", "ab", "", makesv("a\0"));
+    BOOST_TEST(sort_single(strings, sort_order::descending) == (idx_vector{1, 3, 0, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(stable)
+{
+    auto fields = make_fv_vector(1, 0, 1, 0, 1);
+    BOOST_TEST(sort_single(fields) == (idx_vector{1, 3, 0, 2, 4}));
+    BOOST_TEST(sort_single(fields, sort_order::descending) == (idx_vector{0, 2, 4, 1, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(multiple_columns)
+{
+    // country, age, name
+    auto r = makerows(3, "us", 30, "a", "eu", 40, "b", "us", 20, "c", "eu", 40, "a", "eu", 10, "d");
+    BOOST_TEST(sort_permutation(r, {}, {0, 1}) == (idx_vector{4, 1, 3, 2, 0}));
+    BOOST_TEST(sort_permutation(r, {}, {0, {1, sort_order::descending}}) == (idx_vector{1, 3, 4, 0, 2}));
+    BOOST_TEST(sort_permutation(r, {}, {1, 2}) == (idx_vector{4, 2, 0, 3, 1}));
+
+    // Variable-length keys followed by other columns
+    auto r2 = makerows(2, "ab", 1, "a", 2, "a", 1, "abc", 0);
+    BOOST_TEST(sort_permutation(r2, {}, {0, 1}) == (idx_vector{2, 1, 0, 3}));
+    BOOST_TEST(sort_permutation(r2, {}, {{0, sort_order::descending}, 1}) == (idx_vector{3, 0, 2, 1}));
+}
+
+BOOST_AUTO_TEST_CASE(collations)
+{
+    auto r = makerows(1, "b", "A", "a", "B", "_");
+    auto ci = meta_builder().type(column_type::varchar).collation_id(mysql_collations::utf8mb4_general_ci).build();
+    auto bin = meta_builder().type(column_type::varchar).collation_id(mysql_collations::utf8mb4_bin).build();
+    auto cs = meta_builder().type(column_type::varchar).collation_id(mysql_collations::utf8mb4_0900_as_cs).build();
+
+    // Case-insensitive collations fold ASCII letters to uppercase
+    BOOST_TEST(sort_permutation(r, {&ci, 1}, {0}) == (idx_vector{1, 2, 0, 3, 4}));
+
+    // Binary and case-sensitive collations compare bytes
+    BOOST_TEST(sort_permutation(r, {&bin, 1}, {0}) == (idx_vector{1, 3, 4, 2, 0}));
+    BOOST_TEST(sort_permutation(r, {&cs, 1}, {0}) == (idx_vector{1, 3, 4, 2, 0}));
+    BOOST_TEST(sort_permutation(r, {}, {0}) == (idx_vector{1, 3, 4, 2, 0}));
+}
+
+BOOST_AUTO_TEST_CASE(decimals)
+{
+    auto r = makerows(
+        1,
+        "10.5",
+        "9",
+        "-3.25",
+        "0",
+        "-10",
+        "0.05",
+        "9.50",
+        "-0.00",
+        "100",
+        "-3.3",
+        "0.5",
+        nullptr
+    );
+    auto meta = create_meta(column_type::decimal);
+    BOOST_TEST(
+        sort_permutation(r, {&meta, 1}, {0}) == (idx_vector{11, 4, 9, 2, 3, 7, 5, 10, 1, 6, 0, 8})
+    );
+    BOOST_TEST(
+        sort_permutation(r, {&meta, 1}, {{0, sort_order::descending}}) ==
+        (idx_vector{8, 0, 6, 1, 10, 5, 3, 7, 2, 9, 4, 11})
+    );
+}
+
+BOOST_AUTO_TEST_CASE(sort_rows_copy)
+{
+    rows res;
+    {
+        auto r = makerows(2, "b", 2, "a", 1, "c", 3);
+        res = sort_rows(r, {}, {0});
+    }
+    BOOST_TEST(res == makerows(2, "a", 1, "b", 2, "c", 3));
+}
+
+BOOST_AUTO_TEST_CASE(large_matches_std_stable_sort)
+{
+    // Enough rows to exercise the radix passes, with many shared prefixes
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 50);
+    std::vector<std::string> strings;
+    std::vector<std::int64_t> ints;
+    for (std::size_t i = 0; i < 3000; ++i)
+    {
+        strings.push_back("prefix" + std::to_string(dist(gen)));
+        ints.push_back(dist(gen) - 25);
+    }
+    std::vector<field_view> fields;
+    for (std::size_t i = 0; i < strings.size(); ++i)
+    {
+        fields.push_back(field_view(strings[i]));
+        fields.push_back(field_view(ints[i]));
+    }
+    auto r = makerowsv(fields.data(), fields.size(), 2);
+
+    idx_vector expected(strings.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+        expected[i] = i;
+    std::stable_sort(expected.begin(), expected.end(), [&](std::size_t lhs, std::size_t rhs) {
+        if (strings[lhs] != strings[rhs])
+            return strings[lhs] < strings[rhs];
+        return ints[lhs] > ints[rhs];
+    });
+
+    BOOST_TEST(sort_permutation(r, {}, {0, {1, sort_order::descending}}) == expected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
@@ -0,0 +1,391 @@
+//
+// Copyright (c) 2019-2023 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/mysql/client_errc.hpp>
+#include <boost/mysql/column_type.hpp>
+#include <boost/mysql/connection.hpp>
+#include <boost/mysql/error_code.hpp>
+#include <boost/mysql/error_with_diagnostics.hpp>
+#include <boost/mysql/protocol_trace.hpp>
+#include <boost/mysql/replay_stream.hpp>
+#include <boost/mysql/results.hpp>
+#include <boost/mysql/wire_capture.hpp>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test_common/buffer_concat.hpp"
+#include "test_common/netfun_helpers.hpp"
+#include "test_common/printing.hpp"
+#include "test_unit/create_coldef_frame.hpp"
+#include "test_unit/create_frame.hpp"
+#include "test_unit/create_meta.hpp"
+#include "test_unit/create_ok.hpp"
+#include "test_unit/create_ok_frame.hpp"
+#include "test_unit/create_row_message.hpp"
+#include "test_unit/test_stream.hpp"
+
+using namespace boost::mysql;
+using namespace boost::mysql::test;
+using std::chrono::milliseconds;
+
+BOOST_AUTO_TEST_SUITE(test_wire_capture)
+
+using test_connection = connection<test_stream>;
+using replay_connection = connection<replay_stream>;
+
+std::vector<std::uint8_t> resultset_response()
+{
+    std::vector<std::uint8_t> res;
+    concat(res, create_frame(1, {0x02}));
+    concat(res, create_coldef_frame(2, meta_builder().type(column_type::bigint).build_coldef()));
+    concat(res, create_coldef_frame(3, meta_builder().type(column_type::varchar).build_coldef()));
+    concat(res, create_text_row_message(4, 42, "abc"));
+    concat(res, create_text_row_message(5, 43, "def"));
+    concat(res, create_eof_frame(6, ok_builder().affected_rows(2).build()));
+    return res;
+}
+
+void check_resultset(const results& result)
+{
+    BOOST_TEST_REQUIRE(result.rows().size() == 2u);
+    BOOST_TEST(result.rows().at(0).at(0) == field_view(42));
+    BOOST_TEST(result.rows().at(1).at(1) == field_view("def"));
+    BOOST_TEST(result.affected_rows() == 2u);
+}
+
+// Concatenates the data in all records with the given direction
+std::vector<std::uint8_t> join(const std::vector<wire_capture_record>& records, trace_direction dir)
+{
+    std::vector<std::uint8_t> res;
+    for (const auto& rec : records)
+    {
+        if (rec.direction == dir)
+            concat(res, rec.data);
+    }
+    return res;
+}
+
+// Captures the execution of a query against a test_stream
+std::vector<wire_capture_record> capture_query(std::size_t read_break = 0)
+{
+    std::stringstream ss;
+    test_connection conn;
+    auto response = resultset_response();
+    conn.stream().add_bytes(response);
+    if (read_break)
+        conn.stream().add_break(read_break);
+    results result;
+
+    conn.start_wire_capture(ss);
+    conn.execute("SELECT 1", result);
+    conn.stop_wire_capture();
+
+    return read_wire_capture(ss);
+}
+
+void add_record(
+    std::vector<wire_capture_record>& records,
+    trace_direction dir,
+    milliseconds t,
+    const std::string& data
+)
+{
+    records.push_back({dir, t, std::vector<std::uint8_t>(data.begin(), data.end())});
+}
+
+BOOST_AUTO_TEST_CASE(capture_sync)
+{
+    // Setup
+    std::stringstream ss;
+    test_connection conn;
+    auto response = resultset_response();
+    conn.stream().add_bytes(response).add_break(10);
+    results result;
+
+    // Capture
+    conn.start_wire_capture(ss);
+    conn.execute("SELECT 1", result);
+    conn.stop_wire_capture();
+    check_resultset(result);
+
+    // Every read and write was recorded
+    auto records = read_wire_capture(ss);
+    BOOST_TEST_REQUIRE(records.size() == 3u);
+    BOOST_TEST(records[0].direction == trace_direction::write);
+    BOOST_TEST(records[0].data == conn.stream().bytes_written());
+    BOOST_TEST(records[1].direction == trace_direction::read);
+    BOOST_TEST(records[1].data.size() == 10u);
+    BOOST_TEST(records[2].direction == trace_direction::read);
+    BOOST_TEST(join(records, trace_direction::read) == response);
+    BOOST_TEST(records[0].timestamp.count() >= 0);
+    BOOST_TEST((records[0].timestamp <= records[1].timestamp));
+    BOOST_TEST((records[1].timestamp <= records[2].timestamp));
+}
+
+BOOST_AUTO_TEST_CASE(capture_async)
+{
+    // Setup
+    std::stringstream ss;
+    test_connection conn;
+    auto response = resultset_response();
+    conn.stream().add_bytes(response);
+    results result;
+    error_code ec(client_errc::wrong_num_params);
+
+    // Capture
+    conn.start_wire_capture(ss);
+    conn.async_execute("SELECT 1", result, [&ec](error_code err) { ec = err; });
+    run_until_completion(conn.get_executor());
+    conn.stop_wire_capture();
+    BOOST_TEST(ec == error_code());
+    check_resultset(result);
+
+    // Every read and write was recorded
+    auto records = read_wire_capture(ss);
+    BOOST_TEST_REQUIRE(records.size() == 2u);
+    BOOST_TEST(records[0].direction == trace_direction::write);
+    BOOST_TEST(records[0].data == conn.stream().bytes_written());
+    BOOST_TEST(records[1].direction == trace_direction::read);
+    BOOST_TEST(records[1].data == response);
+}
+
+BOOST_AUTO_TEST_CASE(capture_stopped)
+{
+    std::stringstream ss;
+    test_connection conn;
+    conn.stream().add_bytes(create_ok_frame(1, ok_builder().build()));
+    conn.stream().add_bytes(create_ok_frame(1, ok_builder().build()));
+
+    // Nothing is recorded after stopping the capture
+    conn.start_wire_capture(ss);
+    conn.ping();
+    conn.stop_wire_capture();
+    conn.ping();
+
+    BOOST_TEST(read_wire_capture(ss).size() == 2u);
+}
+
+BOOST_AUTO_TEST_CASE(read_empty_capture)
+{
+    std::stringstream ss;
+    test_connection conn;
+    conn.start_wire_capture(ss);
+    conn.stop_wire_capture();
+
+    error_code ec(client_errc::wrong_num_params);
+    auto records = read_wire_capture(ss, ec);
+    BOOST_TEST(ec == error_code());
+    BOOST_TEST(records.empty());
+}
+
+BOOST_AUTO_TEST_CASE(read_errors)
+{
+    // A valid capture with a single record
+    std::stringstream valid;
+    test_connection conn;
+    conn.stream().add_bytes(create_ok_frame(1, ok_builder().build()));
+    conn.start_wire_capture(valid);
+    conn.ping();
+    conn.stop_wire_capture();
+    const std::string contents = valid.str();
+    const std::size_t header_size = 12u;
+
+    struct
+    {
+        const char* name;
+        std::string input;
+        client_errc expected;
+    } test_cases[] = {
+        {"empty", "", client_errc::protocol_value_error},
+        {"short_header", contents.substr(0, 4), client_errc::protocol_value_error},
+        {"bad_magic", "X" + contents.substr(1), client_errc::protocol_value_error},
+        {"bad_version",
+         contents.substr(0, 8) + '\x02' + contents.substr(9),
+         client_errc::protocol_value_error},
+        {"bad_direction",
+         contents.substr(0, header_size) + '\x05' + contents.substr(header_size + 1),
+         client_errc::protocol_value_error},
+        {"short_record_header", contents.substr(0, header_size + 3), client_errc::incomplete_message},
+        {"short_record_data", contents.substr(0, contents.size() - 1), client_errc::incomplete_message},
+        // A corrupt size must not cause a huge allocation
+        {"huge_record_size",
+         contents.substr(0, header_size + 9) + "\xff\xff\xff\xff" + contents.substr(header_size + 13),
+         client_errc::incomplete_message},
+    };
+
+    for (const auto& tc : test_cases)
+    {
+        BOOST_TEST_CONTEXT(tc.name)
+        {
+            std::istringstream input(tc.input);
+            error_code ec;
+            read_wire_capture(input, ec);
+            BOOST_TEST(ec == tc.expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(read_error_exception)
+{
+    std::istringstream input("not a capture");
+    BOOST_CHECK_THROW(read_wire_capture(input), error_with_diagnostics);
+}
+
+BOOST_AUTO_TEST_CASE(replay_sync)
+{
+    // Capture with some record boundaries in the middle of messages
+    auto records = capture_query(15);
+    boost::asio::io_context ctx;
+    replay_connection conn(ctx.get_executor(), records);
+    results result;
+
+    // The connection sees the same conversation
+    conn.execute("SELECT 1", result);
+    check_resultset(result);
+    BOOST_TEST(conn.stream().done());
+
+    // Reading past the capture fails
+    error_code ec;
+    diagnostics diag;
+    conn.ping(ec, diag);
+    BOOST_TEST(ec == error_code(boost::asio::error::eof));
+}
+
+BOOST_AUTO_TEST_CASE(replay_async)
+{
+    auto records = capture_query();
+    boost::asio::io_context ctx;
+    replay_connection conn(ctx.get_executor(), records);
+    results result;
+    error_code ec(client_errc::wrong_num_params);
+
+    conn.async_execute("SELECT 1", result, [&ec](error_code err) { ec = err; });
+    ctx.run();
+
+    BOOST_TEST(ec == error_code());
+    check_resultset(result);
+    BOOST_TEST(conn.stream().done());
+}
+
+BOOST_AUTO_TEST_CASE(replay_rewind)
+{
+    auto records = capture_query();
+    boost::asio::io_context ctx;
+    replay_connection conn(ctx.get_executor(), records);
+    results result;
+
+    // The same capture can be replayed several times
+    for (int i = 0; i < 3; ++i)
+    {
+        conn.execute("SELECT 1", result);
+        check_resultset(result);
+        conn.stream().rewind();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(replay_stream_reads)
+{
+    std::vector<wire_capture_record> records;
+    add_record(records, trace_direction::write, milliseconds(0), "request");
+    add_record(records, trace_direction::read, milliseconds(0), "abcde");
+    add_record(records, trace_direction::read, milliseconds(0), "");
+    add_record(records, trace_direction::write, milliseconds(0), "request");
+    add_record(records, trace_direction::read, milliseconds(0), "fg");
+
+    boost::asio::io_context ctx;
+    replay_stream stream(ctx.get_executor(), records);
+    char buff[4]{};
+    error_code ec;
+    BOOST_TEST(!stream.done());
+
+    // Writes are discarded
+    BOOST_TEST(stream.write_some(boost::asio::buffer("xyz", 3), ec) == 3u);
+    BOOST_TEST(ec == error_code());
+
+    // Reads are limited by the buffer size and record boundaries. Empty records are skipped
+    BOOST_TEST(stream.read_some(boost::asio::buffer(buff), ec) == 4u);
+    BOOST_TEST(std::string(buff, 4) == "abcd");
+    BOOST_TEST(stream.read_some(boost::asio::buffer(buff), ec) == 1u);
+    BOOST_TEST(buff[0] == 'e');
+    BOOST_TEST(stream.read_some(boost::asio::buffer(buff, 0), ec) == 0u);
+    BOOST_TEST(ec == error_code());
+    BOOST_TEST(stream.read_some(boost::asio::buffer(buff), ec) == 2u);
+    BOOST_TEST(std::string(buff, 2) == "fg");
+    BOOST_TEST(stream.done());
+
+    // Past the end
+    BOOST_TEST(stream.read_some(boost::asio::buffer(buff), ec) == 0u);
+    BOOST_TEST(ec == error_code(boost::asio::error::eof));
+    BOOST_CHECK_THROW(stream.read_some(boost::asio::buffer(buff)), boost::system::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(replay_original_timing_sync)
+{
+    std::vector<wire_capture_record> records;
+    add_record(records, trace_direction::write, milliseconds(100), "request");
+    add_record(records, trace_direction::read, milliseconds(120), "abc");
+
+    boost::asio::io_context ctx;
+    replay_stream stream(ctx.get_executor(), records, true);
+    char buff[8]{};
+    error_code ec;
+
+    // Times are relative to the first record, which maps to the first operation
+    auto start = std::chrono::steady_clock::now();
+    stream.write_some(boost::asio::buffer("request", 7), ec);
+    BOOST_TEST(stream.read_some(boost::asio::buffer(buff), ec) == 3u);
+    BOOST_TEST((std::chrono::steady_clock::now() - start >= milliseconds(20)));
+}
+
+BOOST_AUTO_TEST_CASE(replay_original_timing_async)
+{
+    std::vector<wire_capture_record> records;
+    add_record(records, trace_direction::read, milliseconds(0), "abc");
+    add_record(records, trace_direction::read, milliseconds(20), "def");
+
+    boost::asio::io_context ctx;
+    replay_stream stream(ctx.get_executor(), records, true);
+    char buff[8]{};
+    std::size_t bytes_read = 0;
+    error_code ec;
+    struct handler
+    {
+        error_code& ec;
+        std::size_t& bytes_read;
+        void operator()(error_code err, std::size_t n)
+        {
+            ec = err;
+            bytes_read = n;
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    stream.async_read_some(boost::asio::buffer(buff), handler{ec, bytes_read});
+    ctx.run();
+    BOOST_TEST(ec == error_code());
+    BOOST_TEST(bytes_read == 3u);
+
+    stream.async_read_some(boost::asio::buffer(buff), handler{ec, bytes_read});
+    ctx.restart();
+    ctx.run();
+    BOOST_TEST(ec == error_code());
+    BOOST_TEST(bytes_read == 3u);
+    BOOST_TEST(std::string(buff, 3) == "def");
+    BOOST_TEST((std::chrono::steady_clock::now() - start >= milliseconds(20)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()